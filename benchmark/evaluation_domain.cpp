@@ -0,0 +1,186 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/algebra/fields/alt_bn128/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/alt_bn128.hpp>
+
+#include <nil/crypto3/math/domains/arithmetic_sequence_domain.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
+#include <nil/crypto3/math/domains/extended_radix2_domain.hpp>
+#include <nil/crypto3/math/domains/geometric_sequence_domain.hpp>
+#include <nil/crypto3/math/domains/step_radix2_domain.hpp>
+#include <nil/crypto3/math/type_traits.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+typedef fields::bls12_fr<381> bls12_fr_type;
+typedef fields::alt_bn128_fr<254> alt_bn128_fr_type;
+
+/**
+ * Deterministic, non-structured input so that runs of different commits transform identical data.
+ */
+template<typename FieldType>
+std::vector<typename FieldType::value_type> make_values(std::size_t n) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> result(n);
+    value_type x = value_type(0x9E3779B97F4A7C15ull);
+    for (std::size_t i = 0; i < n; ++i) {
+        x = x * x + value_type(i + 1);
+        result[i] = x;
+    }
+    return result;
+}
+
+/**
+ * Maps the benchmark argument (log2 of the size) to the size of the domain under test, and tells whether the field
+ * admits such a domain at all.
+ */
+template<typename FieldType, template<typename> class DomainType>
+struct domain_size;
+
+template<typename FieldType>
+struct domain_size<FieldType, basic_radix2_domain> {
+    static std::size_t get(std::size_t log_m) {
+        return std::size_t(1) << log_m;
+    }
+
+    static bool is_supported(std::size_t m) {
+        return detail::is_basic_radix2_domain<FieldType>(m);
+    }
+};
+
+template<typename FieldType>
+struct domain_size<FieldType, extended_radix2_domain> {
+    static std::size_t get(std::size_t log_m) {
+        return std::size_t(1) << log_m;
+    }
+
+    static bool is_supported(std::size_t m) {
+        return detail::is_extended_radix2_domain<FieldType>(m);
+    }
+};
+
+template<typename FieldType>
+struct domain_size<FieldType, step_radix2_domain> {
+    static std::size_t get(std::size_t log_m) {
+        return (std::size_t(1) << log_m) + (std::size_t(1) << (log_m - 1));
+    }
+
+    static bool is_supported(std::size_t m) {
+        return detail::is_step_radix2_domain<FieldType>(m);
+    }
+};
+
+template<typename FieldType>
+struct domain_size<FieldType, geometric_sequence_domain> {
+    static std::size_t get(std::size_t log_m) {
+        return std::size_t(1) << log_m;
+    }
+
+    static bool is_supported(std::size_t m) {
+        return detail::is_geometric_sequence_domain<FieldType>(m);
+    }
+};
+
+template<typename FieldType>
+struct domain_size<FieldType, arithmetic_sequence_domain> {
+    static std::size_t get(std::size_t log_m) {
+        return std::size_t(1) << log_m;
+    }
+
+    static bool is_supported(std::size_t m) {
+        return detail::is_arithmetic_sequence_domain<FieldType>(m);
+    }
+};
+
+template<typename FieldType, template<typename> class DomainType, bool Inverse>
+void benchmark_domain_fft(benchmark::State &state) {
+    typedef domain_size<FieldType, DomainType> size_type;
+
+    const std::size_t m = size_type::get(state.range(0));
+    if (!size_type::is_supported(m)) {
+        state.SkipWithError("the field does not admit a domain of this size");
+        return;
+    }
+
+    DomainType<FieldType> domain(m);
+    const std::vector<typename FieldType::value_type> input = make_values<FieldType>(m);
+    std::vector<typename FieldType::value_type> a = input;
+
+    // The first transform pays for the lazily computed twiddle tables; keep it out of the measurement.
+    Inverse ? domain.inverse_fft(a) : domain.fft(a);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        a = input;
+        state.ResumeTiming();
+
+        Inverse ? domain.inverse_fft(a) : domain.fft(a);
+        benchmark::DoNotOptimize(a.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["size"] = m;
+    state.SetItemsProcessed(state.iterations() * m);
+}
+
+/**
+ * Radix-2 style domains are measured over the full range; the sequence domains do several inversions and polynomial
+ * multiplications per element, so their range stops earlier to keep a full run of the suite practical.
+ */
+static void radix2_sizes(benchmark::internal::Benchmark *b) {
+    b->ArgName("log_size")->DenseRange(10, 24)->Unit(benchmark::kMillisecond);
+}
+
+static void sequence_sizes(benchmark::internal::Benchmark *b) {
+    b->ArgName("log_size")->DenseRange(10, 18)->Unit(benchmark::kMillisecond);
+}
+
+#define MATH_BENCHMARK_DOMAIN(field, domain, sizes)                                 \
+    BENCHMARK_TEMPLATE(benchmark_domain_fft, field, domain, false)->Apply(sizes); \
+    BENCHMARK_TEMPLATE(benchmark_domain_fft, field, domain, true)->Apply(sizes)
+
+MATH_BENCHMARK_DOMAIN(bls12_fr_type, basic_radix2_domain, radix2_sizes);
+MATH_BENCHMARK_DOMAIN(bls12_fr_type, extended_radix2_domain, radix2_sizes);
+MATH_BENCHMARK_DOMAIN(bls12_fr_type, step_radix2_domain, radix2_sizes);
+MATH_BENCHMARK_DOMAIN(bls12_fr_type, geometric_sequence_domain, sequence_sizes);
+MATH_BENCHMARK_DOMAIN(bls12_fr_type, arithmetic_sequence_domain, sequence_sizes);
+
+MATH_BENCHMARK_DOMAIN(alt_bn128_fr_type, basic_radix2_domain, radix2_sizes);
+MATH_BENCHMARK_DOMAIN(alt_bn128_fr_type, extended_radix2_domain, radix2_sizes);
+MATH_BENCHMARK_DOMAIN(alt_bn128_fr_type, step_radix2_domain, radix2_sizes);
+MATH_BENCHMARK_DOMAIN(alt_bn128_fr_type, geometric_sequence_domain, sequence_sizes);
+MATH_BENCHMARK_DOMAIN(alt_bn128_fr_type, arithmetic_sequence_domain, sequence_sizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/algebra/fields/alt_bn128/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/alt_bn128.hpp>
+
+#include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+typedef fields::bls12_fr<381> bls12_fr_type;
+typedef fields::alt_bn128_fr<254> alt_bn128_fr_type;
+
+/**
+ * Deterministic, non-structured input so that runs of different commits operate on identical data.
+ */
+template<typename FieldType>
+std::vector<typename FieldType::value_type> make_values(std::size_t n, std::uint64_t seed) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> result(n);
+    value_type x = value_type(seed);
+    for (std::size_t i = 0; i < n; ++i) {
+        x = x * x + value_type(i + 1);
+        result[i] = x;
+    }
+    return result;
+}
+
+/**
+ * Multiplies two polynomials with n / 2 coefficients each, so that the product is transformed over n points.
+ */
+template<typename FieldType>
+void benchmark_polynomial_multiplication(benchmark::State &state) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = std::size_t(1) << state.range(0);
+    const polynomial<value_type> a(make_values<FieldType>(n / 2, 0x9E3779B97F4A7C15ull));
+    const polynomial<value_type> b(make_values<FieldType>(n / 2, 0xC2B2AE3D27D4EB4Full));
+
+    for (auto _ : state) {
+        polynomial<value_type> c = a * b;
+        benchmark::DoNotOptimize(c);
+    }
+
+    state.counters["size"] = n;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Divides a polynomial with n coefficients by one with n / 2 coefficients.
+ */
+template<typename FieldType>
+void benchmark_polynomial_division(benchmark::State &state) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = std::size_t(1) << state.range(0);
+    const polynomial<value_type> a(make_values<FieldType>(n, 0x9E3779B97F4A7C15ull));
+    const polynomial<value_type> b(make_values<FieldType>(n / 2, 0xC2B2AE3D27D4EB4Full));
+
+    for (auto _ : state) {
+        polynomial<value_type> q = a / b;
+        benchmark::DoNotOptimize(q);
+    }
+
+    state.counters["size"] = n;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * Interpolates through n points with pairwise distinct abscissas 1, 2, ..., n.
+ */
+template<typename FieldType>
+void benchmark_lagrange_interpolation(benchmark::State &state) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = std::size_t(1) << state.range(0);
+    const std::vector<value_type> y = make_values<FieldType>(n, 0x9E3779B97F4A7C15ull);
+
+    std::vector<std::pair<value_type, value_type>> points(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        points[i] = std::make_pair(value_type(i + 1), y[i]);
+    }
+
+    for (auto _ : state) {
+        polynomial<value_type> p = lagrange_interpolation(points);
+        benchmark::DoNotOptimize(p);
+    }
+
+    state.counters["size"] = n;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void linear_sizes(benchmark::internal::Benchmark *b) {
+    b->ArgName("log_size")->DenseRange(10, 24)->Unit(benchmark::kMillisecond);
+}
+
+/**
+ * Interpolation through the subproduct tree costs a logarithmic factor more than a multiplication, so its range stops
+ * earlier to keep a full run of the suite practical.
+ */
+static void interpolation_sizes(benchmark::internal::Benchmark *b) {
+    b->ArgName("log_size")->DenseRange(4, 16)->Unit(benchmark::kMillisecond);
+}
+
+#define MATH_BENCHMARK_POLYNOMIAL(field)                                                \
+    BENCHMARK_TEMPLATE(benchmark_polynomial_multiplication, field)->Apply(linear_sizes); \
+    BENCHMARK_TEMPLATE(benchmark_polynomial_division, field)->Apply(linear_sizes);       \
+    BENCHMARK_TEMPLATE(benchmark_lagrange_interpolation, field)->Apply(interpolation_sizes)
+
+MATH_BENCHMARK_POLYNOMIAL(bls12_fr_type);
+MATH_BENCHMARK_POLYNOMIAL(alt_bn128_fr_type);
+
+BENCHMARK_MAIN();
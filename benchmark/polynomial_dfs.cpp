@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/algebra/fields/alt_bn128/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/alt_bn128.hpp>
+
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+typedef fields::bls12_fr<381> bls12_fr_type;
+typedef fields::alt_bn128_fr<254> alt_bn128_fr_type;
+
+/**
+ * Deterministic, non-structured input so that runs of different commits operate on identical data.
+ */
+template<typename FieldType>
+std::vector<typename FieldType::value_type> make_values(std::size_t n, std::uint64_t seed) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> result(n);
+    value_type x = value_type(seed);
+    for (std::size_t i = 0; i < n; ++i) {
+        x = x * x + value_type(i + 1);
+        result[i] = x;
+    }
+    return result;
+}
+
+/**
+ * Two polynomials of degree n / 2 - 1 in evaluation form over 2^log_size points, so that their product still fits the
+ * same domain and multiplication stays pointwise.
+ */
+template<typename FieldType>
+std::pair<polynomial_dfs<typename FieldType::value_type>, polynomial_dfs<typename FieldType::value_type>>
+    make_operands(std::size_t log_size) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = std::size_t(1) << log_size;
+    polynomial_dfs<value_type> a_dfs, b_dfs;
+    a_dfs.from_coefficients(make_values<FieldType>(n / 2, 0x9E3779B97F4A7C15ull));
+    b_dfs.from_coefficients(make_values<FieldType>(n / 2, 0xC2B2AE3D27D4EB4Full));
+    a_dfs.resize(n);
+    b_dfs.resize(n);
+    return {a_dfs, b_dfs};
+}
+
+template<typename FieldType, typename Operation>
+void benchmark_polynomial_dfs_operation(benchmark::State &state, Operation op) {
+    const auto operands = make_operands<FieldType>(state.range(0));
+
+    for (auto _ : state) {
+        polynomial_dfs<typename FieldType::value_type> result = op(operands.first, operands.second);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["size"] = operands.first.size();
+    state.SetItemsProcessed(state.iterations() * operands.first.size());
+}
+
+template<typename FieldType>
+void benchmark_polynomial_dfs_addition(benchmark::State &state) {
+    benchmark_polynomial_dfs_operation<FieldType>(state, [](const auto &a, const auto &b) { return a + b; });
+}
+
+template<typename FieldType>
+void benchmark_polynomial_dfs_subtraction(benchmark::State &state) {
+    benchmark_polynomial_dfs_operation<FieldType>(state, [](const auto &a, const auto &b) { return a - b; });
+}
+
+template<typename FieldType>
+void benchmark_polynomial_dfs_multiplication(benchmark::State &state) {
+    benchmark_polynomial_dfs_operation<FieldType>(state, [](const auto &a, const auto &b) { return a * b; });
+}
+
+template<typename FieldType>
+void benchmark_polynomial_dfs_division(benchmark::State &state) {
+    benchmark_polynomial_dfs_operation<FieldType>(state, [](const auto &a, const auto &b) { return a / b; });
+}
+
+/**
+ * A PLONK-style gate constraint q_l * a + q_r * b + q_m * a * b + q_o * c + q_c over same-size operands.
+ */
+template<typename FieldType>
+void benchmark_polynomial_dfs_gate(benchmark::State &state) {
+    typedef typename FieldType::value_type value_type;
+
+    const auto ab = make_operands<FieldType>(state.range(0));
+    const auto qs = make_operands<FieldType>(state.range(0));
+    const auto qm = make_operands<FieldType>(state.range(0));
+    const auto cs = make_operands<FieldType>(state.range(0));
+    const polynomial_dfs<value_type> &a = ab.first, &b = ab.second, &c = cs.first;
+    const polynomial_dfs<value_type> &q_l = qs.first, &q_r = qs.second, &q_m = qm.first, &q_o = qm.second;
+    const value_type q_c = value_type(7);
+
+    for (auto _ : state) {
+        polynomial_dfs<value_type> result = q_l * a + q_r * b + q_m * a * b + q_o * c + q_c;
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["size"] = a.size();
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+static void linear_sizes(benchmark::internal::Benchmark *b) {
+    b->ArgName("log_size")->DenseRange(10, 24)->Unit(benchmark::kMillisecond);
+}
+
+/**
+ * Division goes through the quadratic long division in coefficient form, so its range stops earlier to keep a full
+ * run of the suite practical.
+ */
+static void quadratic_sizes(benchmark::internal::Benchmark *b) {
+    b->ArgName("log_size")->DenseRange(10, 14)->Unit(benchmark::kMillisecond);
+}
+
+#define MATH_BENCHMARK_POLYNOMIAL_DFS(field)                                                    \
+    BENCHMARK_TEMPLATE(benchmark_polynomial_dfs_addition, field)->Apply(linear_sizes);       \
+    BENCHMARK_TEMPLATE(benchmark_polynomial_dfs_subtraction, field)->Apply(linear_sizes);    \
+    BENCHMARK_TEMPLATE(benchmark_polynomial_dfs_multiplication, field)->Apply(linear_sizes); \
+    BENCHMARK_TEMPLATE(benchmark_polynomial_dfs_division, field)->Apply(quadratic_sizes);    \
+    BENCHMARK_TEMPLATE(benchmark_polynomial_dfs_gate, field)->Apply(linear_sizes)
+
+MATH_BENCHMARK_POLYNOMIAL_DFS(bls12_fr_type);
+MATH_BENCHMARK_POLYNOMIAL_DFS(alt_bn128_fr_type);
+
+BENCHMARK_MAIN();
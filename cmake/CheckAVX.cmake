@@ -33,6 +33,17 @@ set(AVX2_CODE "
   }
 ")
 
+set(AVX512IFMA_CODE "
+  #include <immintrin.h>
+
+  int main()
+  {
+    __m512i a = _mm512_set1_epi64(1);
+    a = _mm512_madd52lo_epu64(a, a, a);
+    return (int)_mm512_reduce_add_epi64(a);
+  }
+")
+
 macro(check_avx_lang lang type flags)
     set(__FLAG_I 1)
     set(CMAKE_REQUIRED_FLAGS_SAVE ${CMAKE_REQUIRED_FLAGS})
@@ -68,4 +79,5 @@ macro(check_avx)
 
     check_avx_lang(CXX "AVX" " ;-mavx;/arch:AVX")
     check_avx_lang(CXX "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+    check_avx_lang(CXX "AVX512IFMA" " ;-mavx512f -mavx512ifma;/arch:AVX512")
 endmacro()
\ No newline at end of file
@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_BATCH_INVERSE_HPP
+#define CRYPTO3_MATH_BATCH_INVERSE_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <nil/crypto3/math/instrumentation.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace detail {
+                /* one inversion costs a few hundred multiplications, so each chunk should amortize it */
+                constexpr std::size_t batch_inverse_grain_size = 1ul << 12;
+
+                template<typename Iterator>
+                void batch_inverse_chunk(Iterator first, std::size_t n) {
+                    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+                    std::vector<value_type> prefix(n);
+                    value_type acc = value_type::one();
+                    for (std::size_t i = 0; i < n; ++i) {
+                        prefix[i] = acc;
+                        if (!first[i].is_zero()) {
+                            acc *= first[i];
+                        }
+                    }
+
+                    value_type inverse = acc.inversed();
+                    for (std::size_t i = n; i-- > 0;) {
+                        if (!first[i].is_zero()) {
+                            const value_type x = first[i];
+                            first[i] = inverse * prefix[i];
+                            inverse *= x;
+                        }
+                    }
+                }
+            }    // namespace detail
+
+            /**
+             * Replace every element of [first, last) by its inverse with Montgomery's trick: 3(n - 1)
+             * multiplications and a single inversion instead of n inversions. Zero elements are left untouched.
+             * With a thread pool the range is split into chunks, each costing one inversion.
+             */
+            template<typename Iterator>
+            void batch_inverse(Iterator first, Iterator last, thread_pool *pool = nullptr) {
+                CRYPTO3_MATH_INSTRUMENT("batch_inverse", std::distance(first, last), 0);
+
+                const std::size_t n = std::distance(first, last);
+                detail::parallel_for(
+                    pool, 0, n,
+                    [first](std::size_t begin, std::size_t end) {
+                        detail::batch_inverse_chunk(first + begin, end - begin);
+                    },
+                    detail::batch_inverse_grain_size);
+            }
+
+            template<typename Range>
+            void batch_inverse(Range &values, thread_pool *pool = nullptr) {
+                batch_inverse(std::begin(values), std::end(values), pool);
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_BATCH_INVERSE_HPP
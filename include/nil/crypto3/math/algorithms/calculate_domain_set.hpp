@@ -27,22 +27,27 @@
 #define CRYPTO3_MATH_CALCULATE_DOMAIN_SET_HPP
 
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
-#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/evaluation_domain_cache.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace math {
 
+            /**
+             * The domains of the sizes 2^max_domain_degree, 2^(max_domain_degree - 1), ..., set_size of them, from
+             * the cache of the field. The smaller domains are derived from the largest one: since
+             * omega_{n/2} = omega_n^2 they share its twiddle tables rather than computing their own, see
+             * evaluation_domain_cache::get(m, parent).
+             */
             template<typename FieldType>
             std::vector<std::shared_ptr<evaluation_domain<FieldType>>>
                 calculate_domain_set(const std::size_t max_domain_degree, const std::size_t set_size) {
 
+                evaluation_domain_cache<FieldType> &cache = evaluation_domain_cache<FieldType>::instance();
                 std::vector<std::shared_ptr<evaluation_domain<FieldType>>> domain_set(set_size);
                 for (std::size_t i = 0; i < set_size; i++) {
-                    const std::size_t domain_size = std::pow(2, max_domain_degree - i);
-                    std::shared_ptr<evaluation_domain<FieldType>> domain =
-                        make_evaluation_domain<FieldType>(domain_size);
-                    domain_set[i] = domain;
+                    const std::size_t domain_size = std::size_t(1) << (max_domain_degree - i);
+                    domain_set[i] = i == 0 ? cache.get(domain_size) : cache.get(domain_size, domain_set[0]);
                 }
                 return domain_set;
             }
@@ -0,0 +1,363 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_ALGORITHMS_DISTRIBUTED_FFT_HPP
+#define CRYPTO3_MATH_ALGORITHMS_DISTRIBUTED_FFT_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /*
+             * The radix-2 FFT of the size n distributed over the P ranks of an MPI communicator, each one holding
+             * n / P of the elements, is the four-step FFT of out_of_core_fft over the n1 x n2 matrix,
+             * n1 = 2^(log2(n) / 2) <= n2, with the columns of the coefficients on one side and the rows of the
+             * values on the other, so that it exchanges the elements once, in one MPI_Alltoall:
+             *
+             * - in the column order, the input of distributed_fft and the output of distributed_inverse_fft, rank
+             *   r holds the columns j2 in [r n2 / P, (r + 1) n2 / P) of the matrix a[j1 n2 + j2] one after another,
+             *   a[j1 n2 + j2] at the position (j2 - r n2 / P) n1 + j1;
+             * - in the row order, the output of distributed_fft and the input of distributed_inverse_fft, rank r
+             *   holds the rows k1 in [r n1 / P, (r + 1) n1 / P) of the matrix X[k1 + n1 k2], X[k1 + n1 k2] at the
+             *   position (k1 - r n1 / P) n2 + k2.
+             *
+             * Pointwise operations work on the values in the row order as they do in the natural one. Both orders
+             * are matrix transposes of the natural order, which distributed_transpose makes with one more
+             * MPI_Alltoall. P is a power of two with n1 and n2 divisible by it, and the elements are sent as
+             * raw bytes, as serialize writes them.
+             */
+
+            /**
+             * The sides n1 x n2 of the matrix of distributed_fft for the size n.
+             */
+            inline std::pair<std::size_t, std::size_t> distributed_fft_sides(std::size_t n) {
+                const std::size_t n1 = 1ul << (static_cast<std::size_t>(std::log2(n)) / 2);
+                return {n1, n / n1};
+            }
+
+            namespace detail {
+
+                struct distributed_fft_shape {
+                    std::size_t n1;
+                    std::size_t n2;
+                    std::size_t ranks;
+                    std::size_t rank;
+
+                    distributed_fft_shape(std::size_t n, MPI_Comm comm) {
+                        const std::size_t logn = static_cast<std::size_t>(std::log2(n));
+                        if (n < 2 || n != (1ul << logn)) {
+                            throw std::invalid_argument("distributed_fft: expected n == (1 << logn) > 1");
+                        }
+                        std::tie(n1, n2) = distributed_fft_sides(n);
+
+                        int size, index;
+                        MPI_Comm_size(comm, &size);
+                        MPI_Comm_rank(comm, &index);
+                        ranks = static_cast<std::size_t>(size);
+                        rank = static_cast<std::size_t>(index);
+                        if (n1 % ranks != 0 || n2 % ranks != 0) {
+                            throw std::invalid_argument("distributed_fft: expected a power of two number of ranks "
+                                                        "dividing both sides of the matrix");
+                        }
+                    }
+
+                    std::size_t local_size() const {
+                        return n1 * n2 / ranks;
+                    }
+                };
+
+                template<typename ValueType>
+                class distributed_fft_datatype {
+                    static_assert(std::is_trivially_destructible<ValueType>::value,
+                                  "field elements are sent as they are held in memory");
+
+                public:
+                    distributed_fft_datatype() {
+                        MPI_Type_contiguous(static_cast<int>(sizeof(ValueType)), MPI_BYTE, &type);
+                        MPI_Type_commit(&type);
+                    }
+
+                    distributed_fft_datatype(const distributed_fft_datatype &) = delete;
+                    distributed_fft_datatype &operator=(const distributed_fft_datatype &) = delete;
+
+                    ~distributed_fft_datatype() {
+                        MPI_Type_free(&type);
+                    }
+
+                    MPI_Datatype type;
+                };
+
+                /*
+                 * The transpose of the distributed (rows P) x cols matrix, the local rows x cols block row of which
+                 * is a, into the rows of the cols x (rows P) one: the columns [s cols / P, (s + 1) cols / P) go to
+                 * the rank s, which stacks those of all the ranks and transposes them locally.
+                 */
+                template<typename ValueType>
+                void distributed_exchange(std::vector<ValueType> &a, std::size_t rows, std::size_t cols,
+                                          MPI_Comm comm, thread_pool *pool) {
+                    int size;
+                    MPI_Comm_size(comm, &size);
+                    const std::size_t ranks = static_cast<std::size_t>(size);
+                    const std::size_t width = cols / ranks, block = rows * width;
+
+                    std::vector<ValueType> send(a.size()), receive(a.size());
+                    parallel_for(
+                        pool, 0, rows,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                for (std::size_t s = 0; s < ranks; ++s) {
+                                    std::copy(a.begin() + i * cols + s * width,
+                                              a.begin() + i * cols + (s + 1) * width,
+                                              send.begin() + s * block + i * width);
+                                }
+                            }
+                        },
+                        1);
+
+                    const distributed_fft_datatype<ValueType> datatype;
+                    if (MPI_Alltoall(send.data(), static_cast<int>(block), datatype.type, receive.data(),
+                                     static_cast<int>(block), datatype.type, comm) != MPI_SUCCESS) {
+                        throw std::runtime_error("distributed_fft: MPI_Alltoall failed");
+                    }
+
+                    /* the block of the rank s holds the rows [s rows, (s + 1) rows) of the block column */
+                    const std::size_t all_rows = rows * ranks;
+                    parallel_for(
+                        pool, 0, all_rows,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                const ValueType *row = receive.data() + i * width;
+                                for (std::size_t j = 0; j < width; ++j) {
+                                    a[j * all_rows + i] = row[j];
+                                }
+                            }
+                        },
+                        1);
+                }
+
+                template<typename FieldType>
+                void distributed_local_ffts(std::vector<typename FieldType::value_type> &a, std::size_t length,
+                                            const std::vector<typename FieldType::value_type> &twiddles,
+                                            thread_pool *pool) {
+                    parallel_for(
+                        pool, 0, a.size() / length,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t r = begin; r < end; ++r) {
+                                basic_radix4_fft_cached<FieldType>(a.begin() + r * length, length, twiddles.data());
+                            }
+                        },
+                        1);
+                }
+
+                /*
+                 * x_{j2, j1} * c * g^{j1 n2 + j2} * omega^{j2 k1} over the local columns of the column order, the
+                 * twiddles in their k1 and the coset powers in their j1, either of them left out with g or omega
+                 * null
+                 */
+                template<typename FieldType>
+                void distributed_scale_columns(std::vector<typename FieldType::value_type> &a,
+                                               const distributed_fft_shape &shape,
+                                               const typename FieldType::value_type *omega,
+                                               const typename FieldType::value_type *g,
+                                               const typename FieldType::value_type &c, thread_pool *pool) {
+                    typedef typename FieldType::value_type value_type;
+
+                    const std::size_t first = shape.rank * (shape.n2 / shape.ranks);
+
+                    std::vector<value_type> row_powers(shape.n1, c);
+                    if (g != nullptr) {
+                        const value_type g_n2 = g->pow(shape.n2);
+                        for (std::size_t j1 = 1; j1 < shape.n1; ++j1) {
+                            row_powers[j1] = row_powers[j1 - 1] * g_n2;
+                        }
+                    }
+
+                    parallel_for(
+                        pool, 0, shape.n2 / shape.ranks,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j2 = begin; j2 < end; ++j2) {
+                                const value_type column = g != nullptr ? g->pow(first + j2) : value_type::one();
+                                const value_type w = omega != nullptr ? omega->pow(first + j2) : value_type::one();
+                                value_type w_k1 = column;
+                                for (std::size_t k1 = 0; k1 < shape.n1; ++k1) {
+                                    a[j2 * shape.n1 + k1] *= w_k1 * row_powers[k1];
+                                    w_k1 *= w;
+                                }
+                            }
+                        },
+                        1);
+                }
+
+                template<typename FieldType>
+                void distributed_transform(std::vector<typename FieldType::value_type> &a, std::size_t n,
+                                           bool inverse, const typename FieldType::value_type *g, MPI_Comm comm,
+                                           thread_pool *pool) {
+                    typedef typename FieldType::value_type value_type;
+
+                    const distributed_fft_shape shape(n, comm);
+                    if (a.size() != shape.local_size()) {
+                        throw std::invalid_argument("distributed_fft: expected a.size() == n / ranks");
+                    }
+
+                    const value_type omega =
+                        inverse ? unity_root<FieldType>(n).inversed() : unity_root<FieldType>(n);
+                    value_type omega_n2 = omega;
+                    for (std::size_t i = shape.n2; i < n; i *= 2) {
+                        omega_n2 = omega_n2.squared();
+                    }
+                    /* the table of n2 contains the one of n1 */
+                    const std::vector<value_type> twiddles =
+                        basic_radix2_fft_twiddles<FieldType>(shape.n2, omega_n2);
+
+                    /* the columns, local (n2 / P) x n1, then the rows, local (n1 / P) x n2 */
+                    if (!inverse) {
+                        if (g != nullptr) {
+                            distributed_scale_columns<FieldType>(a, shape, nullptr, g, value_type::one(), pool);
+                        }
+                        distributed_local_ffts<FieldType>(a, shape.n1, twiddles, pool);
+                        distributed_scale_columns<FieldType>(a, shape, &omega, nullptr, value_type::one(), pool);
+                        distributed_exchange(a, shape.n2 / shape.ranks, shape.n1, comm, pool);
+                        distributed_local_ffts<FieldType>(a, shape.n2, twiddles, pool);
+                    } else {
+                        const value_type scale = value_type(n).inversed();
+                        distributed_local_ffts<FieldType>(a, shape.n2, twiddles, pool);
+                        distributed_exchange(a, shape.n1 / shape.ranks, shape.n2, comm, pool);
+                        distributed_scale_columns<FieldType>(a, shape, &omega, nullptr, value_type::one(), pool);
+                        distributed_local_ffts<FieldType>(a, shape.n1, twiddles, pool);
+                        if (g != nullptr) {
+                            const value_type g_inverse = g->inversed();
+                            distributed_scale_columns<FieldType>(a, shape, nullptr, &g_inverse, scale, pool);
+                        } else {
+                            distributed_scale_columns<FieldType>(a, shape, nullptr, nullptr, scale, pool);
+                        }
+                    }
+                }
+            }    // namespace detail
+
+            /**
+             * Same as basic_radix2_domain<FieldType>(n).fft over the ranks of comm, from the coefficients of a in
+             * the column order to the values in the row order, each rank passing its n / P elements.
+             */
+            template<typename FieldType>
+            void distributed_fft(std::vector<typename FieldType::value_type> &a, std::size_t n, MPI_Comm comm,
+                                 thread_pool *pool = nullptr) {
+                detail::distributed_transform<FieldType>(a, n, false, nullptr, comm, pool);
+            }
+
+            /**
+             * Same as basic_radix2_domain<FieldType>(n).inverse_fft over the ranks of comm, from the values of a
+             * in the row order to the coefficients in the column order.
+             */
+            template<typename FieldType>
+            void distributed_inverse_fft(std::vector<typename FieldType::value_type> &a, std::size_t n,
+                                         MPI_Comm comm, thread_pool *pool = nullptr) {
+                detail::distributed_transform<FieldType>(a, n, true, nullptr, comm, pool);
+            }
+
+            /**
+             * distributed_fft of the values on the coset g * S, with the coefficients a_j * g^j applied in the
+             * first pass over the local columns.
+             */
+            template<typename FieldType>
+            void distributed_coset_fft(std::vector<typename FieldType::value_type> &a, std::size_t n,
+                                       const typename FieldType::value_type &g, MPI_Comm comm,
+                                       thread_pool *pool = nullptr) {
+                detail::distributed_transform<FieldType>(a, n, false, &g, comm, pool);
+            }
+
+            template<typename FieldType>
+            void distributed_coset_inverse_fft(std::vector<typename FieldType::value_type> &a, std::size_t n,
+                                               const typename FieldType::value_type &g, MPI_Comm comm,
+                                               thread_pool *pool = nullptr) {
+                detail::distributed_transform<FieldType>(a, n, true, &g, comm, pool);
+            }
+
+            /**
+             * The low-degree extension by 2^k of the values a on S, in the row order, to the coset g * S' of the
+             * size 2^k n, as polynomial_dfs::extend makes it: one distributed_inverse_fft and 2^k
+             * distributed_coset_fft of the size n, whose values, on the cosets g * w^t * S, w = unity_root(2^k n),
+             * are the t-th of the result, each in the row order. So the layout of the coefficients is that of the
+             * size n, and no more elements than those are exchanged for each coset.
+             */
+            template<typename FieldType>
+            std::vector<std::vector<typename FieldType::value_type>>
+                distributed_extend(std::vector<typename FieldType::value_type> a, std::size_t n, std::size_t k,
+                                   const typename FieldType::value_type &g, MPI_Comm comm,
+                                   thread_pool *pool = nullptr) {
+                typedef typename FieldType::value_type value_type;
+
+                distributed_inverse_fft<FieldType>(a, n, comm, pool);
+
+                const std::size_t blowup = 1ul << k;
+                const value_type w = unity_root<FieldType>(blowup * n);
+
+                std::vector<std::vector<value_type>> result(blowup, a);
+                value_type shift = g;
+                for (std::size_t t = 0; t < blowup; ++t) {
+                    distributed_coset_fft<FieldType>(result[t], n, shift, comm, pool);
+                    shift *= w;
+                }
+                return result;
+            }
+
+            /**
+             * Transpose the rows x cols matrix distributed over the ranks of comm by blocks of rows, rows / P of
+             * them on each rank, into the cols x rows one distributed the same way, in one MPI_Alltoall. With
+             * n1 x n2 of distributed_fft, the natural order of the coefficients becomes the column order, and the
+             * row order of the values the natural one, through distributed_transpose(a, n1, n2); the natural
+             * order of the values becomes the row order, and the column order of the coefficients the natural
+             * one, through distributed_transpose(a, n2, n1).
+             */
+            template<typename ValueType>
+            void distributed_transpose(std::vector<ValueType> &a, std::size_t rows, std::size_t cols, MPI_Comm comm,
+                                       thread_pool *pool = nullptr) {
+                int size;
+                MPI_Comm_size(comm, &size);
+                const std::size_t ranks = static_cast<std::size_t>(size);
+                if (rows % ranks != 0 || cols % ranks != 0 || a.size() != rows / ranks * cols) {
+                    throw std::invalid_argument("distributed_transpose: expected rows / ranks rows of cols elements");
+                }
+                detail::distributed_exchange(a, rows / ranks, cols, comm, pool);
+            }
+
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_ALGORITHMS_DISTRIBUTED_FFT_HPP
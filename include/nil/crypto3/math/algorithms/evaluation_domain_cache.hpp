@@ -0,0 +1,189 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_EVALUATION_DOMAIN_CACHE_HPP
+#define CRYPTO3_MATH_EVALUATION_DOMAIN_CACHE_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * A thread-safe registry of the evaluation domains of a field, keyed by the kind of the domain and the
+             * requested size. Domains are built and precomputed once, on the first request, and then shared by all
+             * of the callers, which should treat them as immutable: a shared domain must not be given another pool
+             * with set_thread_pool.
+             *
+             * Domains take thread_pool::global() at the moment they are built, so clear the cache after installing
+             * another global pool to have it picked up.
+             */
+            template<typename FieldType>
+            class evaluation_domain_cache {
+                typedef std::pair<std::type_index, std::size_t> key_type;
+
+            public:
+                typedef FieldType field_type;
+                typedef std::shared_ptr<evaluation_domain<FieldType>> domain_type;
+
+                evaluation_domain_cache() = default;
+
+                evaluation_domain_cache(const evaluation_domain_cache &) = delete;
+                evaluation_domain_cache &operator=(const evaluation_domain_cache &) = delete;
+
+                /**
+                 * The cache of the field used by the polynomial containers and calculate_domain_set.
+                 */
+                static evaluation_domain_cache &instance() {
+                    static evaluation_domain_cache cache;
+                    return cache;
+                }
+
+                /**
+                 * The domain make_evaluation_domain<FieldType>(m) chooses for the size m, or an empty pointer if there
+                 * is none.
+                 */
+                domain_type get(std::size_t m) {
+                    return lookup(typeid(evaluation_domain<FieldType>), m,
+                                  [m]() { return make_evaluation_domain<FieldType>(m); });
+                }
+
+                /**
+                 * The domain get(m) returns, built to share the twiddles of parent if both are basic_radix2_domain,
+                 * see basic_radix2_domain::precompute: the domains of a domain set then hold one table between
+                 * them. A domain of the size m which is in the cache already is returned as it is.
+                 */
+                domain_type get(std::size_t m, const domain_type &parent) {
+                    return lookup(typeid(evaluation_domain<FieldType>), m, [m, &parent]() {
+                        domain_type domain = make_evaluation_domain<FieldType>(m);
+                        basic_radix2_domain<FieldType> *radix2 =
+                            dynamic_cast<basic_radix2_domain<FieldType> *>(domain.get());
+                        basic_radix2_domain<FieldType> *parent_radix2 =
+                            dynamic_cast<basic_radix2_domain<FieldType> *>(parent.get());
+                        if (radix2 != nullptr && parent_radix2 != nullptr && parent_radix2->m >= radix2->m) {
+                            radix2->precompute(*parent_radix2);
+                        }
+                        return domain;
+                    });
+                }
+
+                /**
+                 * The domain of the type DomainType and the size m. Throws the exceptions of the constructor of
+                 * DomainType if there is no such domain.
+                 */
+                template<typename DomainType>
+                std::shared_ptr<DomainType> get(std::size_t m) {
+                    return std::static_pointer_cast<DomainType>(
+                        lookup(typeid(DomainType), m, [m]() { return domain_type(new DomainType(m)); }));
+                }
+
+                /**
+                 * Build and precompute the domains for the given sizes ahead of time, so that the first transforms do
+                 * not pay for them.
+                 */
+                void warm_up(const std::vector<std::size_t> &sizes) {
+                    for (std::size_t m : sizes) {
+                        get(m);
+                    }
+                }
+
+                /**
+                 * Drop the domains of the size m of all kinds. Callers still holding them keep them alive.
+                 */
+                void evict(std::size_t m) {
+                    std::lock_guard<std::mutex> lock(entries_mutex);
+                    for (auto it = entries.begin(); it != entries.end();) {
+                        it = it->first.second == m ? entries.erase(it) : std::next(it);
+                    }
+                }
+
+                /**
+                 * Drop all of the domains.
+                 */
+                void clear() {
+                    std::lock_guard<std::mutex> lock(entries_mutex);
+                    entries.clear();
+                }
+
+                /**
+                 * Number of the cached domains, including those being built at the moment.
+                 */
+                std::size_t size() const {
+                    std::lock_guard<std::mutex> lock(entries_mutex);
+                    return entries.size();
+                }
+
+            private:
+                struct entry {
+                    std::mutex mutex;
+                    bool built = false;
+                    domain_type domain;
+                };
+
+                /*
+                 * The map is locked only to find the entry, and the domain is built under the lock of the entry, so
+                 * that building a large domain does not hold up the requests for the others. A constructor that
+                 * throws leaves the entry unbuilt, and the next request tries again.
+                 */
+                template<typename Make>
+                domain_type lookup(std::type_index kind, std::size_t m, Make make) {
+                    std::shared_ptr<entry> e;
+                    {
+                        std::lock_guard<std::mutex> lock(entries_mutex);
+                        std::shared_ptr<entry> &slot = entries[key_type(kind, m)];
+                        if (!slot) {
+                            slot = std::make_shared<entry>();
+                        }
+                        e = slot;
+                    }
+
+                    std::lock_guard<std::mutex> lock(e->mutex);
+                    if (!e->built) {
+                        e->domain = make();
+                        if (e->domain) {
+                            e->domain->precompute();
+                        }
+                        e->built = true;
+                    }
+                    return e->domain;
+                }
+
+                std::map<key_type, std::shared_ptr<entry>> entries;
+                mutable std::mutex entries_mutex;
+            };
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_EVALUATION_DOMAIN_CACHE_HPP
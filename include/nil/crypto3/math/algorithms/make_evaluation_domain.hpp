@@ -49,6 +49,8 @@ namespace nil {
             */
             template<typename FieldType>
             std::shared_ptr<evaluation_domain<FieldType>> make_evaluation_domain(std::size_t m) {
+                CRYPTO3_MATH_INSTRUMENT("make_evaluation_domain", m, 0);
+
                 typedef std::shared_ptr<evaluation_domain<FieldType>> result_type;
 
                 const std::size_t big = 1ul << (std::size_t(std::ceil(std::log2(m))) - 1);
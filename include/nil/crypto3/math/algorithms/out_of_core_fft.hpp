@@ -0,0 +1,329 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_ALGORITHMS_OUT_OF_CORE_FFT_HPP
+#define CRYPTO3_MATH_ALGORITHMS_OUT_OF_CORE_FFT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define CRYPTO3_MATH_OUT_OF_CORE_FFT_PREAD
+#endif
+
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/detail/field_utils.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+#include <nil/crypto3/math/span.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /*
+             * The stores out_of_core_fft reads from and writes to hold a vector of field elements out of the memory
+             * of the process, or anywhere the caller chooses, and expose it through
+             *
+             *     void read(std::size_t index, value_type *dst, std::size_t count);
+             *     void write(std::size_t index, const value_type *src, std::size_t count);
+             *
+             * which move count consecutive elements starting at the element index. Reads and writes of disjoint
+             * ranges may come from two threads at once.
+             */
+
+            /**
+             * A store over memory, e.g. a polynomial_dfs or a mapped_column of a mapped_archive.
+             */
+            template<typename FieldValueType>
+            class memory_store {
+            public:
+                typedef FieldValueType value_type;
+
+                explicit memory_store(span<value_type> data) : data(data) {
+                }
+
+                void read(std::size_t index, value_type *dst, std::size_t count) {
+                    std::copy(data.begin() + index, data.begin() + index + count, dst);
+                }
+
+                void write(std::size_t index, const value_type *src, std::size_t count) {
+                    std::copy(src, src + count, data.begin() + index);
+                }
+
+            private:
+                span<value_type> data;
+            };
+
+            /**
+             * A store over a file, holding the elements as they are held in memory from the byte offset on, as the
+             * records written by serialize do after mapped_archive::payload_offset bytes. The file is created if
+             * it does not exist, and grows as the elements are written.
+             */
+            template<typename FieldValueType>
+            class file_store {
+            public:
+                typedef FieldValueType value_type;
+
+                explicit file_store(const std::string &path, std::size_t offset = 0) : offset(offset) {
+#ifdef CRYPTO3_MATH_OUT_OF_CORE_FFT_PREAD
+                    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+                    if (fd < 0) {
+                        throw std::runtime_error("file_store: cannot open " + path);
+                    }
+#else
+                    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+                    if (!file) {
+                        file.clear();
+                        file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+                    }
+                    if (!file) {
+                        throw std::runtime_error("file_store: cannot open " + path);
+                    }
+#endif
+                }
+
+                file_store(const file_store &) = delete;
+                file_store &operator=(const file_store &) = delete;
+
+                ~file_store() {
+#ifdef CRYPTO3_MATH_OUT_OF_CORE_FFT_PREAD
+                    ::close(fd);
+#endif
+                }
+
+                void read(std::size_t index, value_type *dst, std::size_t count) {
+                    transfer(index, reinterpret_cast<char *>(dst), count, false);
+                }
+
+                void write(std::size_t index, const value_type *src, std::size_t count) {
+                    transfer(index, const_cast<char *>(reinterpret_cast<const char *>(src)), count, true);
+                }
+
+            private:
+                void transfer(std::size_t index, char *bytes, std::size_t count, bool writing) {
+                    std::size_t position = offset + index * sizeof(value_type);
+                    std::size_t left = count * sizeof(value_type);
+#ifdef CRYPTO3_MATH_OUT_OF_CORE_FFT_PREAD
+                    while (left > 0) {
+                        const ssize_t done = writing ? ::pwrite(fd, bytes, left, static_cast<off_t>(position)) :
+                                                       ::pread(fd, bytes, left, static_cast<off_t>(position));
+                        if (done <= 0) {
+                            throw std::runtime_error(writing ? "file_store: write failed" : "file_store: read failed");
+                        }
+                        bytes += done;
+                        position += static_cast<std::size_t>(done);
+                        left -= static_cast<std::size_t>(done);
+                    }
+#else
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (writing) {
+                        file.seekp(static_cast<std::streamoff>(position));
+                        file.write(bytes, static_cast<std::streamsize>(left));
+                    } else {
+                        file.seekg(static_cast<std::streamoff>(position));
+                        file.read(bytes, static_cast<std::streamsize>(left));
+                    }
+                    if (!file) {
+                        throw std::runtime_error(writing ? "file_store: write failed" : "file_store: read failed");
+                    }
+#endif
+                }
+
+                std::size_t offset;
+#ifdef CRYPTO3_MATH_OUT_OF_CORE_FFT_PREAD
+                int fd;
+#else
+                std::fstream file;
+                std::mutex mutex;
+#endif
+            };
+
+            namespace detail {
+
+                /**
+                 * Default memory budget of out_of_core_fft: 256 MB.
+                 */
+                constexpr std::size_t out_of_core_fft_memory_budget = 1ul << 28;
+
+                /*
+                 * Read or write a panel of columns of the rows x cols row-major matrix stored from the element 0,
+                 * the columns [first, first + width), as rows consecutive runs of width elements.
+                 */
+                template<typename Store, typename ValueType>
+                void out_of_core_fft_read_panel(Store &store, ValueType *panel, std::size_t rows, std::size_t cols,
+                                                std::size_t first, std::size_t width) {
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        store.read(i * cols + first, panel + i * width, width);
+                    }
+                }
+
+                template<typename Store, typename ValueType>
+                void out_of_core_fft_write_panel(Store &store, const ValueType *panel, std::size_t rows,
+                                                 std::size_t cols, std::size_t first, std::size_t width) {
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        store.write(i * cols + first, panel + i * width, width);
+                    }
+                }
+            }    // namespace detail
+
+            /**
+             * Radix-2 FFT, or its inverse, of the n elements of the source into the sink, keeping at most about
+             * memory_budget bytes of them in memory, for vectors which do not fit there.
+             *
+             * It is the four-step FFT of basic_radix2_four_step_fft [Bailey 1990, FFTs in External or Hierarchical
+             * Memory] in two passes over the n1 x n2 matrix, n1 <= n2. The first pass reads panels of the columns
+             * of the source, as runs of the width of the panel, makes the FFTs of size n1 of the columns, scales
+             * them by the twiddles omega^{j2 * k1} and writes them to the sink as contiguous rows of the
+             * transposed n2 x n1 matrix. The second pass makes the FFTs of size n2 of the columns of the sink in
+             * place, panel by panel again, which leaves the output in the natural order. The next panel is read
+             * asynchronously while the current one is transformed, and the FFTs of a panel run on the pool.
+             *
+             * The sink should not overlap the source, which is only read. The output is the same as
+             * basic_radix2_domain<FieldType>(n).fft or inverse_fft gives.
+             */
+            template<typename FieldType, typename Source, typename Sink>
+            void out_of_core_fft(Source &source, Sink &sink, const std::size_t n, bool inverse = false,
+                                 std::size_t memory_budget = detail::out_of_core_fft_memory_budget,
+                                 thread_pool *pool = thread_pool::global().get()) {
+                typedef typename FieldType::value_type value_type;
+
+                const std::size_t logn = static_cast<std::size_t>(std::log2(n));
+                if (n < 2 || n != (1ul << logn)) {
+                    throw std::invalid_argument("out_of_core_fft: expected n == (1 << logn) > 1");
+                }
+
+                const std::size_t n1 = 1ul << (logn / 2), n2 = n / n1;
+                const value_type omega = inverse ? unity_root<FieldType>(n).inversed() : unity_root<FieldType>(n);
+
+                /* the table of n2 contains the one of n1 */
+                value_type omega_n2 = omega;
+                for (std::size_t i = 0; i < logn - static_cast<std::size_t>(std::log2(n2)); ++i) {
+                    omega_n2 = omega_n2.squared();
+                }
+                const std::vector<value_type> twiddles = detail::basic_radix2_fft_twiddles<FieldType>(n2, omega_n2);
+                const value_type scale = value_type(n).inversed();
+
+                /* two panels being read and transformed, and the scratch of the transposes */
+                std::size_t width = 1;
+                while (2 * width <= n1 && 3 * 2 * width * n2 * sizeof(value_type) <= memory_budget) {
+                    width *= 2;
+                }
+                std::vector<value_type> current(width * n2), next(width * n2), scratch(width * n2);
+
+                const auto ffts = [&](value_type *rows, std::size_t count, std::size_t length) {
+                    detail::parallel_for(
+                        pool, 0, count,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t r = begin; r < end; ++r) {
+                                detail::basic_radix4_fft_cached<FieldType>(rows + r * length, length,
+                                                                          twiddles.data());
+                            }
+                        },
+                        1);
+                };
+
+                /* the panel [0, width) is read ahead, then each iteration reads the next one while it works */
+                const auto pipeline = [&](std::size_t columns, auto read, auto transform) {
+                    read(current.data(), 0);
+                    for (std::size_t first = 0; first < columns; first += width) {
+                        std::future<void> prefetch;
+                        if (first + width < columns) {
+                            prefetch = std::async(std::launch::async, read, next.data(), first + width);
+                        }
+                        transform(first);
+                        if (prefetch.valid()) {
+                            prefetch.get();
+                        }
+                        current.swap(next);
+                    }
+                };
+
+                /* columns j2 of the source, the n1 x n2 matrix, into rows j2 of the sink, the n2 x n1 matrix */
+                pipeline(
+                    n2,
+                    [&](value_type *panel, std::size_t first) {
+                        detail::out_of_core_fft_read_panel(source, panel, n1, n2, first, width);
+                    },
+                    [&](std::size_t first) {
+                        detail::basic_radix2_transpose<FieldType>(current.data(), scratch.data(), n1, width, nullptr,
+                                                                  pool);
+                        ffts(scratch.data(), width, n1);
+
+                        detail::parallel_for(
+                            pool, 0, width,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t c = begin; c < end; ++c) {
+                                    const value_type w = omega.pow(first + c);
+                                    value_type w_k1 = value_type::one();
+                                    for (std::size_t k1 = 0; k1 < n1; ++k1) {
+                                        scratch[c * n1 + k1] *= w_k1;
+                                        w_k1 *= w;
+                                    }
+                                }
+                            },
+                            1);
+                        sink.write(first * n1, scratch.data(), width * n1);
+                    });
+
+                /* columns k1 of the sink, the n2 x n1 matrix, in place; X[k1 + n1 * k2] is the element (k2, k1) */
+                pipeline(
+                    n1,
+                    [&](value_type *panel, std::size_t first) {
+                        detail::out_of_core_fft_read_panel(sink, panel, n2, n1, first, width);
+                    },
+                    [&](std::size_t first) {
+                        detail::basic_radix2_transpose<FieldType>(current.data(), scratch.data(), n2, width, nullptr,
+                                                                  pool);
+                        ffts(scratch.data(), width, n2);
+                        if (inverse) {
+                            detail::parallel_for(
+                                pool, 0, width * n2,
+                                [&](std::size_t begin, std::size_t end) {
+                                    for (std::size_t i = begin; i < end; ++i) {
+                                        scratch[i] *= scale;
+                                    }
+                                },
+                                detail::basic_radix2_fft_grain_size);
+                        }
+                        detail::basic_radix2_transpose<FieldType>(scratch.data(), current.data(), width, n2, nullptr,
+                                                                  pool);
+                        detail::out_of_core_fft_write_panel(sink, current.data(), n2, n1, first, width);
+                    });
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_ALGORITHMS_OUT_OF_CORE_FFT_HPP
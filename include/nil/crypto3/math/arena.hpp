@@ -0,0 +1,228 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_ARENA_HPP
+#define CRYPTO3_MATH_ARENA_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * A bump allocator: memory is taken from large blocks by moving a pointer, deallocation does nothing, and
+             * reset() makes all of the blocks available again at once. Meant for the scratch memory of a prover
+             * round, which is reset between the rounds.
+             *
+             * Nothing allocated from the arena may be used after reset() or the destruction of the arena.
+             */
+            class arena {
+            public:
+                /**
+                 * A scope during which default constructed arena_allocator objects of the calling thread allocate
+                 * from the given arena. Scopes nest.
+                 */
+                class scope {
+                public:
+                    explicit scope(arena &a) : previous(current()) {
+                        current() = &a;
+                    }
+
+                    scope(const scope &) = delete;
+                    scope &operator=(const scope &) = delete;
+
+                    ~scope() {
+                        current() = previous;
+                    }
+
+                private:
+                    arena *previous;
+                };
+
+                explicit arena(std::size_t block_size = 1ul << 20) : block_size(block_size), block(0), offset(0) {
+                }
+
+                arena(const arena &) = delete;
+                arena &operator=(const arena &) = delete;
+
+                ~arena() {
+                    release();
+                }
+
+                /**
+                 * Allocate bytes aligned by alignment, which should be a power of two.
+                 */
+                void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    for (; block < blocks.size(); ++block, offset = 0) {
+                        void *p = take(blocks[block], bytes, alignment);
+                        if (p != nullptr) {
+                            return p;
+                        }
+                    }
+
+                    const std::size_t size = std::max(block_size, bytes + alignment);
+                    blocks.push_back({static_cast<char *>(::operator new(size)), size});
+                    offset = 0;
+                    return take(blocks[block], bytes, alignment);
+                }
+
+                /**
+                 * Make all of the memory available again, keeping the blocks for the next round.
+                 */
+                void reset() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    block = 0;
+                    offset = 0;
+                }
+
+                /**
+                 * Free all of the blocks.
+                 */
+                void release() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for (const block_type &b : blocks) {
+                        ::operator delete(b.data);
+                    }
+                    blocks.clear();
+                    block = 0;
+                    offset = 0;
+                }
+
+                /**
+                 * Total size of the blocks owned by the arena.
+                 */
+                std::size_t capacity() const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    std::size_t result = 0;
+                    for (const block_type &b : blocks) {
+                        result += b.size;
+                    }
+                    return result;
+                }
+
+                /**
+                 * The arena of the innermost scope of the calling thread, or nullptr.
+                 */
+                static arena *&current() {
+                    static thread_local arena *instance = nullptr;
+                    return instance;
+                }
+
+            private:
+                struct block_type {
+                    char *data;
+                    std::size_t size;
+                };
+
+                void *take(const block_type &b, std::size_t bytes, std::size_t alignment) {
+                    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(b.data) + offset;
+                    const std::size_t padding = (alignment - address % alignment) % alignment;
+                    if (offset + padding + bytes > b.size) {
+                        return nullptr;
+                    }
+                    offset += padding + bytes;
+                    return b.data + (offset - bytes);
+                }
+
+                std::size_t block_size;
+                std::vector<block_type> blocks;
+                std::size_t block;
+                std::size_t offset;
+                mutable std::mutex mutex;
+            };
+
+            /**
+             * An allocator taking memory from an arena. A default constructed one takes the arena of the current
+             * arena::scope of the calling thread, and falls back to std::allocator if there is none, so that the
+             * temporaries the library makes of a container with this allocator go to the same arena as the
+             * container itself.
+             */
+            template<typename T>
+            class arena_allocator {
+            public:
+                typedef T value_type;
+                typedef std::true_type propagate_on_container_move_assignment;
+                typedef std::true_type propagate_on_container_swap;
+
+                arena_allocator() noexcept : source(arena::current()) {
+                }
+
+                explicit arena_allocator(arena &a) noexcept : source(&a) {
+                }
+
+                template<typename U>
+                arena_allocator(const arena_allocator<U> &other) noexcept : source(other.resource()) {
+                }
+
+                T *allocate(std::size_t n) {
+                    if (source == nullptr) {
+                        return std::allocator<T>().allocate(n);
+                    }
+                    return static_cast<T *>(source->allocate(n * sizeof(T), alignof(T)));
+                }
+
+                void deallocate(T *p, std::size_t n) noexcept {
+                    if (source == nullptr) {
+                        std::allocator<T>().deallocate(p, n);
+                    }
+                }
+
+                arena *resource() const noexcept {
+                    return source;
+                }
+
+            private:
+                arena *source;
+            };
+
+            template<typename T, typename U>
+            bool operator==(const arena_allocator<T> &a, const arena_allocator<U> &b) noexcept {
+                return a.resource() == b.resource();
+            }
+
+            template<typename T, typename U>
+            bool operator!=(const arena_allocator<T> &a, const arena_allocator<U> &b) noexcept {
+                return !(a == b);
+            }
+
+            namespace detail {
+                /* scratch memory of the transforms, taken from the arena of the current scope if there is one */
+                template<typename T>
+                using scratch_vector = std::vector<T, arena_allocator<T>>;
+            }    // namespace detail
+        }        // namespace math
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_ARENA_HPP
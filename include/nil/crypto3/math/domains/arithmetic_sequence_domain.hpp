@@ -26,8 +26,11 @@
 #ifndef CRYPTO3_MATH_ARITHMETIC_SEQUENCE_DOMAIN_HPP
 #define CRYPTO3_MATH_ARITHMETIC_SEQUENCE_DOMAIN_HPP
 
+#include <algorithm>
+#include <mutex>
 #include <vector>
 
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
 #include <nil/crypto3/math/polynomial/basis_change.hpp>
@@ -47,15 +50,28 @@ namespace nil {
 
             public:
                 typedef FieldType field_type;
+                typedef typename evaluation_domain<FieldType>::workspace_type workspace_type;
+
+                using evaluation_domain<FieldType>::fft;
+                using evaluation_domain<FieldType>::inverse_fft;
+                using evaluation_domain<FieldType>::add_poly_z;
+                using evaluation_domain<FieldType>::divide_by_z_on_coset;
 
                 bool precomputation_sentinel;
-                std::vector<std::vector<std::vector<value_type>>> subproduct_tree;
+                std::once_flag precomputation_flag;
+                flat_subproduct_tree<FieldType> subproduct_tree;
                 std::vector<value_type> arithmetic_sequence;
                 value_type arithmetic_generator;
 
-                void do_precomputation() {
-                    compute_subproduct_tree<FieldType>(this->subproduct_tree, log2(this->m));
+                /*
+                 * the parts of the conversions between the Newton and the evaluation forms that depend on the domain
+                 * only: i! * arithmetic_generator (1 for i = 0), its inverses, and the inverses times (-1)^i
+                 */
+                std::vector<value_type> newton_scale;
+                std::vector<value_type> newton_scale_inverse;
+                std::vector<value_type> inverse_fft_kernel;
 
+                void do_precomputation() {
                     arithmetic_generator = value_type(fields::arithmetic_params<FieldType>::arithmetic_generator);
 
                     arithmetic_sequence = std::vector<value_type>(this->m);
@@ -63,9 +79,37 @@ namespace nil {
                         arithmetic_sequence[i] = arithmetic_generator * value_type(i);
                     }
 
+                    /* the tree is over the power of two of the points from the first m of them on, and the Newton
+                       coefficients of a polynomial of a degree below m over them are zero from m on */
+                    std::vector<value_type> points(detail::power_of_two(this->m));
+                    for (std::size_t i = 0; i < points.size(); i++) {
+                        points[i] = arithmetic_generator * value_type(i);
+                    }
+                    compute_subproduct_tree<FieldType>(subproduct_tree, points, this->get_thread_pool());
+
+                    newton_scale = std::vector<value_type>(this->m);
+                    newton_scale[0] = value_type::one();
+                    value_type factorial = value_type::one();
+                    for (std::size_t i = 1; i < this->m; i++) {
+                        factorial *= value_type(i);
+                        newton_scale[i] = factorial * arithmetic_generator;
+                    }
+
+                    newton_scale_inverse = newton_scale;
+                    batch_inverse(newton_scale_inverse, this->get_thread_pool());
+
+                    inverse_fft_kernel = newton_scale_inverse;
+                    for (std::size_t i = 1; i < this->m; i += 2) {
+                        inverse_fft_kernel[i] = -inverse_fft_kernel[i];
+                    }
+
                     precomputation_sentinel = true;
                 }
 
+                void precompute() {
+                    std::call_once(precomputation_flag, [this]() { do_precomputation(); });
+                }
+
                 arithmetic_sequence_domain(const std::size_t m) : evaluation_domain<FieldType>(m) {
                     if (m <= 1) {
                         throw std::invalid_argument("arithmetic(): expected m > 1");
@@ -81,6 +125,14 @@ namespace nil {
                 }
 
                 void fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    fft(a, workspace);
+                }
+
+                void fft(std::vector<value_type> &a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("arithmetic_sequence_domain::fft", this->m,
+                                                   a.capacity() * sizeof(value_type) + workspace.bytes());
+
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -89,32 +141,32 @@ namespace nil {
                         }
                     }
 
-                    if (!this->precomputation_sentinel) {
-                        do_precomputation();
-                    }
+                    precompute();
 
                     /* Monomial to Newton */
-                    monomial_to_newton_basis<FieldType>(a, subproduct_tree, this->m);
+                    typename workspace_type::buffer_type &b = workspace.buffer(3, subproduct_tree.size());
+                    std::fill(std::copy(a.begin(), a.end(), b.begin()), b.end(), value_type::zero());
+                    monomial_to_newton_basis<FieldType>(b, subproduct_tree, this->get_thread_pool());
+                    std::copy(b.begin(), b.begin() + this->m, a.begin());
 
                     /* Newton to Evaluation */
-                    std::vector<value_type> S(this->m); /* i! * arithmetic_generator */
-                    S[0] = value_type::one();
-
-                    value_type factorial = value_type::one();
-                    for (std::size_t i = 1; i < this->m; i++) {
-                        factorial *= value_type(i);
-                        S[i] = (factorial * arithmetic_generator).inversed();
-                    }
-
-                    multiplication(a, a, S);
-                    a.resize(this->m);
+                    typename workspace_type::buffer_type &c = workspace.buffer(0, 0);
+                    multiplication(c, a, newton_scale_inverse, workspace.buffer(1, 0), workspace.buffer(2, 0));
 
                     for (std::size_t i = 0; i < this->m; i++) {
-                        a[i] *= S[i].inversed();
+                        a[i] = (i < c.size() ? c[i] : value_type::zero()) * newton_scale[i];
                     }
                 }
 
                 void inverse_fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    inverse_fft(a, workspace);
+                }
+
+                void inverse_fft(std::vector<value_type> &a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("arithmetic_sequence_domain::inverse_fft", this->m,
+                                                   a.capacity() * sizeof(value_type) + workspace.bytes());
+
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -123,30 +175,30 @@ namespace nil {
                         }
                     }
 
-                    if (!this->precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     /* Interpolation to Newton */
-                    std::vector<value_type> S(this->m); /* i! * arithmetic_generator */
-                    S[0] = value_type::one();
+                    typename workspace_type::buffer_type &W = workspace.buffer(0, this->m);
+                    for (std::size_t i = 0; i < this->m; i++) {
+                        W[i] = a[i] * newton_scale_inverse[i];
+                    }
 
-                    std::vector<value_type> W(this->m);
-                    W[0] = a[0] * S[0];
+                    typename workspace_type::buffer_type &c = workspace.buffer(1, 0);
+                    multiplication(c, W, inverse_fft_kernel, workspace.buffer(2, 0), workspace.buffer(3, 0));
 
-                    value_type factorial = value_type::one();
-                    for (std::size_t i = 1; i < this->m; i++) {
-                        factorial *= value_type(i);
-                        S[i] = (factorial * arithmetic_generator).inversed();
-                        W[i] = a[i] * S[i];
-                        if (i % 2 == 1)
-                            S[i] = -S[i];
+                    for (std::size_t i = 0; i < this->m; i++) {
+                        a[i] = i < c.size() ? c[i] : value_type::zero();
                     }
 
-                    multiplication(a, W, S);
-                    a.resize(this->m);
-
                     /* Newton to Monomial */
-                    newton_to_monomial_basis<FieldType>(a, subproduct_tree, this->m);
+                    typename workspace_type::buffer_type &b = workspace.buffer(0, subproduct_tree.size());
+                    std::fill(std::copy(a.begin(), a.end(), b.begin()), b.end(), value_type::zero());
+                    newton_to_monomial_basis<FieldType>(b, subproduct_tree, this->get_thread_pool());
+                    std::copy(b.begin(), b.begin() + this->m, a.begin());
+                }
+
+                std::size_t workspace_size() const {
+                    return 4 * detail::power_of_two(2 * this->m - 1);
                 }
 
                 std::vector<value_type> evaluate_all_lagrange_polynomials(const value_type &t) {
@@ -154,8 +206,7 @@ namespace nil {
                     /* Evaluate for x = t */
                     /* Return coeffs for each l_j(x) = (l / l_i[j]) * w[j] */
 
-                    if (!precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     /**
                      * If t equals one of the arithmetic progression values,
@@ -186,27 +237,29 @@ namespace nil {
                         g_vanish *= -this->arithmetic_sequence[i];
                     }
 
+                    std::vector<value_type> sequence_inverse(this->arithmetic_sequence);
+                    batch_inverse(sequence_inverse, this->get_thread_pool());
+                    batch_inverse(l, this->get_thread_pool());
+
                     std::vector<value_type> w(this->m);
                     w[0] = g_vanish.inversed() * (this->arithmetic_generator.pow(this->m - 1));
 
-                    l[0] = l_vanish * l[0].inversed() * w[0];
+                    l[0] = l_vanish * l[0] * w[0];
                     for (std::size_t i = 1; i < this->m; i++) {
                         value_type num = this->arithmetic_sequence[i - 1] - this->arithmetic_sequence[this->m - 1];
-                        w[i] = w[i - 1] * num * this->arithmetic_sequence[i].inversed();
-                        l[i] = l_vanish * l[i].inversed() * w[i];
+                        w[i] = w[i - 1] * num * sequence_inverse[i];
+                        l[i] = l_vanish * l[i] * w[i];
                     }
 
                     return l;
                 }
                 value_type get_domain_element(const std::size_t idx) {
-                    if (!this->precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     return this->arithmetic_sequence[idx];
                 }
                 value_type compute_vanishing_polynomial(const value_type &t) {
-                    if (!this->precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     /* Notes: Z = prod_{i = 0 to m} (t - a[i]) */
                     value_type Z = value_type::one();
@@ -216,11 +269,14 @@ namespace nil {
                     return Z;
                 }
                 void add_poly_z(const value_type &coeff, std::vector<value_type> &H) {
+                    add_poly_z(coeff, span<value_type>(H));
+                }
+
+                void add_poly_z(const value_type &coeff, span<value_type> H) {
                     if (H.size() != this->m + 1)
                         throw std::invalid_argument("arithmetic: expected H.size() == this->m+1");
 
-                    if (!this->precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     std::vector<value_type> x(2, value_type::zero());
                     x[0] = -this->arithmetic_sequence[0];
@@ -240,6 +296,10 @@ namespace nil {
                     }
                 }
                 void divide_by_z_on_coset(std::vector<value_type> &P) {
+                    divide_by_z_on_coset(span<value_type>(P));
+                }
+
+                void divide_by_z_on_coset(span<value_type> P) {
                     const value_type coset = this->arithmetic_generator; /* coset in arithmetic sequence? */
                     const value_type Z_inverse_at_coset = this->compute_vanishing_polynomial(coset).inversed();
                     for (std::size_t i = 0; i < this->m; ++i) {
@@ -26,12 +26,17 @@
 #ifndef CRYPTO3_MATH_BASIC_RADIX2_DOMAIN_HPP
 #define CRYPTO3_MATH_BASIC_RADIX2_DOMAIN_HPP
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <nil/crypto3/math/detail/field_utils.hpp>
 
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_simd_fft.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_word_fft.hpp>
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
 
 namespace nil {
@@ -49,9 +54,98 @@ namespace nil {
 
             public:
                 typedef FieldType field_type;
+                typedef typename evaluation_domain<FieldType>::workspace_type workspace_type;
+
+                using evaluation_domain<FieldType>::fft;
+                using evaluation_domain<FieldType>::inverse_fft;
+                using evaluation_domain<FieldType>::add_poly_z;
+                using evaluation_domain<FieldType>::divide_by_z_on_coset;
 
                 value_type omega;
 
+                bool precomputation_sentinel;
+                std::once_flag precomputation_flag;
+
+                /*
+                 * the twiddles of the domain are the first m - 1 entries of the tables, which may be those of a
+                 * larger domain, see precompute(basic_radix2_domain &)
+                 */
+                std::shared_ptr<const std::vector<value_type>> fft_twiddles;
+                std::shared_ptr<const std::vector<value_type>> inverse_fft_twiddles;
+                span<const value_type> fft_cache;
+                span<const value_type> inverse_fft_cache;
+
+                /*
+                 * the twiddles in the Montgomery form and the layout of basic_radix2_simd_fft, if it is compiled in,
+                 * or basic_radix2_lazy_fft otherwise, when basic_radix2_lazy_reduction holds for the field; shared
+                 * with the parent as the tables above, as the kernels read the first m - 1 entries of a larger
+                 * table, and the SIMD one takes the stride of its limbs from the size of the table
+                 */
+                std::shared_ptr<const std::vector<std::uint64_t>> lazy_fft_cache;
+                std::shared_ptr<const std::vector<std::uint64_t>> lazy_inverse_fft_cache;
+
+                /* the twiddles in the Montgomery form of basic_radix2_word_fft, when basic_radix2_word_reduction
+                   holds for the field, shared with the parent in the same way */
+                std::shared_ptr<const std::vector<typename detail::basic_radix2_word<FieldType>::type>> word_fft_cache;
+                std::shared_ptr<const std::vector<typename detail::basic_radix2_word<FieldType>::type>>
+                    word_inverse_fft_cache;
+
+                /*
+                 * powers of the shift of the last coset_fft, and 1/m times the inverse powers for coset_inverse_fft;
+                 * held by pointer so that a domain shared by several threads can swap them under coset_cache_mutex
+                 * while other transforms still read the previous ones
+                 */
+                value_type coset_fft_shift;
+                std::shared_ptr<const std::vector<value_type>> coset_fft_cache;
+                value_type coset_inverse_fft_shift;
+                std::shared_ptr<const std::vector<value_type>> coset_inverse_fft_cache;
+
+                void do_precomputation() {
+                    CRYPTO3_MATH_INSTRUMENT("basic_radix2_domain::precompute", this->m,
+                                            2 * (this->m - 1) * sizeof(value_type));
+
+                    share_twiddles(std::make_shared<const std::vector<value_type>>(
+                                       detail::basic_radix2_fft_twiddles<FieldType>(this->m, omega)),
+                                   std::make_shared<const std::vector<value_type>>(
+                                       detail::basic_radix2_fft_twiddles<FieldType>(this->m, omega.inversed())));
+                }
+
+                void precompute() {
+                    std::call_once(precomputation_flag, [this]() { do_precomputation(); });
+                }
+
+                /**
+                 * Precompute the domain with the twiddles of fft_cache and inverse_fft_cache computed earlier, e.g.
+                 * read back with mapped_archive, instead of computing them. Does nothing if the domain is
+                 * precomputed already.
+                 */
+                void precompute(std::vector<value_type> fft_table, std::vector<value_type> inverse_fft_table) {
+                    if (fft_table.size() != this->m - 1 || inverse_fft_table.size() != this->m - 1)
+                        throw std::invalid_argument("basic_radix2: expected m - 1 twiddles");
+
+                    std::call_once(precomputation_flag, [&]() {
+                        share_twiddles(std::make_shared<const std::vector<value_type>>(std::move(fft_table)),
+                                       std::make_shared<const std::vector<value_type>>(std::move(inverse_fft_table)));
+                    });
+                }
+
+                /**
+                 * Precompute the domain with the twiddles of a domain of a size at least m, which it shares
+                 * instead of computing its own: omega_m = omega_n^(n / m), so the table of the domain of the size
+                 * m is the first m - 1 entries of that of any larger domain. The tables of the lazy and the word
+                 * kernels are shared the same way. Precomputes the parent if it is not yet. Does nothing if the
+                 * domain is precomputed already.
+                 */
+                void precompute(basic_radix2_domain &parent) {
+                    if (parent.m < this->m)
+                        throw std::invalid_argument("basic_radix2: expected a parent domain of a size at least m");
+
+                    parent.precompute();
+                    std::call_once(precomputation_flag, [&]() {
+                        share_twiddles(parent.fft_twiddles, parent.inverse_fft_twiddles, &parent);
+                    });
+                }
+
                 basic_radix2_domain(const std::size_t m) : evaluation_domain<FieldType>(m) {
                     if (m <= 1)
                         throw std::invalid_argument("basic_radix2(): expected m > 1");
@@ -64,9 +158,19 @@ namespace nil {
                     }
 
                     omega = unity_root<FieldType>(m);
+
+                    precomputation_sentinel = false;
                 }
 
                 void fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    fft(a, workspace);
+                }
+
+                void fft(std::vector<value_type> &a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("basic_radix2_domain::fft", this->m,
+                                                   a.capacity() * sizeof(value_type) + workspace.bytes());
+
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -75,10 +179,27 @@ namespace nil {
                         }
                     }
 
-                    detail::basic_radix2_fft<FieldType>(a, omega);
+                    transform(a, false, workspace);
+                }
+
+                void fft(span<value_type> a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("basic_radix2_domain::fft", this->m, workspace.bytes());
+
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("basic_radix2: expected a.size() == this->m");
+
+                    transform(a, false, workspace);
                 }
 
                 void inverse_fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    inverse_fft(a, workspace);
+                }
+
+                void inverse_fft(std::vector<value_type> &a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("basic_radix2_domain::inverse_fft", this->m,
+                                                   a.capacity() * sizeof(value_type) + workspace.bytes());
+
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -87,12 +208,145 @@ namespace nil {
                         }
                     }
 
-                    detail::basic_radix2_fft<FieldType>(a, omega.inversed());
+                    transform(a, true, workspace);
+                }
+
+                void inverse_fft(span<value_type> a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("basic_radix2_domain::inverse_fft", this->m, workspace.bytes());
+
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("basic_radix2: expected a.size() == this->m");
+
+                    transform(a, true, workspace);
+                }
+
+                /**
+                 * The transforms of fft and inverse_fft with one side in the bit-reversed order, which skip the
+                 * bit-reversal pass: the decimation-in-frequency kernel goes from the natural order to the
+                 * bit-reversed one and the decimation-in-time kernel back. So the values of fft_to_bitreversed
+                 * return to the coefficients in the natural order through inverse_fft_from_bitreversed, with any
+                 * pointwise operations in between, without a permutation.
+                 */
+                void fft_to_bitreversed(span<value_type> a) {
+                    transform_bitreversed(a, false, true);
+                }
+
+                void fft_from_bitreversed(span<value_type> a) {
+                    transform_bitreversed(a, false, false);
+                }
 
-                    const value_type sconst = value_type(a.size()).inversed();
-                    for (std::size_t i = 0; i < a.size(); ++i) {
-                        a[i] *= sconst;
+                void inverse_fft_to_bitreversed(span<value_type> a) {
+                    transform_bitreversed(a, true, true);
+                }
+
+                void inverse_fft_from_bitreversed(span<value_type> a) {
+                    transform_bitreversed(a, true, false);
+                }
+
+                void coset_fft(std::vector<value_type> &a, const value_type &g) {
+                    workspace_type workspace;
+                    coset_fft(a, g, workspace);
+                }
+
+                void coset_fft(std::vector<value_type> &a, const value_type &g, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("basic_radix2_domain::coset_fft", this->m,
+                                                   a.capacity() * sizeof(value_type) + workspace.bytes());
+
+                    if (a.size() != this->m) {
+                        if (a.size() < this->m) {
+                            a.resize(this->m, value_type(0));
+                        } else {
+                            throw std::invalid_argument("basic_radix2: expected a.size() == this->m");
+                        }
+                    }
+
+                    precompute();
+
+                    const std::shared_ptr<const std::vector<value_type>> powers =
+                        coset_powers(coset_fft_cache, coset_fft_shift, g, false);
+
+                    if (word_coset_fft(a, *powers, false, workspace,
+                                       detail::basic_radix2_word_reduction<FieldType>())) {
+                        return;
+                    }
+
+                    /* a_i * g^i is fused into the bit-reversal */
+                    if (this->m >= detail::basic_radix2_four_step_fft_threshold) {
+                        detail::basic_radix2_four_step_fft<FieldType>(a.data(), this->m, fft_cache.data(),
+                                                                      this->get_thread_pool(), powers->data());
+                    } else {
+                        detail::basic_radix4_fft_cached<FieldType>(a.begin(), this->m, fft_cache.data(),
+                                                                   this->get_thread_pool(), powers->data());
+                    }
+                }
+
+                void coset_inverse_fft(std::vector<value_type> &a, const value_type &g) {
+                    workspace_type workspace;
+                    coset_inverse_fft(a, g, workspace);
+                }
+
+                void coset_inverse_fft(std::vector<value_type> &a, const value_type &g, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("basic_radix2_domain::coset_inverse_fft", this->m,
+                                                   a.capacity() * sizeof(value_type) + workspace.bytes());
+
+                    if (a.size() != this->m) {
+                        if (a.size() < this->m) {
+                            a.resize(this->m, value_type(0));
+                        } else {
+                            throw std::invalid_argument("basic_radix2: expected a.size() == this->m");
+                        }
+                    }
+
+                    precompute();
+
+                    const std::shared_ptr<const std::vector<value_type>> powers =
+                        coset_powers(coset_inverse_fft_cache, coset_inverse_fft_shift, g, true);
+
+                    if (word_coset_fft(a, *powers, true, workspace,
+                                       detail::basic_radix2_word_reduction<FieldType>())) {
+                        return;
+                    }
+
+                    /* a_i * g^{-i} / m is fused into the last stage of butterflies */
+                    if (this->m >= detail::basic_radix2_four_step_fft_threshold) {
+                        detail::basic_radix2_four_step_fft<FieldType>(a.data(), this->m, inverse_fft_cache.data(),
+                                                                      this->get_thread_pool(), nullptr,
+                                                                      powers->data());
+                    } else {
+                        detail::basic_radix4_fft_cached<FieldType>(a.begin(), this->m, inverse_fft_cache.data(),
+                                                                   this->get_thread_pool(), nullptr,
+                                                                   powers->data());
+                    }
+                }
+
+                void fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    batch(columns, false);
+                }
+
+                void fft_batch(std::vector<value_type> &data) {
+                    batch(data, false);
+                }
+
+                void inverse_fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    batch(columns, true);
+                }
+
+                void inverse_fft_batch(std::vector<value_type> &data) {
+                    batch(data, true);
+                }
+
+                /* the word and the lazy kernels keep their four-step buffers in the word buffers instead */
+                std::size_t workspace_size() const {
+                    if (detail::basic_radix2_word_reduction<FieldType>::value ||
+                        detail::basic_radix2_lazy_reduction<FieldType>::value) {
+                        return 0;
                     }
+                    return this->m >= detail::basic_radix2_four_step_fft_threshold ? this->m : 0;
+                }
+
+                std::size_t workspace_words_size() const {
+                    return word_workspace_words_size(detail::basic_radix2_word_reduction<FieldType>()) +
+                           lazy_workspace_words_size(detail::basic_radix2_lazy_reduction<FieldType>());
                 }
 
                 std::vector<value_type> evaluate_all_lagrange_polynomials(const value_type &t) {
@@ -107,7 +361,36 @@ namespace nil {
                     return (t.pow(this->m)) - value_type::one();
                 }
 
+                std::vector<value_type> compute_vanishing_polynomial_on_coset(const value_type &coset,
+                                                                              std::size_t n) override {
+                    std::vector<value_type> result = this->coset_power(coset, n, this->m);
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; ++j) {
+                                result[j] -= value_type::one();
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+                    return result;
+                }
+
+                std::vector<value_type> evaluate_lagrange_polynomial_on_coset(std::size_t i, const value_type &coset,
+                                                                              std::size_t n) override {
+                    if (i >= this->m)
+                        throw std::invalid_argument("basic_radix2: expected i < m");
+
+                    /* Z'(omega^i) = m omega^{-i} */
+                    const value_type x_i = omega.pow(i);
+                    return this->lagrange_on_coset(compute_vanishing_polynomial_on_coset(coset, n), x_i,
+                                                   x_i * value_type(this->m).inversed(), coset, n);
+                }
+
                 void add_poly_z(const value_type &coeff, std::vector<value_type> &H) {
+                    add_poly_z(coeff, span<value_type>(H));
+                }
+
+                void add_poly_z(const value_type &coeff, span<value_type> H) {
                     if (H.size() != this->m + 1)
                         throw std::invalid_argument("basic_radix2: expected H.size() == this->m+1");
 
@@ -116,6 +399,10 @@ namespace nil {
                 }
 
                 void divide_by_z_on_coset(std::vector<value_type> &P) {
+                    divide_by_z_on_coset(span<value_type>(P));
+                }
+
+                void divide_by_z_on_coset(span<value_type> P) {
                     const value_type coset = fields::arithmetic_params<FieldType>::multiplicative_generator;
                     const value_type Z_inverse_at_coset = this->compute_vanishing_polynomial(coset).inversed();
                     for (std::size_t i = 0; i < this->m; ++i) {
@@ -130,6 +417,303 @@ namespace nil {
                 bool operator!=(const basic_radix2_domain &rhs) const {
                     return !(*this == rhs);
                 }
+
+            private:
+                void transform_bitreversed(span<value_type> a, bool inverse, bool to_bitreversed) {
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("basic_radix2: expected a.size() == this->m");
+
+                    precompute();
+
+                    const span<const value_type> twiddles = inverse ? inverse_fft_cache : fft_cache;
+                    const value_type sconst = value_type(this->m).inversed();
+                    if (to_bitreversed) {
+                        detail::basic_radix2_dif_fft_cached<FieldType>(a.begin(), this->m, twiddles.data(),
+                                                                       this->get_thread_pool(),
+                                                                       inverse ? &sconst : nullptr);
+                        return;
+                    }
+
+                    detail::basic_radix2_dit_fft_cached<FieldType>(a.begin(), this->m, twiddles.data(),
+                                                                   this->get_thread_pool());
+                    if (inverse) {
+                        detail::parallel_for(
+                            this->get_thread_pool(), 0, this->m,
+                            [&a, &sconst](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    a[i] *= sconst;
+                                }
+                            },
+                            detail::basic_radix2_fft_grain_size);
+                    }
+                }
+
+                template<typename Range>
+                void transform(Range &a, bool inverse, workspace_type &workspace) {
+                    precompute();
+
+                    const span<const value_type> twiddles = inverse ? inverse_fft_cache : fft_cache;
+
+                    if (word_fft(a, inverse, inverse ? value_type(this->m).inversed() : value_type::one(), workspace,
+                                 detail::basic_radix2_word_reduction<FieldType>())) {
+                        /* as the lazy kernel below, the word kernel has multiplied by 1/m already */
+                        return;
+                    } else if (lazy_fft(a, inverse, workspace, detail::basic_radix2_lazy_reduction<FieldType>())) {
+                        /* the lazy kernel has multiplied by 1/m on the way out of the Montgomery form */
+                        return;
+                    } else if (this->m >= detail::basic_radix2_four_step_fft_threshold) {
+                        detail::basic_radix2_four_step_fft<FieldType>(a.data(), this->m, twiddles.data(),
+                                                                      this->get_thread_pool(), nullptr, nullptr,
+                                                                      workspace.buffer(0, this->m).data());
+                    } else {
+                        detail::basic_radix4_fft_cached<FieldType>(a, twiddles, this->get_thread_pool());
+                    }
+
+                    if (!inverse) {
+                        return;
+                    }
+
+                    const value_type sconst = value_type(this->m).inversed();
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, this->m,
+                        [&a, &sconst](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                a[i] *= sconst;
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                }
+
+                std::shared_ptr<const std::vector<value_type>>
+                    coset_powers(std::shared_ptr<const std::vector<value_type>> &cache, value_type &shift,
+                                 const value_type &g, bool inverse) {
+                    std::lock_guard<std::mutex> lock(coset_cache_mutex);
+                    if (!cache || shift != g) {
+                        CRYPTO3_MATH_INSTRUMENT_ALLOCATION(this->m * sizeof(value_type));
+                        cache = std::make_shared<const std::vector<value_type>>(
+                            inverse ? detail::basic_radix2_coset_powers<FieldType>(this->m, g.inversed(),
+                                                                                   value_type(this->m).inversed(),
+                                                                                   this->get_thread_pool()) :
+                                      detail::basic_radix2_coset_powers<FieldType>(this->m, g, value_type::one(),
+                                                                                   this->get_thread_pool()));
+                        shift = g;
+                    }
+                    return cache;
+                }
+
+                /* the Montgomery tables of the parent, if any, are derived from the tables given with it */
+                void share_twiddles(std::shared_ptr<const std::vector<value_type>> fft_table,
+                                    std::shared_ptr<const std::vector<value_type>> inverse_fft_table,
+                                    const basic_radix2_domain *parent = nullptr) {
+                    fft_twiddles = std::move(fft_table);
+                    inverse_fft_twiddles = std::move(inverse_fft_table);
+                    fft_cache = span<const value_type>(fft_twiddles->data(), this->m - 1);
+                    inverse_fft_cache = span<const value_type>(inverse_fft_twiddles->data(), this->m - 1);
+                    if (parent != nullptr) {
+                        lazy_fft_cache = parent->lazy_fft_cache;
+                        lazy_inverse_fft_cache = parent->lazy_inverse_fft_cache;
+                        word_fft_cache = parent->word_fft_cache;
+                        word_inverse_fft_cache = parent->word_inverse_fft_cache;
+                    } else {
+                        lazy_precomputation(detail::basic_radix2_lazy_reduction<FieldType>());
+                        word_precomputation(detail::basic_radix2_word_reduction<FieldType>());
+                    }
+
+                    precomputation_sentinel = true;
+                }
+
+                void word_precomputation(std::false_type) {
+                }
+
+                template<typename Range>
+                bool word_fft(Range &, bool, const value_type &, workspace_type &, std::false_type) {
+                    return false;
+                }
+
+                template<typename Range>
+                bool word_coset_fft(Range &, const std::vector<value_type> &, bool, workspace_type &, std::false_type) {
+                    return false;
+                }
+
+                std::size_t word_workspace_words_size(std::false_type) const {
+                    return 0;
+                }
+
+                void word_precomputation(std::true_type) {
+                    typedef typename detail::basic_radix2_word<FieldType>::type word_type;
+
+                    word_fft_cache = std::make_shared<const std::vector<word_type>>(
+                        detail::basic_radix2_word_fft_twiddles<FieldType>(fft_cache));
+                    word_inverse_fft_cache = std::make_shared<const std::vector<word_type>>(
+                        detail::basic_radix2_word_fft_twiddles<FieldType>(inverse_fft_cache));
+                }
+
+                std::size_t word_workspace_words_size(std::true_type) const {
+                    typedef typename detail::basic_radix2_word<FieldType>::type word_type;
+
+                    return (detail::basic_radix2_word_fft_buffer_size(this->m) * sizeof(word_type) +
+                            sizeof(std::uint64_t) - 1) /
+                           sizeof(std::uint64_t);
+                }
+
+                template<typename Range>
+                bool word_fft(Range &a, bool inverse, const value_type &scale, workspace_type &workspace,
+                              std::true_type) {
+                    typedef typename detail::basic_radix2_word<FieldType>::type word_type;
+
+                    detail::basic_radix2_word_fft<FieldType>(
+                        a, inverse ? *word_inverse_fft_cache : *word_fft_cache, scale,
+                        workspace.template words<word_type>(0, detail::basic_radix2_word_fft_buffer_size(this->m)),
+                        this->get_thread_pool());
+                    return true;
+                }
+
+                /* the powers of the shift are applied on the way in for coset_fft, and on the way out, with 1/m,
+                   for coset_inverse_fft */
+                template<typename Range>
+                bool word_coset_fft(Range &a, const std::vector<value_type> &powers, bool inverse,
+                                    workspace_type &workspace, std::true_type) {
+                    const auto scale = [this, &a, &powers]() {
+                        detail::parallel_for(
+                            this->get_thread_pool(), 0, this->m,
+                            [&a, &powers](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    a[i] *= powers[i];
+                                }
+                            },
+                            detail::basic_radix2_fft_grain_size);
+                    };
+
+                    if (!inverse) {
+                        scale();
+                    }
+                    word_fft(a, inverse, value_type::one(), workspace, std::true_type());
+                    if (inverse) {
+                        scale();
+                    }
+                    return true;
+                }
+
+                void lazy_precomputation(std::false_type) {
+                }
+
+                template<typename Range>
+                bool lazy_fft(Range &, bool, workspace_type &, std::false_type) {
+                    return false;
+                }
+
+                std::size_t lazy_workspace_words_size(std::false_type) const {
+                    return 0;
+                }
+
+#ifdef BOOST_HAS_INT128
+#ifdef CRYPTO3_MATH_BASIC_RADIX2_SIMD_FFT
+                void lazy_precomputation(std::true_type) {
+                    lazy_fft_cache = std::make_shared<const std::vector<std::uint64_t>>(
+                        detail::basic_radix2_simd_fft_twiddles<FieldType>(fft_cache));
+                    lazy_inverse_fft_cache = std::make_shared<const std::vector<std::uint64_t>>(
+                        detail::basic_radix2_simd_fft_twiddles<FieldType>(inverse_fft_cache));
+                }
+
+                std::size_t lazy_workspace_words_size(std::true_type) const {
+                    return detail::basic_radix2_simd_fft_buffer_size(this->m);
+                }
+
+                template<typename Range>
+                bool lazy_fft(Range &a, bool inverse, workspace_type &workspace, std::true_type) {
+                    detail::basic_radix2_simd_fft<FieldType>(
+                        a, inverse ? *lazy_inverse_fft_cache : *lazy_fft_cache,
+                        inverse ? value_type(this->m).inversed() : value_type::one(),
+                        workspace.template words<std::uint64_t>(0, detail::basic_radix2_simd_fft_buffer_size(this->m)),
+                        this->get_thread_pool());
+                    return true;
+                }
+#else
+                void lazy_precomputation(std::true_type) {
+                    lazy_fft_cache = std::make_shared<const std::vector<std::uint64_t>>(
+                        detail::basic_radix2_lazy_fft_twiddles<FieldType>(fft_cache));
+                    lazy_inverse_fft_cache = std::make_shared<const std::vector<std::uint64_t>>(
+                        detail::basic_radix2_lazy_fft_twiddles<FieldType>(inverse_fft_cache));
+                }
+
+                std::size_t lazy_workspace_words_size(std::true_type) const {
+                    return 4 * detail::basic_radix2_lazy_fft_buffer_size(this->m);
+                }
+
+                template<typename Range>
+                bool lazy_fft(Range &a, bool inverse, workspace_type &workspace, std::true_type) {
+                    typedef typename detail::montgomery_4x64<FieldType>::limbs_type limbs_type;
+
+                    detail::basic_radix2_lazy_fft<FieldType>(
+                        a, inverse ? *lazy_inverse_fft_cache : *lazy_fft_cache,
+                        inverse ? value_type(this->m).inversed() : value_type::one(),
+                        workspace.template words<limbs_type>(0, detail::basic_radix2_lazy_fft_buffer_size(this->m)),
+                        this->get_thread_pool());
+                    return true;
+                }
+#endif
+#endif
+
+                void batch(std::vector<std::vector<value_type>> &columns, bool inverse) {
+                    std::vector<value_type *> pointers;
+                    pointers.reserve(columns.size());
+                    for (std::vector<value_type> &a : columns) {
+                        if (a.size() != this->m) {
+                            if (a.size() < this->m) {
+                                a.resize(this->m, value_type(0));
+                            } else {
+                                throw std::invalid_argument("basic_radix2: expected a.size() == this->m");
+                            }
+                        }
+                        pointers.push_back(a.data());
+                    }
+
+                    batch(pointers, inverse);
+                }
+
+                void batch(std::vector<value_type> &data, bool inverse) {
+                    if (data.size() % this->m != 0)
+                        throw std::invalid_argument("basic_radix2: expected data.size() to be a multiple of this->m");
+
+                    std::vector<value_type *> pointers;
+                    pointers.reserve(data.size() / this->m);
+                    for (std::size_t i = 0; i < data.size(); i += this->m) {
+                        pointers.push_back(data.data() + i);
+                    }
+
+                    batch(pointers, inverse);
+                }
+
+                void batch(const std::vector<value_type *> &columns, bool inverse) {
+                    workspace_type workspace;
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("basic_radix2_domain::fft_batch", columns.size() * this->m,
+                                                   workspace.bytes());
+
+                    precompute();
+
+                    const span<const value_type> twiddles = inverse ? inverse_fft_cache : fft_cache;
+                    const value_type sconst = value_type(this->m).inversed();
+                    thread_pool *pool = this->get_thread_pool();
+
+                    /* the word and lazy kernels take the columns one by one, through the dispatch of fft, as do the
+                       columns past the cache or fewer than the threads, which parallelize inside the columns */
+                    if (detail::basic_radix2_word_reduction<FieldType>::value ||
+                        detail::basic_radix2_lazy_reduction<FieldType>::value ||
+                        this->m >= detail::basic_radix2_four_step_fft_threshold ||
+                        (pool != nullptr && columns.size() < pool->size())) {
+                        for (value_type *a : columns) {
+                            span<value_type> column(a, this->m);
+                            transform(column, inverse, workspace);
+                        }
+                        return;
+                    }
+
+                    detail::basic_radix2_fft_batch_cached<FieldType>(columns.data(), columns.size(), this->m,
+                                                                     twiddles.data(), inverse ? &sconst : nullptr,
+                                                                     pool);
+                }
+
+                std::mutex coset_cache_mutex;
             };
         }    // namespace math
     }        // namespace crypto3
@@ -0,0 +1,173 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MATH_BASIC_RADIX2_CODELETS_HPP
+#define CRYPTO3_MATH_BASIC_RADIX2_CODELETS_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace detail {
+
+                /**
+                 * Largest size of the fixed-size transforms of basic_radix2_codelet.
+                 */
+                constexpr std::size_t basic_radix2_codelet_max_size = 64;
+
+                constexpr std::size_t basic_radix2_codelet_log2(std::size_t n) {
+                    return n <= 1 ? 0 : 1 + basic_radix2_codelet_log2(n / 2);
+                }
+
+                constexpr std::size_t basic_radix2_codelet_bitreverse(std::size_t x, std::size_t logn) {
+                    return logn == 0 ? 0 : ((x & 1) << (logn - 1)) | basic_radix2_codelet_bitreverse(x >> 1, logn - 1);
+                }
+
+                /**
+                 * The transform of the fixed size N, a power of two up to basic_radix2_codelet_max_size, unrolled
+                 * at compile time: the permutation is a fixed sequence of swaps, and every butterfly reads its
+                 * twiddle at a constant offset of the table of basic_radix2_fft_twiddles, of the size at least N,
+                 * the trivial ones w^0 = 1 being left out. The table is the one of the caller rather than constants
+                 * of the codelet, since field elements are not literal types and the inverse transforms run over
+                 * the inverse table. The output is that of basic_radix2_fft_cached, with no scaling.
+                 */
+                template<typename FieldType, std::size_t N>
+                struct basic_radix2_codelet {
+                    typedef typename FieldType::value_type value_type;
+
+                    static_assert(N >= 2 && N <= basic_radix2_codelet_max_size && (N & (N - 1)) == 0,
+                                  "expected a power of two codelet size up to basic_radix2_codelet_max_size");
+
+                    constexpr static const std::size_t logn = basic_radix2_codelet_log2(N);
+
+                    /* the bit-reversal permutation followed by butterflies */
+                    template<typename RandomAccessIterator>
+                    static void apply(RandomAccessIterator a, const value_type *twiddles) {
+                        permute(a, std::make_index_sequence<N>());
+                        butterflies(a, twiddles);
+                    }
+
+                    /* butterflies only, from the bit-reversed order of the input to the natural one of the output:
+                       the first log2(N) stages of any larger transform over each of its blocks of N elements */
+                    template<typename RandomAccessIterator>
+                    static void butterflies(RandomAccessIterator a, const value_type *twiddles) {
+                        stages(a, twiddles, std::integral_constant<std::size_t, 1>());
+                    }
+
+                private:
+                    template<typename RandomAccessIterator, std::size_t... I>
+                    static void permute(RandomAccessIterator a, std::index_sequence<I...>) {
+                        const int expand[] = {
+                            (swap<I, basic_radix2_codelet_bitreverse(I, logn)>(
+                                 a, std::integral_constant<bool, (I < basic_radix2_codelet_bitreverse(I, logn))>()),
+                             0)...};
+                        (void)expand;
+                    }
+
+                    template<std::size_t I, std::size_t R, typename RandomAccessIterator>
+                    static void swap(RandomAccessIterator a, std::true_type) {
+                        std::swap(a[I], a[R]);
+                    }
+
+                    template<std::size_t I, std::size_t R, typename RandomAccessIterator>
+                    static void swap(RandomAccessIterator, std::false_type) {
+                    }
+
+                    template<typename RandomAccessIterator, std::size_t M>
+                    static void stages(RandomAccessIterator a, const value_type *twiddles,
+                                       std::integral_constant<std::size_t, M>) {
+                        stage<M>(a, twiddles + (M - 1), std::make_index_sequence<N / 2>());
+                        stages(a, twiddles, std::integral_constant<std::size_t, 2 * M>());
+                    }
+
+                    template<typename RandomAccessIterator>
+                    static void stages(RandomAccessIterator, const value_type *,
+                                       std::integral_constant<std::size_t, N>) {
+                    }
+
+                    /* butterfly I of the stage with the half-size M is (k + j, k + j + M) for j = I mod M and
+                       k = 2(I - j), the first index is the K of butterfly */
+                    template<std::size_t M, typename RandomAccessIterator, std::size_t... I>
+                    static void stage(RandomAccessIterator a, const value_type *w, std::index_sequence<I...>) {
+                        const int expand[] = {
+                            (butterfly<2 * (I - I % M) + I % M, M, I % M>(a, w,
+                                                                         std::integral_constant<bool, (I % M == 0)>()),
+                             0)...};
+                        (void)expand;
+                    }
+
+                    template<std::size_t K, std::size_t M, std::size_t J, typename RandomAccessIterator>
+                    static void butterfly(RandomAccessIterator a, const value_type *, std::true_type) {
+                        const value_type t = a[K + M];
+                        a[K + M] = a[K] - t;
+                        a[K] += t;
+                    }
+
+                    template<std::size_t K, std::size_t M, std::size_t J, typename RandomAccessIterator>
+                    static void butterfly(RandomAccessIterator a, const value_type *w, std::false_type) {
+                        const value_type t = w[J] * a[K + M];
+                        a[K + M] = a[K] - t;
+                        a[K] += t;
+                    }
+                };
+
+                /**
+                 * The transform of basic_radix2_codelet for the size n, if there is a codelet of that size; returns
+                 * whether there is.
+                 */
+                template<typename FieldType, typename RandomAccessIterator>
+                bool basic_radix2_codelet_fft(RandomAccessIterator a, const std::size_t n,
+                                              const typename FieldType::value_type *twiddles) {
+                    switch (n) {
+                        case 2:
+                            basic_radix2_codelet<FieldType, 2>::apply(a, twiddles);
+                            return true;
+                        case 4:
+                            basic_radix2_codelet<FieldType, 4>::apply(a, twiddles);
+                            return true;
+                        case 8:
+                            basic_radix2_codelet<FieldType, 8>::apply(a, twiddles);
+                            return true;
+                        case 16:
+                            basic_radix2_codelet<FieldType, 16>::apply(a, twiddles);
+                            return true;
+                        case 32:
+                            basic_radix2_codelet<FieldType, 32>::apply(a, twiddles);
+                            return true;
+                        case 64:
+                            basic_radix2_codelet<FieldType, 64>::apply(a, twiddles);
+                            return true;
+                        default:
+                            return false;
+                    }
+                }
+            }    // namespace detail
+        }        // namespace math
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_BASIC_RADIX2_CODELETS_HPP
@@ -31,20 +31,113 @@
 
 #include <nil/crypto3/algebra/type_traits.hpp>
 
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/arena.hpp>
 #include <nil/crypto3/math/detail/field_utils.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_codelets.hpp>
+#include <nil/crypto3/math/span.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace math {
             namespace detail {
 
+                /**
+                 * Number of butterflies below which a stage is not split between the threads.
+                 */
+                constexpr std::size_t basic_radix2_fft_grain_size = 256;
+
+                /**
+                 * Swap a[k] and a[bitreverse(k)] for k in [begin, end). Every pair is swapped by its smaller index
+                 * only, so disjoint ranges can be processed concurrently.
+                 */
+                template<typename Range>
+                void basic_radix2_bitreverse(Range &a, const std::size_t logn, std::size_t begin, std::size_t end) {
+                    /* swapping in place (from Storer's book) */
+                    for (std::size_t k = begin; k < end; ++k) {
+                        const std::size_t rk = bitreverse(k, logn);
+                        if (k < rk)
+                            std::swap(a[k], a[rk]);
+                    }
+                }
+
+                /**
+                 * Same as above, but also multiply the element moved from index i by scale[i], so that the scaling of
+                 * the input, e.g. by the powers of a coset shift, takes no separate pass over the vector.
+                 */
+                template<typename Range, typename ValueType>
+                void basic_radix2_bitreverse(Range &a, const std::size_t logn, std::size_t begin, std::size_t end,
+                                             const ValueType *scale) {
+                    for (std::size_t k = begin; k < end; ++k) {
+                        const std::size_t rk = bitreverse(k, logn);
+                        if (k < rk) {
+                            std::swap(a[k], a[rk]);
+                            a[k] *= scale[rk];
+                            a[rk] *= scale[k];
+                        } else if (k == rk) {
+                            a[k] *= scale[k];
+                        }
+                    }
+                }
+
+                /**
+                 * Compute the twiddle factors table used by basic_radix2_fft_cached for the size n into the n - 1
+                 * elements at twiddles. Entries [m - 1, 2m - 1) of the table hold w_m^0, ..., w_m^{m - 1}, where
+                 * w_m = omega^{n / (2m)} is the 2m-th root of unity of the stage with half-size m. So the table for
+                 * any smaller power of two size is a prefix of this one, and each stage reads its twiddles
+                 * sequentially.
+                 */
+                template<typename FieldType>
+                void basic_radix2_fft_twiddles(const std::size_t n, const typename FieldType::value_type &omega,
+                                               typename FieldType::value_type *twiddles) {
+                    typedef typename FieldType::value_type value_type;
+
+                    if (n <= 1) {
+                        return;
+                    }
+
+                    /* the last stage (m = n / 2) needs all of omega^0, ..., omega^{n/2 - 1} */
+                    const std::size_t half = n / 2;
+                    twiddles[half - 1] = value_type::one();
+                    for (std::size_t j = 1; j < half; ++j) {
+                        twiddles[half - 1 + j] = twiddles[half - 2 + j] * omega;
+                    }
+
+                    /* w_m = w_{2m}^2, so each previous stage takes every other element of the next one */
+                    for (std::size_t m = half / 2; m >= 1; m /= 2) {
+                        for (std::size_t j = 0; j < m; ++j) {
+                            twiddles[m - 1 + j] = twiddles[2 * m - 1 + 2 * j];
+                        }
+                    }
+                }
+
+                /**
+                 * The same table, allocated.
+                 */
+                template<typename FieldType>
+                std::vector<typename FieldType::value_type>
+                    basic_radix2_fft_twiddles(const std::size_t n, const typename FieldType::value_type &omega) {
+                    typedef typename FieldType::value_type value_type;
+
+                    if (n <= 1) {
+                        return std::vector<value_type>();
+                    }
+
+                    std::vector<value_type> twiddles(n - 1);
+                    basic_radix2_fft_twiddles<FieldType>(n, omega, twiddles.data());
+                    return twiddles;
+                }
+
                 /*
                  * Below we make use of pseudocode from [CLRS 2n Ed, pp. 864].
                  * Also, note that it's the caller's responsibility to multiply by 1/N.
+                 * If the pool is given, the bit-reversal and every stage of butterflies are split between its threads.
                  */
                 template<typename FieldType, typename Range>
-                void basic_radix2_fft(Range &a, const typename FieldType::value_type &omega) {
+                void basic_radix2_fft(Range &a, const typename FieldType::value_type &omega,
+                                      thread_pool *pool = nullptr) {
                     typedef typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
                         value_type;
 
@@ -55,31 +148,606 @@ namespace nil {
                     if (n != (1u << logn))
                         throw std::invalid_argument("expected n == (1u << logn)");
 
-                    /* swapping in place (from Storer's book) */
-                    for (std::size_t k = 0; k < n; ++k) {
-                        const std::size_t rk = bitreverse(k, logn);
-                        if (k < rk)
-                            std::swap(a[k], a[rk]);
+                    /* the table of a codelet is small enough for the stack */
+                    if (n > 1 && n <= basic_radix2_codelet_max_size) {
+                        value_type twiddles[basic_radix2_codelet_max_size - 1];
+                        basic_radix2_fft_twiddles<FieldType>(n, omega, twiddles);
+                        basic_radix2_codelet_fft<FieldType>(std::begin(a), n, twiddles);
+                        return;
                     }
 
+                    parallel_for(
+                        pool, 0, n,
+                        [&a, logn](std::size_t begin, std::size_t end) {
+                            basic_radix2_bitreverse(a, logn, begin, end);
+                        },
+                        basic_radix2_fft_grain_size);
+
                     std::size_t m = 1;    // invariant: m = 2^{s-1}
                     for (std::size_t s = 1; s <= logn; ++s) {
                         // w_m is 2^s-th root of unity now
                         const value_type w_m = omega.pow(n / (2 * m));
 
-                        asm volatile("/* pre-inner */");
-                        for (std::size_t k = 0; k < n; k += 2 * m) {
-                            value_type w = value_type::one();
-                            for (std::size_t j = 0; j < m; ++j) {
-                                const value_type t = w * a[k + j + m];
-                                a[k + j + m] = a[k + j] - t;
-                                a[k + j] += t;
-                                w *= w_m;
+                        /* butterfly i of the stage is (k + j, k + j + m), where j = i mod m and k = 2 * (i - j) */
+                        parallel_for(
+                            pool, 0, n / 2,
+                            [&a, &w_m, m](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end;) {
+                                    const std::size_t j0 = i & (m - 1);
+                                    const std::size_t k = 2 * (i - j0);
+                                    const std::size_t j1 = std::min(m, j0 + (end - i));
+
+                                    value_type w = (j0 == 0) ? value_type::one() : w_m.pow(j0);
+                                    for (std::size_t j = j0; j < j1; ++j) {
+                                        const value_type t = w * a[k + j + m];
+                                        a[k + j + m] = a[k + j] - t;
+                                        a[k + j] += t;
+                                        w *= w_m;
+                                    }
+                                    i += j1 - j0;
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+
+                        m *= 2;
+                    }
+                }
+
+                /**
+                 * Compute the table c * g^0, ..., c * g^{n - 1} of the coset shift powers, which
+                 * basic_radix2_fft_cached takes as pre_scale or post_scale.
+                 */
+                template<typename FieldType>
+                std::vector<typename FieldType::value_type>
+                    basic_radix2_coset_powers(const std::size_t n, const typename FieldType::value_type &g,
+                                              const typename FieldType::value_type &c, thread_pool *pool = nullptr) {
+                    typedef typename FieldType::value_type value_type;
+
+                    std::vector<value_type> powers(n);
+                    parallel_for(
+                        pool, 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            value_type u = c * g.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                powers[i] = u;
+                                u *= g;
+                            }
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    return powers;
+                }
+
+                /*
+                 * Decimation-in-time butterflies of basic_radix2_fft_cached, from the input in the bit-reversed
+                 * order to the output in the natural order, so without the bit-reversal pass. If post_scale is
+                 * given, the output element i is multiplied by post_scale[i] within the last stage, which is where
+                 * the 1/n of an inverse transform goes.
+                 */
+                template<typename FieldType, typename RandomAccessIterator>
+                void basic_radix2_dit_fft_cached(RandomAccessIterator a, const std::size_t n,
+                                                 const typename FieldType::value_type *twiddles,
+                                                 thread_pool *pool = nullptr,
+                                                 const typename FieldType::value_type *post_scale = nullptr) {
+                    typedef typename FieldType::value_type value_type;
+
+                    if (n == 1) {
+                        if (post_scale != nullptr)
+                            a[0] *= post_scale[0];
+                        return;
+                    }
+
+                    /* the first stage has only trivial twiddles */
+                    const value_type *first_scale = n == 2 ? post_scale : nullptr;
+                    parallel_for(
+                        pool, 0, n / 2,
+                        [&a, first_scale](std::size_t begin, std::size_t end) {
+                            for (std::size_t k = 2 * begin; k < 2 * end; k += 2) {
+                                const value_type t = a[k + 1];
+                                a[k + 1] = a[k] - t;
+                                a[k] += t;
+                                if (first_scale != nullptr) {
+                                    a[k] *= first_scale[k];
+                                    a[k + 1] *= first_scale[k + 1];
+                                }
+                            }
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    for (std::size_t m = 2; m < n; m *= 2) {
+                        const value_type *w = twiddles + (m - 1);
+                        const value_type *scale = 2 * m == n ? post_scale : nullptr;
+
+                        /* butterfly i of the stage is (k + j, k + j + m), where j = i mod m and k = 2 * (i - j) */
+                        parallel_for(
+                            pool, 0, n / 2,
+                            [&a, w, m, scale](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end;) {
+                                    const std::size_t j0 = i & (m - 1);
+                                    const std::size_t k = 2 * (i - j0);
+                                    const std::size_t j1 = std::min(m, j0 + (end - i));
+
+                                    for (std::size_t j = j0; j < j1; ++j) {
+                                        const value_type t = w[j] * a[k + j + m];
+                                        a[k + j + m] = a[k + j] - t;
+                                        a[k + j] += t;
+                                        if (scale != nullptr) {
+                                            a[k + j] *= scale[k + j];
+                                            a[k + j + m] *= scale[k + j + m];
+                                        }
+                                    }
+                                    i += j1 - j0;
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                    }
+                }
+
+                /*
+                 * Decimation-in-frequency FFT [Gentleman & Sande 1966, Fast Fourier Transforms: for fun and profit]
+                 * with the table of basic_radix2_fft_twiddles of the size at least n: the transform of
+                 * basic_radix2_fft_cached from the input in the natural order to the output in the bit-reversed
+                 * order, so without the bit-reversal pass. Stages go from the half-size n / 2 down to 1, each
+                 * butterfly (u, v) becoming (u + v, (u - v) * w). If scale is given, every output element is
+                 * multiplied by *scale within the last stage, e.g. by 1/n for the inverse transform.
+                 */
+                template<typename FieldType, typename RandomAccessIterator>
+                void basic_radix2_dif_fft_cached(RandomAccessIterator a, const std::size_t n,
+                                                 const typename FieldType::value_type *twiddles,
+                                                 thread_pool *pool = nullptr,
+                                                 const typename FieldType::value_type *scale = nullptr) {
+                    typedef typename FieldType::value_type value_type;
+
+                    if (n == 1) {
+                        if (scale != nullptr)
+                            a[0] *= *scale;
+                        return;
+                    }
+
+                    for (std::size_t m = n / 2; m >= 2; m /= 2) {
+                        const value_type *w = twiddles + (m - 1);
+
+                        parallel_for(
+                            pool, 0, n / 2,
+                            [&a, w, m](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end;) {
+                                    const std::size_t j0 = i & (m - 1);
+                                    const std::size_t k = 2 * (i - j0);
+                                    const std::size_t j1 = std::min(m, j0 + (end - i));
+
+                                    for (std::size_t j = j0; j < j1; ++j) {
+                                        const value_type t = a[k + j] - a[k + j + m];
+                                        a[k + j] += a[k + j + m];
+                                        a[k + j + m] = t * w[j];
+                                    }
+                                    i += j1 - j0;
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                    }
+
+                    /* the last stage has only trivial twiddles */
+                    parallel_for(
+                        pool, 0, n / 2,
+                        [&a, scale](std::size_t begin, std::size_t end) {
+                            for (std::size_t k = 2 * begin; k < 2 * end; k += 2) {
+                                const value_type t = a[k] - a[k + 1];
+                                a[k] += a[k + 1];
+                                a[k + 1] = t;
+                                if (scale != nullptr) {
+                                    a[k] *= *scale;
+                                    a[k + 1] *= *scale;
+                                }
+                            }
+                        },
+                        basic_radix2_fft_grain_size);
+                }
+
+                /*
+                 * Same as basic_radix2_fft, but with the stage roots of unity read from the table computed by
+                 * basic_radix2_fft_twiddles of the size at least n, over the n elements starting at a.
+                 * If pre_scale is given, the input element i is multiplied by pre_scale[i] within the bit-reversal,
+                 * and if post_scale is given, the output element i is multiplied by post_scale[i] within the last
+                 * stage of butterflies. Without them the inverse transform leaves the 1/n to the caller.
+                 */
+                template<typename FieldType, typename RandomAccessIterator>
+                void basic_radix2_fft_cached(RandomAccessIterator a, const std::size_t n,
+                                             const typename FieldType::value_type *twiddles,
+                                             thread_pool *pool = nullptr,
+                                             const typename FieldType::value_type *pre_scale = nullptr,
+                                             const typename FieldType::value_type *post_scale = nullptr) {
+                    const std::size_t logn = log2(n);
+
+                    if (n == 1) {
+                        if (pre_scale != nullptr)
+                            a[0] *= pre_scale[0];
+                        if (post_scale != nullptr)
+                            a[0] *= post_scale[0];
+                        return;
+                    }
+
+                    parallel_for(
+                        pool, 0, n,
+                        [&a, logn, pre_scale](std::size_t begin, std::size_t end) {
+                            if (pre_scale == nullptr) {
+                                basic_radix2_bitreverse(a, logn, begin, end);
+                            } else {
+                                basic_radix2_bitreverse(a, logn, begin, end, pre_scale);
+                            }
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    basic_radix2_dit_fft_cached<FieldType>(a, n, twiddles, pool, post_scale);
+                }
+
+                /*
+                 * Same as basic_radix2_fft, but with the stage roots of unity read from the table computed by
+                 * basic_radix2_fft_twiddles of the size at least a.size().
+                 */
+                template<typename FieldType, typename Range>
+                void basic_radix2_fft_cached(Range &a, const std::vector<typename FieldType::value_type> &twiddles,
+                                             thread_pool *pool = nullptr) {
+                    typedef typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
+                        value_type;
+
+                    BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
+                    BOOST_STATIC_ASSERT(std::is_same<typename FieldType::value_type, value_type>::value);
+
+                    const std::size_t n = a.size(), logn = log2(n);
+                    if (n != (1u << logn))
+                        throw std::invalid_argument("expected n == (1u << logn)");
+                    if (twiddles.size() + 1 < n)
+                        throw std::invalid_argument("expected twiddles.size() + 1 >= n");
+
+                    basic_radix2_fft_cached<FieldType>(std::begin(a), n, twiddles.data(), pool);
+                }
+
+                /*
+                 * Same as basic_radix2_fft_cached, but with each pair of the stages m and 2m merged into one pass
+                 * of radix-4 butterflies over a[k + j], a[k + j + m], a[k + j + 2m] and a[k + j + 3m], so the
+                 * vector is read log2(n) / 2 times instead of log2(n). The radix-2 butterflies inside and the
+                 * twiddles are the same, including w_{4m}^{j + m} of the second stage, which a field has no
+                 * cheaper way to multiply by. So is the output. The sizes up to basic_radix2_codelet_max_size run as
+                 * a codelet, and the first stages of the larger ones as the butterflies of a codelet over each block
+                 * of 32 or 64 elements, which leaves an even number of stages to the radix-4 passes.
+                 */
+                template<typename FieldType, typename RandomAccessIterator>
+                void basic_radix4_fft_cached(RandomAccessIterator a, const std::size_t n,
+                                             const typename FieldType::value_type *twiddles,
+                                             thread_pool *pool = nullptr,
+                                             const typename FieldType::value_type *pre_scale = nullptr,
+                                             const typename FieldType::value_type *post_scale = nullptr) {
+                    typedef typename FieldType::value_type value_type;
+
+                    const std::size_t logn = log2(n);
+
+                    if (n < 2) {
+                        basic_radix2_fft_cached<FieldType>(a, n, twiddles, pool, pre_scale, post_scale);
+                        return;
+                    }
+
+                    if (n <= basic_radix2_codelet_max_size) {
+                        if (pre_scale != nullptr) {
+                            for (std::size_t i = 0; i < n; ++i) {
+                                a[i] *= pre_scale[i];
                             }
                         }
-                        asm volatile("/* post-inner */");
-                        m *= 2;
+                        basic_radix2_codelet_fft<FieldType>(a, n, twiddles);
+                        if (post_scale != nullptr) {
+                            for (std::size_t i = 0; i < n; ++i) {
+                                a[i] *= post_scale[i];
+                            }
+                        }
+                        return;
+                    }
+
+                    parallel_for(
+                        pool, 0, n,
+                        [&a, logn, pre_scale](std::size_t begin, std::size_t end) {
+                            if (pre_scale == nullptr) {
+                                basic_radix2_bitreverse(a, logn, begin, end);
+                            } else {
+                                basic_radix2_bitreverse(a, logn, begin, end, pre_scale);
+                            }
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    /* the block of the codelet leaves an even number of stages */
+                    constexpr std::size_t max_block = basic_radix2_codelet_max_size;
+                    const std::size_t block =
+                        (logn - basic_radix2_codelet_log2(max_block)) % 2 == 0 ? max_block : max_block / 2;
+                    parallel_for(
+                        pool, 0, n / block,
+                        [&a, twiddles, block](std::size_t begin, std::size_t end) {
+                            for (std::size_t b = begin; b < end; ++b) {
+                                if (block == max_block) {
+                                    basic_radix2_codelet<FieldType, max_block>::butterflies(a + b * block, twiddles);
+                                } else {
+                                    basic_radix2_codelet<FieldType, max_block / 2>::butterflies(a + b * block,
+                                                                                                twiddles);
+                                }
+                            }
+                        },
+                        std::max<std::size_t>(1, basic_radix2_fft_grain_size / block));
+
+                    for (std::size_t m = block; 2 * m < n; m *= 4) {
+                        const value_type *w1 = twiddles + (m - 1);
+                        const value_type *w2 = twiddles + (2 * m - 1);
+                        const value_type *scale = 4 * m == n ? post_scale : nullptr;
+
+                        /* radix-4 butterfly i of the pass starts at k + j, where j = i mod m and k = 4 * (i - j) */
+                        parallel_for(
+                            pool, 0, n / 4,
+                            [&a, w1, w2, m, scale](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end;) {
+                                    const std::size_t j0 = i & (m - 1);
+                                    const std::size_t k = 4 * (i - j0);
+                                    const std::size_t j1 = std::min(m, j0 + (end - i));
+
+                                    for (std::size_t j = j0; j < j1; ++j) {
+                                        const std::size_t i0 = k + j, i1 = i0 + m, i2 = i1 + m, i3 = i2 + m;
+
+                                        /* stage m */
+                                        value_type x1 = w1[j] * a[i1], x3 = w1[j] * a[i3];
+                                        const value_type x0 = a[i0] + x1;
+                                        x1 = a[i0] - x1;
+                                        const value_type x2 = a[i2] + x3;
+                                        x3 = a[i2] - x3;
+
+                                        /* stage 2m */
+                                        const value_type t2 = w2[j] * x2;
+                                        const value_type t3 = w2[j + m] * x3;
+                                        a[i0] = x0 + t2;
+                                        a[i2] = x0 - t2;
+                                        a[i1] = x1 + t3;
+                                        a[i3] = x1 - t3;
+                                    }
+
+                                    if (scale != nullptr) {
+                                        for (std::size_t j = j0; j < j1; ++j) {
+                                            for (std::size_t l = k + j; l < k + 4 * m; l += m) {
+                                                a[l] *= scale[l];
+                                            }
+                                        }
+                                    }
+                                    i += j1 - j0;
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                    }
+                }
+
+                template<typename FieldType, typename Range>
+                void basic_radix4_fft_cached(Range &a, span<const typename FieldType::value_type> twiddles,
+                                             thread_pool *pool = nullptr) {
+                    typedef typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
+                        value_type;
+
+                    BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
+                    BOOST_STATIC_ASSERT(std::is_same<typename FieldType::value_type, value_type>::value);
+
+                    const std::size_t n = a.size(), logn = log2(n);
+                    if (n != (1u << logn))
+                        throw std::invalid_argument("expected n == (1u << logn)");
+                    if (twiddles.size() + 1 < n)
+                        throw std::invalid_argument("expected twiddles.size() + 1 >= n");
+
+                    basic_radix4_fft_cached<FieldType>(std::begin(a), n, twiddles.data(), pool);
+                }
+
+                /**
+                 * Number of columns basic_radix2_fft_batch_cached runs the butterflies over at once.
+                 */
+                constexpr std::size_t basic_radix2_fft_batch_interleave = 4;
+
+                /*
+                 * Same as basic_radix2_fft_cached, applied to each of the count columns of size n. Each twiddle is
+                 * loaded once for a group of basic_radix2_fft_batch_interleave columns whose independent butterflies
+                 * are interleaved, and the groups are split between the threads of the pool.
+                 * If scale is given, every element gets multiplied by *scale after the transform, e.g. by 1/n for
+                 * the inverse transforms.
+                 */
+                template<typename FieldType>
+                void basic_radix2_fft_batch_cached(typename FieldType::value_type *const *columns,
+                                                   const std::size_t count, const std::size_t n,
+                                                   const typename FieldType::value_type *twiddles,
+                                                   const typename FieldType::value_type *scale = nullptr,
+                                                   thread_pool *pool = nullptr) {
+                    typedef typename FieldType::value_type value_type;
+
+                    const std::size_t logn = log2(n);
+                    const std::size_t group = basic_radix2_fft_batch_interleave;
+
+                    parallel_for(
+                        pool, 0, (count + group - 1) / group,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t g = begin * group; g < std::min(count, end * group); g += group) {
+                                value_type *const *cols = columns + g;
+                                const std::size_t cols_count = std::min(group, count - g);
+
+                                for (std::size_t c = 0; c < cols_count; ++c) {
+                                    basic_radix2_bitreverse(cols[c], logn, 0, n);
+                                }
+
+                                for (std::size_t m = 1; m < n; m *= 2) {
+                                    const value_type *w = twiddles + (m - 1);
+                                    for (std::size_t k = 0; k < n; k += 2 * m) {
+                                        for (std::size_t j = 0; j < m; ++j) {
+                                            for (std::size_t c = 0; c < cols_count; ++c) {
+                                                const value_type t = w[j] * cols[c][k + j + m];
+                                                cols[c][k + j + m] = cols[c][k + j] - t;
+                                                cols[c][k + j] += t;
+                                            }
+                                        }
+                                    }
+                                }
+
+                                if (scale != nullptr) {
+                                    for (std::size_t c = 0; c < cols_count; ++c) {
+                                        for (std::size_t i = 0; i < n; ++i) {
+                                            cols[c][i] *= *scale;
+                                        }
+                                    }
+                                }
+                            }
+                        },
+                        1);
+                }
+
+                /**
+                 * Size of the tiles basic_radix2_transpose moves at once: a pair of 16x16 tiles of 32-byte elements
+                 * fits into L1.
+                 */
+                constexpr std::size_t basic_radix2_transpose_tile_size = 16;
+
+                /**
+                 * Call f(i, j) for the elements (i, j) of the rows x cols matrix tile by tile, so that f may read the
+                 * element of a row-major matrix and write it to its transpose with both sides in the cache. The
+                 * tiles of the rows are split between the threads of the pool.
+                 */
+                template<typename Function>
+                void basic_radix2_transpose_tiles(const std::size_t rows, const std::size_t cols, thread_pool *pool,
+                                                  const Function &f) {
+                    const std::size_t tile = basic_radix2_transpose_tile_size;
+
+                    parallel_for(
+                        pool, 0, (rows + tile - 1) / tile,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t ii = begin * tile; ii < std::min(rows, end * tile); ii += tile) {
+                                for (std::size_t jj = 0; jj < cols; jj += tile) {
+                                    for (std::size_t i = ii; i < std::min(rows, ii + tile); ++i) {
+                                        for (std::size_t j = jj; j < std::min(cols, jj + tile); ++j) {
+                                            f(i, j);
+                                        }
+                                    }
+                                }
+                            }
+                        },
+                        1);
+                }
+
+                /**
+                 * Write the transpose of the rows x cols row-major matrix src into dst, optionally multiplying
+                 * element (i, j) of src by omega^{i * j}, taken from the last stage of the twiddles table of the size
+                 * rows * cols. Optionally, src[e] is also multiplied by src_scale[e] and dst[e] by dst_scale[e].
+                 */
+                template<typename FieldType>
+                void basic_radix2_transpose(const typename FieldType::value_type *src,
+                                            typename FieldType::value_type *dst, const std::size_t rows,
+                                            const std::size_t cols, const typename FieldType::value_type *twiddles,
+                                            thread_pool *pool,
+                                            const typename FieldType::value_type *src_scale = nullptr,
+                                            const typename FieldType::value_type *dst_scale = nullptr) {
+                    typedef typename FieldType::value_type value_type;
+
+                    const std::size_t half = rows * cols / 2;
+                    const value_type *omega_powers = twiddles == nullptr ? nullptr : twiddles + (half - 1);
+
+                    basic_radix2_transpose_tiles(rows, cols, pool, [&](std::size_t i, std::size_t j) {
+                        if (omega_powers == nullptr && src_scale == nullptr && dst_scale == nullptr) {
+                            dst[j * rows + i] = src[i * cols + j];
+                            return;
+                        }
+
+                        value_type v = src[i * cols + j];
+                        if (src_scale != nullptr) {
+                            v *= src_scale[i * cols + j];
+                        }
+                        if (omega_powers != nullptr) {
+                            /* omega^{n/2 + e} = -omega^e */
+                            const std::size_t e = i * j;
+                            v = e < half ? v * omega_powers[e] : -(v * omega_powers[e - half]);
+                        }
+                        if (dst_scale != nullptr) {
+                            v *= dst_scale[j * rows + i];
+                        }
+                        dst[j * rows + i] = v;
+                    });
+                }
+
+                /**
+                 * Minimal size from which basic_radix2_domain switches to basic_radix2_four_step_fft: 2^18 elements
+                 * of 32 bytes are 8 MB, which is past the L2 and most of the L3 caches.
+                 */
+                constexpr std::size_t basic_radix2_four_step_fft_threshold = 1ul << 18;
+
+                /*
+                 * Four-step FFT [Bailey 1990, FFTs in External or Hierarchical Memory]. The vector of size
+                 * n = n1 * n2 is treated as the n1 x n2 matrix, so the transform becomes n2 FFTs of size n1,
+                 * multiplication by the twiddles omega^{j2 * k1} and n1 FFTs of size n2, each of them running on
+                 * a contiguous row that fits into the cache. The output is in the same natural order as
+                 * basic_radix2_fft_cached produces. Twiddles are the table of basic_radix2_fft_twiddles for the size
+                 * at least a.size(), which contains the tables for n1 and n2 too. The optional pre_scale and
+                 * post_scale multiply the input and the output elementwise, as in basic_radix2_fft_cached, and
+                 * are applied by the first and the last transposes. The transposes go through n elements of scratch,
+                 * which are allocated here unless the caller gives them.
+                 */
+                template<typename FieldType>
+                void basic_radix2_four_step_fft(typename FieldType::value_type *data, const std::size_t n,
+                                                const typename FieldType::value_type *twiddles,
+                                                thread_pool *pool = nullptr,
+                                                const typename FieldType::value_type *pre_scale = nullptr,
+                                                const typename FieldType::value_type *post_scale = nullptr,
+                                                typename FieldType::value_type *scratch = nullptr) {
+                    typedef typename FieldType::value_type value_type;
+
+                    const std::size_t logn = log2(n);
+
+                    if (n < 4) {
+                        basic_radix4_fft_cached<FieldType>(data, n, twiddles, pool, pre_scale, post_scale);
+                        return;
+                    }
+
+                    /* data[j1 * n2 + j2] is the element (j1, j2) of the n1 x n2 matrix */
+                    const std::size_t n1 = 1ul << (logn / 2);
+                    const std::size_t n2 = n / n1;
+
+                    scratch_vector<value_type> owned_scratch(scratch == nullptr ? n : 0);
+                    if (scratch == nullptr) {
+                        scratch = owned_scratch.data();
                     }
+
+                    const auto row_ffts = [&](value_type *rows, const std::size_t rows_count,
+                                              const std::size_t length) {
+                        parallel_for(
+                            pool, 0, rows_count,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t r = begin; r < end; ++r) {
+                                    basic_radix4_fft_cached<FieldType>(rows + r * length, length, twiddles);
+                                }
+                            },
+                            1);
+                    };
+
+                    /* columns of length n1 become contiguous rows */
+                    basic_radix2_transpose<FieldType>(data, scratch, n1, n2, nullptr, pool, pre_scale);
+                    row_ffts(scratch, n2, n1);
+
+                    /* scale (j2, k1) by omega^{j2 * k1} on the way back */
+                    basic_radix2_transpose<FieldType>(scratch, data, n2, n1, twiddles, pool);
+                    row_ffts(data, n1, n2);
+
+                    /* X[k1 + n1 * k2] is the element (k1, k2) */
+                    basic_radix2_transpose<FieldType>(data, scratch, n1, n2, nullptr, pool, nullptr, post_scale);
+                    std::copy(scratch, scratch + n, data);
+                }
+
+                template<typename FieldType, typename Range>
+                void basic_radix2_four_step_fft(Range &a, const std::vector<typename FieldType::value_type> &twiddles,
+                                                thread_pool *pool = nullptr) {
+                    typedef typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
+                        value_type;
+
+                    BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
+                    BOOST_STATIC_ASSERT(std::is_same<typename FieldType::value_type, value_type>::value);
+
+                    const std::size_t n = a.size(), logn = log2(n);
+                    if (n != (1u << logn))
+                        throw std::invalid_argument("expected n == (1u << logn)");
+                    if (twiddles.size() + 1 < n)
+                        throw std::invalid_argument("expected twiddles.size() + 1 >= n");
+
+                    basic_radix2_four_step_fft<FieldType>(&*std::begin(a), n, twiddles.data(), pool);
                 }
 
                 /**
@@ -131,13 +799,18 @@ namespace nil {
                      */
 
                     const value_type Z = (t.pow(m)) - value_type::one();
-                    value_type l = Z * value_type(m).inversed();
                     value_type r = value_type::one();
                     for (std::size_t i = 0; i < m; ++i) {
-                        u[i] = l * (t - r).inversed();
-                        l *= omega;
+                        u[i] = t - r;
                         r *= omega;
                     }
+                    batch_inverse(u);
+
+                    value_type l = Z * value_type(m).inversed();
+                    for (std::size_t i = 0; i < m; ++i) {
+                        u[i] *= l;
+                        l *= omega;
+                    }
 
                     return u;
                 }
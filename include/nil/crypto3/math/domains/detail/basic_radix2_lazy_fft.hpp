@@ -0,0 +1,416 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_BASIC_RADIX2_LAZY_FFT_HPP
+#define CRYPTO3_MATH_BASIC_RADIX2_LAZY_FFT_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+
+#include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace detail {
+
+                /**
+                 * Whether basic_radix2_domain runs the FFTs over the field with basic_radix2_lazy_fft. That is the
+                 * case for the fields of 193 to 255 bits, e.g. the scalar fields of BN254 and BLS12-381, Pallas and
+                 * Vesta, whose elements fit into four 64-bit limbs with a spare bit. Specialize it to opt a field
+                 * in or out.
+                 */
+                template<typename FieldType>
+                struct basic_radix2_lazy_reduction
+#ifdef BOOST_HAS_INT128
+                    : std::integral_constant<bool, (FieldType::modulus_bits > 192 && FieldType::modulus_bits <= 255)> {
+#else
+                    : std::false_type {
+#endif
+                };
+
+#ifdef BOOST_HAS_INT128
+                /**
+                 * Montgomery arithmetic modulo the modulus of the field, with R = 2^256, over four 64-bit limbs
+                 * stored least significant first. Results are not reduced: they stay below 2p, and the callers
+                 * keep the values below bound * p, where bound * p < 2^256.
+                 */
+                template<typename FieldType>
+                struct montgomery_4x64 {
+                    typedef std::array<std::uint64_t, 4> limbs_type;
+                    typedef typename FieldType::value_type value_type;
+                    typedef typename FieldType::integral_type integral_type;
+                    typedef unsigned __int128 wide_type;
+
+                    BOOST_STATIC_ASSERT(FieldType::modulus_bits <= 255);
+
+                    constexpr static const std::size_t bound = FieldType::modulus_bits <= 254 ? 4 : 2;
+
+                    limbs_type p;
+                    limbs_type p2;
+                    limbs_type r2;
+                    std::uint64_t pinv;
+
+                    static const montgomery_4x64 &instance() {
+                        static const montgomery_4x64 params;
+                        return params;
+                    }
+
+                    static limbs_type to_limbs(const integral_type &x) {
+                        const integral_type mask = integral_type(~std::uint64_t(0));
+                        integral_type t = x;
+                        limbs_type r;
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            r[i] = static_cast<std::uint64_t>(t & mask);
+                            t >>= 64;
+                        }
+                        return r;
+                    }
+
+                    static integral_type from_limbs(const limbs_type &x) {
+                        integral_type r = integral_type(x[3]);
+                        for (std::size_t i = 3; i-- > 0;) {
+                            r <<= 64;
+                            r |= integral_type(x[i]);
+                        }
+                        return r;
+                    }
+
+                    static limbs_type load(const std::uint64_t *x) {
+                        return {x[0], x[1], x[2], x[3]};
+                    }
+
+                    static bool geq(const limbs_type &a, const limbs_type &b) {
+                        for (std::size_t i = 4; i-- > 0;) {
+                            if (a[i] != b[i]) {
+                                return a[i] > b[i];
+                            }
+                        }
+                        return true;
+                    }
+
+                    /* r = a + b mod 2^256, returns the carry */
+                    static std::uint64_t add(limbs_type &r, const limbs_type &a, const limbs_type &b) {
+                        wide_type c = 0;
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            c += wide_type(a[i]) + b[i];
+                            r[i] = std::uint64_t(c);
+                            c >>= 64;
+                        }
+                        return std::uint64_t(c);
+                    }
+
+                    /* r = a - b mod 2^256, returns the borrow */
+                    static std::uint64_t sub(limbs_type &r, const limbs_type &a, const limbs_type &b) {
+                        std::uint64_t borrow = 0;
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            const wide_type d = wide_type(a[i]) - b[i] - borrow;
+                            r[i] = std::uint64_t(d);
+                            borrow = std::uint64_t(d >> 64) & 1;
+                        }
+                        return borrow;
+                    }
+
+                    /* a * b / R mod p, below 2p as long as a * b < R * p */
+                    limbs_type mul(const limbs_type &a, const limbs_type &b) const {
+                        std::uint64_t t[6] = {0, 0, 0, 0, 0, 0};
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            wide_type c = 0;
+                            for (std::size_t j = 0; j < 4; ++j) {
+                                c += wide_type(a[j]) * b[i] + t[j];
+                                t[j] = std::uint64_t(c);
+                                c >>= 64;
+                            }
+                            c += t[4];
+                            t[4] = std::uint64_t(c);
+                            t[5] = std::uint64_t(c >> 64);
+
+                            const std::uint64_t m = t[0] * pinv;
+                            c = (wide_type(m) * p[0] + t[0]) >> 64;
+                            for (std::size_t j = 1; j < 4; ++j) {
+                                c += wide_type(m) * p[j] + t[j];
+                                t[j - 1] = std::uint64_t(c);
+                                c >>= 64;
+                            }
+                            c += t[4];
+                            t[3] = std::uint64_t(c);
+                            t[4] = t[5] + std::uint64_t(c >> 64);
+                        }
+                        return {t[0], t[1], t[2], t[3]};
+                    }
+
+                    /* reduce a below 2p to [0, p) */
+                    limbs_type reduce(const limbs_type &a) const {
+                        limbs_type r = a;
+                        if (geq(r, p)) {
+                            sub(r, r, p);
+                        }
+                        return r;
+                    }
+
+                    limbs_type to_montgomery(const value_type &x) const {
+                        return mul(to_limbs(integral_type(x.data)), r2);
+                    }
+
+                    /* x * c for x in the Montgomery form below bound * p and c in the standard one */
+                    value_type from_montgomery(const limbs_type &x, const limbs_type &c) const {
+                        return value_type(from_limbs(reduce(mul(x, c))));
+                    }
+
+                private:
+                    montgomery_4x64() {
+                        p = to_limbs(FieldType::modulus);
+                        add(p2, p, p);
+
+                        /* -p^{-1} mod 2^64 by Newton's iteration, each step doubles the correct low bits */
+                        std::uint64_t inv = 1;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            inv *= 2 - p[0] * inv;
+                        }
+                        pinv = ~inv + 1;
+
+                        /* R^2 mod p by 512 doublings of 1, each of them below 2p < 2^256 */
+                        r2 = {1, 0, 0, 0};
+                        for (std::size_t i = 0; i < 512; ++i) {
+                            add(r2, r2, r2);
+                            if (geq(r2, p)) {
+                                sub(r2, r2, p);
+                            }
+                        }
+                    }
+                };
+
+                /**
+                 * Same as basic_radix2_fft_cached over the values and the twiddles table of
+                 * basic_radix2_lazy_fft_twiddles in the Montgomery form of montgomery_4x64. The butterflies skip
+                 * full reduction [Harvey 2014, Faster arithmetic for number-theoretic transforms]: the values stay
+                 * below montgomery_4x64::bound * p between the stages, and the caller normalizes them once when
+                 * leaving the Montgomery form.
+                 */
+                template<typename FieldType>
+                void basic_radix2_lazy_fft(typename montgomery_4x64<FieldType>::limbs_type *a, const std::size_t n,
+                                           const std::uint64_t *twiddles, thread_pool *pool = nullptr) {
+                    typedef montgomery_4x64<FieldType> montgomery_type;
+                    typedef typename montgomery_type::limbs_type limbs_type;
+
+                    const montgomery_type &mont = montgomery_type::instance();
+                    const std::size_t logn = log2(n);
+
+                    /* (x, y) -> (x + y * w, x - y * w), with y * w already computed */
+                    const auto butterfly = [&mont](limbs_type &x, limbs_type &y, const limbs_type &t) {
+                        if (montgomery_type::bound == 4) {
+                            /* x, y < 4p, t < 2p: bring x below 2p, then both outputs are below 4p */
+                            if (montgomery_type::geq(x, mont.p2)) {
+                                montgomery_type::sub(x, x, mont.p2);
+                            }
+                            montgomery_type::sub(y, x, t);
+                            montgomery_type::add(y, y, mont.p2);
+                            montgomery_type::add(x, x, t);
+                        } else {
+                            /* x, y, t < 2p: one conditional correction by 2p keeps the outputs below 2p */
+                            if (montgomery_type::sub(y, x, t)) {
+                                montgomery_type::add(y, y, mont.p2);
+                            }
+                            if (montgomery_type::add(x, x, t) || montgomery_type::geq(x, mont.p2)) {
+                                montgomery_type::sub(x, x, mont.p2);
+                            }
+                        }
+                    };
+
+                    parallel_for(
+                        pool, 0, n,
+                        [a, logn](std::size_t begin, std::size_t end) {
+                            basic_radix2_bitreverse(a, logn, begin, end);
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    /* the first stage has only trivial twiddles */
+                    parallel_for(
+                        pool, 0, n / 2,
+                        [a, &mont, &butterfly](std::size_t begin, std::size_t end) {
+                            for (std::size_t k = 2 * begin; k < 2 * end; k += 2) {
+                                limbs_type t = a[k + 1];
+                                if (montgomery_type::bound == 4 && montgomery_type::geq(t, mont.p2)) {
+                                    montgomery_type::sub(t, t, mont.p2);
+                                }
+                                butterfly(a[k], a[k + 1], t);
+                            }
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    for (std::size_t m = 2; m < n; m *= 2) {
+                        const std::uint64_t *w = twiddles + 4 * (m - 1);
+
+                        parallel_for(
+                            pool, 0, n / 2,
+                            [a, w, m, &mont, &butterfly](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end;) {
+                                    const std::size_t j0 = i & (m - 1);
+                                    const std::size_t k = 2 * (i - j0);
+                                    const std::size_t j1 = std::min(m, j0 + (end - i));
+
+                                    for (std::size_t j = j0; j < j1; ++j) {
+                                        butterfly(a[k + j], a[k + j + m],
+                                                  mont.mul(a[k + j + m], montgomery_type::load(w + 4 * j)));
+                                    }
+                                    i += j1 - j0;
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                    }
+                }
+
+                /**
+                 * Number of the elements in the Montgomery form basic_radix2_lazy_fft keeps for n values: from
+                 * basic_radix2_four_step_fft_threshold, the transposes of the four-step decomposition go through
+                 * two of them.
+                 */
+                constexpr std::size_t basic_radix2_lazy_fft_buffer_size(const std::size_t n) {
+                    return n >= basic_radix2_four_step_fft_threshold ? 2 * n : n;
+                }
+
+                /**
+                 * Run basic_radix2_lazy_fft over the values of a, converting them to the Montgomery form and back, with
+                 * the output multiplied by scale, which carries the 1/n of an inverse transform. The Montgomery forms
+                 * are kept in the caller's buffer of basic_radix2_lazy_fft_buffer_size(a.size()) elements. From
+                 * basic_radix2_four_step_fft_threshold, the transform is the one of basic_radix2_four_step_fft with the
+                 * lazy butterflies in the FFTs of the rows, and the conversions are fused into its first and last
+                 * transposes.
+                 */
+                template<typename FieldType, typename Range>
+                void basic_radix2_lazy_fft(Range &a, const std::vector<std::uint64_t> &twiddles,
+                                           const typename FieldType::value_type &scale,
+                                           typename montgomery_4x64<FieldType>::limbs_type *buffer,
+                                           thread_pool *pool = nullptr) {
+                    typedef montgomery_4x64<FieldType> montgomery_type;
+                    typedef typename montgomery_type::limbs_type limbs_type;
+
+                    const montgomery_type &mont = montgomery_type::instance();
+                    const limbs_type c = montgomery_type::to_limbs(typename FieldType::integral_type(scale.data));
+                    const std::size_t n = a.size();
+
+                    if (n < basic_radix2_four_step_fft_threshold) {
+                        parallel_for(
+                            pool, 0, n,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    buffer[i] = mont.to_montgomery(a[i]);
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+
+                        basic_radix2_lazy_fft<FieldType>(buffer, n, twiddles.data(), pool);
+
+                        parallel_for(
+                            pool, 0, n,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    a[i] = mont.from_montgomery(buffer[i], c);
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                        return;
+                    }
+
+                    /* a[j1 * n2 + j2] is the element (j1, j2) of the n1 x n2 matrix */
+                    const std::size_t logn = log2(n);
+                    const std::size_t n1 = 1ul << (logn / 2);
+                    const std::size_t n2 = n / n1;
+                    const std::size_t half = n / 2;
+                    const std::uint64_t *omega_powers = twiddles.data() + 4 * (half - 1);
+                    limbs_type *rows = buffer;
+                    limbs_type *columns = buffer + n;
+
+                    const auto row_ffts = [&](limbs_type *values, const std::size_t rows_count,
+                                              const std::size_t length) {
+                        parallel_for(
+                            pool, 0, rows_count,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t r = begin; r < end; ++r) {
+                                    basic_radix2_lazy_fft<FieldType>(values + r * length, length, twiddles.data());
+                                }
+                            },
+                            1);
+                    };
+
+                    /* columns of length n1 become contiguous rows in the Montgomery form */
+                    basic_radix2_transpose_tiles(n1, n2, pool, [&](std::size_t i, std::size_t j) {
+                        rows[j * n1 + i] = mont.to_montgomery(a[i * n2 + j]);
+                    });
+                    row_ffts(rows, n2, n1);
+
+                    /* scale (j2, k1) by omega^{j2 * k1}, with omega^{n/2 + e} = -omega^e, on the way back; the
+                       values below bound * p times the reduced twiddles stay below R * p */
+                    basic_radix2_transpose_tiles(n2, n1, pool, [&](std::size_t i, std::size_t j) {
+                        const std::size_t e = i * j;
+                        limbs_type &v = columns[j * n2 + i];
+                        if (e < half) {
+                            v = mont.mul(rows[i * n1 + j], montgomery_type::load(omega_powers + 4 * e));
+                        } else {
+                            montgomery_type::sub(
+                                v, mont.p,
+                                mont.reduce(mont.mul(rows[i * n1 + j],
+                                                     montgomery_type::load(omega_powers + 4 * (e - half)))));
+                        }
+                    });
+                    row_ffts(columns, n1, n2);
+
+                    /* X[k1 + n1 * k2] is the element (k1, k2) */
+                    basic_radix2_transpose_tiles(n1, n2, pool, [&](std::size_t i, std::size_t j) {
+                        a[j * n1 + i] = mont.from_montgomery(columns[i * n2 + j], c);
+                    });
+                }
+
+                /**
+                 * Convert the table of basic_radix2_fft_twiddles to the Montgomery form for basic_radix2_lazy_fft,
+                 * four limbs per entry.
+                 */
+                template<typename FieldType>
+                std::vector<std::uint64_t>
+                    basic_radix2_lazy_fft_twiddles(span<const typename FieldType::value_type> twiddles) {
+                    typedef montgomery_4x64<FieldType> montgomery_type;
+
+                    const montgomery_type &mont = montgomery_type::instance();
+
+                    /* twiddles must be fully reduced for the bounds of the butterflies */
+                    std::vector<std::uint64_t> result(4 * twiddles.size());
+                    for (std::size_t i = 0; i < twiddles.size(); ++i) {
+                        const typename montgomery_type::limbs_type w = mont.reduce(mont.to_montgomery(twiddles[i]));
+                        std::copy(w.begin(), w.end(), result.begin() + 4 * i);
+                    }
+                    return result;
+                }
+#endif
+            }    // namespace detail
+        }        // namespace math
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_BASIC_RADIX2_LAZY_FFT_HPP
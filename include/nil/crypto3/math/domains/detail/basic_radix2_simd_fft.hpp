@@ -0,0 +1,650 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_BASIC_RADIX2_SIMD_FFT_HPP
+#define CRYPTO3_MATH_BASIC_RADIX2_SIMD_FFT_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <nil/crypto3/math/domains/detail/basic_radix2_lazy_fft.hpp>
+
+#if defined(BOOST_HAS_INT128) && (defined(__AVX2__) || (defined(__AVX512F__) && defined(__AVX512IFMA__)))
+#include <immintrin.h>
+#define CRYPTO3_MATH_BASIC_RADIX2_SIMD_FFT
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace detail {
+
+#ifdef CRYPTO3_MATH_BASIC_RADIX2_SIMD_FFT
+                /*
+                 * Operations on the lanes of a SIMD register, each holding one limb of Bits bits of a field element.
+                 * The scalar version runs the same arithmetic one element at a time.
+                 */
+                template<std::size_t Bits, std::size_t Limbs>
+                struct basic_radix2_scalar_ops {
+                    typedef std::uint64_t vec;
+
+                    constexpr static const std::size_t lanes = 1;
+                    constexpr static const std::size_t bits = Bits;
+                    constexpr static const std::size_t limbs = Limbs;
+                    constexpr static const std::uint64_t mask = (std::uint64_t(1) << Bits) - 1;
+
+                    static vec set1(std::uint64_t x) {
+                        return x;
+                    }
+                    static vec load(const std::uint64_t *p) {
+                        return *p;
+                    }
+                    static void store(std::uint64_t *p, vec x) {
+                        *p = x;
+                    }
+                    static vec add(vec a, vec b) {
+                        return a + b;
+                    }
+                    static vec sub(vec a, vec b) {
+                        return a - b;
+                    }
+                    static vec low(vec a) {
+                        return a & mask;
+                    }
+                    static vec high(vec a) {
+                        return a >> Bits;
+                    }
+                    /* lo += a * b mod 2^Bits, hi += a * b / 2^Bits for a, b < 2^Bits */
+                    static void mul_add(vec &lo, vec &hi, vec a, vec b) {
+                        const unsigned __int128 t = (unsigned __int128)a * b;
+                        lo += std::uint64_t(t) & mask;
+                        hi += std::uint64_t(t >> Bits);
+                    }
+                    /* a * b mod 2^Bits, for any a and b < 2^Bits */
+                    static vec mul_low(vec a, vec b) {
+                        return (a * b) & mask;
+                    }
+                    /* flag ? a : b for flag in {0, 1} */
+                    static vec select(vec flag, vec a, vec b) {
+                        return flag ? a : b;
+                    }
+                };
+
+#if defined(__AVX512F__) && defined(__AVX512IFMA__)
+                /*
+                 * AVX-512 IFMA: eight elements per register in five limbs of 52 bits each.
+                 */
+                struct basic_radix2_simd_ops {
+                    typedef __m512i vec;
+                    typedef basic_radix2_scalar_ops<52, 5> scalar_ops;
+
+                    constexpr static const std::size_t lanes = 8;
+                    constexpr static const std::size_t bits = 52;
+                    constexpr static const std::size_t limbs = 5;
+                    constexpr static const std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+
+                    static vec set1(std::uint64_t x) {
+                        return _mm512_set1_epi64(x);
+                    }
+                    static vec load(const std::uint64_t *p) {
+                        return _mm512_loadu_si512(p);
+                    }
+                    static void store(std::uint64_t *p, vec x) {
+                        _mm512_storeu_si512(p, x);
+                    }
+                    static vec add(vec a, vec b) {
+                        return _mm512_add_epi64(a, b);
+                    }
+                    static vec sub(vec a, vec b) {
+                        return _mm512_sub_epi64(a, b);
+                    }
+                    static vec low(vec a) {
+                        return _mm512_and_si512(a, set1(mask));
+                    }
+                    static vec high(vec a) {
+                        return _mm512_srli_epi64(a, bits);
+                    }
+                    static void mul_add(vec &lo, vec &hi, vec a, vec b) {
+                        lo = _mm512_madd52lo_epu64(lo, a, b);
+                        hi = _mm512_madd52hi_epu64(hi, a, b);
+                    }
+                    static vec mul_low(vec a, vec b) {
+                        return low(_mm512_madd52lo_epu64(_mm512_setzero_si512(), a, b));
+                    }
+                    static vec select(vec flag, vec a, vec b) {
+                        return _mm512_mask_blend_epi64(_mm512_test_epi64_mask(flag, flag), b, a);
+                    }
+                };
+#else
+                /*
+                 * AVX2: four elements per register in nine limbs of 29 bits each, so that the 32 x 32-bit
+                 * products of _mm256_mul_epu32 are exact.
+                 */
+                struct basic_radix2_simd_ops {
+                    typedef __m256i vec;
+                    typedef basic_radix2_scalar_ops<29, 9> scalar_ops;
+
+                    constexpr static const std::size_t lanes = 4;
+                    constexpr static const std::size_t bits = 29;
+                    constexpr static const std::size_t limbs = 9;
+                    constexpr static const std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+
+                    static vec set1(std::uint64_t x) {
+                        return _mm256_set1_epi64x(x);
+                    }
+                    static vec load(const std::uint64_t *p) {
+                        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                    }
+                    static void store(std::uint64_t *p, vec x) {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+                    }
+                    static vec add(vec a, vec b) {
+                        return _mm256_add_epi64(a, b);
+                    }
+                    static vec sub(vec a, vec b) {
+                        return _mm256_sub_epi64(a, b);
+                    }
+                    static vec low(vec a) {
+                        return _mm256_and_si256(a, set1(mask));
+                    }
+                    static vec high(vec a) {
+                        return _mm256_srli_epi64(a, bits);
+                    }
+                    static void mul_add(vec &lo, vec &hi, vec a, vec b) {
+                        const vec t = _mm256_mul_epu32(a, b);
+                        lo = add(lo, low(t));
+                        hi = add(hi, high(t));
+                    }
+                    /* _mm256_mul_epu32 takes the low 32 bits of a, which is enough modulo 2^29 */
+                    static vec mul_low(vec a, vec b) {
+                        return low(_mm256_mul_epu32(a, b));
+                    }
+                    static vec select(vec flag, vec a, vec b) {
+                        return _mm256_blendv_epi8(b, a, _mm256_sub_epi64(_mm256_setzero_si256(), flag));
+                    }
+                };
+#endif
+
+                /**
+                 * Constants of the Montgomery arithmetic modulo the field modulus over Limbs limbs of Bits bits,
+                 * with R = 2^{Bits * Limbs} > 4p, so the butterflies keep the values below 4p.
+                 */
+                template<typename FieldType, std::size_t Bits, std::size_t Limbs>
+                struct basic_radix2_simd_params {
+                    typedef montgomery_4x64<FieldType> montgomery_type;
+                    typedef typename montgomery_type::limbs_type limbs_type;
+                    typedef typename FieldType::integral_type integral_type;
+
+                    BOOST_STATIC_ASSERT(Bits * Limbs >= FieldType::modulus_bits + 2);
+
+                    constexpr static const std::uint64_t mask = (std::uint64_t(1) << Bits) - 1;
+
+                    std::uint64_t p[Limbs];
+                    /* R - p and R - 2p, adding them subtracts p and 2p */
+                    std::uint64_t neg_p[Limbs];
+                    std::uint64_t neg_p2[Limbs];
+                    /* 2p with every limb but the top one at least 2^Bits - 1, so that 2p - x takes no borrows */
+                    std::uint64_t p2_redundant[Limbs];
+                    /* R^2 mod p */
+                    std::uint64_t r2[Limbs];
+                    /* -p^{-1} mod 2^Bits */
+                    std::uint64_t pinv;
+
+                    static const basic_radix2_simd_params &instance() {
+                        static const basic_radix2_simd_params params;
+                        return params;
+                    }
+
+                    static void to_limbs(const integral_type &x, std::uint64_t *r, std::size_t stride = 1) {
+                        const integral_type m = integral_type(mask);
+                        integral_type t = x;
+                        for (std::size_t i = 0; i < Limbs; ++i) {
+                            r[i * stride] = static_cast<std::uint64_t>(t & m);
+                            t >>= Bits;
+                        }
+                    }
+
+                    static integral_type from_limbs(const std::uint64_t *x, std::size_t stride = 1) {
+                        integral_type r = integral_type(x[(Limbs - 1) * stride]);
+                        for (std::size_t i = Limbs - 1; i-- > 0;) {
+                            r <<= Bits;
+                            r |= integral_type(x[i * stride]);
+                        }
+                        return r;
+                    }
+
+                private:
+                    /* x is below 2p < 2^256, so it has no more than 256 significant bits */
+                    static void split(const limbs_type &x, std::uint64_t *r) {
+                        for (std::size_t i = 0; i < Limbs; ++i) {
+                            std::uint64_t v = 0;
+                            for (std::size_t b = 0; b < Bits; ++b) {
+                                const std::size_t bit = i * Bits + b;
+                                if (bit < 256 && ((x[bit / 64] >> (bit % 64)) & 1)) {
+                                    v |= std::uint64_t(1) << b;
+                                }
+                            }
+                            r[i] = v;
+                        }
+                    }
+
+                    static void negate(const std::uint64_t *x, std::uint64_t *r) {
+                        std::uint64_t carry = 1;
+                        for (std::size_t i = 0; i < Limbs; ++i) {
+                            const std::uint64_t v = (mask - x[i]) + carry;
+                            r[i] = v & mask;
+                            carry = v >> Bits;
+                        }
+                    }
+
+                    basic_radix2_simd_params() {
+                        const limbs_type p64 = montgomery_type::to_limbs(FieldType::modulus);
+                        limbs_type p2_64;
+                        montgomery_type::add(p2_64, p64, p64);
+
+                        std::uint64_t p2[Limbs];
+                        split(p64, p);
+                        split(p2_64, p2);
+                        negate(p, neg_p);
+                        negate(p2, neg_p2);
+
+                        p2_redundant[0] = p2[0] + (mask + 1);
+                        for (std::size_t i = 1; i + 1 < Limbs; ++i) {
+                            p2_redundant[i] = p2[i] + mask;
+                        }
+                        p2_redundant[Limbs - 1] = p2[Limbs - 1] - 1;
+
+                        std::uint64_t inv = 1;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            inv *= 2 - p[0] * inv;
+                        }
+                        pinv = (~inv + 1) & mask;
+
+                        /* R^2 mod p by doublings of 1 */
+                        limbs_type x = {1, 0, 0, 0};
+                        for (std::size_t i = 0; i < 2 * Bits * Limbs; ++i) {
+                            montgomery_type::add(x, x, x);
+                            if (montgomery_type::geq(x, p64)) {
+                                montgomery_type::sub(x, x, p64);
+                            }
+                        }
+                        split(x, r2);
+                    }
+                };
+
+                /*
+                 * Montgomery arithmetic and the lazy butterfly of basic_radix2_lazy_fft over the lanes of Ops, on
+                 * the elements stored as arrays of Ops::limbs registers.
+                 */
+                template<typename FieldType, typename Ops>
+                struct basic_radix2_simd_arithmetic {
+                    typedef typename Ops::vec vec;
+                    typedef basic_radix2_simd_params<FieldType, Ops::bits, Ops::limbs> params_type;
+
+                    constexpr static const std::size_t limbs = Ops::limbs;
+
+                    vec p[limbs];
+                    vec neg_p[limbs];
+                    vec neg_p2[limbs];
+                    vec p2_redundant[limbs];
+                    vec pinv;
+
+                    basic_radix2_simd_arithmetic() {
+                        const params_type &params = params_type::instance();
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            p[i] = Ops::set1(params.p[i]);
+                            neg_p[i] = Ops::set1(params.neg_p[i]);
+                            neg_p2[i] = Ops::set1(params.neg_p2[i]);
+                            p2_redundant[i] = Ops::set1(params.p2_redundant[i]);
+                        }
+                        pinv = Ops::set1(params.pinv);
+                    }
+
+                    static void load(vec *x, const std::uint64_t *data, std::size_t stride) {
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            x[i] = Ops::load(data + i * stride);
+                        }
+                    }
+
+                    static void store(std::uint64_t *data, std::size_t stride, const vec *x) {
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            Ops::store(data + i * stride, x[i]);
+                        }
+                    }
+
+                    static void normalize(vec *x) {
+                        for (std::size_t i = 0; i + 1 < limbs; ++i) {
+                            x[i + 1] = Ops::add(x[i + 1], Ops::high(x[i]));
+                            x[i] = Ops::low(x[i]);
+                        }
+                    }
+
+                    /* x - c if x >= c, where neg = R - c */
+                    static void reduce(vec *x, const vec *neg) {
+                        vec d[limbs];
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            d[i] = Ops::add(x[i], neg[i]);
+                        }
+                        normalize(d);
+                        const vec geq = Ops::high(d[limbs - 1]);
+                        d[limbs - 1] = Ops::low(d[limbs - 1]);
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            x[i] = Ops::select(geq, d[i], x[i]);
+                        }
+                    }
+
+                    /* r = a * b / R mod p, below 2p as long as a * b < R * p */
+                    void mul(vec *r, const vec *a, const vec *b) const {
+                        vec t[limbs + 1];
+                        for (std::size_t i = 0; i <= limbs; ++i) {
+                            t[i] = Ops::set1(0);
+                        }
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                Ops::mul_add(t[j], t[j + 1], a[j], b[i]);
+                            }
+                            const vec m = Ops::mul_low(t[0], pinv);
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                Ops::mul_add(t[j], t[j + 1], m, p[j]);
+                            }
+                            /* the low limb is divisible by 2^bits now */
+                            t[1] = Ops::add(t[1], Ops::high(t[0]));
+                            for (std::size_t j = 0; j < limbs; ++j) {
+                                t[j] = t[j + 1];
+                            }
+                            t[limbs] = Ops::set1(0);
+                        }
+                        normalize(t);
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            r[i] = t[i];
+                        }
+                    }
+
+                    /* (x, y) -> (x + y * w, x - y * w) with x, y < 4p and w < p, or w = 1 if it is null */
+                    void butterfly(vec *x, vec *y, const vec *w) const {
+                        vec t[limbs];
+                        if (w == nullptr) {
+                            for (std::size_t i = 0; i < limbs; ++i) {
+                                t[i] = y[i];
+                            }
+                            reduce(t, neg_p2);
+                        } else {
+                            mul(t, y, w);
+                        }
+                        reduce(x, neg_p2);
+                        for (std::size_t i = 0; i < limbs; ++i) {
+                            y[i] = Ops::sub(Ops::add(x[i], p2_redundant[i]), t[i]);
+                            x[i] = Ops::add(x[i], t[i]);
+                        }
+                        normalize(x);
+                        normalize(y);
+                    }
+                };
+
+                /**
+                 * Same as basic_radix2_lazy_fft, but with Ops::lanes butterflies per instruction. Limb l of the
+                 * element i is data[l * n + i], and the twiddles table from basic_radix2_simd_fft_twiddles is in
+                 * the same layout, with limb l of the entry i at twiddles[l * twiddles_stride + i]: the stride is
+                 * the size of the table, which is n - 1 or more for the table of a larger domain. The stages of
+                 * half-size below Ops::lanes run on the scalar version of the arithmetic.
+                 */
+                template<typename FieldType, typename Ops = basic_radix2_simd_ops>
+                void basic_radix2_simd_fft(std::uint64_t *data, const std::size_t n, const std::uint64_t *twiddles,
+                                           const std::size_t twiddles_stride, thread_pool *pool = nullptr) {
+                    typedef typename Ops::vec vec;
+                    typedef typename Ops::scalar_ops scalar_ops;
+                    typedef typename scalar_ops::vec scalar_vec;
+
+                    constexpr std::size_t limbs = Ops::limbs;
+                    constexpr std::size_t lanes = Ops::lanes;
+
+                    const std::size_t logn = log2(n);
+                    const std::size_t stride = twiddles_stride;
+
+                    parallel_for(
+                        pool, 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t k = begin; k < end; ++k) {
+                                const std::size_t rk = bitreverse(k, logn);
+                                if (k < rk) {
+                                    for (std::size_t l = 0; l < limbs; ++l) {
+                                        std::swap(data[l * n + k], data[l * n + rk]);
+                                    }
+                                }
+                            }
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    for (std::size_t m = 1; m < n; m *= 2) {
+                        const std::uint64_t *w = twiddles + (m - 1);
+
+                        if (m < lanes || n / 2 < lanes) {
+                            parallel_for(
+                                pool, 0, n / 2,
+                                [&](std::size_t begin, std::size_t end) {
+                                    const basic_radix2_simd_arithmetic<FieldType, scalar_ops> arithmetic;
+                                    scalar_vec x[limbs], y[limbs], t[limbs];
+                                    for (std::size_t i = begin; i < end; ++i) {
+                                        const std::size_t j = i & (m - 1);
+                                        const std::size_t k = 2 * (i - j) + j;
+                                        arithmetic.load(x, data + k, n);
+                                        arithmetic.load(y, data + k + m, n);
+                                        if (m == 1) {
+                                            arithmetic.butterfly(x, y, nullptr);
+                                        } else {
+                                            arithmetic.load(t, w + j, stride);
+                                            arithmetic.butterfly(x, y, t);
+                                        }
+                                        arithmetic.store(data + k, n, x);
+                                        arithmetic.store(data + k + m, n, y);
+                                    }
+                                },
+                                basic_radix2_fft_grain_size);
+                            continue;
+                        }
+
+                        /* vector butterfly v covers the butterflies lanes * v, ..., lanes * v + lanes - 1 */
+                        parallel_for(
+                            pool, 0, n / 2 / lanes,
+                            [&](std::size_t begin, std::size_t end) {
+                                const basic_radix2_simd_arithmetic<FieldType, Ops> arithmetic;
+                                vec x[limbs], y[limbs], t[limbs];
+                                for (std::size_t v = begin; v < end; ++v) {
+                                    const std::size_t i = v * lanes;
+                                    const std::size_t j = i & (m - 1);
+                                    const std::size_t k = 2 * (i - j) + j;
+                                    arithmetic.load(x, data + k, n);
+                                    arithmetic.load(y, data + k + m, n);
+                                    arithmetic.load(t, w + j, stride);
+                                    arithmetic.butterfly(x, y, t);
+                                    arithmetic.store(data + k, n, x);
+                                    arithmetic.store(data + k + m, n, y);
+                                }
+                            },
+                            basic_radix2_fft_grain_size / lanes);
+                    }
+                }
+
+                /**
+                 * Number of the 64-bit words basic_radix2_simd_fft keeps for n values: as many elements as
+                 * basic_radix2_lazy_fft_buffer_size, of Ops::limbs limbs each.
+                 */
+                template<typename Ops = basic_radix2_simd_ops>
+                constexpr std::size_t basic_radix2_simd_fft_buffer_size(const std::size_t n) {
+                    return Ops::limbs * basic_radix2_lazy_fft_buffer_size(n);
+                }
+
+                /**
+                 * Run basic_radix2_simd_fft over the values of a, converting them to its layout and back, with the
+                 * output multiplied by scale, e.g. 1/n for the inverse transform or one otherwise. The converted values
+                 * are kept in the caller's buffer of basic_radix2_simd_fft_buffer_size(a.size()) words. From
+                 * basic_radix2_four_step_fft_threshold, the transform is the one of basic_radix2_four_step_fft with the
+                 * SIMD butterflies in the FFTs of the rows, each of them stored in the layout of basic_radix2_simd_fft
+                 * on its own, and the conversions are fused into its first and last transposes.
+                 */
+                template<typename FieldType, typename Ops = basic_radix2_simd_ops, typename Range>
+                void basic_radix2_simd_fft(Range &a, const std::vector<std::uint64_t> &twiddles,
+                                           const typename FieldType::value_type &scale, std::uint64_t *buffer,
+                                           thread_pool *pool = nullptr) {
+                    typedef typename FieldType::integral_type integral_type;
+                    typedef typename Ops::scalar_ops scalar_ops;
+                    typedef basic_radix2_simd_params<FieldType, Ops::bits, Ops::limbs> params_type;
+
+                    constexpr std::size_t limbs = Ops::limbs;
+
+                    const params_type &params = params_type::instance();
+                    const basic_radix2_simd_arithmetic<FieldType, scalar_ops> arithmetic;
+                    const std::size_t n = a.size();
+                    const std::size_t stride = twiddles.size() / limbs;
+
+                    std::uint64_t c[limbs];
+                    params_type::to_limbs(integral_type(scale.data), c);
+
+                    /* the conversions run one element at a time, they are a small part of the transform */
+                    const auto to_simd = [&](std::uint64_t *x, std::size_t plane, std::size_t i) {
+                        std::uint64_t v[limbs];
+                        params_type::to_limbs(integral_type(a[i].data), v);
+                        arithmetic.mul(v, v, params.r2);
+                        arithmetic.store(x, plane, v);
+                    };
+                    const auto from_simd = [&](const std::uint64_t *x, std::size_t plane, std::size_t i) {
+                        std::uint64_t v[limbs];
+                        arithmetic.load(v, x, plane);
+                        arithmetic.mul(v, v, c);
+                        arithmetic.reduce(v, arithmetic.neg_p);
+                        a[i] = typename FieldType::value_type(params_type::from_limbs(v));
+                    };
+
+                    if (n < basic_radix2_four_step_fft_threshold) {
+                        parallel_for(
+                            pool, 0, n,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    to_simd(buffer + i, n, i);
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+
+                        basic_radix2_simd_fft<FieldType, Ops>(buffer, n, twiddles.data(), stride, pool);
+
+                        parallel_for(
+                            pool, 0, n,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    from_simd(buffer + i, n, i);
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                        return;
+                    }
+
+                    /* a[j1 * n2 + j2] is the element (j1, j2) of the n1 x n2 matrix; limb l of the element k of
+                       the row r of the length L is at values[r * limbs * L + l * L + k] */
+                    const std::size_t logn = log2(n);
+                    const std::size_t n1 = 1ul << (logn / 2);
+                    const std::size_t n2 = n / n1;
+                    const std::size_t half = n / 2;
+                    const std::uint64_t *omega_powers = twiddles.data() + (half - 1);
+                    std::uint64_t *rows = buffer;
+                    std::uint64_t *columns = buffer + limbs * n;
+
+                    const auto row_ffts = [&](std::uint64_t *values, const std::size_t rows_count,
+                                              const std::size_t length) {
+                        parallel_for(
+                            pool, 0, rows_count,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t r = begin; r < end; ++r) {
+                                    basic_radix2_simd_fft<FieldType, Ops>(values + r * limbs * length, length,
+                                                                          twiddles.data(), stride);
+                                }
+                            },
+                            1);
+                    };
+
+                    /* columns of length n1 become contiguous rows in the layout of basic_radix2_simd_fft */
+                    basic_radix2_transpose_tiles(n1, n2, pool, [&](std::size_t i, std::size_t j) {
+                        to_simd(rows + j * limbs * n1 + i, n1, i * n2 + j);
+                    });
+                    row_ffts(rows, n2, n1);
+
+                    /* scale (j2, k1) by omega^{j2 * k1}, with omega^{n/2 + e} = -omega^e, on the way back; the
+                       values below 4p times the reduced twiddles stay below R * p */
+                    basic_radix2_transpose_tiles(n2, n1, pool, [&](std::size_t i, std::size_t j) {
+                        const std::size_t e = i * j;
+                        std::uint64_t v[limbs], w[limbs];
+                        arithmetic.load(v, rows + i * limbs * n1 + j, n1);
+                        arithmetic.load(w, omega_powers + (e < half ? e : e - half), stride);
+                        arithmetic.mul(v, v, w);
+                        if (e >= half) {
+                            /* 2p - v without borrows, as in the butterflies */
+                            for (std::size_t l = 0; l < limbs; ++l) {
+                                v[l] = arithmetic.p2_redundant[l] - v[l];
+                            }
+                            arithmetic.normalize(v);
+                        }
+                        arithmetic.store(columns + j * limbs * n2 + i, n2, v);
+                    });
+                    row_ffts(columns, n1, n2);
+
+                    /* X[k1 + n1 * k2] is the element (k1, k2) */
+                    basic_radix2_transpose_tiles(n1, n2, pool, [&](std::size_t i, std::size_t j) {
+                        from_simd(columns + i * limbs * n2 + j, n2, j * n1 + i);
+                    });
+                }
+
+                /**
+                 * Convert the table of basic_radix2_fft_twiddles to the layout and the Montgomery form of
+                 * basic_radix2_simd_fft.
+                 */
+                template<typename FieldType, typename Ops = basic_radix2_simd_ops>
+                std::vector<std::uint64_t>
+                    basic_radix2_simd_fft_twiddles(span<const typename FieldType::value_type> twiddles) {
+                    typedef typename Ops::scalar_ops scalar_ops;
+                    typedef basic_radix2_simd_params<FieldType, Ops::bits, Ops::limbs> params_type;
+
+                    constexpr std::size_t limbs = Ops::limbs;
+
+                    const params_type &params = params_type::instance();
+                    const basic_radix2_simd_arithmetic<FieldType, scalar_ops> arithmetic;
+                    const std::size_t size = twiddles.size();
+
+                    /* twiddles must be fully reduced for the bounds of the butterflies */
+                    std::vector<std::uint64_t> result(limbs * size);
+                    std::uint64_t x[limbs];
+                    for (std::size_t i = 0; i < size; ++i) {
+                        params_type::to_limbs(typename FieldType::integral_type(twiddles[i].data), x);
+                        arithmetic.mul(x, x, params.r2);
+                        arithmetic.reduce(x, arithmetic.neg_p);
+                        arithmetic.store(result.data() + i, size, x);
+                    }
+                    return result;
+                }
+#endif
+            }    // namespace detail
+        }        // namespace math
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_BASIC_RADIX2_SIMD_FFT_HPP
@@ -0,0 +1,377 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MATH_BASIC_RADIX2_WORD_FFT_HPP
+#define CRYPTO3_MATH_BASIC_RADIX2_WORD_FFT_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <boost/config.hpp>
+
+#include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+#include <nil/crypto3/math/span.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace detail {
+
+                /**
+                 * Whether basic_radix2_domain runs the FFTs over the field with basic_radix2_word_fft, in native
+                 * single-word arithmetic: the fields of at most 31 bits, e.g. BabyBear, in 32-bit words, whose
+                 * transforms take packed AVX2 lanes when compiled in, and with a 128-bit integer type the fields of
+                 * at most 64 bits, e.g. Goldilocks, in 64-bit words. Specialize it to opt a field in or out.
+                 */
+                template<typename FieldType>
+                struct basic_radix2_word_reduction
+#ifdef BOOST_HAS_INT128
+                    : std::integral_constant<bool, (FieldType::modulus_bits <= 64)> {
+#else
+                    : std::integral_constant<bool, (FieldType::modulus_bits <= 31)> {
+#endif
+                };
+
+                /**
+                 * The word of basic_radix2_word_fft for the field, with a spare bit for the 32-bit words.
+                 */
+                template<typename FieldType>
+                struct basic_radix2_word {
+                    typedef typename std::conditional<(FieldType::modulus_bits <= 31), std::uint32_t,
+                                                      std::uint64_t>::type type;
+                };
+
+                template<typename Word>
+                struct basic_radix2_wide_word;
+
+                template<>
+                struct basic_radix2_wide_word<std::uint32_t> {
+                    typedef std::uint64_t type;
+                };
+
+#ifdef BOOST_HAS_INT128
+                template<>
+                struct basic_radix2_wide_word<std::uint64_t> {
+                    typedef unsigned __int128 type;
+                };
+#endif
+
+                /**
+                 * Montgomery arithmetic modulo the modulus of the field in one word, with R = 2^bits of the word.
+                 * Values are kept fully reduced, below p.
+                 */
+                template<typename FieldType>
+                struct montgomery_word {
+                    typedef typename basic_radix2_word<FieldType>::type word_type;
+                    typedef typename basic_radix2_wide_word<word_type>::type wide_type;
+                    typedef typename FieldType::value_type value_type;
+                    typedef typename FieldType::integral_type integral_type;
+
+                    constexpr static const std::size_t bits = 8 * sizeof(word_type);
+
+                    word_type p;
+                    word_type pinv;
+                    word_type r2;
+
+                    static const montgomery_word &instance() {
+                        static const montgomery_word params;
+                        return params;
+                    }
+
+                    word_type add(word_type a, word_type b) const {
+                        const wide_type s = wide_type(a) + b;
+                        return word_type(s >= p ? s - p : s);
+                    }
+
+                    word_type sub(word_type a, word_type b) const {
+                        return a >= b ? a - b : word_type(wide_type(a) + p - b);
+                    }
+
+                    /* a * b / R mod p: the low words of a * b and m * p add up to 0 mod R, with a carry unless the
+                       first one is 0 */
+                    word_type mul(word_type a, word_type b) const {
+                        const wide_type t = wide_type(a) * b;
+                        const word_type m = word_type(t) * pinv;
+                        const wide_type u = (t >> bits) + ((wide_type(m) * p) >> bits) + (word_type(t) != 0);
+                        return word_type(u >= p ? u - p : u);
+                    }
+
+                    word_type to_montgomery(const value_type &x) const {
+                        return mul(static_cast<word_type>(integral_type(x.data)), r2);
+                    }
+
+                    /* x * c for x in the Montgomery form and c in the standard one */
+                    value_type from_montgomery(word_type x, word_type c) const {
+                        return value_type(integral_type(mul(x, c)));
+                    }
+
+                private:
+                    montgomery_word() {
+                        p = static_cast<word_type>(integral_type(FieldType::modulus));
+
+                        /* -p^{-1} mod R by Newton's iteration, each step doubles the correct low bits */
+                        word_type inv = 1;
+                        for (std::size_t i = 0; i < 6; ++i) {
+                            inv *= word_type(2) - p * inv;
+                        }
+                        pinv = word_type(~inv + 1);
+
+                        /* R^2 mod p by 2 * bits doublings of 1 */
+                        r2 = 1;
+                        for (std::size_t i = 0; i < 2 * bits; ++i) {
+                            r2 = add(r2, r2);
+                        }
+                    }
+                };
+
+#if defined(__AVX2__)
+                /*
+                 * Eight 32-bit Montgomery values per register, for the fields of at most 31 bits: the sums stay
+                 * below 2^32, so a wrapped difference is the larger one and min_epu32 takes the reduced result.
+                 */
+                struct basic_radix2_word_avx2_ops {
+                    __m256i p;
+                    __m256i pinv;
+
+                    basic_radix2_word_avx2_ops(std::uint32_t modulus, std::uint32_t modulus_inverse) :
+                        p(_mm256_set1_epi32(modulus)), pinv(_mm256_set1_epi32(modulus_inverse)) {
+                    }
+
+                    __m256i add(__m256i a, __m256i b) const {
+                        const __m256i s = _mm256_add_epi32(a, b);
+                        return _mm256_min_epu32(s, _mm256_sub_epi32(s, p));
+                    }
+
+                    __m256i sub(__m256i a, __m256i b) const {
+                        const __m256i d = _mm256_sub_epi32(a, b);
+                        return _mm256_min_epu32(d, _mm256_add_epi32(d, p));
+                    }
+
+                    /* (t + m * p) / 2^32 for the products t in the 64-bit lanes, below 2p */
+                    __m256i reduce(__m256i t) const {
+                        const __m256i m = _mm256_mul_epu32(t, pinv);
+                        return _mm256_srli_epi64(_mm256_add_epi64(t, _mm256_mul_epu32(m, p)), 32);
+                    }
+
+                    /* the even lanes, then the odd ones, are multiplied in the 64-bit lanes */
+                    __m256i mul(__m256i a, __m256i b) const {
+                        const __m256i even = reduce(_mm256_mul_epu32(a, b));
+                        const __m256i odd =
+                            reduce(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)));
+                        const __m256i u = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+                        return _mm256_min_epu32(u, _mm256_sub_epi32(u, p));
+                    }
+                };
+
+                /* butterflies of the half-size m for j in [j0, j1), by eight while there are so many */
+                template<typename Montgomery>
+                std::size_t basic_radix2_word_butterflies(std::uint32_t *x, std::uint32_t *y, const std::uint32_t *w,
+                                                          std::size_t j0, std::size_t j1, const Montgomery &mont) {
+                    const basic_radix2_word_avx2_ops ops(mont.p, mont.pinv);
+                    std::size_t j = j0;
+                    for (; j + 8 <= j1; j += 8) {
+                        const __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + j));
+                        const __m256i v = ops.mul(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + j)),
+                                                  _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + j)));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + j), ops.add(u, v));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(y + j), ops.sub(u, v));
+                    }
+                    return j;
+                }
+#endif
+
+                template<typename Word, typename Montgomery>
+                std::size_t basic_radix2_word_butterflies(Word *, Word *, const Word *, std::size_t j0, std::size_t,
+                                                          const Montgomery &) {
+                    return j0;
+                }
+
+                /**
+                 * Same as basic_radix2_fft_cached over the values and the twiddles table of
+                 * basic_radix2_word_fft_twiddles in the Montgomery form of montgomery_word.
+                 */
+                template<typename FieldType>
+                void basic_radix2_word_fft(typename montgomery_word<FieldType>::word_type *a, const std::size_t n,
+                                           const typename montgomery_word<FieldType>::word_type *twiddles,
+                                           thread_pool *pool = nullptr) {
+                    typedef montgomery_word<FieldType> montgomery_type;
+                    typedef typename montgomery_type::word_type word_type;
+
+                    const montgomery_type &mont = montgomery_type::instance();
+                    const std::size_t logn = log2(n);
+
+                    parallel_for(
+                        pool, 0, n,
+                        [a, logn](std::size_t begin, std::size_t end) {
+                            basic_radix2_bitreverse(a, logn, begin, end);
+                        },
+                        basic_radix2_fft_grain_size);
+
+                    for (std::size_t m = 1; m < n; m *= 2) {
+                        const word_type *w = twiddles + (m - 1);
+
+                        parallel_for(
+                            pool, 0, n / 2,
+                            [a, w, m, &mont](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end;) {
+                                    const std::size_t j0 = i & (m - 1);
+                                    const std::size_t k = 2 * (i - j0);
+                                    const std::size_t j1 = std::min(m, j0 + (end - i));
+
+                                    word_type *x = a + k, *y = a + k + m;
+                                    for (std::size_t j = basic_radix2_word_butterflies(x, y, w, j0, j1, mont); j < j1;
+                                         ++j) {
+                                        const word_type t = mont.mul(y[j], w[j]);
+                                        y[j] = mont.sub(x[j], t);
+                                        x[j] = mont.add(x[j], t);
+                                    }
+                                    i += j1 - j0;
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                    }
+                }
+
+                /**
+                 * Number of the words basic_radix2_word_fft keeps for n values: from
+                 * basic_radix2_four_step_fft_threshold, the transposes of the four-step decomposition go through
+                 * two of them.
+                 */
+                constexpr std::size_t basic_radix2_word_fft_buffer_size(const std::size_t n) {
+                    return n >= basic_radix2_four_step_fft_threshold ? 2 * n : n;
+                }
+
+                /**
+                 * Run basic_radix2_word_fft over the values of a, converting them to the Montgomery form and back, with
+                 * the output multiplied by scale: 1/n for an inverse transform, one for a forward one. The Montgomery
+                 * forms are kept in the caller's buffer of basic_radix2_word_fft_buffer_size(a.size()) words. From
+                 * basic_radix2_four_step_fft_threshold, the transform is the one of basic_radix2_four_step_fft with the
+                 * word butterflies in the FFTs of the rows, and the conversions are fused into its first and last
+                 * transposes.
+                 */
+                template<typename FieldType, typename Range>
+                void basic_radix2_word_fft(Range &a,
+                                           const std::vector<typename montgomery_word<FieldType>::word_type> &twiddles,
+                                           const typename FieldType::value_type &scale,
+                                           typename montgomery_word<FieldType>::word_type *buffer,
+                                           thread_pool *pool = nullptr) {
+                    typedef montgomery_word<FieldType> montgomery_type;
+                    typedef typename montgomery_type::word_type word_type;
+
+                    const montgomery_type &mont = montgomery_type::instance();
+                    const word_type c = static_cast<word_type>(typename FieldType::integral_type(scale.data));
+                    const std::size_t n = a.size();
+
+                    if (n < basic_radix2_four_step_fft_threshold) {
+                        parallel_for(
+                            pool, 0, n,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    buffer[i] = mont.to_montgomery(a[i]);
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+
+                        basic_radix2_word_fft<FieldType>(buffer, n, twiddles.data(), pool);
+
+                        parallel_for(
+                            pool, 0, n,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    a[i] = mont.from_montgomery(buffer[i], c);
+                                }
+                            },
+                            basic_radix2_fft_grain_size);
+                        return;
+                    }
+
+                    /* a[j1 * n2 + j2] is the element (j1, j2) of the n1 x n2 matrix */
+                    const std::size_t logn = log2(n);
+                    const std::size_t n1 = 1ul << (logn / 2);
+                    const std::size_t n2 = n / n1;
+                    const std::size_t half = n / 2;
+                    const word_type *omega_powers = twiddles.data() + (half - 1);
+                    word_type *rows = buffer;
+                    word_type *columns = buffer + n;
+
+                    const auto row_ffts = [&](word_type *values, const std::size_t rows_count,
+                                              const std::size_t length) {
+                        parallel_for(
+                            pool, 0, rows_count,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t r = begin; r < end; ++r) {
+                                    basic_radix2_word_fft<FieldType>(values + r * length, length, twiddles.data());
+                                }
+                            },
+                            1);
+                    };
+
+                    /* columns of length n1 become contiguous rows in the Montgomery form */
+                    basic_radix2_transpose_tiles(n1, n2, pool, [&](std::size_t i, std::size_t j) {
+                        rows[j * n1 + i] = mont.to_montgomery(a[i * n2 + j]);
+                    });
+                    row_ffts(rows, n2, n1);
+
+                    /* scale (j2, k1) by omega^{j2 * k1}, with omega^{n/2 + e} = -omega^e, on the way back */
+                    basic_radix2_transpose_tiles(n2, n1, pool, [&](std::size_t i, std::size_t j) {
+                        const std::size_t e = i * j;
+                        const word_type x = rows[i * n1 + j];
+                        columns[j * n2 + i] = e < half ? mont.mul(x, omega_powers[e]) :
+                                                         mont.sub(0, mont.mul(x, omega_powers[e - half]));
+                    });
+                    row_ffts(columns, n1, n2);
+
+                    /* X[k1 + n1 * k2] is the element (k1, k2) */
+                    basic_radix2_transpose_tiles(n1, n2, pool, [&](std::size_t i, std::size_t j) {
+                        a[j * n1 + i] = mont.from_montgomery(columns[i * n2 + j], c);
+                    });
+                }
+
+                /**
+                 * Convert the table of basic_radix2_fft_twiddles to the Montgomery form for basic_radix2_word_fft.
+                 */
+                template<typename FieldType>
+                std::vector<typename montgomery_word<FieldType>::word_type>
+                    basic_radix2_word_fft_twiddles(span<const typename FieldType::value_type> twiddles) {
+                    typedef montgomery_word<FieldType> montgomery_type;
+
+                    const montgomery_type &mont = montgomery_type::instance();
+
+                    std::vector<typename montgomery_type::word_type> result(twiddles.size());
+                    for (std::size_t i = 0; i < twiddles.size(); ++i) {
+                        result[i] = mont.to_montgomery(twiddles[i]);
+                    }
+                    return result;
+                }
+            }    // namespace detail
+        }        // namespace math
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_BASIC_RADIX2_WORD_FFT_HPP
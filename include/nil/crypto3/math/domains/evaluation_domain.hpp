@@ -26,14 +26,112 @@
 #ifndef CRYPTO3_MATH_EVALUATION_DOMAIN_HPP
 #define CRYPTO3_MATH_EVALUATION_DOMAIN_HPP
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include <nil/crypto3/multiprecision/integer.hpp>
 
+#include <nil/crypto3/math/arena.hpp>
+#include <nil/crypto3/math/coset.hpp>
+#include <nil/crypto3/math/instrumentation.hpp>
+#include <nil/crypto3/math/span.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace math {
 
+            namespace detail {
+                /**
+                 * Least number of points per chunk when the evaluations on a coset are split between threads.
+                 */
+                constexpr std::size_t coset_evaluation_grain_size = 1ul << 10;
+            }    // namespace detail
+
+            /**
+             * Caller-owned scratch memory for the transforms of evaluation domains. The buffers grow to the largest
+             * size a transform has asked for and keep their memory, so the repeated transforms of a domain with the
+             * same workspace make no allocations of their own. A workspace may serve domains of different sizes, but
+             * not concurrent transforms. A workspace made within an arena::scope takes its memory from that arena.
+             */
+            template<typename FieldType>
+            class evaluation_domain_workspace {
+                typedef typename FieldType::value_type value_type;
+
+            public:
+                typedef detail::scratch_vector<value_type> buffer_type;
+                typedef detail::scratch_vector<std::uint64_t> words_type;
+
+                constexpr static std::size_t buffers_count = 4;
+
+                /**
+                 * The buffer with the given index resized to n elements. Its contents are unspecified.
+                 */
+                buffer_type &buffer(std::size_t index, std::size_t n) {
+                    if (index >= buffers_count)
+                        throw std::invalid_argument("evaluation_domain_workspace: expected index < buffers_count");
+
+                    buffers[index].resize(n);
+                    return buffers[index];
+                }
+
+                /**
+                 * Number of field elements the buffers hold memory for.
+                 */
+                std::size_t capacity() const {
+                    std::size_t result = 0;
+                    for (const buffer_type &b : buffers) {
+                        result += b.capacity();
+                    }
+                    return result;
+                }
+
+                /**
+                 * The word buffer with the given index as the storage of n objects of the trivially copyable type T,
+                 * e.g. the field elements in the Montgomery form of the FFT kernels. Its contents are unspecified.
+                 */
+                template<typename T>
+                T *words(std::size_t index, std::size_t n) {
+                    static_assert(std::is_trivially_copyable<T>::value, "expected a trivially copyable type");
+                    static_assert(alignof(T) <= alignof(std::uint64_t), "expected the alignment of at most 8 bytes");
+
+                    if (index >= buffers_count)
+                        throw std::invalid_argument("evaluation_domain_workspace: expected index < buffers_count");
+
+                    word_buffers[index].resize((n * sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+                    return reinterpret_cast<T *>(word_buffers[index].data());
+                }
+
+                /**
+                 * Number of 64-bit words the word buffers hold memory for.
+                 */
+                std::size_t words_capacity() const {
+                    std::size_t result = 0;
+                    for (const words_type &b : word_buffers) {
+                        result += b.capacity();
+                    }
+                    return result;
+                }
+
+                /**
+                 * Number of bytes the buffers and the word buffers hold memory for.
+                 */
+                std::size_t bytes() const {
+                    return capacity() * sizeof(typename buffer_type::value_type) +
+                           words_capacity() * sizeof(typename words_type::value_type);
+                }
+
+            private:
+                std::array<buffer_type, buffers_count> buffers;
+                std::array<words_type, buffers_count> word_buffers;
+            };
+
             /**
              * An evaluation domain.
              */
@@ -44,6 +142,7 @@ namespace nil {
 
             public:
                 typedef FieldType field_type;
+                typedef evaluation_domain_workspace<FieldType> workspace_type;
 
                 value_type root;
                 value_type root_inverse;
@@ -61,12 +160,34 @@ namespace nil {
                  *
                  * (See the function get_evaluation_domain below.)
                  */
-                evaluation_domain(const std::size_t m) : m(m), log2_size(multiprecision::msb(m)) {};
+                evaluation_domain(const std::size_t m) :
+                    m(m), log2_size(multiprecision::msb(m)), pool(thread_pool::global()) {};
+
+                virtual ~evaluation_domain() = default;
 
                 inline std::size_t size() const {
                     return m;
                 }
 
+                /**
+                 * Run the transforms of the domain on the given pool. An empty pointer makes them serial.
+                 * Defaults to thread_pool::global() at the moment of construction.
+                 */
+                void set_thread_pool(const std::shared_ptr<thread_pool> &p) {
+                    pool = p;
+                }
+
+                inline thread_pool *get_thread_pool() const {
+                    return pool.get();
+                }
+
+                /**
+                 * Build the tables the transforms of the domain use, if it has any. Transforms call it on their first
+                 * use; calling it from several threads sharing the domain is safe.
+                 */
+                virtual void precompute() {
+                }
+
                 /**
                  * Get the idx-th element in S.
                  */
@@ -82,6 +203,134 @@ namespace nil {
                  */
                 virtual void inverse_fft(std::vector<value_type> &a) = 0;
 
+                /**
+                 * Same as fft(a), but with the scratch memory taken from the workspace.
+                 */
+                virtual void fft(std::vector<value_type> &a, workspace_type &) {
+                    fft(a);
+                }
+
+                /**
+                 * Same as inverse_fft(a), but with the scratch memory taken from the workspace.
+                 */
+                virtual void inverse_fft(std::vector<value_type> &a, workspace_type &) {
+                    inverse_fft(a);
+                }
+
+                /**
+                 * Compute the FFT, over the domain S, of the m values a views, in place. Unlike the std::vector
+                 * overloads, a is not padded: its size must be m.
+                 */
+                void fft(span<value_type> a) {
+                    workspace_type workspace;
+                    fft(a, workspace);
+                }
+
+                /**
+                 * Compute the inverse FFT, over the domain S, of the m values a views, in place.
+                 */
+                void inverse_fft(span<value_type> a) {
+                    workspace_type workspace;
+                    inverse_fft(a, workspace);
+                }
+
+                /**
+                 * Same as fft(a), but with the scratch memory taken from the workspace. Domains which do not
+                 * override it run the transform on a copy of the values.
+                 */
+                virtual void fft(span<value_type> a, workspace_type &workspace) {
+                    through_vector(a, [this, &workspace](std::vector<value_type> &v) { fft(v, workspace); });
+                }
+
+                /**
+                 * Same as inverse_fft(a), but with the scratch memory taken from the workspace.
+                 */
+                virtual void inverse_fft(span<value_type> a, workspace_type &workspace) {
+                    through_vector(a, [this, &workspace](std::vector<value_type> &v) { inverse_fft(v, workspace); });
+                }
+
+                /**
+                 * Number of field elements the transforms of the domain take from a workspace.
+                 */
+                virtual std::size_t workspace_size() const {
+                    return 0;
+                }
+
+                /**
+                 * Number of 64-bit words the transforms of the domain take from the word buffers of a workspace.
+                 */
+                virtual std::size_t workspace_words_size() const {
+                    return 0;
+                }
+
+                /**
+                 * Compute the FFT, over the coset g * S, of the vector a, i.e. evaluate it at g * S.
+                 */
+                virtual void coset_fft(std::vector<value_type> &a, const value_type &g) {
+                    workspace_type workspace;
+                    coset_fft(a, g, workspace);
+                }
+
+                /**
+                 * Compute the inverse FFT, over the coset g * S, of the vector a, i.e. interpolate the values at
+                 * g * S.
+                 */
+                virtual void coset_inverse_fft(std::vector<value_type> &a, const value_type &g) {
+                    workspace_type workspace;
+                    coset_inverse_fft(a, g, workspace);
+                }
+
+                /**
+                 * Same as coset_fft(a, g), but with the scratch memory taken from the workspace.
+                 */
+                virtual void coset_fft(std::vector<value_type> &a, const value_type &g, workspace_type &workspace) {
+                    multiply_by_coset(a, g);
+                    fft(a, workspace);
+                }
+
+                /**
+                 * Same as coset_inverse_fft(a, g), but with the scratch memory taken from the workspace.
+                 */
+                virtual void coset_inverse_fft(std::vector<value_type> &a, const value_type &g,
+                                               workspace_type &workspace) {
+                    inverse_fft(a, workspace);
+                    multiply_by_coset(a, g.inversed());
+                }
+
+                /**
+                 * Compute the FFT, over the domain S, of each of the vectors in columns.
+                 */
+                virtual void fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    for (std::vector<value_type> &a : columns) {
+                        fft(a);
+                    }
+                }
+
+                /**
+                 * Compute the FFT, over the domain S, of each of the data.size() / m consecutive columns of size m
+                 * stored in data.
+                 */
+                virtual void fft_batch(std::vector<value_type> &data) {
+                    batch_by_columns(data, [this](std::vector<value_type> &a) { fft(a); });
+                }
+
+                /**
+                 * Compute the inverse FFT, over the domain S, of each of the vectors in columns.
+                 */
+                virtual void inverse_fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    for (std::vector<value_type> &a : columns) {
+                        inverse_fft(a);
+                    }
+                }
+
+                /**
+                 * Compute the inverse FFT, over the domain S, of each of the data.size() / m consecutive columns of
+                 * size m stored in data.
+                 */
+                virtual void inverse_fft_batch(std::vector<value_type> &data) {
+                    batch_by_columns(data, [this](std::vector<value_type> &a) { inverse_fft(a); });
+                }
+
                 /**
                  * Evaluate all Lagrange polynomials.
                  *
@@ -108,12 +357,174 @@ namespace nil {
                  */
                 virtual void divide_by_z_on_coset(std::vector<value_type> &P) = 0;
 
+                /**
+                 * Same as add_poly_z(coeff, H) for the m + 1 coefficients H views.
+                 */
+                virtual void add_poly_z(const value_type &coeff, span<value_type> H) {
+                    if (H.size() != m + 1)
+                        throw std::invalid_argument("evaluation_domain: expected H.size() == m + 1");
+
+                    std::vector<value_type> v(H.begin(), H.end());
+                    add_poly_z(coeff, v);
+                    std::copy(v.begin(), v.end(), H.begin());
+                }
+
+                /**
+                 * Same as divide_by_z_on_coset(P) for the m values P views.
+                 */
+                virtual void divide_by_z_on_coset(span<value_type> P) {
+                    through_vector(P, [this](std::vector<value_type> &v) { divide_by_z_on_coset(v); });
+                }
+
+                /**
+                 * Evaluate the vanishing polynomial of S at the points coset * w^j, j < n, of the coset of the
+                 * subgroup of the power of two size n, w = unity_root(n), e.g. on the extended coset of a quotient.
+                 * Domains which do not override it evaluate compute_vanishing_polynomial at each of the points.
+                 */
+                virtual std::vector<value_type> compute_vanishing_polynomial_on_coset(const value_type &coset,
+                                                                                      std::size_t n) {
+                    const std::vector<value_type> x = coset_power(coset, n, 1);
+
+                    std::vector<value_type> result(n);
+                    detail::parallel_for(
+                        get_thread_pool(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; ++j) {
+                                result[j] = compute_vanishing_polynomial(x[j]);
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+                    return result;
+                }
+
+                /**
+                 * Evaluate the Lagrange polynomial L_i of S at the points of the coset of the power of two size n
+                 * as compute_vanishing_polynomial_on_coset does: L_i = Z(x) / (Z'(x_i) (x - x_i)).
+                 */
+                virtual std::vector<value_type> evaluate_lagrange_polynomial_on_coset(std::size_t i,
+                                                                                      const value_type &coset,
+                                                                                      std::size_t n) {
+                    if (i >= m)
+                        throw std::invalid_argument("evaluation_domain: expected i < m");
+
+                    const value_type x_i = get_domain_element(i);
+                    value_type derivative = value_type::one();
+                    for (std::size_t j = 0; j < m; ++j) {
+                        if (j != i) {
+                            derivative *= x_i - get_domain_element(j);
+                        }
+                    }
+
+                    return lagrange_on_coset(compute_vanishing_polynomial_on_coset(coset, n), x_i,
+                                             derivative.inversed(), coset, n);
+                }
+
                 bool operator==(const evaluation_domain &rhs) const {
                     return root == rhs.root && root_inverse == rhs.root_inverse && domain == rhs.domain &&
                            domain_inverse == rhs.domain_inverse && generator == rhs.generator &&
                            generator_inverse == rhs.generator_inverse && m == rhs.m && log2_size == rhs.log2_size &&
                            generator_size == rhs.generator_size;
                 }
+
+            protected:
+                /*
+                 * The values of x^e at the points coset * w^j of the coset of the power of two size n: w^e is of the
+                 * order n / gcd(n, e), so only its first period is computed and then repeated.
+                 */
+                std::vector<value_type> coset_power(const value_type &coset, std::size_t n, std::size_t e) {
+                    if (n == 0 || (n & (n - 1)) != 0)
+                        throw std::invalid_argument("evaluation_domain: expected a power of two coset size");
+
+                    const std::size_t period = e == 0 ? 1 : n / std::min(n, e & (~e + 1));
+                    const value_type step = unity_root<FieldType>(n).pow(e);
+                    const value_type start = coset.pow(e);
+
+                    std::vector<value_type> result(n);
+                    detail::parallel_for(
+                        get_thread_pool(), 0, period,
+                        [&](std::size_t begin, std::size_t end) {
+                            value_type x = start * step.pow(begin);
+                            for (std::size_t j = begin; j < end; ++j) {
+                                result[j] = x;
+                                x *= step;
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+                    detail::parallel_for(
+                        get_thread_pool(), period, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; ++j) {
+                                result[j] = result[j % period];
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+                    return result;
+                }
+
+                /*
+                 * scale * z / (x - x_i) at the points of the coset, with the values of x - x_i inverted in one batch,
+                 * for the values z of the vanishing polynomial; 1 at x_i itself, if the coset has it
+                 */
+                std::vector<value_type> lagrange_on_coset(std::vector<value_type> z, const value_type &x_i,
+                                                          const value_type &scale, const value_type &coset,
+                                                          std::size_t n) {
+                    std::vector<value_type> d = coset_power(coset, n, 1);
+
+                    /* the points are distinct, so at most one of them is x_i */
+                    std::size_t at_x_i = n;
+                    detail::parallel_for(
+                        get_thread_pool(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; ++j) {
+                                d[j] -= x_i;
+                                if (d[j].is_zero()) {
+                                    d[j] = value_type::one();
+                                    at_x_i = j;
+                                }
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+
+                    batch_inverse(d, get_thread_pool());
+
+                    detail::parallel_for(
+                        get_thread_pool(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; ++j) {
+                                z[j] *= scale * d[j];
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+                    if (at_x_i < n) {
+                        z[at_x_i] = value_type::one();
+                    }
+                    return z;
+                }
+
+                template<typename Transform>
+                void through_vector(span<value_type> a, Transform transform) {
+                    if (a.size() != m)
+                        throw std::invalid_argument("evaluation_domain: expected a.size() == m");
+
+                    std::vector<value_type> v(a.begin(), a.end());
+                    transform(v);
+                    std::copy(v.begin(), v.end(), a.begin());
+                }
+
+                template<typename Transform>
+                void batch_by_columns(std::vector<value_type> &data, Transform transform) {
+                    if (data.size() % m != 0)
+                        throw std::invalid_argument("evaluation_domain: expected data.size() to be a multiple of m");
+
+                    std::vector<value_type> column(m);
+                    for (auto it = data.begin(); it != data.end(); it += m) {
+                        column.assign(it, it + m);
+                        transform(column);
+                        std::copy(column.begin(), column.end(), it);
+                    }
+                }
+
+                std::shared_ptr<thread_pool> pool;
             };
         }    // namespace math
     }        // namespace crypto3
@@ -26,6 +26,7 @@
 #ifndef CRYPTO3_MATH_EXTENDED_RADIX2_DOMAIN_HPP
 #define CRYPTO3_MATH_EXTENDED_RADIX2_DOMAIN_HPP
 
+#include <mutex>
 #include <vector>
 
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
@@ -47,10 +48,55 @@ namespace nil {
 
             public:
                 typedef FieldType field_type;
+                typedef typename evaluation_domain<FieldType>::workspace_type workspace_type;
+
+                using evaluation_domain<FieldType>::fft;
+                using evaluation_domain<FieldType>::inverse_fft;
+                using evaluation_domain<FieldType>::add_poly_z;
+                using evaluation_domain<FieldType>::divide_by_z_on_coset;
 
                 std::size_t small_m;
                 value_type omega;
                 value_type shift;
+                value_type shift_to_small_m;
+                /* the scale of inverse_fft, (small_m * (1 - shift^small_m))^{-1} */
+                value_type sconst;
+
+                std::once_flag precomputation_flag;
+
+                /* the twiddles of the two transforms of the size small_m, and shift^i and sconst * shift^{-i} for
+                   i < small_m */
+                std::vector<value_type> fft_cache;
+                std::vector<value_type> inverse_fft_cache;
+                std::vector<value_type> shift_powers;
+                std::vector<value_type> inverse_shift_powers;
+
+                void do_precomputation() {
+                    fft_cache = detail::basic_radix2_fft_twiddles<FieldType>(small_m, omega);
+                    inverse_fft_cache = detail::basic_radix2_fft_twiddles<FieldType>(small_m, omega.inversed());
+
+                    shift_powers.resize(small_m);
+                    inverse_shift_powers.resize(small_m);
+                    const value_type shift_inverse = shift.inversed();
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, small_m,
+                        [&](std::size_t begin, std::size_t end) {
+                            value_type shift_i = shift.pow(begin);
+                            value_type shift_inverse_i = sconst * shift_inverse.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                shift_powers[i] = shift_i;
+                                inverse_shift_powers[i] = shift_inverse_i;
+
+                                shift_i *= shift;
+                                shift_inverse_i *= shift_inverse;
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                }
+
+                void precompute() {
+                    std::call_once(precomputation_flag, [this]() { do_precomputation(); });
+                }
 
                 extended_radix2_domain(const std::size_t m) : evaluation_domain<FieldType>(m) {
                     if (m <= 1)
@@ -68,9 +114,17 @@ namespace nil {
                     omega = unity_root<FieldType>(small_m);
 
                     shift = detail::coset_shift<FieldType>();
+
+                    shift_to_small_m = shift.pow(small_m);
+                    sconst = (value_type(small_m) * (value_type::one() - shift_to_small_m)).inversed();
                 }
 
                 void fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    fft(a, workspace);
+                }
+
+                void fft(std::vector<value_type> &a, workspace_type &workspace) {
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -79,29 +133,41 @@ namespace nil {
                         }
                     }
 
-                    std::vector<value_type> a0(small_m, value_type::zero());
-                    std::vector<value_type> a1(small_m, value_type::zero());
-
-                    const value_type shift_to_small_m = shift.pow(small_m);
-
-                    value_type shift_i = value_type::one();
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        a0[i] = a[i] + a[small_m + i];
-                        a1[i] = shift_i * (a[i] + shift_to_small_m * a[small_m + i]);
-
-                        shift_i *= shift;
-                    }
-
-                    detail::basic_radix2_fft<FieldType>(a0, omega);
-                    detail::basic_radix2_fft<FieldType>(a1, omega);
+                    fft(span<value_type>(a), workspace);
+                }
 
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        a[i] = a0[i];
-                        a[i + small_m] = a1[i];
-                    }
+                /*
+                 * The halves of a take the two polynomials of the size small_m whose transforms are those over the
+                 * subgroup and over its coset by shift, and then the transforms in place.
+                 */
+                void fft(span<value_type> a, workspace_type &) {
+                    CRYPTO3_MATH_INSTRUMENT("extended_radix2_domain::fft", this->m, 0);
+
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("extended_radix2: expected a.size() == this->m");
+
+                    precompute();
+
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, small_m,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                const value_type x = a[i], y = a[small_m + i];
+                                a[i] = x + y;
+                                a[small_m + i] = shift_powers[i] * (x + shift_to_small_m * y);
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+
+                    halves_fft(a, fft_cache);
                 }
 
                 void inverse_fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    inverse_fft(a, workspace);
+                }
+
+                void inverse_fft(std::vector<value_type> &a, workspace_type &workspace) {
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -110,26 +176,34 @@ namespace nil {
                         }
                     }
 
-                    // note: this is not in-place
-                    std::vector<value_type> a0(a.begin(), a.begin() + small_m);
-                    std::vector<value_type> a1(a.begin() + small_m, a.end());
+                    inverse_fft(span<value_type>(a), workspace);
+                }
 
-                    const value_type omega_inverse = omega.inversed();
-                    detail::basic_radix2_fft<FieldType>(a0, omega_inverse);
-                    detail::basic_radix2_fft<FieldType>(a1, omega_inverse);
+                void inverse_fft(span<value_type> a, workspace_type &) {
+                    CRYPTO3_MATH_INSTRUMENT("extended_radix2_domain::inverse_fft", this->m, 0);
 
-                    const value_type shift_to_small_m = shift.pow(small_m);
-                    const value_type sconst = (value_type(small_m) * (value_type::one() - shift_to_small_m)).inversed();
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("extended_radix2: expected a.size() == this->m");
 
-                    const value_type shift_inverse = shift.inversed();
-                    value_type shift_inverse_i = value_type::one();
+                    precompute();
 
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        a[i] = sconst * (-shift_to_small_m * a0[i] + shift_inverse_i * a1[i]);
-                        a[i + small_m] = sconst * (a0[i] - shift_inverse_i * a1[i]);
+                    halves_fft(a, inverse_fft_cache);
 
-                        shift_inverse_i *= shift_inverse;
-                    }
+                    const value_type sconst_shift_to_small_m = sconst * shift_to_small_m;
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, small_m,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                const value_type x = a[i], y = inverse_shift_powers[i] * a[small_m + i];
+                                a[i] = y - sconst_shift_to_small_m * x;
+                                a[small_m + i] = sconst * x - y;
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                }
+
+                std::size_t workspace_size() const {
+                    return 0;
                 }
 
                 std::vector<value_type> evaluate_all_lagrange_polynomials(const value_type &t) {
@@ -142,7 +216,6 @@ namespace nil {
                     std::vector<value_type> result(this->m, value_type::zero());
 
                     const value_type t_to_small_m = t.pow(small_m);
-                    const value_type shift_to_small_m = shift.pow(small_m);
                     const value_type one_over_denom = (shift_to_small_m - value_type::one()).inversed();
                     const value_type T0_coeff = (t_to_small_m - shift_to_small_m) * (-one_over_denom);
                     const value_type T1_coeff = (t_to_small_m - value_type::one()) * one_over_denom;
@@ -166,23 +239,41 @@ namespace nil {
                     return (t.pow(small_m) - value_type::one()) * (t.pow(small_m) - shift.pow(small_m));
                 }
 
+                std::vector<value_type> compute_vanishing_polynomial_on_coset(const value_type &coset,
+                                                                              std::size_t n) override {
+                    std::vector<value_type> result = this->coset_power(coset, n, small_m);
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; ++j) {
+                                result[j] = (result[j] - value_type::one()) * (result[j] - shift_to_small_m);
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+                    return result;
+                }
+
                 void add_poly_z(const value_type &coeff, std::vector<value_type> &H) {
+                    add_poly_z(coeff, span<value_type>(H));
+                }
+
+                void add_poly_z(const value_type &coeff, span<value_type> H) {
                     // if (H.size() != this->m + 1)
                     //    throw std::invalid_argument("extended_radix2: expected H.size() == this->m+1");
 
-                    const value_type shift_to_small_m = shift.pow(small_m);
-
                     H[this->m] += coeff;
                     H[small_m] -= coeff * (shift_to_small_m + value_type::one());
                     H[0] += coeff * shift_to_small_m;
                 }
 
                 void divide_by_z_on_coset(std::vector<value_type> &P) {
+                    divide_by_z_on_coset(span<value_type>(P));
+                }
+
+                void divide_by_z_on_coset(span<value_type> P) {
                     const value_type coset = fields::arithmetic_params<FieldType>::multiplicative_generator;
 
                     const value_type coset_to_small_m = coset.pow(small_m);
-                    const value_type shift_to_small_m = shift.pow(small_m);
-
                     const value_type Z0 =
                         (coset_to_small_m - value_type::one()) * (coset_to_small_m - shift_to_small_m);
                     const value_type Z1 = (coset_to_small_m * shift_to_small_m - value_type::one()) *
@@ -196,6 +287,21 @@ namespace nil {
                         P[i + small_m] *= Z1_inverse;
                     }
                 }
+
+            private:
+                /* the transforms of both halves of a with the twiddles, side by side when there is a thread pool */
+                void halves_fft(span<value_type> a, const std::vector<value_type> &twiddles) {
+                    thread_pool *pool = this->get_thread_pool();
+                    detail::parallel_for(
+                        pool, 0, 2,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t h = begin; h < end; ++h) {
+                                detail::basic_radix4_fft_cached<FieldType>(a.data() + h * small_m, small_m,
+                                                                           twiddles.data(), pool);
+                            }
+                        },
+                        1);
+                }
             };
         }    // namespace math
     }        // namespace crypto3
@@ -26,11 +26,16 @@
 #ifndef CRYPTO3_MATH_GEOMETRIC_SEQUENCE_DOMAIN_HPP
 #define CRYPTO3_MATH_GEOMETRIC_SEQUENCE_DOMAIN_HPP
 
+#include <algorithm>
+#include <mutex>
 #include <vector>
 
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
 
-#include <nil/crypto3/math/polynomial/basis_change.hpp>
+#include <nil/crypto3/math/polynomial/basic_operations.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -47,28 +52,117 @@ namespace nil {
 
             public:
                 typedef FieldType field_type;
+                typedef typename evaluation_domain<FieldType>::workspace_type workspace_type;
+
+                using evaluation_domain<FieldType>::fft;
+                using evaluation_domain<FieldType>::inverse_fft;
+                using evaluation_domain<FieldType>::add_poly_z;
+                using evaluation_domain<FieldType>::divide_by_z_on_coset;
 
                 bool precomputation_sentinel;
+                std::once_flag precomputation_flag;
                 std::vector<value_type> geometric_sequence;
                 std::vector<value_type> geometric_triangular_sequence;
 
+                /*
+                 * With g the generator, T(k) = k (k - 1) / 2 and ij = T(i + j) - T(i) - T(j), the transform is the
+                 * chirp-z one: A(g^i) = g^{-T(i)} sum_j a_j g^{-T(j)} g^{T(i + j)}. The inverse takes the transform of
+                 * c_i = y_i / M'(g^i), e_d = sum_i c_i g^{id}, and sums a_k = sum_d M_{k + 1 + d} e_d with the
+                 * coefficients of M = prod_j (x - g^j) of the q-binomial theorem. These are two convolutions with
+                 * kernels that depend on the domain only: g^{T(k)} for k < 2m - 1, and M_{m - t} for t < m. They
+                 * are kept transformed over the subgroup of the size chirp_size, already multiplied by
+                 * 1 / chirp_size, if the field has one, or as coefficients for multiplication otherwise.
+                 */
+                std::size_t chirp_size;
+                bool chirp_fft_available;
+                std::vector<value_type> chirp_kernel;
+                std::vector<value_type> vanishing_kernel;
+                std::vector<value_type> chirp_fft_twiddles;
+                std::vector<value_type> chirp_inverse_fft_twiddles;
+
+                /* g^{-T(i)}, and g^{-T(i)} / M'(g^i) */
+                std::vector<value_type> geometric_triangular_sequence_inverse;
+                std::vector<value_type> inverse_fft_scale;
+
                 void do_precomputation() {
-                    geometric_sequence = std::vector<value_type>(this->m, value_type::zero());
+                    const std::size_t m = this->m;
+
+                    /* g^{T(k)} for k < 2m - 1, of which geometric_triangular_sequence is the first m */
+                    chirp_kernel = std::vector<value_type>(2 * m - 1);
+                    chirp_kernel[0] = value_type::one();
+                    geometric_sequence = std::vector<value_type>(m, value_type::zero());
                     geometric_sequence[0] = value_type::one();
 
-                    geometric_triangular_sequence = std::vector<value_type>(this->m, value_type::zero());
-                    geometric_triangular_sequence[0] = value_type::one();
+                    const value_type generator = fields::arithmetic_params<FieldType>::geometric_generator;
+                    value_type generator_k = value_type::one();
+                    for (std::size_t k = 1; k < 2 * m - 1; k++) {
+                        chirp_kernel[k] = chirp_kernel[k - 1] * generator_k;
+                        generator_k *= generator;
+                        if (k < m) {
+                            geometric_sequence[k] = generator_k;
+                        }
+                    }
+                    geometric_triangular_sequence.assign(chirp_kernel.begin(), chirp_kernel.begin() + m);
+
+                    geometric_triangular_sequence_inverse = geometric_triangular_sequence;
+                    batch_inverse(geometric_triangular_sequence_inverse, this->get_thread_pool());
 
-                    for (std::size_t i = 1; i < this->m; i++) {
-                        geometric_sequence[i] =
-                            geometric_sequence[i - 1] * fields::arithmetic_params<FieldType>::geometric_generator;
-                        geometric_triangular_sequence[i] =
-                            geometric_triangular_sequence[i - 1] * geometric_sequence[i - 1];
+                    /* P_i = prod_{1 <= l <= i} (g^l - 1) for i <= m */
+                    std::vector<value_type> products(m + 1);
+                    products[0] = value_type::one();
+                    for (std::size_t i = 1; i < m; i++) {
+                        products[i] = products[i - 1] * (geometric_sequence[i] - value_type::one());
+                    }
+                    products[m] = products[m - 1] * (geometric_sequence[m - 1] * generator - value_type::one());
+
+                    std::vector<value_type> products_inverse(products.begin(), products.begin() + m);
+                    batch_inverse(products_inverse, this->get_thread_pool());
+
+                    /*
+                     * M'(g^i) = g^{T(i) + i (m - 1 - i)} (-1)^{m - 1 - i} P_i P_{m - 1 - i}, and
+                     * i (m - 1 - i) = T(m - 1) - T(i) - T(m - 1 - i)
+                     */
+                    inverse_fft_scale = std::vector<value_type>(m);
+                    for (std::size_t i = 0; i < m; i++) {
+                        inverse_fft_scale[i] = geometric_triangular_sequence_inverse[m - 1] *
+                                               geometric_triangular_sequence[m - 1 - i] *
+                                               geometric_triangular_sequence_inverse[i] * products_inverse[i] *
+                                               products_inverse[m - 1 - i];
+                        if ((m - 1 - i) % 2 == 1)
+                            inverse_fft_scale[i] = -inverse_fft_scale[i];
+                    }
+
+                    /* M_{m - t} = (-1)^t g^{T(t)} P_m / (P_t P_{m - t}) */
+                    vanishing_kernel = std::vector<value_type>(m);
+                    vanishing_kernel[0] = value_type::one();
+                    for (std::size_t t = 1; t < m; t++) {
+                        vanishing_kernel[t] = geometric_triangular_sequence[t] * products[m] * products_inverse[t] *
+                                              products_inverse[m - t];
+                        if (t % 2 == 1)
+                            vanishing_kernel[t] = -vanishing_kernel[t];
+                    }
+
+                    chirp_size = detail::power_of_two(2 * m - 1);
+                    const std::size_t s = fields::arithmetic_params<FieldType>::s;
+                    chirp_fft_available = s >= 8 * sizeof(std::size_t) || chirp_size <= (std::size_t(1) << s);
+
+                    if (chirp_fft_available) {
+                        const value_type omega = unity_root<FieldType>(chirp_size);
+                        chirp_fft_twiddles = detail::basic_radix2_fft_twiddles<FieldType>(chirp_size, omega);
+                        chirp_inverse_fft_twiddles =
+                            detail::basic_radix2_fft_twiddles<FieldType>(chirp_size, omega.inversed());
+
+                        transform_kernel(chirp_kernel);
+                        transform_kernel(vanishing_kernel);
                     }
 
                     precomputation_sentinel = true;
                 }
 
+                void precompute() {
+                    std::call_once(precomputation_flag, [this]() { do_precomputation(); });
+                }
+
                 geometric_sequence_domain(const std::size_t m) : evaluation_domain<FieldType>(m) {
                     if (m <= 1) {
                         throw std::invalid_argument("geometric(): expected m > 1");
@@ -85,6 +179,11 @@ namespace nil {
                 }
 
                 void fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    fft(a, workspace);
+                }
+
+                void fft(std::vector<value_type> &a, workspace_type &workspace) {
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -93,32 +192,25 @@ namespace nil {
                         }
                     }
 
-                    if (!precomputation_sentinel)
-                        do_precomputation();
-
-                    monomial_to_newton_basis_geometric<FieldType>(a, geometric_sequence, geometric_triangular_sequence,
-                                                                  this->m);
-
-                    /* Newton to Evaluation */
-                    std::vector<value_type> T(this->m);
-                    T[0] = value_type::one();
-
-                    std::vector<value_type> g(this->m);
-                    g[0] = a[0];
+                    fft(span<value_type>(a), workspace);
+                }
 
-                    for (std::size_t i = 1; i < this->m; i++) {
-                        T[i] = T[i - 1] * (geometric_sequence[i] - value_type::one()).inversed();
-                        g[i] = geometric_triangular_sequence[i] * a[i];
-                    }
+                void fft(span<value_type> a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("geometric_sequence_domain::fft", this->m, workspace.bytes());
 
-                    multiplication(a, g, T);
-                    a.resize(this->m);
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("geometric: expected a.size() == this->m");
 
-                    for (std::size_t i = 0; i < this->m; i++) {
-                        a[i] *= T[i].inversed();
-                    }
+                    precompute();
+                    chirp_fft(a, geometric_triangular_sequence_inverse, workspace, this->get_thread_pool());
                 }
+
                 void inverse_fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    inverse_fft(a, workspace);
+                }
+
+                void inverse_fft(std::vector<value_type> &a, workspace_type &workspace) {
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -127,36 +219,50 @@ namespace nil {
                         }
                     }
 
-                    if (!precomputation_sentinel)
-                        do_precomputation();
+                    inverse_fft(span<value_type>(a), workspace);
+                }
 
-                    /* Interpolation to Newton */
-                    std::vector<value_type> T(this->m);
-                    T[0] = value_type::one();
+                void inverse_fft(span<value_type> a, workspace_type &workspace) {
+                    CRYPTO3_MATH_INSTRUMENT_MEMORY("geometric_sequence_domain::inverse_fft", this->m,
+                                                   workspace.bytes());
 
-                    std::vector<value_type> W(this->m);
-                    W[0] = a[0] * T[0];
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("geometric: expected a.size() == this->m");
 
-                    value_type prev_T = T[0];
-                    for (std::size_t i = 1; i < this->m; i++) {
-                        prev_T *= (geometric_sequence[i] - value_type::one()).inversed();
+                    precompute();
+                    chirp_inverse_fft(a, workspace, this->get_thread_pool());
+                }
 
-                        W[i] = a[i] * prev_T;
-                        T[i] = geometric_triangular_sequence[i] * prev_T;
-                        if (i % 2 == 1)
-                            T[i] = -T[i];
-                    }
+                /**
+                 * The columns are split between the threads of the pool, each with its own workspace, and all of
+                 * them read the same transformed kernels.
+                 */
+                void fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    batch(columns, false);
+                }
 
-                    multiplication(a, W, T);
-                    a.resize(this->m);
+                void fft_batch(std::vector<value_type> &data) {
+                    batch(data, false);
+                }
 
-                    for (std::size_t i = 0; i < this->m; i++) {
-                        a[i] *= geometric_triangular_sequence[i].inversed();
-                    }
+                void inverse_fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    batch(columns, true);
+                }
+
+                void inverse_fft_batch(std::vector<value_type> &data) {
+                    batch(data, true);
+                }
 
-                    newton_to_monomial_basis_geometric<FieldType>(a, geometric_sequence, geometric_triangular_sequence,
-                                                                  this->m);
+                std::size_t workspace_size() const {
+                    const std::size_t n = detail::power_of_two(2 * this->m - 1);
+                    const std::size_t s = fields::arithmetic_params<FieldType>::s;
+                    if (s >= 8 * sizeof(std::size_t) || n <= (std::size_t(1) << s)) {
+                        return n;
+                    }
+                    /* the product of multiplication holds up to 3m - 2 terms */
+                    return n + 3 * (3 * this->m - 2);
                 }
+
                 std::vector<value_type> evaluate_all_lagrange_polynomials(const value_type &t) {
                     /* Compute Lagrange polynomial of size m, with m+1 points (x_0, y_0), ... ,(x_m, y_m) */
                     /* Evaluate for x = t */
@@ -164,9 +270,7 @@ namespace nil {
 
                     /* for all i: w[i] = (1 / r) * w[i-1] * (1 - a[i]^m-i+1) / (1 - a[i]^-i) */
 
-                    if (!precomputation_sentinel) {
-                        do_precomputation();
-                    }
+                    precompute();
 
                     /**
                      * If t equals one of the geometric progression values,
@@ -204,27 +308,30 @@ namespace nil {
                     value_type r = geometric_sequence[this->m - 1].inversed();
                     value_type r_i = r;
 
+                    /* g[0] is zero and is left as is */
+                    std::vector<value_type> g_inverse(g);
+                    batch_inverse(g_inverse, this->get_thread_pool());
+                    batch_inverse(l, this->get_thread_pool());
+
                     std::vector<value_type> g_i(this->m);
                     g_i[0] = g_vanish.inversed();
 
-                    l[0] = l_vanish * l[0].inversed() * g_i[0];
+                    l[0] = l_vanish * l[0] * g_i[0];
                     for (std::size_t i = 1; i < this->m; i++) {
-                        g_i[i] = g_i[i - 1] * g[this->m - i] * -g[i].inversed() * geometric_sequence[i];
-                        l[i] = l_vanish * r_i * l[i].inversed() * g_i[i];
+                        g_i[i] = g_i[i - 1] * g[this->m - i] * -g_inverse[i] * geometric_sequence[i];
+                        l[i] = l_vanish * r_i * l[i] * g_i[i];
                         r_i *= r;
                     }
 
                     return l;
                 }
                 value_type get_domain_element(const std::size_t idx) {
-                    if (!precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     return this->geometric_sequence[idx];
                 }
                 value_type compute_vanishing_polynomial(const value_type &t) {
-                    if (!precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     /* Notes: Z = prod_{i = 0 to m} (t - a[i]) */
                     /* Better approach: Montgomery Trick + Divide&Conquer/FFT */
@@ -235,11 +342,14 @@ namespace nil {
                     return Z;
                 }
                 void add_poly_z(const value_type &coeff, std::vector<value_type> &H) {
+                    add_poly_z(coeff, span<value_type>(H));
+                }
+
+                void add_poly_z(const value_type &coeff, span<value_type> H) {
                     if (H.size() != this->m + 1)
                         throw std::invalid_argument("geometric: expected H.size() == this->m+1");
 
-                    if (!precomputation_sentinel)
-                        do_precomputation();
+                    precompute();
 
                     std::vector<value_type> x(2, value_type::zero());
                     x[0] = -geometric_sequence[0];
@@ -259,6 +369,10 @@ namespace nil {
                     }
                 }
                 void divide_by_z_on_coset(std::vector<value_type> &P) {
+                    divide_by_z_on_coset(span<value_type>(P));
+                }
+
+                void divide_by_z_on_coset(span<value_type> P) {
                     const value_type coset = value_type(
                         fields::arithmetic_params<FieldType>::multiplicative_generator); /* coset in geometric
                                                                                             sequence? */
@@ -267,6 +381,147 @@ namespace nil {
                         P[i] *= Z_inverse_at_coset;
                     }
                 }
+
+            private:
+                void transform_kernel(std::vector<value_type> &kernel) {
+                    kernel.resize(chirp_size, value_type::zero());
+                    detail::basic_radix4_fft_cached<FieldType>(kernel.data(), chirp_size, chirp_fft_twiddles.data(),
+                                                               this->get_thread_pool());
+
+                    const value_type sconst = value_type(chirp_size).inversed();
+                    for (value_type &k : kernel) {
+                        k *= sconst;
+                    }
+                }
+
+                /*
+                 * Replace the first count elements of u, followed by zeros, by their convolution with the kernel,
+                 * of which the first chirp_size elements are kept.
+                 */
+                void convolution(typename workspace_type::buffer_type &u, const std::size_t count,
+                                 const std::vector<value_type> &kernel, workspace_type &workspace, thread_pool *pool) {
+                    if (chirp_fft_available) {
+                        detail::basic_radix4_fft_cached<FieldType>(u.data(), chirp_size, chirp_fft_twiddles.data(),
+                                                                   pool);
+                        detail::parallel_for(
+                            pool, 0, chirp_size,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; i++) {
+                                    u[i] *= kernel[i];
+                                }
+                            },
+                            detail::basic_radix2_fft_grain_size);
+                        detail::basic_radix4_fft_cached<FieldType>(u.data(), chirp_size,
+                                                                   chirp_inverse_fft_twiddles.data(), pool);
+                        return;
+                    }
+
+                    typename workspace_type::buffer_type &c = workspace.buffer(1, 0);
+                    multiplication(c, span<const value_type>(u.data(), count), kernel, workspace.buffer(2, 0),
+                                   workspace.buffer(3, 0));
+
+                    const std::size_t kept = std::min(c.size(), chirp_size);
+                    std::fill(std::copy(c.begin(), c.begin() + kept, u.begin()), u.end(), value_type::zero());
+                }
+
+                /* the transform of a with a_j scaled by pre_scale[j] instead of g^{-T(j)} */
+                void chirp_fft(span<value_type> a, const std::vector<value_type> &pre_scale,
+                               workspace_type &workspace, thread_pool *pool) {
+                    const std::size_t m = this->m;
+                    typename workspace_type::buffer_type &u = workspace.buffer(0, chirp_size);
+
+                    /* a reversed, so that the convolution gives sum_j a_j g^{T(i + j)} at m - 1 + i */
+                    detail::parallel_for(
+                        pool, 0, chirp_size,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t t = begin; t < end; t++) {
+                                u[t] = t < m ? a[m - 1 - t] * pre_scale[m - 1 - t] : value_type::zero();
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+
+                    convolution(u, m, chirp_kernel, workspace, pool);
+
+                    detail::parallel_for(
+                        pool, 0, m,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; i++) {
+                                a[i] = u[m - 1 + i] * geometric_triangular_sequence_inverse[i];
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                }
+
+                void chirp_inverse_fft(span<value_type> a, workspace_type &workspace, thread_pool *pool) {
+                    const std::size_t m = this->m;
+
+                    /* e = the transform of y_i / M'(g^i) */
+                    chirp_fft(a, inverse_fft_scale, workspace, pool);
+
+                    typename workspace_type::buffer_type &u = workspace.buffer(0, chirp_size);
+                    detail::parallel_for(
+                        pool, 0, chirp_size,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t t = begin; t < end; t++) {
+                                u[t] = t < m ? a[t] : value_type::zero();
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+
+                    /* a_k = sum_d e_d M_{k + 1 + d} is at m - 1 - k of the convolution of e with M_{m - t} */
+                    convolution(u, m, vanishing_kernel, workspace, pool);
+
+                    detail::parallel_for(
+                        pool, 0, m,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t k = begin; k < end; k++) {
+                                a[k] = u[m - 1 - k];
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                }
+
+                void batch(std::vector<std::vector<value_type>> &columns, bool inverse) {
+                    for (std::vector<value_type> &a : columns) {
+                        if (a.size() != this->m) {
+                            if (a.size() < this->m) {
+                                a.resize(this->m, value_type(0));
+                            } else {
+                                throw std::invalid_argument("geometric: expected a.size() == this->m");
+                            }
+                        }
+                    }
+
+                    batch(columns.size(), [&](std::size_t c) { return span<value_type>(columns[c]); }, inverse);
+                }
+
+                void batch(std::vector<value_type> &data, bool inverse) {
+                    if (data.size() % this->m != 0)
+                        throw std::invalid_argument("geometric: expected data.size() to be a multiple of m");
+
+                    batch(
+                        data.size() / this->m,
+                        [&](std::size_t c) { return span<value_type>(data.data() + c * this->m, this->m); }, inverse);
+                }
+
+                template<typename Column>
+                void batch(const std::size_t count, Column column, bool inverse) {
+                    precompute();
+
+                    /* the threads take whole columns, unless there are fewer of them than threads */
+                    thread_pool *pool = this->get_thread_pool();
+                    thread_pool *inner = pool != nullptr && count < pool->size() ? pool : nullptr;
+                    detail::parallel_for(pool, 0, count, [&](std::size_t begin, std::size_t end) {
+                        workspace_type workspace;
+                        for (std::size_t c = begin; c < end; c++) {
+                            if (inverse) {
+                                chirp_inverse_fft(column(c), workspace, inner);
+                            } else {
+                                chirp_fft(column(c), geometric_triangular_sequence_inverse, workspace, inner);
+                            }
+                        }
+                    });
+                }
             };
         }    // namespace math
     }        // namespace crypto3
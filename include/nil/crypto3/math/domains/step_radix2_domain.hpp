@@ -26,10 +26,14 @@
 #ifndef CRYPTO3_MATH_STEP_RADIX2_DOMAIN_HPP
 #define CRYPTO3_MATH_STEP_RADIX2_DOMAIN_HPP
 
+#include <algorithm>
+#include <mutex>
 #include <vector>
 
+#include <nil/crypto3/math/arena.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
 
 namespace nil {
@@ -47,6 +51,12 @@ namespace nil {
 
             public:
                 typedef FieldType field_type;
+                typedef typename evaluation_domain<FieldType>::workspace_type workspace_type;
+
+                using evaluation_domain<FieldType>::fft;
+                using evaluation_domain<FieldType>::inverse_fft;
+                using evaluation_domain<FieldType>::add_poly_z;
+                using evaluation_domain<FieldType>::divide_by_z_on_coset;
 
                 std::size_t big_m;
                 std::size_t small_m;
@@ -54,6 +64,50 @@ namespace nil {
                 value_type big_omega;
                 value_type small_omega;
 
+                std::once_flag precomputation_flag;
+
+                /* the twiddles of the transforms of the sizes big_m and small_m */
+                std::vector<value_type> big_fft_cache;
+                std::vector<value_type> big_inverse_fft_cache;
+                std::vector<value_type> small_fft_cache;
+                std::vector<value_type> small_inverse_fft_cache;
+
+                /* omega^i for i < big_m, and omega^{-i} / 2 for i < small_m */
+                std::vector<value_type> omega_powers;
+                std::vector<value_type> inverse_omega_powers;
+
+                void do_precomputation() {
+                    big_fft_cache = detail::basic_radix2_fft_twiddles<FieldType>(big_m, big_omega);
+                    big_inverse_fft_cache = detail::basic_radix2_fft_twiddles<FieldType>(big_m, big_omega.inversed());
+                    small_fft_cache = detail::basic_radix2_fft_twiddles<FieldType>(small_m, small_omega);
+                    small_inverse_fft_cache =
+                        detail::basic_radix2_fft_twiddles<FieldType>(small_m, small_omega.inversed());
+
+                    omega_powers.resize(big_m);
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, big_m,
+                        [&](std::size_t begin, std::size_t end) {
+                            value_type omega_i = omega.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                omega_powers[i] = omega_i;
+                                omega_i *= omega;
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+
+                    inverse_omega_powers.resize(small_m);
+                    const value_type omega_inverse = omega.inversed();
+                    value_type omega_inverse_i = value_type(2).inversed();
+                    for (std::size_t i = 0; i < small_m; ++i) {
+                        inverse_omega_powers[i] = omega_inverse_i;
+                        omega_inverse_i *= omega_inverse;
+                    }
+                }
+
+                void precompute() {
+                    std::call_once(precomputation_flag, [this]() { do_precomputation(); });
+                }
+
                 step_radix2_domain(const std::size_t m) : evaluation_domain<FieldType>(m) {
                     if (m <= 1)
                         throw std::invalid_argument("step_radix2(): expected m > 1");
@@ -71,6 +125,11 @@ namespace nil {
                 }
 
                 void fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    fft(a, workspace);
+                }
+
+                void fft(std::vector<value_type> &a, workspace_type &workspace) {
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type(0));
@@ -79,93 +138,96 @@ namespace nil {
                         }
                     }
 
-                    std::vector<value_type> c(big_m, value_type::zero());
-                    std::vector<value_type> d(big_m, value_type::zero());
-
-                    value_type omega_i = value_type::one();
-                    for (std::size_t i = 0; i < big_m; ++i) {
-                        c[i] = (i < small_m ? a[i] + a[i + big_m] : a[i]);
-                        d[i] = omega_i * (i < small_m ? a[i] - a[i + big_m] : a[i]);
-                        omega_i *= omega;
-                    }
-
-                    std::vector<value_type> e(small_m, value_type::zero());
-                    const std::size_t compr = 1ul << (static_cast<std::size_t>(std::ceil(std::log2(big_m))) -
-                                                      static_cast<std::size_t>(std::ceil(std::log2(small_m))));
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        for (std::size_t j = 0; j < compr; ++j) {
-                            e[i] += d[i + j * small_m];
-                        }
-                    }
-
-                    detail::basic_radix2_fft<FieldType>(c, omega.squared());
-                    detail::basic_radix2_fft<FieldType>(e, unity_root<FieldType>(small_m));
+                    fft(span<value_type>(a), workspace);
+                }
 
-                    for (std::size_t i = 0; i < big_m; ++i) {
-                        a[i] = c[i];
-                    }
+                /*
+                 * a[0, big_m) takes the polynomial reduced modulo x^big_m - 1, and a[big_m, m) the one reduced
+                 * modulo x^small_m - omega^small_m and scaled by omega^i, whose transforms are then done in place.
+                 * Only a[0, small_m) and a[big_m, m) are written before that, and a[small_m, big_m) is what the
+                 * reduction modulo x^small_m reads, so each i < small_m is independent.
+                 */
+                void fft(span<value_type> a, workspace_type &) {
+                    CRYPTO3_MATH_INSTRUMENT("step_radix2_domain::fft", this->m, 0);
 
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        a[i + big_m] = e[i];
-                    }
-                }
-                void inverse_fft(std::vector<value_type> &a) {
                     if (a.size() != this->m)
                         throw std::invalid_argument("step_radix2: expected a.size() == this->m");
 
-                    std::vector<value_type> U0(a.begin(), a.begin() + big_m);
-                    std::vector<value_type> U1(a.begin() + big_m, a.end());
-
-                    detail::basic_radix2_fft<FieldType>(U0, omega.squared().inversed());
-                    detail::basic_radix2_fft<FieldType>(U1, unity_root<FieldType>(small_m).inversed());
-
-                    const value_type U0_size_inv = value_type(big_m).inversed();
-                    for (std::size_t i = 0; i < big_m; ++i) {
-                        U0[i] *= U0_size_inv;
-                    }
+                    precompute();
+
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, small_m,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                const value_type x = a[i], y = a[big_m + i];
+                                value_type e = omega_powers[i] * (x - y);
+                                for (std::size_t j = i + small_m; j < big_m; j += small_m) {
+                                    e += omega_powers[j] * a[j];
+                                }
+                                a[i] = x + y;
+                                a[big_m + i] = e;
+                            }
+                        },
+                        std::max<std::size_t>(1, detail::basic_radix2_fft_grain_size * small_m / big_m));
+
+                    parts_fft(a, big_fft_cache, small_fft_cache);
+                }
 
-                    const value_type U1_size_inv = value_type(small_m).inversed();
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        U1[i] *= U1_size_inv;
-                    }
+                void inverse_fft(std::vector<value_type> &a) {
+                    workspace_type workspace;
+                    inverse_fft(a, workspace);
+                }
 
-                    std::vector<value_type> tmp = U0;
-                    value_type omega_i = value_type::one();
-                    for (std::size_t i = 0; i < big_m; ++i) {
-                        tmp[i] *= omega_i;
-                        omega_i *= omega;
-                    }
+                void inverse_fft(std::vector<value_type> &a, workspace_type &workspace) {
+                    inverse_fft(span<value_type>(a), workspace);
+                }
 
-                    // save A_suffix
-                    for (std::size_t i = small_m; i < big_m; ++i) {
-                        a[i] = U0[i];
-                    }
+                void inverse_fft(span<value_type> a, workspace_type &) {
+                    CRYPTO3_MATH_INSTRUMENT("step_radix2_domain::inverse_fft", this->m, 0);
 
-                    const std::size_t compr = 1ul << (static_cast<std::size_t>(std::ceil(std::log2(big_m))) -
-                                                      static_cast<std::size_t>(std::ceil(std::log2(small_m))));
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        for (std::size_t j = 1; j < compr; ++j) {
-                            U1[i] -= tmp[i + j * small_m];
-                        }
-                    }
+                    if (a.size() != this->m)
+                        throw std::invalid_argument("step_radix2: expected a.size() == this->m");
 
-                    const value_type omega_inv = omega.inversed();
-                    value_type omega_inv_i = value_type::one();
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        U1[i] *= omega_inv_i;
-                        omega_inv_i *= omega_inv;
-                    }
+                    precompute();
+
+                    parts_fft(a, big_inverse_fft_cache, small_inverse_fft_cache);
+
+                    const value_type big_m_inverse = value_type(big_m).inversed();
+                    const value_type small_m_inverse = value_type(small_m).inversed();
+                    const value_type over_two_big_m = big_m_inverse * value_type(2).inversed();
+
+                    // compute A_prefix and B2 from U0 = a[0, big_m) / big_m and U1 = a[big_m, m) / small_m,
+                    // reading the A_suffix of a[small_m, big_m) before it is scaled
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, small_m,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                value_type s = value_type::zero();
+                                for (std::size_t j = i + small_m; j < big_m; j += small_m) {
+                                    s += omega_powers[j] * a[j];
+                                }
+                                const value_type u0 = over_two_big_m * a[i];
+                                const value_type u1 =
+                                    inverse_omega_powers[i] * (small_m_inverse * a[big_m + i] - big_m_inverse * s);
+                                a[i] = u0 + u1;
+                                a[big_m + i] = u0 - u1;
+                            }
+                        },
+                        std::max<std::size_t>(1, detail::basic_radix2_fft_grain_size * small_m / big_m));
 
-                    // compute A_prefix
-                    const value_type over_two = value_type(2).inversed();
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        a[i] = (U0[i] + U1[i]) * over_two;
-                    }
+                    // save A_suffix
+                    detail::parallel_for(
+                        this->get_thread_pool(), small_m, big_m,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                a[i] *= big_m_inverse;
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                }
 
-                    // compute B2
-                    for (std::size_t i = 0; i < small_m; ++i) {
-                        a[big_m + i] = (U0[i] - U1[i]) * over_two;
-                    }
+                std::size_t workspace_size() const {
+                    return 0;
                 }
 
                 std::vector<value_type> evaluate_all_lagrange_polynomials(const value_type &t) {
@@ -208,7 +270,28 @@ namespace nil {
                     return (t.pow(big_m) - value_type::one()) * (t.pow(small_m) - omega.pow(small_m));
                 }
 
+                std::vector<value_type> compute_vanishing_polynomial_on_coset(const value_type &coset,
+                                                                              std::size_t n) override {
+                    const value_type omega_to_small_m = omega.pow(small_m);
+                    const std::vector<value_type> big = this->coset_power(coset, n, big_m);
+
+                    std::vector<value_type> result = this->coset_power(coset, n, small_m);
+                    detail::parallel_for(
+                        this->get_thread_pool(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; ++j) {
+                                result[j] = (big[j] - value_type::one()) * (result[j] - omega_to_small_m);
+                            }
+                        },
+                        detail::coset_evaluation_grain_size);
+                    return result;
+                }
+
                 void add_poly_z(const value_type &coeff, std::vector<value_type> &H) {
+                    add_poly_z(coeff, span<value_type>(H));
+                }
+
+                void add_poly_z(const value_type &coeff, span<value_type> H) {
                     // if (H.size() != this->m + 1)
                     //    throw std::invalid_argument("step_radix2: expected H.size() == this->m+1");
 
@@ -220,6 +303,10 @@ namespace nil {
                     H[0] += coeff * omega_to_small_m;
                 }
                 void divide_by_z_on_coset(std::vector<value_type> &P) {
+                    divide_by_z_on_coset(span<value_type>(P));
+                }
+
+                void divide_by_z_on_coset(span<value_type> P) {
                     // (c^{2^k}-1) * (c^{2^r} * w^{2^{r+1}*i) - w^{2^r})
                     const value_type coset = fields::arithmetic_params<FieldType>::multiplicative_generator;
 
@@ -229,10 +316,16 @@ namespace nil {
                     const value_type omega_to_2small_m = omega.pow(2 * small_m);
                     value_type elt = value_type::one();
 
+                    detail::scratch_vector<value_type> Z(big_m);
                     for (std::size_t i = 0; i < big_m; ++i) {
-                        P[i] *= (coset_to_small_m_times_Z0 * elt - omega_to_small_m_times_Z0).inversed();
+                        Z[i] = coset_to_small_m_times_Z0 * elt - omega_to_small_m_times_Z0;
                         elt *= omega_to_2small_m;
                     }
+                    batch_inverse(Z, this->get_thread_pool());
+
+                    for (std::size_t i = 0; i < big_m; ++i) {
+                        P[i] *= Z[i];
+                    }
 
                     // (c^{2^k}*w^{2^k}-1) * (c^{2^k} * w^{2^r} - w^{2^r})
 
@@ -244,6 +337,27 @@ namespace nil {
                         P[big_m + i] *= Z1_inverse;
                     }
                 }
+
+            private:
+                /* the transforms of a[0, big_m) and a[big_m, m), side by side when there is a thread pool */
+                void parts_fft(span<value_type> a, const std::vector<value_type> &big_twiddles,
+                               const std::vector<value_type> &small_twiddles) {
+                    thread_pool *pool = this->get_thread_pool();
+                    detail::parallel_for(
+                        pool, 0, 2,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t h = begin; h < end; ++h) {
+                                if (h == 0) {
+                                    detail::basic_radix4_fft_cached<FieldType>(a.data(), big_m, big_twiddles.data(),
+                                                                               pool);
+                                } else {
+                                    detail::basic_radix4_fft_cached<FieldType>(a.data() + big_m, small_m,
+                                                                               small_twiddles.data(), pool);
+                                }
+                            }
+                        },
+                        1);
+                }
             };
         }    // namespace math
     }        // namespace crypto3
@@ -0,0 +1,569 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MATH_EXPRESSION_COMPILER_HPP
+#define CRYPTO3_MATH_EXPRESSION_COMPILER_HPP
+
+#ifndef CRYPTO3_MATH_EXPRESSION_HPP
+#error "compiler.hpp must not be included directly!"
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
+#include <nil/crypto3/math/expressions/ast.hpp>
+#include <nil/crypto3/math/expressions/evaluator.hpp>
+#include <nil/crypto3/math/expressions/math.hpp>
+#include <nil/crypto3/math/span.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace expressions {
+                namespace detail {
+                    namespace ast {
+                        template<typename FieldValueType>
+                        struct compiler;
+                    }    // namespace ast
+                }        // namespace detail
+
+                /// @brief An expression compiled to a tape of field operations
+                ///
+                /// The tape is a flat list of instructions over registers, which are allocated once so that a
+                /// register is reused as soon as its value is dead. It is run over blocks of block_size rows at
+                /// a time: every instruction makes one tight loop over the rows of the block, so the dispatch
+                /// costs once per block and not once per row as walking the tree does, and a division inverts
+                /// the whole block in one batch. The blocks run on the global thread pool.
+                ///
+                /// Constants must be integers, operations are +, -, *, / and the powers ** and pow with a
+                /// constant non-negative integer exponent. Division by zero gives zero.
+                template<typename FieldValueType>
+                class compiled_expression {
+                public:
+                    typedef FieldValueType value_type;
+
+                    /// @brief Rows evaluated by each pass over the tape
+                    constexpr static const std::size_t block_size = 64;
+
+                    /// @brief Variables of the expression, in the order the columns are bound in
+                    const std::vector<std::string> &variables() const {
+                        return names;
+                    }
+
+                    /// @brief Number of instructions of the tape
+                    std::size_t size() const {
+                        return tape.size();
+                    }
+
+                    /// @brief Number of registers of block_size rows the tape runs over
+                    std::size_t registers() const {
+                        return temporaries;
+                    }
+
+                    /// @brief Evaluate the expression for a given symbol table
+                    value_type evaluate(const std::map<std::string, value_type> &st) const {
+                        std::vector<span<const value_type>> columns;
+                        for (const std::string &name : names) {
+                            auto it = st.find(name);
+                            if (it == st.end()) {
+                                throw std::invalid_argument("Unknown variable " + name);
+                            }
+                            columns.emplace_back(&it->second, 1);
+                        }
+
+                        value_type result;
+                        evaluate(span<value_type>(&result, 1), columns);
+                        return result;
+                    }
+
+                    /// @brief Evaluate the expression on every row of the columns
+                    ///
+                    /// @param[out] out     the values, row i from the row i of the columns
+                    /// @param[in] columns  the columns of the variables, in the order of variables(), each of at
+                    ///                     least out.size() rows
+                    void evaluate(span<value_type> out, const std::vector<span<const value_type>> &columns) const {
+                        if (columns.size() != names.size()) {
+                            throw std::invalid_argument("expected a column for every variable");
+                        }
+                        for (const span<const value_type> &column : columns) {
+                            if (column.size() < out.size()) {
+                                throw std::invalid_argument("expected columns of at least out.size() rows");
+                            }
+                        }
+
+                        const std::size_t n = out.size();
+                        math::detail::parallel_for(
+                            thread_pool::global().get(), 0, (n + block_size - 1) / block_size,
+                            [&](std::size_t begin, std::size_t end) {
+                                std::vector<value_type> registers(temporaries * block_size);
+                                std::vector<value_type> broadcast(constants.size() * block_size);
+                                for (std::size_t c = 0; c < constants.size(); ++c) {
+                                    std::fill(broadcast.begin() + c * block_size,
+                                              broadcast.begin() + (c + 1) * block_size, constants[c]);
+                                }
+
+                                const auto fetch = [&](const operand &x, std::size_t row) -> const value_type * {
+                                    switch (x.kind) {
+                                        case operand::variable:
+                                            return columns[x.index].data() + row;
+                                        case operand::constant:
+                                            return broadcast.data() + x.index * block_size;
+                                        default:
+                                            return registers.data() + x.index * block_size;
+                                    }
+                                };
+
+                                for (std::size_t block = begin; block < end; ++block) {
+                                    const std::size_t row = block * block_size;
+                                    const std::size_t count = std::min(block_size, n - row);
+
+                                    for (const instruction &ins : tape) {
+                                        value_type *r = registers.data() + ins.result * block_size;
+                                        const value_type *x = fetch(ins.lhs, row);
+                                        const value_type *y = ins.arity == 2 ? fetch(ins.rhs, row) : nullptr;
+                                        run(ins, r, x, y, count);
+                                    }
+
+                                    const value_type *result_values = fetch(result, row);
+                                    std::copy(result_values, result_values + count, out.begin() + row);
+                                }
+                            });
+                    }
+
+                    /// @brief Evaluate the expression on every row of the named columns
+                    ///
+                    /// The columns, e.g. polynomial_dfs or std::vector, must have the same number of rows.
+                    template<typename Column>
+                    std::vector<value_type> evaluate(const std::map<std::string, Column> &st) const {
+                        std::vector<span<const value_type>> columns;
+                        std::size_t rows = st.empty() ? 1 : st.begin()->second.size();
+                        for (const auto &column : st) {
+                            if (column.second.size() != rows) {
+                                throw std::invalid_argument("expected columns of the same size");
+                            }
+                        }
+                        for (const std::string &name : names) {
+                            auto it = st.find(name);
+                            if (it == st.end()) {
+                                throw std::invalid_argument("Unknown variable " + name);
+                            }
+                            columns.emplace_back(it->second.data(), it->second.size());
+                        }
+
+                        std::vector<value_type> out(rows);
+                        evaluate(span<value_type>(out), columns);
+                        return out;
+                    }
+
+                private:
+                    friend struct detail::ast::compiler<FieldValueType>;
+
+                    enum class opcode : std::uint8_t { add, sub, mul, div, neg, pow };
+
+                    struct operand {
+                        enum kind_type : std::uint8_t { variable, constant, temporary };
+
+                        kind_type kind;
+                        std::uint32_t index;
+                    };
+
+                    struct instruction {
+                        opcode op;
+                        std::uint8_t arity;
+                        operand lhs;
+                        operand rhs;
+                        std::uint32_t result;
+                        std::uint64_t exponent;
+                    };
+
+                    static void run(const instruction &ins, value_type *r, const value_type *x, const value_type *y,
+                                    std::size_t count) {
+                        switch (ins.op) {
+                            case opcode::add:
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    r[i] = x[i] + y[i];
+                                }
+                                break;
+                            case opcode::sub:
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    r[i] = x[i] - y[i];
+                                }
+                                break;
+                            case opcode::mul:
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    r[i] = x[i] * y[i];
+                                }
+                                break;
+                            case opcode::div:
+                                /* r never shares a register with x, see allocate */
+                                std::copy(y, y + count, r);
+                                batch_inverse(r, r + count);
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    r[i] *= x[i];
+                                }
+                                break;
+                            case opcode::neg:
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    r[i] = -x[i];
+                                }
+                                break;
+                            case opcode::pow:
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    r[i] = x[i].pow(ins.exponent);
+                                }
+                                break;
+                        }
+                    }
+
+                    std::vector<std::string> names;
+                    std::vector<value_type> constants;
+                    std::vector<instruction> tape;
+                    operand result;
+                    std::size_t temporaries = 0;
+                };
+
+                namespace detail {
+                    namespace ast {
+
+                        /// @brief Compile the abstract syntax tree into a compiled_expression
+                        ///
+                        /// Operations on constants only are folded over the field, identities such as x * 1 and
+                        /// x + 0 are simplified, powers are reduced to multiplications and every instruction is
+                        /// hash-consed, so that a subterm repeated in the expression is computed once. The tape is
+                        /// emitted with one temporary per instruction, which are then mapped on registers.
+                        template<typename FieldValueType>
+                        struct compiler {
+                            typedef compiled_expression<FieldValueType> expression_type;
+                            typedef typename expression_type::opcode opcode;
+                            typedef typename expression_type::operand result_type;
+
+                            static expression_type compile(const operand &ast) {
+                                compiler c;
+                                c.e.result = boost::apply_visitor(c, ast);
+                                c.eliminate_dead_code();
+                                c.allocate();
+                                return std::move(c.e);
+                            }
+
+                            result_type operator()(nil) const {
+                                throw std::invalid_argument("Empty expression");
+                            }
+
+                            result_type operator()(double n) {
+                                if (n != std::floor(n) || std::fabs(n) > 9007199254740992.0) {
+                                    throw std::invalid_argument("expected an integer constant below 2^53");
+                                }
+                                const FieldValueType v = FieldValueType(static_cast<std::uint64_t>(std::fabs(n)));
+                                return constant(n < 0 ? -v : v);
+                            }
+
+                            result_type operator()(std::string const &c) {
+                                auto it = std::find(e.names.begin(), e.names.end(), c);
+                                if (it == e.names.end()) {
+                                    it = e.names.insert(e.names.end(), c);
+                                }
+                                return result_type {result_type::variable,
+                                                    static_cast<std::uint32_t>(it - e.names.begin())};
+                            }
+
+                            result_type operator()(unary_op const &x) {
+                                const result_type rhs = boost::apply_visitor(*this, x.rhs);
+                                if (x.op == static_cast<double (*)(double)>(&detail::math::plus)) {
+                                    return rhs;
+                                }
+                                if (x.op == static_cast<double (*)(double)>(&detail::math::minus)) {
+                                    return emit(opcode::neg, rhs, rhs);
+                                }
+                                throw std::invalid_argument("Function not defined over a field");
+                            }
+
+                            result_type operator()(binary_op const &x) {
+                                return binary(x.op, boost::apply_visitor(*this, x.lhs), x.rhs);
+                            }
+
+                            result_type operator()(expression const &x) {
+                                result_type state = boost::apply_visitor(*this, x.lhs);
+                                for (operation const &oper : x.rhs) {
+                                    state = binary(oper.op, state, oper.rhs);
+                                }
+                                return state;
+                            }
+
+                        private:
+                            result_type binary(double (*op)(double, double), const result_type &lhs,
+                                               const operand &rhs_ast) {
+                                if (op == static_cast<double (*)(double, double)>(&std::pow)) {
+                                    const operand exponent = boost::apply_visitor(ConstantFolder {}, rhs_ast);
+                                    if (!holds_alternative<double>(exponent) || boost::get<double>(exponent) < 0 ||
+                                        boost::get<double>(exponent) != std::floor(boost::get<double>(exponent))) {
+                                        throw std::invalid_argument("expected a constant non-negative integer exponent");
+                                    }
+                                    return emit(opcode::pow, lhs, lhs,
+                                                static_cast<std::uint64_t>(boost::get<double>(exponent)));
+                                }
+
+                                const result_type rhs = boost::apply_visitor(*this, rhs_ast);
+                                if (op == static_cast<double (*)(double, double)>(&detail::math::plus)) {
+                                    return emit(opcode::add, lhs, rhs);
+                                }
+                                if (op == static_cast<double (*)(double, double)>(&detail::math::minus)) {
+                                    return emit(opcode::sub, lhs, rhs);
+                                }
+                                if (op == static_cast<double (*)(double, double)>(&detail::math::multiplies)) {
+                                    return emit(opcode::mul, lhs, rhs);
+                                }
+                                if (op == static_cast<double (*)(double, double)>(&detail::math::divides)) {
+                                    return emit(opcode::div, lhs, rhs);
+                                }
+                                throw std::invalid_argument("Operation not defined over a field");
+                            }
+
+                            result_type constant(const FieldValueType &v) {
+                                auto it = std::find(e.constants.begin(), e.constants.end(), v);
+                                if (it == e.constants.end()) {
+                                    it = e.constants.insert(e.constants.end(), v);
+                                }
+                                return result_type {result_type::constant,
+                                                    static_cast<std::uint32_t>(it - e.constants.begin())};
+                            }
+
+                            bool is_constant(const result_type &x, const FieldValueType &v) const {
+                                return x.kind == result_type::constant && e.constants[x.index] == v;
+                            }
+
+                            static bool same(const result_type &x, const result_type &y) {
+                                return x.kind == y.kind && x.index == y.index;
+                            }
+
+                            /// Emit an instruction, unless it folds to a constant, simplifies to an operand or
+                            /// to cheaper instructions, or is already on the tape with the same operands.
+                            result_type emit(opcode op, result_type lhs, result_type rhs, std::uint64_t exponent = 0) {
+                                const FieldValueType zero = FieldValueType::zero(), one = FieldValueType::one();
+                                const std::uint8_t arity = op == opcode::neg || op == opcode::pow ? 1 : 2;
+                                if (lhs.kind == result_type::constant && rhs.kind == result_type::constant) {
+                                    const FieldValueType x = e.constants[lhs.index], y = e.constants[rhs.index];
+                                    FieldValueType r;
+                                    expression_type::run({op, arity, lhs, rhs, 0, exponent}, &r, &x, &y, 1);
+                                    return constant(r);
+                                }
+
+                                switch (op) {
+                                    case opcode::add:
+                                        if (is_constant(lhs, zero)) {
+                                            return rhs;
+                                        }
+                                        if (is_constant(rhs, zero)) {
+                                            return lhs;
+                                        }
+                                        break;
+                                    case opcode::sub:
+                                        if (is_constant(rhs, zero)) {
+                                            return lhs;
+                                        }
+                                        if (is_constant(lhs, zero)) {
+                                            return emit(opcode::neg, rhs, rhs);
+                                        }
+                                        if (same(lhs, rhs)) {
+                                            return constant(zero);
+                                        }
+                                        break;
+                                    case opcode::mul:
+                                        if (is_constant(lhs, zero) || is_constant(rhs, zero)) {
+                                            return constant(zero);
+                                        }
+                                        if (is_constant(lhs, one)) {
+                                            return rhs;
+                                        }
+                                        if (is_constant(rhs, one)) {
+                                            return lhs;
+                                        }
+                                        if (is_constant(lhs, -one)) {
+                                            return emit(opcode::neg, rhs, rhs);
+                                        }
+                                        if (is_constant(rhs, -one)) {
+                                            return emit(opcode::neg, lhs, lhs);
+                                        }
+                                        break;
+                                    case opcode::div:
+                                        /* a constant divisor is inverted once, division by zero gives zero */
+                                        if (rhs.kind == result_type::constant) {
+                                            const FieldValueType &y = e.constants[rhs.index];
+                                            return y == zero ? constant(zero) : emit(opcode::mul, lhs, constant(y.inversed()));
+                                        }
+                                        if (is_constant(lhs, zero)) {
+                                            return lhs;
+                                        }
+                                        break;
+                                    case opcode::neg:
+                                        if (lhs.kind == result_type::temporary && e.tape[lhs.index].op == opcode::neg) {
+                                            return e.tape[lhs.index].lhs;
+                                        }
+                                        break;
+                                    case opcode::pow:
+                                        /* square and multiply, the squares are shared through the tape */
+                                        if (exponent == 0) {
+                                            return constant(one);
+                                        }
+                                        if (exponent > 1) {
+                                            result_type r = emit(opcode::pow, lhs, lhs, exponent / 2);
+                                            r = emit(opcode::mul, r, r);
+                                            return exponent % 2 == 1 ? emit(opcode::mul, r, lhs) : r;
+                                        }
+                                        return lhs;
+                                }
+
+                                /* commutative operations take their operands in one order, for the lookup */
+                                if ((op == opcode::add || op == opcode::mul) &&
+                                    std::make_pair(rhs.kind, rhs.index) < std::make_pair(lhs.kind, lhs.index)) {
+                                    std::swap(lhs, rhs);
+                                }
+
+                                const auto key = std::make_tuple(op, lhs.kind, lhs.index, rhs.kind, rhs.index);
+                                auto it = emitted.find(key);
+                                if (it != emitted.end()) {
+                                    return it->second;
+                                }
+
+                                e.tape.push_back({op, arity, lhs, rhs, static_cast<std::uint32_t>(e.tape.size()),
+                                                  exponent});
+                                const result_type r {result_type::temporary, e.tape.back().result};
+                                emitted.emplace(key, r);
+                                return r;
+                            }
+
+                            /// Drop the instructions the result does not depend on, which simplifications such as
+                            /// -(-x) = x leave behind.
+                            void eliminate_dead_code() {
+                                std::vector<bool> live(e.tape.size(), false);
+                                if (e.result.kind == result_type::temporary) {
+                                    live[e.result.index] = true;
+                                }
+                                for (std::size_t i = e.tape.size(); i-- > 0;) {
+                                    if (live[i]) {
+                                        for (const result_type *x : {&e.tape[i].lhs, &e.tape[i].rhs}) {
+                                            if (x->kind == result_type::temporary) {
+                                                live[x->index] = true;
+                                            }
+                                        }
+                                    }
+                                }
+
+                                std::vector<std::uint32_t> position(e.tape.size());
+                                std::size_t n = 0;
+                                for (std::size_t i = 0; i < e.tape.size(); ++i) {
+                                    if (!live[i]) {
+                                        continue;
+                                    }
+                                    instruction_type ins = e.tape[i];
+                                    for (result_type *x : {&ins.lhs, &ins.rhs}) {
+                                        if (x->kind == result_type::temporary) {
+                                            x->index = position[x->index];
+                                        }
+                                    }
+                                    position[i] = static_cast<std::uint32_t>(n);
+                                    ins.result = position[i];
+                                    e.tape[n++] = ins;
+                                }
+                                e.tape.resize(n);
+                                if (e.result.kind == result_type::temporary) {
+                                    e.result.index = position[e.result.index];
+                                }
+                            }
+
+                            /// Map the temporaries, one per instruction, on registers: a register is released after
+                            /// the last use of its value. Instructions working row by row may write their result
+                            /// over a dying operand, while a division takes its result register before releasing
+                            /// those of its operands, since it overwrites the result before reading the dividend.
+                            void allocate() {
+                                const std::size_t none = e.tape.size();
+                                std::vector<std::size_t> last_use(e.tape.size(), none);
+                                for (std::size_t i = 0; i < e.tape.size(); ++i) {
+                                    for (const result_type *x : {&e.tape[i].lhs, &e.tape[i].rhs}) {
+                                        if (x->kind == result_type::temporary) {
+                                            last_use[x->index] = i;
+                                        }
+                                    }
+                                }
+                                if (e.result.kind == result_type::temporary) {
+                                    last_use[e.result.index] = none;
+                                }
+
+                                std::vector<std::uint32_t> registers(e.tape.size()), free, dying;
+                                for (std::size_t i = 0; i < e.tape.size(); ++i) {
+                                    instruction_type &ins = e.tape[i];
+                                    dying.clear();
+                                    for (result_type *x : {&ins.lhs, &ins.rhs}) {
+                                        if (x->kind == result_type::temporary) {
+                                            const std::uint32_t temporary = x->index;
+                                            x->index = registers[temporary];
+                                            /* released once, even if it is both operands */
+                                            if (last_use[temporary] == i) {
+                                                dying.push_back(registers[temporary]);
+                                                last_use[temporary] = none;
+                                            }
+                                        }
+                                    }
+
+                                    if (ins.op != opcode::div) {
+                                        free.insert(free.end(), dying.begin(), dying.end());
+                                    }
+                                    if (free.empty()) {
+                                        free.push_back(static_cast<std::uint32_t>(e.temporaries++));
+                                    }
+                                    registers[i] = free.back();
+                                    free.pop_back();
+                                    ins.result = registers[i];
+                                    if (ins.op == opcode::div) {
+                                        free.insert(free.end(), dying.begin(), dying.end());
+                                    }
+                                }
+                                if (e.result.kind == result_type::temporary) {
+                                    e.result.index = registers[e.result.index];
+                                }
+                            }
+
+                            typedef typename expression_type::instruction instruction_type;
+                            typedef typename result_type::kind_type kind_type;
+
+                            expression_type e;
+                            std::map<std::tuple<opcode, kind_type, std::uint32_t, kind_type, std::uint32_t>,
+                                     result_type>
+                                emitted;
+                        };
+                    }    // namespace ast
+                }        // namespace detail
+            }            // namespace expressions
+        }                // namespace math
+    }                    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_EXPRESSION_COMPILER_HPP
@@ -29,6 +29,7 @@
 #include <nil/crypto3/math/expressions/ast.hpp>
 #include <nil/crypto3/math/expressions/evaluator.hpp>
 #include <nil/crypto3/math/expressions/parser.hpp>
+#include <nil/crypto3/math/expressions/compiler.hpp>
 
 #include <memory>
 #include <stdexcept>
@@ -58,6 +59,8 @@ namespace nil {
                 class Parser {
                     class impl {
                         typename detail::ast::operand ast;
+                        /* the tree as parsed, constants are folded over the field when compiling */
+                        typename detail::ast::operand source;
 
                     public:
                         void parse(std::string const &expr) {
@@ -75,6 +78,7 @@ namespace nil {
                             }
 
                             ast = ast_;
+                            source = ast;
                         }
 
                         void optimize() { ast = boost::apply_visitor(detail::ast::ConstantFolder{}, ast); }
@@ -82,6 +86,11 @@ namespace nil {
                         double evaluate(std::map<std::string, double> const &st) {
                             return boost::apply_visitor(detail::ast::eval{st}, ast);
                         }
+
+                        template<typename FieldValueType>
+                        compiled_expression<FieldValueType> compile() const {
+                            return detail::ast::compiler<FieldValueType>::compile(source);
+                        }
                     };
                     std::unique_ptr<impl> pimpl;
 
@@ -106,6 +115,14 @@ namespace nil {
                     double evaluate(std::map<std::string, double> const &st = {}) {
                         return pimpl->evaluate(st);
                     }
+
+                    /// @brief Compile the parsed expression to a tape of operations over a field
+                    ///
+                    /// The result does not depend on optimize(), constants are folded over the field.
+                    template<typename FieldValueType>
+                    compiled_expression<FieldValueType> compile() const {
+                        return pimpl->template compile<FieldValueType>();
+                    }
                 };
 
                 /// @brief Convenience function
@@ -121,6 +138,18 @@ namespace nil {
                     parser.parse(expr);
                     return parser.evaluate(st);
                 }
+
+                /// @brief Convenience function
+                ///
+                /// This function builds the grammar, parses the expression and compiles it over a field.
+                ///
+                /// @param[in] expr  mathematical expression
+                template<typename FieldValueType>
+                compiled_expression<FieldValueType> compile(std::string const &expr) {
+                    Parser parser;
+                    parser.parse(expr);
+                    return parser.compile<FieldValueType>();
+                }
             }    // namespace expressions
         }    // namespace math
     }        // namespace crypto3
@@ -0,0 +1,411 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_INSTRUMENTATION_HPP
+#define CRYPTO3_MATH_INSTRUMENTATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace instrumentation {
+
+                /**
+                 * The totals of the calls of one call site: their number, the sum of their sizes, e.g. the
+                 * lengths of the transforms, the wall time spent in them and the bytes they allocated.
+                 */
+                struct counters {
+                    std::uint64_t calls = 0;
+                    std::uint64_t elements = 0;
+                    std::uint64_t nanoseconds = 0;
+                    std::uint64_t bytes = 0;
+                };
+
+                struct site_counters {
+                    std::string name;
+                    std::string file;
+                    int line;
+                    counters totals;
+                };
+
+                /**
+                 * One call, as the trace-event exporter writes it, with the times from the first call site
+                 * registration on.
+                 */
+                struct trace_event {
+                    const char *name;
+                    std::uint64_t start_nanoseconds;
+                    std::uint64_t duration_nanoseconds;
+                    std::uint64_t elements;
+                    std::size_t thread;
+                };
+
+                namespace detail {
+                    struct call_site {
+                        call_site(const char *site_name, const char *site_file, int site_line, std::size_t i) :
+                            name(site_name), file(site_file), line(site_line), index(i) {
+                        }
+
+                        const char *name;
+                        const char *file;
+                        int line;
+                        std::size_t index;
+                    };
+
+                    /*
+                     * The counters of one thread by the index of the call site and its trace events. Only the
+                     * thread itself adds to them, so its mutex is taken by the reports only.
+                     */
+                    struct thread_counters {
+                        std::mutex mutex;
+                        std::vector<counters> totals;
+                        std::vector<trace_event> events;
+                    };
+
+                    /*
+                     * The call sites, each registered once by the static of CRYPTO3_MATH_INSTRUMENT, so once per
+                     * instantiation in a template, and the counters of the threads which have run them, merged by
+                     * the reports. Up to trace_capacity trace events are kept over all the threads.
+                     */
+                    class registry {
+                    public:
+                        typedef std::chrono::steady_clock clock_type;
+
+                        static registry &instance() {
+                            static registry r;
+                            return r;
+                        }
+
+                        call_site &add(const char *name, const char *file, int line) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            sites.emplace_back(name, file, line, sites.size());
+                            return sites.back();
+                        }
+
+                        /* the counters of the calling thread, registered on its first call */
+                        thread_counters &local() {
+                            thread_local const std::shared_ptr<thread_counters> counters = add_thread();
+                            return *counters;
+                        }
+
+                        /* takes one of the trace_capacity places of the trace events, if any is left */
+                        bool reserve_event() {
+                            std::size_t count = events_count.load(std::memory_order_relaxed);
+                            while (count < trace_capacity.load(std::memory_order_relaxed)) {
+                                if (events_count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+                                    return true;
+                                }
+                            }
+                            return false;
+                        }
+
+                        /* the trace events of all the threads by their start; the caller holds mutex */
+                        std::vector<trace_event> merged_events() {
+                            std::vector<trace_event> result;
+                            for (const std::shared_ptr<thread_counters> &t : threads) {
+                                std::lock_guard<std::mutex> lock(t->mutex);
+                                result.insert(result.end(), t->events.begin(), t->events.end());
+                            }
+                            std::stable_sort(result.begin(), result.end(),
+                                             [](const trace_event &x, const trace_event &y) {
+                                                 return x.start_nanoseconds < y.start_nanoseconds;
+                                             });
+                            return result;
+                        }
+
+                        std::uint64_t since_epoch(clock_type::time_point t) const {
+                            return std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch).count();
+                        }
+
+                        std::mutex mutex;
+                        std::deque<call_site> sites;
+                        std::vector<std::shared_ptr<thread_counters>> threads;
+                        std::atomic<std::size_t> trace_capacity;
+                        std::atomic<std::size_t> events_count;
+
+                    private:
+                        registry() : trace_capacity(1ul << 20), events_count(0), epoch(clock_type::now()) {
+                        }
+
+                        std::shared_ptr<thread_counters> add_thread() {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            threads.push_back(std::make_shared<thread_counters>());
+                            return threads.back();
+                        }
+
+                        clock_type::time_point epoch;
+                    };
+
+                    /* a small number per thread, for the tid of the trace events */
+                    inline std::size_t thread_index() {
+                        static std::atomic<std::size_t> next(0);
+                        thread_local const std::size_t index = next++;
+                        return index;
+                    }
+
+                    /*
+                     * Adds the call to the counters of its thread when it goes out of scope. The innermost scope of
+                     * the thread takes the allocations of CRYPTO3_MATH_INSTRUMENT_ALLOCATION.
+                     */
+                    class scope {
+                    public:
+                        scope(call_site &call, std::uint64_t call_elements, std::uint64_t call_bytes) :
+                            site(call), elements(call_elements), bytes(call_bytes), outer(current()),
+                            start(registry::clock_type::now()) {
+                            current() = this;
+                        }
+
+                        scope(const scope &) = delete;
+                        scope &operator=(const scope &) = delete;
+
+                        ~scope() {
+                            current() = outer;
+
+                            registry &r = registry::instance();
+                            const std::uint64_t begin = r.since_epoch(start);
+                            const std::uint64_t duration = r.since_epoch(registry::clock_type::now()) - begin;
+
+                            thread_counters &local = r.local();
+                            std::lock_guard<std::mutex> lock(local.mutex);
+                            if (local.totals.size() <= site.index) {
+                                local.totals.resize(site.index + 1);
+                            }
+                            counters &totals = local.totals[site.index];
+                            totals.calls += 1;
+                            totals.elements += elements;
+                            totals.nanoseconds += duration;
+                            totals.bytes += bytes;
+                            if (r.reserve_event()) {
+                                local.events.push_back({site.name, begin, duration, elements, thread_index()});
+                            }
+                        }
+
+                        void add_bytes(std::uint64_t allocated) {
+                            bytes += allocated;
+                        }
+
+                        static void allocation(std::uint64_t allocated) {
+                            if (current() != nullptr) {
+                                current()->add_bytes(allocated);
+                            }
+                        }
+
+                    private:
+                        static scope *&current() {
+                            thread_local scope *innermost = nullptr;
+                            return innermost;
+                        }
+
+                        call_site &site;
+                        std::uint64_t elements;
+                        std::uint64_t bytes;
+                        scope *outer;
+                        registry::clock_type::time_point start;
+                    };
+
+                    /* a scope which adds the growth of the bytes memory() returns over the call */
+                    template<typename Memory>
+                    class memory_scope : public scope {
+                    public:
+                        memory_scope(call_site &call, std::uint64_t call_elements, const Memory &call_memory) :
+                            scope(call, call_elements, 0), memory(call_memory), initial(memory()) {
+                        }
+
+                        ~memory_scope() {
+                            const std::uint64_t current = memory();
+                            if (current > initial) {
+                                add_bytes(current - initial);
+                            }
+                        }
+
+                    private:
+                        Memory memory;
+                        std::uint64_t initial;
+                    };
+
+                    inline void write_json_string(std::ostream &out, const char *s) {
+                        out << '"';
+                        for (; *s != '\0'; ++s) {
+                            if (*s == '"' || *s == '\\') {
+                                out << '\\';
+                            }
+                            out << *s;
+                        }
+                        out << '"';
+                    }
+                }    // namespace detail
+
+                /**
+                 * The counters of the call sites which have run, with the sites of the same file and line, i.e.
+                 * the instantiations of one template, added up. Empty unless CRYPTO3_MATH_INSTRUMENTATION is
+                 * defined.
+                 */
+                inline std::vector<site_counters> snapshot() {
+                    detail::registry &r = detail::registry::instance();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+
+                    std::vector<counters> sums(r.sites.size());
+                    for (const std::shared_ptr<detail::thread_counters> &t : r.threads) {
+                        std::lock_guard<std::mutex> thread_lock(t->mutex);
+                        for (std::size_t i = 0; i < t->totals.size(); ++i) {
+                            sums[i].calls += t->totals[i].calls;
+                            sums[i].elements += t->totals[i].elements;
+                            sums[i].nanoseconds += t->totals[i].nanoseconds;
+                            sums[i].bytes += t->totals[i].bytes;
+                        }
+                    }
+
+                    std::vector<site_counters> result;
+                    for (const detail::call_site &site : r.sites) {
+                        auto same = std::find_if(result.begin(), result.end(), [&site](const site_counters &s) {
+                            return s.line == site.line && s.file == site.file;
+                        });
+                        if (same == result.end()) {
+                            result.push_back({site.name, site.file, site.line, counters()});
+                            same = result.end() - 1;
+                        }
+                        same->totals.calls += sums[site.index].calls;
+                        same->totals.elements += sums[site.index].elements;
+                        same->totals.nanoseconds += sums[site.index].nanoseconds;
+                        same->totals.bytes += sums[site.index].bytes;
+                    }
+                    return result;
+                }
+
+                /**
+                 * Zero the counters and drop the trace events recorded so far.
+                 */
+                inline void reset() {
+                    detail::registry &r = detail::registry::instance();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+
+                    for (const std::shared_ptr<detail::thread_counters> &t : r.threads) {
+                        std::lock_guard<std::mutex> thread_lock(t->mutex);
+                        t->totals.clear();
+                        t->events.clear();
+                    }
+                    r.events_count = 0;
+                }
+
+                /**
+                 * Keep at most capacity trace events, the first ones; 0 turns the event log off and leaves the
+                 * counters only.
+                 */
+                inline void set_trace_capacity(std::size_t capacity) {
+                    detail::registry &r = detail::registry::instance();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+
+                    r.trace_capacity = capacity;
+                    if (r.events_count.load() > capacity) {
+                        /* the first capacity events of all the threads go to one of them */
+                        std::vector<trace_event> events = r.merged_events();
+                        events.resize(capacity);
+                        for (const std::shared_ptr<detail::thread_counters> &t : r.threads) {
+                            std::lock_guard<std::mutex> thread_lock(t->mutex);
+                            t->events.clear();
+                            t->events.shrink_to_fit();
+                        }
+                        if (!r.threads.empty()) {
+                            std::lock_guard<std::mutex> thread_lock(r.threads.front()->mutex);
+                            r.threads.front()->events = std::move(events);
+                        }
+                        r.events_count = capacity;
+                    }
+                }
+
+                /**
+                 * Write the recorded calls in the Trace Event Format, as complete events with the times in
+                 * microseconds, to be opened with chrome://tracing or Perfetto.
+                 */
+                inline void write_trace_events(std::ostream &out) {
+                    detail::registry &r = detail::registry::instance();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+
+                    const std::vector<trace_event> events = r.merged_events();
+                    out << "{\"traceEvents\":[";
+                    for (std::size_t i = 0; i < events.size(); ++i) {
+                        const trace_event &event = events[i];
+                        out << (i == 0 ? "" : ",") << "{\"name\":";
+                        detail::write_json_string(out, event.name);
+                        out << ",\"cat\":\"math\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+                            << ",\"ts\":" << event.start_nanoseconds / 1000.0
+                            << ",\"dur\":" << event.duration_nanoseconds / 1000.0
+                            << ",\"args\":{\"size\":" << event.elements << "}}";
+                    }
+                    out << "]}";
+                }
+            }    // namespace instrumentation
+        }        // namespace math
+    }            // namespace crypto3
+}    // namespace nil
+
+#define CRYPTO3_MATH_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define CRYPTO3_MATH_INSTRUMENT_CONCAT(a, b) CRYPTO3_MATH_INSTRUMENT_CONCAT_IMPL(a, b)
+
+/**
+ * Count the rest of the enclosing scope as one call of the call site name, of the size elements, allocating
+ * bytes bytes. Expands to nothing, with the arguments unevaluated, unless CRYPTO3_MATH_INSTRUMENTATION is defined.
+ * CRYPTO3_MATH_INSTRUMENT_MEMORY counts as the bytes the growth of the expression memory, e.g. of the capacities of
+ * the vectors and workspaces the call fills, from the start to the end of the scope, and
+ * CRYPTO3_MATH_INSTRUMENT_ALLOCATION adds bytes to the innermost call of the thread, for the temporaries.
+ */
+#ifdef CRYPTO3_MATH_INSTRUMENTATION
+#define CRYPTO3_MATH_INSTRUMENT_SITE(name)                                                                 \
+    static ::nil::crypto3::math::instrumentation::detail::call_site &CRYPTO3_MATH_INSTRUMENT_CONCAT(       \
+        crypto3_math_instrument_site_, __LINE__) =                                                         \
+        ::nil::crypto3::math::instrumentation::detail::registry::instance().add(name, __FILE__, __LINE__)
+#define CRYPTO3_MATH_INSTRUMENT(name, elements, bytes)                                                     \
+    CRYPTO3_MATH_INSTRUMENT_SITE(name);                                                                    \
+    ::nil::crypto3::math::instrumentation::detail::scope CRYPTO3_MATH_INSTRUMENT_CONCAT(                   \
+        crypto3_math_instrument_scope_, __LINE__)(                                                         \
+        CRYPTO3_MATH_INSTRUMENT_CONCAT(crypto3_math_instrument_site_, __LINE__), (elements), (bytes))
+#define CRYPTO3_MATH_INSTRUMENT_MEMORY(name, elements, memory)                                             \
+    CRYPTO3_MATH_INSTRUMENT_SITE(name);                                                                    \
+    const auto CRYPTO3_MATH_INSTRUMENT_CONCAT(crypto3_math_instrument_memory_, __LINE__) =                 \
+        [&]() -> std::uint64_t { return (memory); };                                                       \
+    ::nil::crypto3::math::instrumentation::detail::memory_scope<decltype(                                  \
+        CRYPTO3_MATH_INSTRUMENT_CONCAT(crypto3_math_instrument_memory_, __LINE__))>                        \
+        CRYPTO3_MATH_INSTRUMENT_CONCAT(crypto3_math_instrument_scope_, __LINE__)(                          \
+            CRYPTO3_MATH_INSTRUMENT_CONCAT(crypto3_math_instrument_site_, __LINE__), (elements),           \
+            CRYPTO3_MATH_INSTRUMENT_CONCAT(crypto3_math_instrument_memory_, __LINE__))
+#define CRYPTO3_MATH_INSTRUMENT_ALLOCATION(bytes)                                                          \
+    ::nil::crypto3::math::instrumentation::detail::scope::allocation(bytes)
+#else
+#define CRYPTO3_MATH_INSTRUMENT(name, elements, bytes) ((void)0)
+#define CRYPTO3_MATH_INSTRUMENT_MEMORY(name, elements, memory) ((void)0)
+#define CRYPTO3_MATH_INSTRUMENT_ALLOCATION(bytes) ((void)0)
+#endif
+
+#endif    // CRYPTO3_MATH_INSTRUMENTATION_HPP
@@ -26,176 +26,198 @@
 #ifndef CRYPTO3_MATH_KRONECKER_SUBSTITUTION_HPP
 #define CRYPTO3_MATH_KRONECKER_SUBSTITUTION_HPP
 
-#include <vector>
 #include <algorithm>
-#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <vector>
 
-#include <boost/math/tools/polynomial.hpp>
+#if defined(CRYPTO3_MATH_HAS_GMP)
+#include <gmp.h>
+#define CRYPTO3_MATH_KRONECKER_SUBSTITUTION_MPN
+#elif defined(CRYPTO3_MATH_HAS_MPIR)
+#include <mpir.h>
+#define CRYPTO3_MATH_KRONECKER_SUBSTITUTION_MPN
+#endif
 
 namespace nil {
     namespace crypto3 {
         namespace math {
-            namespace polynomial {
-                /*!
-                 * @brief Given two polynomial vectors, A and B, the function performs
-                 * polynomial multiplication and returns the resulting polynomial vector.
-                 * The implementation makes use of
-                 * [Harvey 07, Multipoint Kronecker Substitution, Section 2.1] and
-                 * [Gathen and Gerhard, Modern Computer Algebra 3rd Ed., Section 8.4].
+            namespace detail {
+#ifdef CRYPTO3_MATH_KRONECKER_SUBSTITUTION_MPN
+                typedef mp_limb_t kronecker_limb_type;
+
+                /**
+                 * r = a * b for a of na and b of nb limbs, r of na + nb limbs not overlapping them, with mpn_mul, or
+                 * with mpn_sqr if a and b are the same number.
                  */
-                template<typename FieldType>
-                void kronecker_substitution(std::vector<typename FieldType::value_type>& v3,
-                                            const std::vector<typename FieldType::value_type>& v1,
-                                            const std::vector<typename FieldType::value_type>& v2) {
-                    typedef typename FieldType::value_type value_type;
+                inline void kronecker_limbs_multiplication(kronecker_limb_type *r, const kronecker_limb_type *a,
+                                                           std::size_t na, const kronecker_limb_type *b,
+                                                           std::size_t nb) {
+                    if (a == b && na == nb) {
+                        mpn_sqr(r, a, na);
+                    } else if (na >= nb) {
+                        mpn_mul(r, a, na, b, nb);
+                    } else {
+                        mpn_mul(r, b, nb, a, na);
+                    }
+                }
+#else
+                typedef std::uint32_t kronecker_limb_type;
 
-                    // Initialize
-                    bool square = (v1 == v2) ? 1 : 0;
-
-                    // Polynomial length
-                    std::size_t n1 = v1.size();
-                    std::size_t n2 = v2.size();
-                    std::size_t n3 = n1 + n2 - 1;
-
-                    // Determine number of bits needed
-                    value_type v1_max = *max_element(std::begin(v1), std::end(v1));
-                    value_type v2_max = *max_element(std::begin(v2), std::end(v2));
-                    /*size_t b = 2 * (v1_max * v2_max).as_bigint().num_bits() + 1;
-
-
-                    // Number of limbs needed in total
-                    std::size_t k1 = (n1 * b + (GMP_NUMB_BITS)-1) / GMP_NUMB_BITS;
-                    std::size_t k2 = (n2 * b + (GMP_NUMB_BITS)-1) / GMP_NUMB_BITS;
-
-
-                    // Output polynomial
-                    v3.resize(n3, value_type::zero());
-
-                    // Allocate all MP_LIMB_T space once and store the reference pointer M1
-                    // to free memory afterwards. P1, P2, and P3 will remain fixed pointers
-                    // to the start of their respective polynomials as reference.
-                    mp_limb_t* m1 = (mp_limb_t*)malloc(sizeof(mp_limb_t) * 2 * (k1 + k2));
-                    mp_limb_t* p1 = m1;
-                    mp_limb_t* p2 = p1 + k1;
-                    mp_limb_t* p3 = p2 + k2;
-
-                    // Helper variables
-                    mp_limb_t* ref;
-                    mp_limb_t limb;
-                    unsigned long val;
-                    unsigned long mask;
-                    unsigned long limb_b;
-                    unsigned long delta;
-                    unsigned long delta_b;
-
-                    // Construct P1 limb
-                    ref = p1;
-                    limb = 0;
-                    limb_b = 0;
-                    for (std::size_t i = 0; i < n1; i++) {
-                        val = v1[i].as_ulong();
-                        limb += (val << limb_b);
-
-                         // If the next iteration of LIMB_B is >= to the GMP_LIMB_BITS, then
-                         // write it out to MP_LIMB_T* and reset LIMB. If VAL has remaining
-                         // bits due to GMP_LIMB_BITS boundary, set it in LIMB and proceed.
-                        if (limb_b + b >= GMP_LIMB_BITS) {
-                            *ref++ = limb;
-                            limb = limb_b ? (val >> (GMP_LIMB_BITS - limb_b)) : 0;
-                            limb_b -= GMP_LIMB_BITS;
+                /**
+                 * r = a * b for a of na and b of nb limbs, r of na + nb limbs not overlapping them, with the
+                 * schoolbook multiplication. Only used when the library is built without GMP or MPIR, so that
+                 * multiplication_on_kronecker is still available, multiplication does not dispatch to it then.
+                 */
+                inline void kronecker_limbs_multiplication(kronecker_limb_type *r, const kronecker_limb_type *a,
+                                                           std::size_t na, const kronecker_limb_type *b,
+                                                           std::size_t nb) {
+                    std::fill(r, r + na + nb, kronecker_limb_type(0));
+                    for (std::size_t i = 0; i < na; ++i) {
+                        std::uint64_t carry = 0;
+                        for (std::size_t j = 0; j < nb; ++j) {
+                            carry += std::uint64_t(a[i]) * b[j] + r[i + j];
+                            r[i + j] = static_cast<kronecker_limb_type>(carry);
+                            carry >>= 32;
                         }
-                        limb_b += b;
+                        r[i + nb] = static_cast<kronecker_limb_type>(carry);
                     }
-                    if (limb_b)
-                        *ref++ = limb;
-
-                    // Construct P2 limb. If V2 == V1, then P2 = P1 - square case.
-                    if (square)
-                        p2 = p1;
-                    else {
-                        ref = p2;
-                        limb = 0;
-                        limb_b = 0;
-                        for (std::size_t i = 0; i < n2; i++) {
-                            val = v2[i].as_ulong();
-                            limb += (val << limb_b);
-
-                             // If the next iteration of LIMB_B is >= to the GMP_LIMB_BITS, then
-                             // write it out to MP_LIMB_T* and reset LIMB. If VAL has remaining
-                             // bits due to GMP_LIMB_BITS boundary, set it in LIMB and proceed.
-                            if (limb_b + b >= GMP_LIMB_BITS) {
-                                *ref++ = limb;
-                                limb = limb_b ? (val >> (GMP_LIMB_BITS - limb_b)) : 0;
-                                limb_b -= GMP_LIMB_BITS;
+                }
+#endif
+
+                constexpr std::size_t kronecker_limb_bits = 8 * sizeof(kronecker_limb_type);
+
+                /**
+                 * Write the coefficients of A, as integers below the modulus, to r at the bit offsets 0, bits,
+                 * 2 * bits, ..., which is the value of A at x = 2^bits.
+                 */
+                template<typename FieldType, typename InputRange>
+                void kronecker_pack(std::vector<kronecker_limb_type> &r, const InputRange &a, std::size_t bits) {
+                    typedef typename FieldType::integral_type integral_type;
+
+                    constexpr std::size_t L = kronecker_limb_bits;
+                    constexpr std::size_t coefficient_limbs = (FieldType::modulus_bits + L - 1) / L;
+                    const integral_type mask = integral_type(~kronecker_limb_type(0));
+
+                    const std::size_t n = std::distance(std::begin(a), std::end(a));
+                    r.assign((n * bits + coefficient_limbs * L) / L + 1, kronecker_limb_type(0));
+
+                    std::size_t offset = 0;
+                    for (auto it = std::begin(a); it != std::end(a); ++it, offset += bits) {
+                        integral_type t = integral_type(it->data);
+                        std::size_t position = offset;
+                        for (std::size_t i = 0; i < coefficient_limbs; ++i, position += L) {
+                            const kronecker_limb_type w = static_cast<kronecker_limb_type>(t & mask);
+                            if (i + 1 < coefficient_limbs) {
+                                t >>= L;
+                            }
+                            const std::size_t shift = position % L;
+                            r[position / L] |= w << shift;
+                            if (shift != 0) {
+                                r[position / L + 1] |= w >> (L - shift);
                             }
-                            limb_b += b;
                         }
-                        if (limb_b)
-                            *ref++ = limb;
                     }
 
-                    // Multiply P1 and P2 limbs and store result in P3 limb.
-                    mpn_mul(p3, p1, k1, p2, k2);
-
-                    // Perfect alignment case: bits B is equivalent to GMP_LIMB_BITS
-                    if (b == GMP_LIMB_BITS)
-                        for (std::size_t i = 0; i < n3; i++)
-                            v3[i] = value_type(*p3++);
-                    // Non-alignment case
-                    else {
-                        // Mask of 2^b - 1
-                        mask = (1UL << b) - 1;
-
-                        limb = 0;
-                        limb_b = 0;
-                        for (std::size_t i = 0; i < n3; i++) {
-
-                             // If the coefficient's bit length is contained in LIMB, then
-                             // write the masked value out to vector V3 and decrement LIMB
-                             // by B bits.
-                            if (b <= limb_b) {
-                                v3[i] = value_type(limb & mask);
-
-                                delta = b;
-                                delta_b = limb_b - delta;
-                            }
+                    while (r.size() > 1 && r.back() == 0) {
+                        r.pop_back();
+                    }
+                }
+
+                /**
+                 * Read the n fields of bits bits from p, of size limbs, and reduce each of them modulo the field
+                 * modulus into c.
+                 */
+                template<typename FieldType, typename Range>
+                void kronecker_unpack(Range &c, std::size_t n, const kronecker_limb_type *p, std::size_t size,
+                                      std::size_t bits) {
+                    typedef typename FieldType::value_type value_type;
 
-                             // If the remaining coefficient is across two LIMBs, then write
-                             // to vector V3 the current limb's value and add upper bits from
-                             // the second part. Lastly, decrement LIMB by the coefficient's
-                             // upper portion bit length.
-                            else {
-                                v3[i] = value_type(limb);
-                                v3[i] += value_type(((limb = *p3++) << limb_b) & mask);
+                    constexpr std::size_t L = kronecker_limb_bits;
+                    const std::size_t words = (bits + L - 1) / L;
 
-                                delta = b - limb_b;
-                                delta_b = GMP_LIMB_BITS - delta;
-                            }
+                    /* 2^L, from the square of 2^{L / 2} to stay within the integer constructors of the field */
+                    value_type radix = value_type(std::uint64_t(1) << (L / 2));
+                    radix = radix * radix;
+
+                    const auto limb = [&](std::size_t i) { return i < size ? p[i] : kronecker_limb_type(0); };
 
-                            limb >>= delta;
-                            limb_b = delta_b;
+                    c.resize(n);
+                    for (std::size_t j = 0; j < n; ++j) {
+                        value_type v = value_type::zero();
+                        for (std::size_t k = words; k-- > 0;) {
+                            const std::size_t position = j * bits + k * L;
+                            const std::size_t shift = position % L;
+                            kronecker_limb_type w = limb(position / L) >> shift;
+                            if (shift != 0) {
+                                w |= limb(position / L + 1) << (L - shift);
+                            }
+                            const std::size_t width = std::min(L, bits - k * L);
+                            if (width < L) {
+                                w &= (kronecker_limb_type(1) << width) - 1;
+                            }
+                            v = v * radix + value_type(w);
                         }
+                        c[j] = v;
                     }
+                }
+            }    // namespace detail
+
+            /*!
+             * @brief Given two polynomial vectors, A and B, the function performs
+             * polynomial multiplication and returns the resulting polynomial vector.
+             * The coefficients are packed into the integers A(2^b) and B(2^b), with b bits enough for every
+             * coefficient of the product over the integers, which are multiplied with mpn_mul of GMP or MPIR, and
+             * the coefficients of C are read back from the b-bit fields of the product. C has
+             * A.size() + B.size() - 1 coefficients.
+             * The implementation makes use of
+             * [Harvey 07, Multipoint Kronecker Substitution, Section 2.1] and
+             * [Gathen and Gerhard, Modern Computer Algebra 3rd Ed., Section 8.4].
+             */
+            template<typename FieldType, typename Range, typename InputRange1, typename InputRange2>
+            void kronecker_substitution(Range &c, const InputRange1 &a, const InputRange2 &b) {
+                typedef typename FieldType::value_type value_type;
+                typedef detail::kronecker_limb_type limb_type;
+
+                const std::size_t n1 = std::distance(std::begin(a), std::end(a));
+                const std::size_t n2 = std::distance(std::begin(b), std::end(b));
+                if (n1 == 0 || n2 == 0) {
+                    c.resize(1);
+                    c[0] = value_type::zero();
+                    return;
+                }
 
-                    // Free memory
-                    free(m1);
-
-                    _condense(v3);*/
+                /* every coefficient of the product is below min(n1, n2) * (p - 1)^2 < 2^bits */
+                std::size_t bits = 2 * FieldType::modulus_bits;
+                for (std::size_t k = 1; k < std::min(n1, n2); k <<= 1) {
+                    ++bits;
                 }
 
-                /**
-                 * Perform the multiplication of two polynomials, polynomial A * polynomial B, using Kronecker Substitution,
-                 * and stores result in polynomial C.
-                 */
-                template<typename FieldType>
-                void multiplication_on_kronecker(std::vector<typename FieldType::value_type>& c,
-                                                             const std::vector<typename FieldType::value_type>& a,
-                                                             const std::vector<typename FieldType::value_type>& b) {
-                    kronecker_substitution<FieldType>(c, a, b);
+                const bool square = static_cast<const void *>(&a) == static_cast<const void *>(&b);
+
+                std::vector<limb_type> p1, p2;
+                detail::kronecker_pack<FieldType>(p1, a, bits);
+                if (!square) {
+                    detail::kronecker_pack<FieldType>(p2, b, bits);
                 }
-            }    // namespace polynomial    
-        }    // namespace fft
+                const std::vector<limb_type> &q2 = square ? p1 : p2;
+
+                std::vector<limb_type> p3(p1.size() + q2.size());
+                detail::kronecker_limbs_multiplication(p3.data(), p1.data(), p1.size(), q2.data(), q2.size());
+
+                detail::kronecker_unpack<FieldType>(c, n1 + n2 - 1, p3.data(), p3.size(), bits);
+            }
+
+            /**
+             * Perform the multiplication of two polynomials, polynomial A * polynomial B, using Kronecker Substitution,
+             * and stores result in polynomial C.
+             */
+            template<typename FieldType, typename Range, typename InputRange1, typename InputRange2>
+            void multiplication_on_kronecker(Range &c, const InputRange1 &a, const InputRange2 &b) {
+                kronecker_substitution<FieldType>(c, a, b);
+            }
+        }    // namespace math
     }        // namespace crypto3
 }    // namespace nil
 
-#endif    // ALGEBRA_FFT_KRONECKER_SUBSTITUTION_HPP
+#endif    // CRYPTO3_MATH_KRONECKER_SUBSTITUTION_HPP
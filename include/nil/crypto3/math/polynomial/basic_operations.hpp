@@ -30,12 +30,39 @@
 #include <vector>
 
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/instrumentation.hpp>
+#include <nil/crypto3/math/kronecker_substitution.hpp>
 #include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
 #include <nil/crypto3/math/detail/field_utils.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace math {
+            namespace detail {
+                /**
+                 * Size of the quotient and of the divisor from which division switches from the long division to
+                 * newton_division.
+                 */
+                constexpr std::size_t newton_division_threshold = 1024;
+
+                /**
+                 * Size of the product up to which multiplication goes through kronecker_substitution instead of
+                 * the FFT, when the library is built with GMP or MPIR.
+                 */
+                constexpr std::size_t kronecker_multiplication_max_size = 1ul << 14;
+            }    // namespace detail
+
+            /**
+             * Sizes of the smaller factor from which multiplication switches from the schoolbook product to
+             * Karatsuba, and from Karatsuba to the FFT (or to kronecker_substitution). Specialize it for a field
+             * whose arithmetic moves the crossovers.
+             */
+            template<typename FieldType>
+            struct multiplication_thresholds {
+                constexpr static const std::size_t karatsuba = 16;
+                constexpr static const std::size_t fft = 256;
+            };
+
             /**
              * Returns true if polynomial A is a zero polynomial.
              */
@@ -148,12 +175,130 @@ namespace nil {
                 condense(c);
             }
 
+            namespace detail {
+                /**
+                 * r = a * b for a of na and b of nb coefficients, r of na + nb - 1 coefficients not overlapping
+                 * them. A square, a == b, takes the products a_i * a_j, i < j, once.
+                 */
+                template<typename FieldValueType>
+                void schoolbook_multiplication(FieldValueType *r, const FieldValueType *a, std::size_t na,
+                                               const FieldValueType *b, std::size_t nb) {
+                    std::fill(r, r + na + nb - 1, FieldValueType::zero());
+                    if (a == b && na == nb) {
+                        for (std::size_t i = 0; i < na; ++i) {
+                            for (std::size_t j = i + 1; j < na; ++j) {
+                                r[i + j] += a[i] * a[j];
+                            }
+                        }
+                        for (std::size_t i = 0; i < 2 * na - 1; ++i) {
+                            r[i] = r[i].doubled();
+                        }
+                        for (std::size_t i = 0; i < na; ++i) {
+                            r[2 * i] += a[i].squared();
+                        }
+                        return;
+                    }
+                    for (std::size_t i = 0; i < na; ++i) {
+                        for (std::size_t j = 0; j < nb; ++j) {
+                            r[i + j] += a[i] * b[j];
+                        }
+                    }
+                }
+
+                /**
+                 * Size of the scratch karatsuba_multiplication needs for factors of na and nb coefficients: every
+                 * level takes less than 2 * (na + nb) + 2 from it for factors of about half of the size.
+                 */
+                constexpr std::size_t karatsuba_scratch_size(std::size_t na, std::size_t nb) {
+                    return 4 * (na + nb) + 256;
+                }
+
+                /**
+                 * r = a * b for a of na and b of nb coefficients, r of na + nb - 1 coefficients not overlapping
+                 * them, with Karatsuba down to the schoolbook product below the threshold. A factor over twice as
+                 * long as the other is multiplied by slices of the size of the other.
+                 * Below we make use of the Karatsuba multiplication from
+                 * [von zur Gathen & Gerhard 2013. Modern Computer Algebra, 3rd edition], section 8.1.
+                 */
+                template<typename FieldValueType>
+                void karatsuba_multiplication(FieldValueType *r, const FieldValueType *a, std::size_t na,
+                                              const FieldValueType *b, std::size_t nb, FieldValueType *scratch,
+                                              FieldValueType *scratch_end, std::size_t threshold) {
+                    if (na < nb) {
+                        std::swap(a, b);
+                        std::swap(na, nb);
+                    }
+                    if (nb < std::max<std::size_t>(threshold, 2)) {
+                        schoolbook_multiplication(r, a, na, b, nb);
+                        return;
+                    }
+
+                    if (na >= 2 * nb) {
+                        FieldValueType *t = scratch;
+                        scratch += 2 * nb - 1;
+                        BOOST_ASSERT(scratch <= scratch_end);
+
+                        std::fill(r, r + na + nb - 1, FieldValueType::zero());
+                        for (std::size_t offset = 0; offset < na; offset += nb) {
+                            const std::size_t length = std::min(nb, na - offset);
+                            karatsuba_multiplication(t, a + offset, length, b, nb, scratch, scratch_end, threshold);
+                            for (std::size_t i = 0; i < length + nb - 1; ++i) {
+                                r[offset + i] += t[i];
+                            }
+                        }
+                        return;
+                    }
+
+                    /* a = a_0 + x^m * a_1, b = b_0 + x^m * b_1, with nb > m, so that b_1 is not empty */
+                    const bool square = a == b && na == nb;
+                    const std::size_t m = na / 2, la = na - m, lb = std::max(m, nb - m);
+
+                    FieldValueType *sa = scratch;
+                    FieldValueType *sb = square ? sa : sa + la;
+                    FieldValueType *z1 = sb + lb;
+                    scratch = z1 + la + lb - 1;
+                    BOOST_ASSERT(scratch <= scratch_end);
+
+                    /* r = z_0 + x^{2m} * z_2 */
+                    karatsuba_multiplication(r, a, m, b, m, scratch, scratch_end, threshold);
+                    r[2 * m - 1] = FieldValueType::zero();
+                    karatsuba_multiplication(r + 2 * m, a + m, la, b + m, nb - m, scratch, scratch_end, threshold);
+
+                    for (std::size_t i = 0; i < la; ++i) {
+                        sa[i] = i < m ? a[i] + a[m + i] : a[m + i];
+                    }
+                    if (!square) {
+                        for (std::size_t i = 0; i < lb; ++i) {
+                            sb[i] = i < m ? (i < nb - m ? b[i] + b[m + i] : b[i]) : b[m + i];
+                        }
+                    }
+
+                    /* z_1 = (a_0 + a_1) * (b_0 + b_1) - z_0 - z_2 */
+                    karatsuba_multiplication(z1, sa, la, sb, lb, scratch, scratch_end, threshold);
+                    for (std::size_t i = 0; i < 2 * m - 1; ++i) {
+                        z1[i] -= r[i];
+                    }
+                    for (std::size_t i = 0; i < la + nb - m - 1; ++i) {
+                        z1[i] -= r[2 * m + i];
+                    }
+
+                    for (std::size_t i = 0; i < la + lb - 1; ++i) {
+                        r[m + i] += z1[i];
+                    }
+                }
+            }    // namespace detail
+
             /**
-             * Perform the multiplication of two polynomials, polynomial A * polynomial B, using FFT, and stores
-             * result in polynomial C.
+             * Perform the multiplication of two polynomials, polynomial A * polynomial B, and stores result in
+             * polynomial C: with the schoolbook product or Karatsuba below the multiplication_thresholds of the
+             * field, with FFT above them. The transforms of A and B run in the caller-owned u and v, which are
+             * resized and keep their memory for the next call, so A and B may be of other range types than C and
+             * u and v.
+             * Products the field has no FFT of the size for go through Karatsuba, or, as do mid-size products,
+             * through kronecker_substitution with GMP or MPIR. The square A * A makes one transform.
              */
-            template<typename Range>
-            void multiplication(Range &c, const Range &a, const Range &b) {
+            template<typename Range, typename InputRange1, typename InputRange2, typename WorkRange>
+            void multiplication(Range &c, const InputRange1 &a, const InputRange2 &b, WorkRange &u, WorkRange &v) {
 
                 typedef
                     typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
@@ -162,19 +307,68 @@ namespace nil {
                 BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
                 BOOST_STATIC_ASSERT(std::is_same<typename FieldType::value_type, value_type>::value);
 
-                const std::size_t n = detail::power_of_two(a.size() + b.size() - 1);
+                const std::size_t size = a.size() + b.size() - 1;
+                CRYPTO3_MATH_INSTRUMENT_MEMORY("multiplication", size,
+                                               (c.capacity() + u.capacity() + v.capacity()) * sizeof(value_type));
+
+                const std::size_t n = detail::power_of_two(size);
+                const bool square = static_cast<const void *>(&a) == static_cast<const void *>(&b) ||
+                                    (a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin()));
+
+                /* the FFT needs a subgroup of the size n, which fields of a small 2-adicity do not have */
+                const std::size_t s = algebra::fields::arithmetic_params<FieldType>::s;
+                const bool fft_available = s >= 8 * sizeof(std::size_t) || n <= (std::size_t(1) << s);
+
+#ifdef CRYPTO3_MATH_KRONECKER_SUBSTITUTION_MPN
+                if (!fft_available || (std::min(a.size(), b.size()) >= multiplication_thresholds<FieldType>::fft &&
+                                       size <= detail::kronecker_multiplication_max_size)) {
+                    if (square) {
+                        kronecker_substitution<FieldType>(c, a, a);
+                    } else {
+                        kronecker_substitution<FieldType>(c, a, b);
+                    }
+                    condense(c);
+                    return;
+                }
+#endif
+
+                if (!fft_available || std::min(a.size(), b.size()) < multiplication_thresholds<FieldType>::fft) {
+                    const std::vector<value_type> x(a.begin(), a.end());
+                    std::vector<value_type> y;
+                    if (!square) {
+                        y.assign(b.begin(), b.end());
+                    }
+
+                    std::vector<value_type> r(size), scratch(detail::karatsuba_scratch_size(a.size(), b.size()));
+                    CRYPTO3_MATH_INSTRUMENT_ALLOCATION(
+                        (x.capacity() + y.capacity() + r.capacity() + scratch.capacity()) * sizeof(value_type));
+                    detail::karatsuba_multiplication(r.data(), x.data(), a.size(), square ? x.data() : y.data(),
+                                                     b.size(), scratch.data(), scratch.data() + scratch.size(),
+                                                     multiplication_thresholds<FieldType>::karatsuba);
+
+                    c.resize(size);
+                    std::copy(r.begin(), r.end(), c.begin());
+                    condense(c);
+                    return;
+                }
+
                 value_type omega = unity_root<FieldType>(n);
 
-                Range u(a);
-                Range v(b);
-                u.resize(n, value_type::zero());
-                v.resize(n, value_type::zero());
+                u.resize(n);
+                std::fill(std::copy(a.begin(), a.end(), u.begin()), u.end(), value_type::zero());
+                if (!square) {
+                    v.resize(n);
+                    std::fill(std::copy(b.begin(), b.end(), v.begin()), v.end(), value_type::zero());
+                }
                 c.resize(n, value_type::zero());
 
                 detail::basic_radix2_fft<FieldType>(u, omega);
-                detail::basic_radix2_fft<FieldType>(v, omega);
-
-                std::transform(u.begin(), u.end(), v.begin(), c.begin(), std::multiplies<value_type>());
+                if (square) {
+                    std::transform(u.begin(), u.end(), c.begin(), [](const value_type &x) { return x.squared(); });
+                } else {
+                    detail::basic_radix2_fft<FieldType>(v, omega);
+                    std::transform(u.begin(), u.end(), v.begin(), c.begin(), std::multiplies<value_type>());
+                }
 
                 detail::basic_radix2_fft<FieldType>(c, omega.inversed());
 
@@ -186,6 +380,19 @@ namespace nil {
                 condense(c);
             }
 
+            /**
+             * Perform the multiplication of two polynomials, polynomial A * polynomial B, using FFT, and stores
+             * result in polynomial C.
+             */
+            template<typename Range>
+            void multiplication(Range &c, const Range &a, const Range &b) {
+                typedef
+                    typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                std::vector<value_type> u, v;
+                multiplication(c, a, b, u, v);
+            }
+
             /**
              * Compute the transposed, polynomial multiplication of vector a and vector b.
              * Below we make use of the transposed multiplication definition from
@@ -206,7 +413,7 @@ namespace nil {
                 multiplication(r, r, c);
 
                 /* Determine Middle Product */
-                Range result;
+                Range result(a.get_allocator());
                 for (std::size_t i = m - 1; i < n + m; i++) {
                     result.emplace_back(r[i]);
                 }
@@ -214,37 +421,165 @@ namespace nil {
             }
 
             /**
-             * Perform the standard Euclidean Division algorithm.
+             * Perform the division of polynomial A by the binomial x^n - c, n > 0, in O(deg(A)): the coefficients
+             * of Q follow from the top ones down as q_{k - n} = a_k + c * q_k.
+             * Output: Polynomial Q, Polynomial R, such that A = (Q * (x^n - c)) + R.
+             */
+            template<typename Range>
+            void division_by_binomial(
+                Range &q, Range &r, const Range &a, std::size_t n,
+                const typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type &c) {
+
+                typedef
+                    typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                if (a.size() <= n) {
+                    q = Range(1, value_type::zero(), a.get_allocator());
+                    r = Range(a);
+                    condense(r);
+                    return;
+                }
+
+                q = Range(a.size() - n, value_type::zero(), a.get_allocator());
+                for (std::size_t k = a.size(); k-- > n;) {
+                    q[k - n] = k < q.size() ? a[k] + c * q[k] : a[k];
+                }
+
+                r = Range(a.begin(), a.begin() + n, a.get_allocator());
+                for (std::size_t k = 0; k < std::min(n, q.size()); k++) {
+                    r[k] += c * q[k];
+                }
+                condense(r);
+                condense(q);
+            }
+
+            /**
+             * Perform the synthetic division of polynomial A by x - z in O(deg(A)).
+             * Output: Polynomial Q, such that A = (Q * (x - z)) + A(z); A(z) is returned.
+             */
+            template<typename Range>
+            typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
+                division_by_linear(
+                    Range &q, const Range &a,
+                    const typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type &z) {
+
+                typedef
+                    typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                if (a.size() <= 1) {
+                    q = Range(1, value_type::zero(), a.get_allocator());
+                    return a.size() == 1 ? a[0] : value_type::zero();
+                }
+
+                q = Range(a.size() - 1, value_type::zero(), a.get_allocator());
+                value_type carry = a.back();
+                for (std::size_t k = a.size() - 1; k != 0; --k) {
+                    q[k - 1] = carry;
+                    carry = a[k - 1] + z * carry;
+                }
+                condense(q);
+                return carry;
+            }
+
+            /**
+             * Compute the first n coefficients of the power series 1 / A, i.e. the polynomial G of degree below n
+             * such that A * G = 1 mod x^n. Runs the Newton iteration G = G * (2 - A * G), which doubles the number
+             * of correct coefficients of G at each step, with FFT multiplications.
+             * The constant coefficient of A must not be zero.
+             */
+            template<typename Range>
+            Range reciprocal(const Range &a, std::size_t n) {
+
+                typedef
+                    typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                Range g(1, a[0].inversed(), a.get_allocator());
+                Range e(a.get_allocator());
+
+                for (std::size_t l = 1; l < n;) {
+                    l = std::min(2 * l, n);
+
+                    const Range a_l(a.begin(), a.begin() + std::min(l, a.size()), a.get_allocator());
+                    multiplication(e, a_l, g);
+                    e.resize(l, value_type::zero());
+
+                    /* e = 2 - A * G mod x^l */
+                    std::transform(e.begin(), e.end(), e.begin(), std::negate<value_type>());
+                    e[0] += value_type(2);
+
+                    multiplication(g, g, e);
+                    g.resize(l, value_type::zero());
+                }
+                return g;
+            }
+
+            /**
+             * Perform the division of polynomial A by polynomial B in O(M(n)), M(n) being the cost of the FFT
+             * multiplication. The reversed quotient is the first deg(A) - deg(B) + 1 coefficients of the reversed
+             * A times the reciprocal of the reversed B [von zur Gathen & Gerhard, Modern Computer Algebra, 9.1].
              * Input: Polynomial A, Polynomial B, where A / B
              * Output: Polynomial Q, Polynomial R, such that A = (Q * B) + R.
              */
             template<typename Range>
-            void division(Range &q, Range &r, const Range &a, const Range &b) {
+            void newton_division(Range &q, Range &r, const Range &a, const Range &b) {
 
                 typedef
                     typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
 
+                if (a.size() < b.size()) {
+                    q = Range(1, value_type::zero(), a.get_allocator());
+                    r = Range(a);
+                    return;
+                }
+
+                const std::size_t k = a.size() - b.size() + 1; /* Size of Q */
+
+                Range a_reversed(a), b_reversed(b);
+                reverse(a_reversed, k);
+                reverse(b_reversed, std::min(k, b.size()));
+
+                multiplication(q, a_reversed, reciprocal(b_reversed, k));
+                q.resize(k, value_type::zero());
+                std::reverse(q.begin(), q.end());
+
+                /* only the deg(B) low coefficients of A - Q * B can be non-zero */
+                Range qb(a.get_allocator());
+                multiplication(qb, q, b);
+                r = Range(a.begin(), a.begin() + std::max<std::size_t>(b.size() - 1, 1), a.get_allocator());
+                for (std::size_t i = 0; i < std::min(r.size(), qb.size()); i++) {
+                    r[i] -= qb[i];
+                }
+
+                condense(r);
+                condense(q);
+            }
+
+            /**
+             * Perform the standard Euclidean Division algorithm. Divisions with both the quotient and the divisor
+             * of at least detail::newton_division_threshold coefficients go through newton_division.
+             * Input: Polynomial A, Polynomial B, where A / B
+             * Output: Polynomial Q, Polynomial R, such that A = (Q * B) + R.
+             */
+            template<typename Range>
+            void division(Range &q, Range &r, const Range &a, const Range &b) {
+                typedef
+                    typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                CRYPTO3_MATH_INSTRUMENT_MEMORY("division", a.size(),
+                                               (q.capacity() + r.capacity()) * sizeof(value_type));
+
                 std::size_t d = b.size() - 1; /* Degree of B */
 
-                if (b.back() == value_type::one() && is_zero(b.begin() + 1, b.end() - 1) && a.size() >= b.size()) {
-                    q = Range(a.size() - b.size() + 1, value_type::zero());
-                    r = Range(a.begin(), a.end() - (a.size() - b.size() + 1));
-
-                    value_type x = -b[0];
-                    auto end = a.end() - 1;
-                    for (std::size_t t = q.size(); t != 0; --t, --end) {
-                        q[t - 1] += *end;
-                        if (t - 1 >= d) {
-                            q[t - 1 - d] = q[t - 1] * x;
-                        } else {
-                            r[t - 1] += q[t - 1] * x;
-                        }
-                    }
-                    condense(r);
+                if (d > 0 && b.back() == value_type::one() && is_zero(b.begin() + 1, b.end() - 1) &&
+                    a.size() >= b.size()) {
+                    division_by_binomial(q, r, a, d, -b[0]);
+                } else if (a.size() >= b.size() &&
+                           std::min(a.size() - b.size() + 1, b.size()) >= detail::newton_division_threshold) {
+                    newton_division(q, r, a, b);
                 } else {
                     value_type c = b.back().inversed(); /* Inverse of Leading Coefficient of B */
                     r = Range(a);
-                    q = Range(r.size(), value_type::zero());
+                    q = Range(r.size(), value_type::zero(), a.get_allocator());
 
                     std::size_t r_deg = r.size() - 1;
                     std::size_t shift;
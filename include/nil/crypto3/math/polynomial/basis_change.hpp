@@ -27,14 +27,65 @@
 #define CRYPTO3_MATH_BASIS_CHANGE_HPP
 
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <vector>
 
+#include <nil/crypto3/math/span.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
 #include <nil/crypto3/math/polynomial/basic_operations.hpp>
 #include <nil/crypto3/math/polynomial/xgcd.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace math {
+            namespace detail {
+                /**
+                 * Number of points and of coefficients from which polynomial::evaluate_many switches from
+                 * evaluate_with_horner to the remainder tree. Below it on either side the O(nk) of Horner's rule,
+                 * which also splits between threads evenly, is ahead of the logarithmic factors of the tree.
+                 */
+                constexpr std::size_t subproduct_tree_evaluation_threshold = 2048;
+
+                /**
+                 * Least number of coefficients per chunk when evaluate_with_horner splits the coefficients between
+                 * threads.
+                 */
+                constexpr std::size_t horner_chunk_size = 1ul << 12;
+            }    // namespace detail
+
+            /**
+             * Compute the Subproduct Tree of the points x_0, ..., x_{k-1} and store it in Tree T:
+             * T_{0, j} = x - x_j and T_{i, j} = T_{i - 1, 2j} * T_{i - 1, 2j + 1}, with a last node of a row
+             * without a pair carried up to the next row as it is. The root T_{T.size() - 1, 0} is the product of
+             * all x - x_j.
+             */
+            template<typename FieldType>
+            void compute_subproduct_tree(std::vector<std::vector<std::vector<typename FieldType::value_type>>> &T,
+                                         const std::vector<typename FieldType::value_type> &points) {
+
+                typedef typename FieldType::value_type value_type;
+
+                T.assign(1, std::vector<std::vector<value_type>>(points.size()));
+                for (std::size_t j = 0; j < points.size(); j++) {
+                    T[0][j] = {-points[j], value_type::one()};
+                }
+
+                while (T.back().size() > 1) {
+                    const std::vector<std::vector<value_type>> &children = T.back();
+
+                    std::vector<std::vector<value_type>> row((children.size() + 1) / 2);
+                    for (std::size_t j = 0; j < row.size(); j++) {
+                        if (2 * j + 1 < children.size()) {
+                            multiplication(row[j], children[2 * j], children[2 * j + 1]);
+                        } else {
+                            row[j] = children[2 * j];
+                        }
+                    }
+                    T.push_back(std::move(row));
+                }
+            }
 
             /**
              * Compute the Subproduct Tree of degree 2^M and store it in Tree T.
@@ -48,136 +99,376 @@ namespace nil {
 
                 typedef typename FieldType::value_type value_type;
 
-                if (T.size() != m + 1)
-                    T.resize(m + 1);
-
                 /*
                  * Subproduct tree T is represented as a 2-dimensional array T_{i, j}.
                  * T_{i, j} = product_{l = [2^i * j] to [2^i * (j+1) - 1]} (x - x_l)
                  * Note: n = 2^m.
                  */
+                std::vector<value_type> points(1u << m);
+                for (std::size_t j = 0; j < points.size(); j++) {
+                    points[j] = value_type(j);
+                }
 
-                /* Precompute the first row. */
-                T[0] = std::vector<std::vector<value_type>>(1u << m);
-                for (std::size_t j = 0; j < (1u << m); j++) {
-                    T[0][j] = std::vector<value_type>(2, value_type::one());
-                    T[0][j][0] = value_type(-j);
+                compute_subproduct_tree<FieldType>(T, points);
+            }
+
+            /**
+             * Evaluate polynomial A at the points of the Subproduct Tree T with the remainder tree: the remainders
+             * of A modulo the nodes are taken from the root down, and its remainder modulo a leaf x - x_j is A(x_j).
+             * Below we make use of the algorithm 10.5 from
+             * [von zur Gathen & Gerhard 2013. Modern Computer Algebra, 3rd edition], on page 299.
+             */
+            template<typename FieldType, typename Range>
+            std::vector<typename FieldType::value_type> evaluate_with_subproduct_tree(
+                const Range &a, const std::vector<std::vector<std::vector<typename FieldType::value_type>>> &T) {
+
+                typedef typename FieldType::value_type value_type;
+
+                std::vector<value_type> q;
+                std::vector<std::vector<value_type>> remainders(1), next;
+
+                const std::vector<value_type> dividend(std::begin(a), std::end(a));
+                if (dividend.empty()) {
+                    return std::vector<value_type>(T[0].size(), value_type::zero());
                 }
+                division(q, remainders[0], dividend, T.back()[0]);
 
-                std::vector<value_type> a;
-                std::vector<value_type> b;
+                /* the parent of T_{i, j} is T_{i + 1, j / 2} */
+                for (std::size_t i = T.size() - 1; i-- > 0;) {
+                    next.resize(T[i].size());
+                    for (std::size_t j = 0; j < T[i].size(); j++) {
+                        division(q, next[j], remainders[j / 2], T[i][j]);
+                    }
+                    remainders.swap(next);
+                }
+
+                std::vector<value_type> result(remainders.size());
+                for (std::size_t j = 0; j < result.size(); j++) {
+                    result[j] = remainders[j][0];
+                }
+                return result;
+            }
+
+            /**
+             * Evaluate polynomial A at the points with Horner's rule, a block of several points per pass over the
+             * coefficients: the accumulators of a block are independent of each other, so their multiplications
+             * overlap instead of waiting on one another. The blocks run on the global thread pool, and when there
+             * are fewer blocks than threads the coefficients are split as well, A = sum_c A_c(x) * x^{l_c}.
+             */
+            template<typename FieldType, typename Range>
+            std::vector<typename FieldType::value_type> evaluate_with_horner(
+                const Range &a, const std::vector<typename FieldType::value_type> &points) {
+
+                typedef typename FieldType::value_type value_type;
 
-                std::size_t index = 0;
-                for (std::size_t i = 1; i <= m; i++) {
-                    T[i] = std::vector<std::vector<value_type>>(1u << (m - i));
-                    for (std::size_t j = 0; j < (1u << (m - i)); j++) {
-                        a = T[i - 1][index];
-                        index++;
+                constexpr std::size_t block = 8;
 
-                        b = T[i - 1][index];
-                        index++;
+                const std::size_t n = std::distance(std::begin(a), std::end(a));
+                const std::size_t blocks = (points.size() + block - 1) / block;
 
-                        multiplication(T[i][j], a, b);
+                thread_pool *pool = thread_pool::global().get();
+                std::size_t chunks = 1;
+                if (pool != nullptr && blocks < pool->size()) {
+                    chunks = std::max<std::size_t>(
+                        1, std::min(pool->size() / std::max<std::size_t>(blocks, 1), n / detail::horner_chunk_size));
+                }
+
+                std::vector<std::vector<value_type>> partial(chunks, std::vector<value_type>(points.size()));
+                detail::parallel_for(pool, 0, chunks * blocks, [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t t = begin; t < end; t++) {
+                        const std::size_t c = t / blocks, p = (t % blocks) * block;
+                        const std::size_t count = std::min(block, points.size() - p);
+                        const std::size_t lo = c * n / chunks, hi = (c + 1) * n / chunks;
+
+                        value_type acc[block];
+                        for (std::size_t i = 0; i < count; i++) {
+                            acc[i] = value_type::zero();
+                        }
+                        auto it = std::begin(a);
+                        std::advance(it, hi);
+                        for (std::size_t j = hi; j > lo; j--) {
+                            const value_type &coeff = *--it;
+                            for (std::size_t i = 0; i < count; i++) {
+                                acc[i] = acc[i] * points[p + i] + coeff;
+                            }
+                        }
+
+                        for (std::size_t i = 0; i < count; i++) {
+                            partial[c][p + i] = lo == 0 ? acc[i] : acc[i] * points[p + i].pow(lo);
+                        }
+                    }
+                });
+
+                for (std::size_t c = 1; c < chunks; c++) {
+                    for (std::size_t i = 0; i < points.size(); i++) {
+                        partial[0][i] += partial[c][i];
                     }
-                    index = 0;
                 }
+                return std::move(partial[0]);
             }
 
             /**
-             * Perform the general change of basis from Monomial to Newton Basis with Subproduct Tree T.
-             * Below we make use of the MonomialToNewton and TNewtonToMonomial pseudocode from
-             * [Bostan and Schost 2005. Polynomial Evaluation and Interpolation on Special Sets of Points], on page
-             * 12 and 14.
+             * Interpolate the values y_j at the pairwise distinct points of the Subproduct Tree T. With M the root
+             * and c_j = y_j / M'(x_j), the polynomial is the sum of c_j * M / (x - x_j), which is combined from the
+             * leaves up as f_{i, j} = f_{i - 1, 2j} * T_{i - 1, 2j + 1} + f_{i - 1, 2j + 1} * T_{i - 1, 2j}.
+             * The values M'(x_j) come from evaluate_with_subproduct_tree and are inverted in one batch.
+             * Below we make use of the algorithm 10.11 from
+             * [von zur Gathen & Gerhard 2013. Modern Computer Algebra, 3rd edition], on page 301.
              */
             template<typename FieldType, typename Range>
-            void
-                monomial_to_newton_basis(Range &a,
-                                         const std::vector<std::vector<std::vector<typename FieldType::value_type>>> &T,
-                                         size_t n) {
+            std::vector<typename FieldType::value_type> interpolate_with_subproduct_tree(
+                const Range &values, const std::vector<std::vector<std::vector<typename FieldType::value_type>>> &T) {
 
                 typedef typename FieldType::value_type value_type;
-                static_assert(std::is_same<typename Range::value_type, value_type>::value);
 
-                std::size_t m = log2(n);
-                // if (T.size() != m + 1u)
-                // throw DomainSizeException("expected T.size() == m + 1");
+                const std::vector<value_type> &root = T.back()[0];
+                std::vector<value_type> derivative(std::max<std::size_t>(root.size() - 1, 1), value_type::zero());
+                for (std::size_t i = 1; i < root.size(); i++) {
+                    derivative[i - 1] = root[i] * value_type(i);
+                }
 
-                /* MonomialToNewton */
-                std::vector<value_type> I(T[m][0]);
-                reverse(I, n);
+                std::vector<value_type> c = evaluate_with_subproduct_tree<FieldType>(derivative, T);
+                batch_inverse(c);
 
-                std::vector<value_type> mod(n + 1, value_type::zero());
-                mod[n] = value_type::one();
+                std::vector<std::vector<value_type>> f(c.size()), next;
+                auto y = std::begin(values);
+                for (std::size_t j = 0; j < c.size(); j++, y++) {
+                    f[j] = std::vector<value_type>(1, c[j] * *y);
+                }
 
-                extended_euclidean(mod, I, mod, mod, I);
+                std::vector<value_type> left, right;
+                for (std::size_t i = 1; i < T.size(); i++) {
+                    next.resize(T[i].size());
+                    for (std::size_t j = 0; j < T[i].size(); j++) {
+                        if (2 * j + 1 < T[i - 1].size()) {
+                            multiplication(left, f[2 * j], T[i - 1][2 * j + 1]);
+                            multiplication(right, f[2 * j + 1], T[i - 1][2 * j]);
+                            addition(next[j], left, right);
+                        } else {
+                            next[j] = f[2 * j];
+                        }
+                    }
+                    f.swap(next);
+                }
+                return f[0];
+            }
 
-                I.resize(n);
+            /**
+             * The Subproduct Tree of 2^k points in one buffer, stored level by level. The nodes are monic, so only
+             * their low coefficients are kept: T_{i, j}, the product of x - x_l over the 2^i points from j * 2^i,
+             * takes the 2^i coefficients from i * 2^k + j * 2^i, and every level takes 2^k of them. For the
+             * quotients of monomial_to_newton_basis, the first 2^i coefficients of 1 / rev(T_{i, 2j}), the
+             * reversed left child of the pair j, go from i * 2^{k - 1} + j * 2^i of reciprocals.
+             */
+            template<typename FieldType>
+            struct flat_subproduct_tree {
+                typedef typename FieldType::value_type value_type;
+
+                std::size_t log_size = 0;
+                std::vector<value_type> nodes;
+                std::vector<value_type> reciprocals;
 
-                std::vector<value_type> Q(transpose_multiplication(n - 1, I, a));
-                reverse(Q, n);
+                std::size_t size() const {
+                    return std::size_t(1) << log_size;
+                }
 
-                /* TNewtonToMonomial */
-                std::vector<std::vector<value_type>> c(n);
-                c[0] = Q;
+                value_type *node(std::size_t i, std::size_t j) {
+                    return nodes.data() + i * size() + (j << i);
+                }
 
-                std::size_t row_length;
-                std::size_t c_vec;
-                /* NB: unsigned reverse iteration: cannot do i >= 0, but can do i < m
-                   because unsigned integers are guaranteed to wrap around */
-                for (std::size_t i = m - 1; i < m; i--) {
-                    row_length = T[i].size() - 1;
-                    c_vec = 1u << i;
+                const value_type *node(std::size_t i, std::size_t j) const {
+                    return nodes.data() + i * size() + (j << i);
+                }
+
+                value_type *reciprocal(std::size_t i, std::size_t j) {
+                    return reciprocals.data() + i * (size() / 2) + (j << i);
+                }
 
-                    /* NB: unsigned reverse iteration */
-                    for (std::size_t j = (1u << (m - i - 1)) - 1; j < (1u << (m - i - 1)); j--) {
-                        c[2 * j + 1] = transpose_multiplication((1u << i) - 1, T[i][row_length - 2 * j], c[j]);
-                        c[2 * j] = c[j];
-                        c[2 * j].resize(c_vec);
+                const value_type *reciprocal(std::size_t i, std::size_t j) const {
+                    return reciprocals.data() + i * (size() / 2) + (j << i);
+                }
+            };
+
+            namespace detail {
+                /**
+                 * Scratch space of the products on a flat_subproduct_tree, which keeps its memory from one product
+                 * to the next.
+                 */
+                template<typename FieldType>
+                struct subproduct_tree_scratch {
+                    typedef typename FieldType::value_type value_type;
+
+                    std::vector<value_type> product, u, v, karatsuba;
+                    std::vector<value_type> first, second;
+
+                    /* r = a * b for a and b of n coefficients, r of 2n - 1 coefficients not overlapping them */
+                    void multiply(value_type *r, const value_type *a, const value_type *b, std::size_t n) {
+                        if (n < multiplication_thresholds<FieldType>::fft) {
+                            karatsuba.resize(karatsuba_scratch_size(n, n));
+                            karatsuba_multiplication(r, a, n, b, n, karatsuba.data(),
+                                                     karatsuba.data() + karatsuba.size(),
+                                                     multiplication_thresholds<FieldType>::karatsuba);
+                            return;
+                        }
+
+                        multiplication(product, span<const value_type>(a, n), span<const value_type>(b, n), u, v);
+                        const std::size_t size = std::min(product.size(), 2 * n - 1);
+                        std::fill(std::copy(product.begin(), product.begin() + size, r), r + 2 * n - 1,
+                                  value_type::zero());
+                    }
+                };
+
+                /*
+                 * Call f(i, pair, scratch) for the pairs of nodes of every level for which the pair j has to be
+                 * done after the pair j / 2 of the level i + 1 if top_down, or after the pairs 2j and 2j + 1 of the
+                 * level i - 1 otherwise. The pairs of a level are split between the threads of the pool.
+                 */
+                template<typename FieldType, typename F>
+                void for_each_subproduct_tree_pair(std::size_t log_size, bool top_down, thread_pool *pool, F f) {
+                    for (std::size_t step = 0; step < log_size; step++) {
+                        const std::size_t i = top_down ? log_size - 1 - step : step;
+                        parallel_for(pool, 0, std::size_t(1) << (log_size - 1 - i),
+                                     [&f, i](std::size_t begin, std::size_t end) {
+                                         subproduct_tree_scratch<FieldType> scratch;
+                                         for (std::size_t j = begin; j < end; j++) {
+                                             f(i, j, scratch);
+                                         }
+                                     });
                     }
                 }
+            }    // namespace detail
+
+            /**
+             * Compute the Subproduct Tree of the 2^k points into the flat layout, level by level with the nodes
+             * of a level split between the threads of the pool: (x^s + a) (x^s + b) = x^{2s} + (a + b) x^s + ab.
+             * Then the reciprocals of the reversed left children, of which monomial_to_newton_basis takes its
+             * quotients.
+             */
+            template<typename FieldType>
+            void compute_subproduct_tree(flat_subproduct_tree<FieldType> &T,
+                                         const std::vector<typename FieldType::value_type> &points,
+                                         thread_pool *pool = nullptr) {
+
+                typedef typename FieldType::value_type value_type;
+
+                const std::size_t n = points.size();
+                if (n == 0 || (n & (n - 1)) != 0)
+                    throw std::invalid_argument("compute_subproduct_tree: expected a power of two of points");
+
+                T.log_size = static_cast<std::size_t>(std::log2(n));
+                T.nodes.assign((T.log_size + 1) * n, value_type::zero());
+                T.reciprocals.assign(T.log_size * (n / 2), value_type::zero());
 
-                /* Store Computed Newton Basis Coefficients */
-                std::size_t j = 0;
-                /* NB: unsigned reverse iteration */
-                for (std::size_t i = c.size() - 1; i < c.size(); i--) {
-                    a[j++] = c[i][0];
+                for (std::size_t j = 0; j < n; j++) {
+                    T.nodes[j] = -points[j];
                 }
+
+                detail::for_each_subproduct_tree_pair<FieldType>(
+                    T.log_size, false, pool,
+                    [&T](std::size_t i, std::size_t j, detail::subproduct_tree_scratch<FieldType> &scratch) {
+                        const std::size_t s = std::size_t(1) << i;
+                        const value_type *a = T.node(i, 2 * j), *b = T.node(i, 2 * j + 1);
+                        value_type *r = T.node(i + 1, j);
+
+                        scratch.multiply(r, a, b, s);
+                        r[2 * s - 1] = value_type::zero();
+                        for (std::size_t l = 0; l < s; l++) {
+                            r[s + l] += a[l] + b[l];
+                        }
+
+                        /* rev(T_{i, 2j}) mod x^s is 1, a_{s - 1}, ..., a_1 */
+                        scratch.first.resize(s);
+                        scratch.first[0] = value_type::one();
+                        for (std::size_t l = 1; l < s; l++) {
+                            scratch.first[l] = a[s - l];
+                        }
+                        const std::vector<value_type> inverse = math::reciprocal(scratch.first, s);
+                        std::copy(inverse.begin(), inverse.begin() + s, T.reciprocal(i, j));
+                    });
             }
 
             /**
-             * Perform the general change of basis from Newton to Monomial Basis with Subproduct Tree T.
-             * Below we make use of the NewtonToMonomial pseudocode from
-             * [Bostan and Schost 2005. Polynomial Evaluation and Interpolation on Special Sets of Points], on
-             * page 11.
+             * Perform the change of basis from Monomial to Newton Basis with the flat Subproduct Tree T, in place
+             * for the T.size() coefficients of a. From the root down, the block of 2s coefficients of f over the
+             * points of T_{i + 1, j} takes the remainder and the quotient of f by the left child T_{i, 2j}: with
+             * f = q T_{i, 2j} + r, the Newton coefficients of r are those of the points of the left child, and
+             * those of q of the right one. The quotient is the reversed high half of f times 1 / rev(T_{i, 2j}).
+             * Below we make use of the divide-and-conquer change of basis from
+             * [Bostan and Schost 2005. Polynomial Evaluation and Interpolation on Special Sets of Points], section 2.
              */
             template<typename FieldType, typename Range>
-            void
-                newton_to_monomial_basis(Range &a,
-                                         const std::vector<std::vector<std::vector<typename FieldType::value_type>>> &T,
-                                         size_t n) {
+            void monomial_to_newton_basis(Range &a, const flat_subproduct_tree<FieldType> &T,
+                                          thread_pool *pool = nullptr) {
 
                 typedef typename FieldType::value_type value_type;
-                static_assert(std::is_same<typename Range::value_type, value_type>::value);
 
-                std::size_t m = log2(n);
-                // if (T.size() != m + 1u)
-                // throw DomainSizeException("expected T.size() == m + 1");
+                if (std::size_t(std::distance(std::begin(a), std::end(a))) != T.size())
+                    throw std::invalid_argument("monomial_to_newton_basis: expected a.size() == T.size()");
+
+                value_type *data = &*std::begin(a);
+                detail::for_each_subproduct_tree_pair<FieldType>(
+                    T.log_size, true, pool,
+                    [&T, data](std::size_t i, std::size_t j, detail::subproduct_tree_scratch<FieldType> &scratch) {
+                        const std::size_t s = std::size_t(1) << i;
+                        value_type *f = data + 2 * j * s;
+
+                        std::vector<value_type> &h = scratch.first, &p = scratch.second;
+                        h.resize(s);
+                        p.resize(2 * s - 1);
+
+                        /* rev(q) = rev(f) / rev(T_{i, 2j}) mod x^s */
+                        for (std::size_t l = 0; l < s; l++) {
+                            h[l] = f[2 * s - 1 - l];
+                        }
+                        scratch.multiply(p.data(), h.data(), T.reciprocal(i, j), s);
+                        for (std::size_t l = 0; l < s; l++) {
+                            h[l] = p[s - 1 - l];
+                        }
+
+                        /* r = f - q * T_{i, 2j} mod x^s */
+                        scratch.multiply(p.data(), h.data(), T.node(i, 2 * j), s);
+                        for (std::size_t l = 0; l < s; l++) {
+                            f[l] -= p[l];
+                        }
+                        std::copy(h.begin(), h.end(), f + s);
+                    });
+            }
 
-                std::vector<std::vector<value_type>> f(n);
-                for (std::size_t i = 0; i < n; i++) {
-                    f[i] = std::vector<value_type>(1, a[i]);
-                }
+            /**
+             * Perform the change of basis from Newton to Monomial Basis with the flat Subproduct Tree T, in place
+             * for the T.size() coefficients of a. From the leaves up, the blocks f and g of the children of
+             * T_{i + 1, j} are merged into f + T_{i, 2j} g.
+             * Below we make use of the NewtonToMonomial pseudocode from
+             * [Bostan and Schost 2005. Polynomial Evaluation and Interpolation on Special Sets of Points], on
+             * page 11.
+             */
+            template<typename FieldType, typename Range>
+            void newton_to_monomial_basis(Range &a, const flat_subproduct_tree<FieldType> &T,
+                                          thread_pool *pool = nullptr) {
 
-                /* NewtonToMonomial */
-                std::vector<value_type> temp(1, value_type::zero());
-                for (std::size_t i = 0; i < m; i++) {
-                    for (std::size_t j = 0; j < (1u << (m - i - 1)); j++) {
-                        multiplication(temp, T[i][2 * j], f[2 * j + 1]);
-                        addition(f[j], f[2 * j], temp);
-                    }
-                }
+                typedef typename FieldType::value_type value_type;
 
-                a = f[0];
+                if (std::size_t(std::distance(std::begin(a), std::end(a))) != T.size())
+                    throw std::invalid_argument("newton_to_monomial_basis: expected a.size() == T.size()");
+
+                value_type *data = &*std::begin(a);
+                detail::for_each_subproduct_tree_pair<FieldType>(
+                    T.log_size, false, pool,
+                    [&T, data](std::size_t i, std::size_t j, detail::subproduct_tree_scratch<FieldType> &scratch) {
+                        const std::size_t s = std::size_t(1) << i;
+                        value_type *f = data + 2 * j * s;
+
+                        /* T_{i, 2j} g = x^s g + t g, for the stored low coefficients t of T_{i, 2j} */
+                        std::vector<value_type> &p = scratch.second;
+                        p.resize(2 * s - 1);
+                        scratch.multiply(p.data(), T.node(i, 2 * j), f + s, s);
+                        for (std::size_t l = 0; l < s; l++) {
+                            f[l] += p[l];
+                        }
+                        for (std::size_t l = 0; l + 1 < s; l++) {
+                            f[s + l] += p[s + l];
+                        }
+                    });
             }
 
             /**
@@ -202,10 +493,25 @@ namespace nil {
                 z[0] = value_type::one();
                 f[0] = a[0];
 
+                /* 1 / (1 - geometric_sequence[i]) and 1 / geometric_triangular_sequence[i] */
+                std::vector<value_type> d_inverse(n, value_type::one());
+                std::vector<value_type> t_inverse(n, value_type::one());
                 for (std::size_t i = 1; i < n; i++) {
-                    u[i] = u[i - 1] * geometric_sequence[i] * (value_type::one() - geometric_sequence[i]).inversed();
-                    w[i] = a[i] * (u[i].inversed());
-                    z[i] = u[i] * geometric_triangular_sequence[i].inversed();
+                    d_inverse[i] = value_type::one() - geometric_sequence[i];
+                    t_inverse[i] = geometric_triangular_sequence[i];
+                }
+                batch_inverse(d_inverse);
+                batch_inverse(t_inverse);
+
+                for (std::size_t i = 1; i < n; i++) {
+                    u[i] = u[i - 1] * geometric_sequence[i] * d_inverse[i];
+                }
+                std::vector<value_type> u_inverse(u);
+                batch_inverse(u_inverse);
+
+                for (std::size_t i = 1; i < n; i++) {
+                    w[i] = a[i] * u_inverse[i];
+                    z[i] = u[i] * t_inverse[i];
                     f[i] = w[i] * geometric_triangular_sequence[i];
 
                     if (i % 2 == 1) {
@@ -243,15 +549,30 @@ namespace nil {
                 w[0] = a[0];
                 z[0] = value_type::one();
 
+                /* 1 / (1 - geometric_sequence[i]) and 1 / geometric_triangular_sequence[i] */
+                std::vector<value_type> d_inverse(n, value_type::one());
+                std::vector<value_type> t_inverse(n, value_type::one());
+                for (std::size_t i = 1; i < n; i++) {
+                    d_inverse[i] = value_type::one() - geometric_sequence[i];
+                    t_inverse[i] = geometric_triangular_sequence[i];
+                }
+                batch_inverse(d_inverse);
+                batch_inverse(t_inverse);
+
+                for (std::size_t i = 1; i < n; i++) {
+                    u[i] = u[i - 1] * geometric_sequence[i] * d_inverse[i];
+                }
+                std::vector<value_type> u_inverse(u);
+                batch_inverse(u_inverse);
+
                 for (std::size_t i = 1; i < n; i++) {
                     v[i] = a[i] * geometric_triangular_sequence[i];
                     if (i % 2 == 1)
                         v[i] = -v[i];
 
-                    u[i] = u[i - 1] * geometric_sequence[i] * (value_type::one() - geometric_sequence[i]).inversed();
-                    w[i] = v[i] * u[i].inversed();
+                    w[i] = v[i] * u_inverse[i];
 
-                    z[i] = u[i] * geometric_triangular_sequence[i].inversed();
+                    z[i] = u[i] * t_inverse[i];
                     if (i % 2 == 1)
                         z[i] = -z[i];
                 }
@@ -0,0 +1,424 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_POLYNOMIAL_DFS_EXPRESSION_HPP
+#define CRYPTO3_MATH_POLYNOMIAL_DFS_EXPRESSION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/algebra/type_traits.hpp>
+
+#include <nil/crypto3/math/detail/field_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * Order of the values of a polynomial_dfs over its domain, see polynomial_dfs::order.
+             */
+            enum class evaluation_order { natural, bit_reversed };
+
+            /**
+             * Base of the lazy polynomial_dfs expressions. Arithmetic on polynomial_dfs and polynomial_dfs_view is
+             * evaluated at once and returns a polynomial_dfs. Arithmetic with an operand which is a node, e.g. one of
+             * make_expression or polynomial_shift_view, builds a tree of such nodes instead, which holds its
+             * operands by reference and is evaluated in one pass over the evaluation points when it is assigned to a
+             * polynomial_dfs or a polynomial_dfs_view. Operands of a smaller size than the result are extended to it
+             * once, at that moment.
+             *
+             * Like any expression template, a node must not outlive the operands it was built from: store the
+             * result in a polynomial_dfs rather than in an auto variable.
+             */
+            template<typename Derived>
+            struct polynomial_dfs_expression {
+                const Derived& derived() const {
+                    return static_cast<const Derived&>(*this);
+                }
+            };
+
+            /**
+             * Values of a polynomial_dfs or polynomial_dfs_view taking part in an expression. Before the evaluation
+             * the leaf is bound to the values on the domain of the result; a size-1 leaf is a constant and is read
+             * at index 0 whatever the size of the result is.
+             *
+             * A leaf may also be rotated, see polynomial_shift_view: it then reads the values of f(omega^shift x),
+             * omega the generator of the domain of the size domain_size, at index i + (n / domain_size) * shift of
+             * the values on the domain of any size n it is bound to.
+             *
+             * The values of a leaf are in the order of its polynomial, see evaluation_order.
+             */
+            template<typename FieldValueType>
+            class polynomial_dfs_leaf : public polynomial_dfs_expression<polynomial_dfs_leaf<FieldValueType>> {
+            public:
+                typedef FieldValueType value_type;
+
+                polynomial_dfs_leaf(const value_type* data, std::size_t size, std::size_t degree, int shift = 0,
+                                    std::size_t domain_size = 0,
+                                    evaluation_order order = evaluation_order::natural) :
+                    source(data), _size(size), _d(degree), shift(shift),
+                    domain_size(domain_size == 0 ? size : domain_size), _order(order) {
+                    bind(data, size);
+                }
+
+                std::size_t size() const {
+                    return _size;
+                }
+
+                std::size_t degree() const {
+                    return _d;
+                }
+
+                const value_type* data() const {
+                    return source;
+                }
+
+                evaluation_order order() const {
+                    return _order;
+                }
+
+                /**
+                 * Whether the leaf reads f(omega^shift x) for a shift which is not 0, i.e. is rotated on any domain.
+                 */
+                bool shifted() const {
+                    return _size != 1 && shift != 0;
+                }
+
+                /**
+                 * Whether index i reads anything else than the value at index i.
+                 */
+                bool rotated() const {
+                    return offset != 0;
+                }
+
+                void bind(const value_type* v, std::size_t n) const {
+                    values = v;
+                    offset = 0;
+                    mask = _size == 1 ? 0 : ~std::size_t(0);
+                    if (_size != 1 && shift != 0) {
+                        BOOST_ASSERT_MSG(n % domain_size == 0 && n == detail::power_of_two(n),
+                                         "rotation to a domain which is not a multiple of the power of two");
+                        const long long d = static_cast<long long>(domain_size);
+                        offset = static_cast<std::size_t>((shift % d + d) % d) * (n / domain_size);
+                        mask = n - 1;
+                    }
+                }
+
+                value_type operator[](std::size_t i) const {
+                    return values[(i + offset) & mask];
+                }
+
+                void collect(std::vector<const polynomial_dfs_leaf*>& leaves) const {
+                    leaves.push_back(this);
+                }
+
+            private:
+                const value_type* source;
+                std::size_t _size;
+                std::size_t _d;
+                int shift;
+                std::size_t domain_size;
+                evaluation_order _order;
+
+                mutable const value_type* values;
+                mutable std::size_t offset;
+                mutable std::size_t mask;
+            };
+
+            /**
+             * Field element taking part in an expression, i.e. a constant polynomial.
+             */
+            template<typename FieldValueType>
+            class polynomial_dfs_constant
+                : public polynomial_dfs_expression<polynomial_dfs_constant<FieldValueType>> {
+            public:
+                typedef FieldValueType value_type;
+
+                explicit polynomial_dfs_constant(const value_type& v) : value(v) {
+                }
+
+                std::size_t size() const {
+                    return 1;
+                }
+
+                std::size_t degree() const {
+                    return 0;
+                }
+
+                const value_type& operator[](std::size_t) const {
+                    return value;
+                }
+
+                void collect(std::vector<const polynomial_dfs_leaf<value_type>*>&) const {
+                }
+
+            private:
+                value_type value;
+            };
+
+            namespace detail {
+                struct polynomial_dfs_plus {
+                    static std::size_t degree(std::size_t a, std::size_t b) {
+                        return std::max(a, b);
+                    }
+
+                    static std::size_t size(std::size_t a_size, std::size_t b_size, std::size_t, std::size_t) {
+                        return std::max(a_size, b_size);
+                    }
+
+                    template<typename T>
+                    static T apply(const T& a, const T& b) {
+                        return a + b;
+                    }
+                };
+
+                struct polynomial_dfs_minus {
+                    static std::size_t degree(std::size_t a, std::size_t b) {
+                        return std::max(a, b);
+                    }
+
+                    static std::size_t size(std::size_t a_size, std::size_t b_size, std::size_t, std::size_t) {
+                        return std::max(a_size, b_size);
+                    }
+
+                    template<typename T>
+                    static T apply(const T& a, const T& b) {
+                        return a - b;
+                    }
+                };
+
+                struct polynomial_dfs_multiplies {
+                    static std::size_t degree(std::size_t a, std::size_t b) {
+                        return a + b;
+                    }
+
+                    static std::size_t size(std::size_t a_size, std::size_t b_size, std::size_t a_degree,
+                                            std::size_t b_degree) {
+                        return power_of_two(std::max({a_size, b_size, a_degree + b_degree + 1}));
+                    }
+
+                    template<typename T>
+                    static T apply(const T& a, const T& b) {
+                        return a * b;
+                    }
+                };
+
+                /**
+                 * Maps an operand to the node it is represented by: nodes stand for themselves, containers get a
+                 * leaf (specialized next to the containers) and field elements a constant.
+                 */
+                template<typename T, typename = void>
+                struct polynomial_dfs_operand {
+                    static constexpr bool value = false;
+                };
+
+                template<typename T>
+                struct polynomial_dfs_operand<
+                    T, typename std::enable_if<std::is_base_of<polynomial_dfs_expression<T>, T>::value>::type> {
+                    static constexpr bool value = true;
+                    typedef T type;
+
+                    static const T& make(const T& x) {
+                        return x;
+                    }
+                };
+
+                template<typename T>
+                struct polynomial_dfs_operand<T, typename std::enable_if<is_field_element<T>::value>::type> {
+                    static constexpr bool value = true;
+                    typedef polynomial_dfs_constant<T> type;
+
+                    static type make(const T& x) {
+                        return type(x);
+                    }
+                };
+
+                template<typename T>
+                struct is_polynomial_dfs_node : std::is_base_of<polynomial_dfs_expression<T>, T> { };
+
+                template<typename T>
+                struct is_polynomial_dfs_container {
+                    static constexpr bool value =
+                        polynomial_dfs_operand<T>::value && !is_polynomial_dfs_node<T>::value &&
+                        !is_field_element<T>::value;
+                };
+
+                /* at least one side is a polynomial (node or container), the other one may be a field element */
+                template<typename L, typename R>
+                struct is_polynomial_dfs_operation {
+                    static constexpr bool value =
+                        polynomial_dfs_operand<L>::value && polynomial_dfs_operand<R>::value &&
+                        !(is_field_element<L>::value && is_field_element<R>::value);
+                };
+
+                /* an operation which builds a node, as one of the sides is a node already */
+                template<typename L, typename R>
+                struct is_polynomial_dfs_lazy_operation {
+                    static constexpr bool value =
+                        is_polynomial_dfs_operation<L, R>::value &&
+                        (is_polynomial_dfs_node<L>::value || is_polynomial_dfs_node<R>::value);
+                };
+
+                /**
+                 * The polynomial_dfs an operation on the container T evaluates into, specialized next to the
+                 * containers.
+                 */
+                template<typename T>
+                struct polynomial_dfs_result { };
+
+                /* the result of an operation on containers and field elements, which is evaluated at once */
+                template<typename L, typename R, typename = void>
+                struct polynomial_dfs_eager_operation { };
+
+                template<typename L, typename R>
+                struct polynomial_dfs_eager_operation<
+                    L, R,
+                    typename std::enable_if<is_polynomial_dfs_operation<L, R>::value &&
+                                            !is_polynomial_dfs_lazy_operation<L, R>::value>::type> {
+                    typedef typename polynomial_dfs_result<
+                        typename std::conditional<is_field_element<L>::value, R, L>::type>::type type;
+                };
+            }    // namespace detail
+
+            template<typename Operation, typename L, typename R>
+            class polynomial_dfs_binary_expression
+                : public polynomial_dfs_expression<polynomial_dfs_binary_expression<Operation, L, R>> {
+            public:
+                typedef typename L::value_type value_type;
+
+                polynomial_dfs_binary_expression(const L& l, const R& r) :
+                    left(l), right(r),
+                    _d(Operation::degree(l.degree(), r.degree())),
+                    _size(Operation::size(l.size(), r.size(), l.degree(), r.degree())) {
+                }
+
+                std::size_t size() const {
+                    return _size;
+                }
+
+                std::size_t degree() const {
+                    return _d;
+                }
+
+                value_type operator[](std::size_t i) const {
+                    return Operation::apply(value_type(left[i]), value_type(right[i]));
+                }
+
+                void collect(std::vector<const polynomial_dfs_leaf<value_type>*>& leaves) const {
+                    left.collect(leaves);
+                    right.collect(leaves);
+                }
+
+            private:
+                L left;
+                R right;
+                std::size_t _d;
+                std::size_t _size;
+            };
+
+            template<typename E>
+            class polynomial_dfs_negate_expression
+                : public polynomial_dfs_expression<polynomial_dfs_negate_expression<E>> {
+            public:
+                typedef typename E::value_type value_type;
+
+                explicit polynomial_dfs_negate_expression(const E& e) : operand(e) {
+                }
+
+                std::size_t size() const {
+                    return operand.size();
+                }
+
+                std::size_t degree() const {
+                    return operand.degree();
+                }
+
+                value_type operator[](std::size_t i) const {
+                    return -value_type(operand[i]);
+                }
+
+                void collect(std::vector<const polynomial_dfs_leaf<value_type>*>& leaves) const {
+                    operand.collect(leaves);
+                }
+
+            private:
+                E operand;
+            };
+
+#define CRYPTO3_MATH_POLYNOMIAL_DFS_OPERATOR(op, operation)                                                        \
+    template<typename L, typename R,                                                                               \
+             typename = typename std::enable_if<detail::is_polynomial_dfs_lazy_operation<L, R>::value>::type>      \
+    polynomial_dfs_binary_expression<operation, typename detail::polynomial_dfs_operand<L>::type,                  \
+                                     typename detail::polynomial_dfs_operand<R>::type>                             \
+        op(const L& l, const R& r) {                                                                               \
+        return {detail::polynomial_dfs_operand<L>::make(l), detail::polynomial_dfs_operand<R>::make(r)};           \
+    }                                                                                                              \
+                                                                                                                   \
+    template<typename L, typename R>                                                                               \
+    typename detail::polynomial_dfs_eager_operation<L, R>::type op(const L& l, const R& r) {                      \
+        return typename detail::polynomial_dfs_eager_operation<L, R>::type(                                       \
+            polynomial_dfs_binary_expression<operation, typename detail::polynomial_dfs_operand<L>::type,          \
+                                             typename detail::polynomial_dfs_operand<R>::type>(                    \
+                detail::polynomial_dfs_operand<L>::make(l), detail::polynomial_dfs_operand<R>::make(r)));          \
+    }
+
+            CRYPTO3_MATH_POLYNOMIAL_DFS_OPERATOR(operator+, detail::polynomial_dfs_plus)
+            CRYPTO3_MATH_POLYNOMIAL_DFS_OPERATOR(operator-, detail::polynomial_dfs_minus)
+            CRYPTO3_MATH_POLYNOMIAL_DFS_OPERATOR(operator*, detail::polynomial_dfs_multiplies)
+
+#undef CRYPTO3_MATH_POLYNOMIAL_DFS_OPERATOR
+
+            template<typename E, typename = typename std::enable_if<detail::is_polynomial_dfs_node<E>::value>::type>
+            polynomial_dfs_negate_expression<E> operator-(const E& e) {
+                return polynomial_dfs_negate_expression<E>(e);
+            }
+
+            template<typename E>
+            typename detail::polynomial_dfs_result<E>::type operator-(const E& e) {
+                return typename detail::polynomial_dfs_result<E>::type(
+                    polynomial_dfs_negate_expression<typename detail::polynomial_dfs_operand<E>::type>(
+                        detail::polynomial_dfs_operand<E>::make(e)));
+            }
+
+            /**
+             * The node of a polynomial_dfs or a polynomial_dfs_view, for the arithmetic to build an expression
+             * evaluated in one pass instead of the intermediate polynomials, e.g.
+             * h = make_expression(f) * g + c evaluates f * g + c at once into h.
+             */
+            template<typename T,
+                     typename = typename std::enable_if<detail::is_polynomial_dfs_container<T>::value>::type>
+            typename detail::polynomial_dfs_operand<T>::type make_expression(const T& x) {
+                return detail::polynomial_dfs_operand<T>::make(x);
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_POLYNOMIAL_DFS_EXPRESSION_HPP
@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MATH_POLYNOMIAL_FOLD_HPP
+#define CRYPTO3_MATH_POLYNOMIAL_FOLD_HPP
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
+#include <nil/crypto3/math/algorithms/evaluation_domain_cache.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * Fold the values of f on the coset coset_shift * D, D the domain of the size of f, by the factor k, a
+             * power of two: f(x) = sum_{t < k} x^t f_t(x^k) becomes sum_{t < k} beta^t f_t(y), given by its values
+             * on the coset coset_shift^k * D^k in the order of f, as an FRI commit round needs.
+             *
+             * The fold works on the values, with no transform: the factor 2 is
+             * (f(x) + f(-x)) / 2 + beta (f(x) - f(-x)) / (2x), and the factor k is log2(k) such folds by
+             * beta, beta^2, ..., done one after another on the k values of f over each coset of the k-th roots of
+             * unity, in one parallel pass. The inverses of x come from the inverse twiddles of domain, which may be
+             * of any size at least that of f: the domains of calculate_domain_set share the table of the largest
+             * one, so the domain of the first round serves all of them.
+             */
+            template<typename FieldValueType, typename Allocator, typename FieldType>
+            polynomial_dfs<FieldValueType, Allocator>
+                fold(const polynomial_dfs<FieldValueType, Allocator> &f, const FieldValueType &beta,
+                     const FieldValueType &coset_shift, std::size_t k,
+                     const std::shared_ptr<evaluation_domain<FieldType>> &domain) {
+                typedef FieldValueType value_type;
+
+                const std::size_t n = f.size();
+                if (k < 2 || k != detail::power_of_two(k) || k > n) {
+                    throw std::invalid_argument("fold: expected a power of two factor in (1, f.size()]");
+                }
+                basic_radix2_domain<FieldType> *radix2 = dynamic_cast<basic_radix2_domain<FieldType> *>(domain.get());
+                if (radix2 == nullptr || radix2->m < n) {
+                    throw std::invalid_argument("fold: expected a basic_radix2_domain of a size at least f.size()");
+                }
+                radix2->precompute();
+                const value_type *inverse_twiddles = radix2->inverse_fft_cache.data();
+
+                /* beta^(2^l) / (2 coset_shift^(2^l)) for the l-th fold */
+                const std::size_t logk = static_cast<std::size_t>(std::log2(k));
+                const value_type two_inversed = value_type(2).inversed();
+                std::vector<value_type> scale(logk);
+                value_type b = beta, s = coset_shift;
+                for (std::size_t l = 0; l < logk; ++l) {
+                    scale[l] = b * (s + s).inversed();
+                    b = b.squared();
+                    s = s.squared();
+                }
+
+                const std::size_t result_size = n / k;
+                const bool reversed = f.order() == evaluation_order::bit_reversed;
+                const std::size_t logr = static_cast<std::size_t>(std::log2(result_size));
+                /* the values are all zero yet, reorder only tags them with the order of f */
+                polynomial_dfs<FieldValueType, Allocator> result(f.degree() / k, result_size, f.get_allocator());
+                result.reorder(f.order());
+
+                detail::parallel_for(
+                    thread_pool::global().get(), 0, result_size,
+                    [&](std::size_t begin, std::size_t end) {
+                        std::vector<value_type> buffer(k);
+                        for (std::size_t q = begin; q < end; ++q) {
+                            /*
+                             * buffer[t] is the value at the point of index j + t * n / k of D: the values over a
+                             * coset of the k-th roots of unity lie n / k apart in the natural order, and are
+                             * adjacent, in the bit-reversed order of t, in the bit-reversed order
+                             */
+                            std::size_t j = q;
+                            if (reversed) {
+                                j = detail::bitreverse(q, logr);
+                                for (std::size_t t = 0; t < k; ++t) {
+                                    buffer[detail::bitreverse(t, logk)] = f[q * k + t];
+                                }
+                            } else {
+                                for (std::size_t t = 0; t < k; ++t) {
+                                    buffer[t] = f[q + t * result_size];
+                                }
+                            }
+
+                            /* the l-th fold is over the domain of the size n / 2^l */
+                            std::size_t half = k / 2, domain_half = n / 2;
+                            for (std::size_t l = 0; l < logk; ++l, half /= 2, domain_half /= 2) {
+                                for (std::size_t t = 0; t < half; ++t) {
+                                    const value_type &x_inversed =
+                                        inverse_twiddles[domain_half - 1 + j + t * result_size];
+                                    const value_type sum = buffer[t] + buffer[t + half];
+                                    const value_type difference = buffer[t] - buffer[t + half];
+                                    buffer[t] = two_inversed * sum + scale[l] * x_inversed * difference;
+                                }
+                            }
+                            result[q] = buffer[0];
+                        }
+                    },
+                    detail::basic_radix2_fft_grain_size);
+                return result;
+            }
+
+            /**
+             * Fold with the basic_radix2_domain of the size of f from the cache of the field.
+             */
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType, Allocator> fold(const polynomial_dfs<FieldValueType, Allocator> &f,
+                                                           const FieldValueType &beta,
+                                                           const FieldValueType &coset_shift, std::size_t k = 2) {
+                typedef typename FieldValueType::field_type FieldType;
+                const std::shared_ptr<evaluation_domain<FieldType>> domain =
+                    evaluation_domain_cache<FieldType>::instance().template get<basic_radix2_domain<FieldType>>(
+                        f.size());
+                return fold(f, beta, coset_shift, k, domain);
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_POLYNOMIAL_FOLD_HPP
@@ -0,0 +1,169 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_POLYNOMIAL_GRAND_PRODUCT_HPP
+#define CRYPTO3_MATH_POLYNOMIAL_GRAND_PRODUCT_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
+#include <nil/crypto3/math/instrumentation.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace detail {
+                /* the scan is a multiplication and a few loads per index, so the blocks have to be large */
+                constexpr std::size_t grand_product_grain_size = 1ul << 12;
+
+                template<typename FieldValueType, typename Numerator, typename Denominator>
+                polynomial_dfs<FieldValueType> grand_product(const Numerator &numerator,
+                                                             const Denominator &denominator) {
+                    typedef FieldValueType value_type;
+
+                    std::vector<const polynomial_dfs_leaf<value_type> *> leaves;
+                    numerator.collect(leaves);
+                    denominator.collect(leaves);
+                    std::size_t n = 1;
+                    for (const polynomial_dfs_leaf<value_type> *leaf : leaves) {
+                        n = std::max(n, leaf->size());
+                    }
+                    CRYPTO3_MATH_INSTRUMENT("grand_product", n, 0);
+
+                    const std::vector<polynomial_dfs<value_type>> numerator_copies =
+                        polynomial_dfs<value_type>::bind_expression(numerator, n);
+                    const std::vector<polynomial_dfs<value_type>> denominator_copies =
+                        polynomial_dfs<value_type>::bind_expression(denominator, n);
+
+                    polynomial_dfs<value_type> result(n - 1, n);
+                    value_type *z = result.data();
+                    z[0] = value_type::one();
+                    if (n == 1) {
+                        return result;
+                    }
+
+                    /* z[i + 1] holds the ratio of the index i, so that the scan below runs in place */
+                    thread_pool *pool = thread_pool::global().get();
+                    detail::parallel_for(
+                        pool, 1, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                z[i] = denominator[i - 1];
+                            }
+                        },
+                        grand_product_grain_size);
+                    batch_inverse(z + 1, z + n, pool);
+
+                    /* a local scan of each block, then the block products are scanned and applied to the blocks */
+                    const std::size_t blocks_count =
+                        std::max<std::size_t>(std::min((n - 1) / grand_product_grain_size, pool ? pool->size() : 1),
+                                              1);
+                    const std::size_t block_size = (n - 1 + blocks_count - 1) / blocks_count;
+                    std::vector<value_type> totals(blocks_count, value_type::one());
+                    std::vector<char> zero(blocks_count, false);
+                    detail::parallel_for(pool, 0, blocks_count, [&](std::size_t first, std::size_t last) {
+                        for (std::size_t k = first; k < last; ++k) {
+                            const std::size_t begin = 1 + k * block_size, end = std::min(begin + block_size, n);
+                            value_type acc = value_type::one();
+                            for (std::size_t i = begin; i < end; ++i) {
+                                zero[k] |= z[i].is_zero();
+                                acc *= numerator[i - 1] * z[i];
+                                z[i] = acc;
+                            }
+                            totals[k] = acc;
+                        }
+                    });
+                    if (std::find(zero.begin(), zero.end(), true) != zero.end()) {
+                        throw std::invalid_argument("grand_product: zero denominator");
+                    }
+
+                    for (std::size_t k = 1; k < blocks_count; ++k) {
+                        totals[k] *= totals[k - 1];
+                    }
+                    detail::parallel_for(pool, 1, blocks_count, [&](std::size_t first, std::size_t last) {
+                        for (std::size_t k = first; k < last; ++k) {
+                            const std::size_t begin = 1 + k * block_size, end = std::min(begin + block_size, n);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                z[i] *= totals[k - 1];
+                            }
+                        }
+                    });
+                    return result;
+                }
+            }    // namespace detail
+
+            /**
+             * Running product of the ratios numerator / denominator over the points of the domain, the accumulator
+             * z of a permutation or lookup argument: z[0] = 1 and z[i + 1] = z[i] * numerator[i] / denominator[i],
+             * in the natural order. The ratio of the last point is not part of z; for a valid argument
+             * z[n - 1] * numerator[n - 1] / denominator[n - 1] is 1.
+             *
+             * Numerator and denominator are polynomial_dfs, polynomial_dfs_view, field elements or lazy expressions
+             * of them, such as (make_expression(w) + beta * sigma + gamma) * (make_expression(w') + gamma), which
+             * are read point by point inside the scan: no column of the ratios is built besides z itself. The domain
+             * is that of the largest operand, the smaller ones are extended to it. The denominators are inverted with
+             * batch_inverse, and the product runs as a block-wise parallel prefix scan on the global thread pool
+             * when one is installed. Throws std::invalid_argument if a denominator vanishes.
+             */
+            template<typename Numerator, typename Denominator,
+                     typename = typename std::enable_if<
+                         detail::is_polynomial_dfs_operation<Numerator, Denominator>::value>::type>
+            polynomial_dfs<typename detail::polynomial_dfs_operand<Numerator>::type::value_type>
+                grand_product(const Numerator &numerator, const Denominator &denominator) {
+                typedef typename detail::polynomial_dfs_operand<Numerator>::type::value_type value_type;
+
+                const typename detail::polynomial_dfs_operand<Numerator>::type n =
+                    detail::polynomial_dfs_operand<Numerator>::make(numerator);
+                const typename detail::polynomial_dfs_operand<Denominator>::type d =
+                    detail::polynomial_dfs_operand<Denominator>::make(denominator);
+                return detail::grand_product<value_type>(n, d);
+            }
+
+            /**
+             * Running product of the ratios of the values of two vectors over the same domain, see above: their size
+             * is a power of two.
+             */
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType> grand_product(const std::vector<FieldValueType, Allocator> &numerator,
+                                                         const std::vector<FieldValueType, Allocator> &denominator) {
+                if (numerator.empty() || numerator.size() != detail::power_of_two(numerator.size()) ||
+                    numerator.size() != denominator.size()) {
+                    throw std::invalid_argument("grand_product: expected vectors of the same power of two size");
+                }
+                const std::size_t n = numerator.size();
+                return detail::grand_product<FieldValueType>(
+                    polynomial_dfs_leaf<FieldValueType>(numerator.data(), n, n - 1),
+                    polynomial_dfs_leaf<FieldValueType>(denominator.data(), n, n - 1));
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_POLYNOMIAL_GRAND_PRODUCT_HPP
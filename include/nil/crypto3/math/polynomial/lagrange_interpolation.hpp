@@ -27,15 +27,51 @@
 #ifndef CRYPTO3_MATH_LAGRANGE_INTERPOLATION_HPP
 #define CRYPTO3_MATH_LAGRANGE_INTERPOLATION_HPP
 
+#include <cmath>
+#include <vector>
+
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/polynomial/basis_change.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
+#include <nil/crypto3/math/algorithms/evaluation_domain_cache.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace math {
-            // Default implementation according to Wikipedia
-            // https://en.wikipedia.org/wiki/Lagrange_polynomial
+            namespace detail {
+                /**
+                 * Returns true if x is 1, omega, ..., omega^{k - 1} for the root of unity omega of a radix-2 domain
+                 * of the size k.
+                 */
+                template<typename FieldType>
+                bool is_radix2_subgroup(const std::vector<typename FieldType::value_type> &x) {
+                    typedef typename FieldType::value_type value_type;
+
+                    const std::size_t k = x.size();
+                    if (k < 2 || k != power_of_two(k) ||
+                        static_cast<std::size_t>(std::log2(k)) > fields::arithmetic_params<FieldType>::s) {
+                        return false;
+                    }
+
+                    const value_type omega = unity_root<FieldType>(k);
+                    value_type power = value_type::one();
+                    for (std::size_t i = 0; i < k; i++) {
+                        if (x[i] != power) {
+                            return false;
+                        }
+                        power *= omega;
+                    }
+                    return true;
+                }
+            }    // namespace detail
+
+            /**
+             * Interpolate the points (x_j, y_j) with pairwise distinct x_j. Points on a radix-2 subgroup
+             * 1, omega, ..., omega^{k - 1} take an inverse FFT, the others interpolate_with_subproduct_tree in
+             * O(M(k) log(k)).
+             */
             template<typename InputRange,
                      typename FieldValueType =
                          typename std::iterator_traits<typename InputRange::iterator>::value_type::first_type>
@@ -45,20 +81,30 @@ namespace nil {
                 polynomial<FieldValueType>>::type
                 lagrange_interpolation(const InputRange &points) {
 
+                typedef typename FieldValueType::field_type FieldType;
+
                 std::size_t k = std::size(points);
+                if (k == 0) {
+                    return polynomial<FieldValueType>();
+                }
 
-                polynomial<FieldValueType> result;
+                std::vector<FieldValueType> x(k), y(k);
                 for (std::size_t j = 0; j < k; ++j) {
-                    polynomial<FieldValueType> term({points[j].second});
-                    for (std::size_t m = 0; m < k; ++m) {
-                        if (m != j) {
-                            term = term * (polynomial<FieldValueType>({-points[m].first, FieldValueType::one()}) /
-                                           polynomial<FieldValueType>({points[j].first - points[m].first}));
-                        }
-                    }
-                    result = result + term;
+                    x[j] = points[j].first;
+                    y[j] = points[j].second;
                 }
-                return result;
+
+                if (detail::is_radix2_subgroup<FieldType>(x)) {
+                    evaluation_domain_cache<FieldType>::instance().template get<basic_radix2_domain<FieldType>>(k)
+                        ->inverse_fft(y);
+                } else {
+                    std::vector<std::vector<std::vector<FieldValueType>>> T;
+                    compute_subproduct_tree<FieldType>(T, x);
+                    y = interpolate_with_subproduct_tree<FieldType>(y, T);
+                }
+
+                condense(y);
+                return polynomial<FieldValueType>(std::move(y));
             }
         }    // namespace math
     }        // namespace crypto3
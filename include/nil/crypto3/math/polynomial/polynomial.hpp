@@ -31,6 +31,7 @@
 #include <vector>
 
 #include <nil/crypto3/math/polynomial/basic_operations.hpp>
+#include <nil/crypto3/math/polynomial/basis_change.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -58,6 +59,9 @@ namespace nil {
                 polynomial() : val({0}) {
                 }
 
+                explicit polynomial(const allocator_type& a) : val({0}, a) {
+                }
+
                 explicit polynomial(size_type n) : val(n) {
                 }
                 explicit polynomial(size_type n, const allocator_type& a) : val(n, a) {
@@ -154,7 +158,7 @@ namespace nil {
                 }
 
                 allocator_type get_allocator() const BOOST_NOEXCEPT {
-                    return this->val.__alloc();
+                    return this->val.get_allocator();
                 }
 
                 iterator begin() BOOST_NOEXCEPT {
@@ -349,6 +353,34 @@ namespace nil {
                     return result;
                 }
 
+                /**
+                 * Evaluate the polynomial at every one of the points. Many points of a large polynomial are
+                 * evaluated with the remainder tree over their subproduct tree, other cases with evaluate_with_horner.
+                 */
+                std::vector<FieldValueType> evaluate_many(const std::vector<FieldValueType>& points) const {
+                    typedef typename FieldValueType::field_type FieldType;
+
+                    if (points.size() < detail::subproduct_tree_evaluation_threshold ||
+                        this->size() < detail::subproduct_tree_evaluation_threshold) {
+                        return evaluate_with_horner<FieldType>(val, points);
+                    }
+
+                    std::vector<std::vector<std::vector<FieldValueType>>> T;
+                    compute_subproduct_tree<FieldType>(T, points);
+                    return evaluate_with_subproduct_tree<FieldType>(val, T);
+                }
+
+                /**
+                 * Evaluate the polynomial at the points of the subproduct tree T, which is built once with
+                 * compute_subproduct_tree and reused for every polynomial evaluated at the same points.
+                 */
+                std::vector<FieldValueType>
+                    evaluate_many(const std::vector<std::vector<std::vector<FieldValueType>>>& T) const {
+                    typedef typename FieldValueType::field_type FieldType;
+
+                    return evaluate_with_subproduct_tree<FieldType>(val, T);
+                }
+
                 /**
                  * Returns true if polynomial is a zero polynomial.
                  */
@@ -385,13 +417,13 @@ namespace nil {
                  * polynomial C.
                  */
                 polynomial operator+(const polynomial& other) const {
-                    polynomial result;
+                    polynomial result(get_allocator());
                     addition(result, *this, other);
                     return result;
                 }
 
                 polynomial operator-() const {
-                    polynomial result(this->size());
+                    polynomial result(this->size(), get_allocator());
                     std::transform(this->begin(), this->end(), result.begin(), std::negate<FieldValueType>());
                     return result;
                 }
@@ -401,7 +433,7 @@ namespace nil {
                  * polynomial C.
                  */
                 polynomial operator-(const polynomial& other) const {
-                    polynomial result;
+                    polynomial result(get_allocator());
                     subtraction(result, *this, other);
                     return result;
                 }
@@ -411,7 +443,7 @@ namespace nil {
                  * polynomial C.
                  */
                 polynomial operator*(const polynomial& other) const {
-                    polynomial result;
+                    polynomial result(get_allocator());
                     multiplication(result, *this, other);
                     return result;
                 }
@@ -422,7 +454,7 @@ namespace nil {
                  * Output: Polynomial Q, such that A = (Q * B) + R.
                  */
                 polynomial operator/(const polynomial& other) const {
-                    polynomial r,q;
+                    polynomial r(get_allocator()), q(get_allocator());
                     division(q, r, *this, other);
                     return q;
                 }
@@ -433,10 +465,30 @@ namespace nil {
                  * Output: Polynomial R, such that A = (Q * B) + R.
                  */
                 polynomial operator%(const polynomial& other) const {
-                    polynomial r, q;
+                    polynomial r(get_allocator()), q(get_allocator());
                     division(q, r, *this, other);
                     return r;
                 }
+
+                /**
+                 * Divide the polynomial by the binomial x^n - c, e.g. by the vanishing polynomial x^n - 1 of a
+                 * subgroup of the size n, in O(n). The remainder is dropped, see division_by_binomial.
+                 */
+                polynomial divide_by_binomial(std::size_t n, const FieldValueType& c) const {
+                    polynomial r(get_allocator()), q(get_allocator());
+                    division_by_binomial(q, r, *this, n, c);
+                    return q;
+                }
+
+                /**
+                 * Divide the polynomial by x - z in O(n). The remainder, its value at z, is dropped, see
+                 * division_by_linear.
+                 */
+                polynomial divide_by_linear(const FieldValueType& z) const {
+                    polynomial q(get_allocator());
+                    division_by_linear(q, *this, z);
+                    return q;
+                }
             };
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -444,7 +496,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator+(const polynomial<FieldValueType, Allocator>& A,
                                                             const FieldValueType& B) {
 
-                return A + polynomial<FieldValueType>(B);
+                return A + polynomial<FieldValueType, Allocator>(1, B, A.get_allocator());
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -452,7 +504,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator+(const FieldValueType& A,
                                                             const polynomial<FieldValueType, Allocator>& B) {
 
-                return polynomial<FieldValueType>(A) + B;
+                return polynomial<FieldValueType, Allocator>(1, A, B.get_allocator()) + B;
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -460,7 +512,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator-(const polynomial<FieldValueType, Allocator>& A,
                                                             const FieldValueType& B) {
 
-                return A - polynomial<FieldValueType>(B);
+                return A - polynomial<FieldValueType, Allocator>(1, B, A.get_allocator());
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -468,7 +520,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator-(const FieldValueType& A,
                                                             const polynomial<FieldValueType, Allocator>& B) {
 
-                return polynomial<FieldValueType>(A) - B;
+                return polynomial<FieldValueType, Allocator>(1, A, B.get_allocator()) - B;
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -476,7 +528,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator*(const polynomial<FieldValueType, Allocator>& A,
                                                             const FieldValueType& B) {
 
-                return A * polynomial<FieldValueType>(B);
+                return A * polynomial<FieldValueType, Allocator>(1, B, A.get_allocator());
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -484,7 +536,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator*(const FieldValueType& A,
                                                             const polynomial<FieldValueType, Allocator>& B) {
 
-                return polynomial<FieldValueType>(A) * B;
+                return polynomial<FieldValueType, Allocator>(1, A, B.get_allocator()) * B;
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -492,7 +544,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator/(const polynomial<FieldValueType, Allocator>& A,
                                                             const FieldValueType& B) {
 
-                return A / polynomial<FieldValueType>(B);
+                return A / polynomial<FieldValueType, Allocator>(1, B, A.get_allocator());
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -500,7 +552,7 @@ namespace nil {
             polynomial<FieldValueType, Allocator> operator/(const FieldValueType& A,
                                                             const polynomial<FieldValueType, Allocator>& B) {
 
-                return polynomial<FieldValueType>(A) / B;
+                return polynomial<FieldValueType, Allocator>(1, A, B.get_allocator()) / B;
             }
         }    // namespace math
     }        // namespace crypto3
@@ -28,10 +28,17 @@
 #define CRYPTO3_MATH_POLYNOMIAL_POLYNOM_DFT_HPP
 
 #include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
 #include <nil/crypto3/math/polynomial/basic_operations.hpp>
-#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/polynomial/detail/polynomial_dfs_expression.hpp>
+#include <nil/crypto3/math/algorithms/evaluation_domain_cache.hpp>
+#include <nil/crypto3/math/instrumentation.hpp>
+#include <nil/crypto3/math/span.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -43,6 +50,7 @@ namespace nil {
 
                 container_type val;
                 size_t _d;
+                evaluation_order _order = evaluation_order::natural;
 
             public:
                 typedef typename container_type::value_type value_type;
@@ -94,10 +102,11 @@ namespace nil {
 
                 ~polynomial_dfs() = default;
 
-                polynomial_dfs(const polynomial_dfs& x) : val(x.val), _d(x._d) {
+                polynomial_dfs(const polynomial_dfs& x) : val(x.val), _d(x._d), _order(x._order) {
                 }
 
-                polynomial_dfs(const polynomial_dfs& x, const allocator_type& a) : val(x.val, a), _d(x._d) {
+                polynomial_dfs(const polynomial_dfs& x, const allocator_type& a) :
+                    val(x.val, a), _d(x._d), _order(x._order) {
                 }
 
                 polynomial_dfs(size_t d, std::initializer_list<value_type> il) : val(il), _d(d) {
@@ -113,10 +122,11 @@ namespace nil {
                 polynomial_dfs(polynomial_dfs&& x)
                     BOOST_NOEXCEPT(std::is_nothrow_move_constructible<allocator_type>::value) :
                     val(x.val),
-                    _d(x._d) {
+                    _d(x._d), _order(x._order) {
                 }
 
-                polynomial_dfs(polynomial_dfs&& x, const allocator_type& a) : val(x.val, a), _d(x._d) {
+                polynomial_dfs(polynomial_dfs&& x, const allocator_type& a) :
+                    val(x.val, a), _d(x._d), _order(x._order) {
                 }
 
                 polynomial_dfs(size_t d, const container_type& c) : val(c), _d(d) {
@@ -129,15 +139,43 @@ namespace nil {
                                      "DFS optimal polynom size must be power of two");
                 }
 
+                /**
+                 * Evaluate a lazy expression over polynomial_dfs operands, see polynomial_dfs_expression.
+                 */
+                template<typename Expression>
+                polynomial_dfs(const polynomial_dfs_expression<Expression>& e) :
+                    val(e.derived().size()), _d(e.derived().degree()) {
+                    _order = evaluate_expression(e, val.data(), true);
+                }
+
                 polynomial_dfs& operator=(const polynomial_dfs& x) {
                     val = x.val;
                     _d = x._d;
+                    _order = x._order;
                     return *this;
                 }
 
                 polynomial_dfs& operator=(polynomial_dfs&& x) {
                     val = x.val;
                     _d = x._d;
+                    _order = x._order;
+                    return *this;
+                }
+
+                /**
+                 * Evaluate the expression in place if it has the current size, operands may then alias *this.
+                 */
+                template<typename Expression>
+                polynomial_dfs& operator=(const polynomial_dfs_expression<Expression>& e) {
+                    const std::size_t d = e.derived().degree();
+                    if (val.size() == e.derived().size()) {
+                        _order = evaluate_expression(e, val.data(), true);
+                    } else {
+                        container_type result(e.derived().size(), val.get_allocator());
+                        _order = evaluate_expression(e, result.data(), true);
+                        val.swap(result);
+                    }
+                    _d = d;
                     return *this;
                 }
 
@@ -156,11 +194,28 @@ namespace nil {
                 //                    return *this;
                 //                }
 
+                /**
+                 * Whether the polynomials have the same degree and the same values, compared in the natural order:
+                 * the same values stored in the natural and in the bit-reversed order compare equal.
+                 */
                 bool operator==(const polynomial_dfs& rhs) const {
-                    return val == rhs.val && _d == rhs.d;
+                    if (_d != rhs._d || val.size() != rhs.val.size()) {
+                        return false;
+                    }
+                    if (_order == rhs._order || val.size() == 1) {
+                        return val == rhs.val;
+                    }
+
+                    const std::size_t logn = static_cast<std::size_t>(std::log2(val.size()));
+                    for (std::size_t i = 0; i < val.size(); ++i) {
+                        if (val[i] != rhs.val[detail::bitreverse(i, logn)]) {
+                            return false;
+                        }
+                    }
+                    return true;
                 }
                 bool operator!=(const polynomial_dfs& rhs) const {
-                    return !(rhs == *this && _d == rhs.d);
+                    return !(*this == rhs);
                 }
 
                 //                template<typename InputIterator>
@@ -178,7 +233,7 @@ namespace nil {
                 //                }
 
                 allocator_type get_allocator() const BOOST_NOEXCEPT {
-                    return this->val.__alloc();
+                    return this->val.get_allocator();
                 }
 
                 iterator begin() BOOST_NOEXCEPT {
@@ -235,6 +290,30 @@ namespace nil {
                     return _d;
                 }
 
+                /**
+                 * Order of the values: operator[] and the iterators give the value at the point omega^i at
+                 * index i for the natural order, and at index bitreverse(i) for the bit-reversed one.
+                 */
+                evaluation_order order() const BOOST_NOEXCEPT {
+                    return _order;
+                }
+
+                /**
+                 * Permute the values into the given order.
+                 */
+                void reorder(evaluation_order order) {
+                    if (order != _order && val.size() > 1) {
+                        const std::size_t logn = static_cast<std::size_t>(std::log2(val.size()));
+                        detail::parallel_for(
+                            thread_pool::global().get(), 0, val.size(),
+                            [this, logn](std::size_t begin, std::size_t end) {
+                                detail::basic_radix2_bitreverse(val, logn, begin, end);
+                            },
+                            detail::basic_radix2_fft_grain_size);
+                    }
+                    _order = order;
+                }
+
                 size_type max_degree() const BOOST_NOEXCEPT {
                     return this->size();
                 }
@@ -344,31 +423,100 @@ namespace nil {
                 }
 
                 void resize(size_type _sz) {
+                    CRYPTO3_MATH_INSTRUMENT("polynomial_dfs::resize", _sz,
+                                            (_sz > this->size() ? _sz - this->size() : 0) * sizeof(FieldValueType));
+
                     // BOOST_ASSERT_MSG(_sz >= _d, "Can't restore polynomial in the future");
 
+                    reorder(evaluation_order::natural);
+
                     if (this->size() == 1){
                         this->val.resize(_sz, this->val[0]);
+                    } else if (_sz > this->size() && _sz == detail::power_of_two(_sz) &&
+                               this->size() == detail::power_of_two(this->size())) {
+                        this->extend(static_cast<std::size_t>(std::log2(_sz / this->size())));
                     } else {
                         typedef typename value_type::field_type FieldType;
 
-                        make_evaluation_domain<FieldType>(this->size())->inverse_fft(this->val);
+                        evaluation_domain_cache<FieldType> &domains = evaluation_domain_cache<FieldType>::instance();
+                        transform(*domains.get(this->size()), this->val, true);
                         this->val.resize(_sz, FieldValueType::zero());
-                        make_evaluation_domain<FieldType>(_sz)->fft(this->val);
+                        transform(*domains.get(_sz), this->val, false);
+                    }
+                }
+
+                /**
+                 * Extend the evaluations to the domain of the size 2^k * size(), i.e. compute the low-degree
+                 * extension with the blowup factor 2^k. Same as resize to that size, but takes one inverse FFT and
+                 * 2^k - 1 coset FFTs of the size size() instead of the FFT of the extended size.
+                 */
+                void extend(std::size_t k) {
+                    std::vector<polynomial_dfs*> polys = {this};
+                    extend(polys, k);
+                }
+
+                /**
+                 * Extend each of the polynomials as extend(k) does. The coset FFTs of all the polynomials of the
+                 * same size run as one batch.
+                 */
+                static void extend_batch(std::vector<polynomial_dfs>& polys, std::size_t k) {
+                    std::vector<polynomial_dfs*> group;
+                    std::vector<bool> done(polys.size(), false);
+                    for (std::size_t i = 0; i < polys.size(); ++i) {
+                        if (done[i]) {
+                            continue;
+                        }
+                        group.clear();
+                        for (std::size_t j = i; j < polys.size(); ++j) {
+                            if (!done[j] && polys[j].size() == polys[i].size()) {
+                                group.push_back(&polys[j]);
+                                done[j] = true;
+                            }
+                        }
+                        extend(group, k);
                     }
                 }
 
                 void swap(polynomial_dfs& other) {
                     val.swap(other.val);
                     std::swap(_d, other._d);
+                    std::swap(_order, other._order);
                 }
 
+                /**
+                 * Evaluates the polynomial at an arbitrary point in O(n) with the barycentric formula
+                 * f(x) = (x^n - 1) / n * sum_i omega^i * f_i / (x - omega^i), so no inverse FFT is needed.
+                 */
                 FieldValueType evaluate(const FieldValueType& value) const {
+                    CRYPTO3_MATH_INSTRUMENT("polynomial_dfs::evaluate", this->size(),
+                                            this->size() * sizeof(FieldValueType));
+
+                    const std::vector<FieldValueType> weights = barycentric_weights(this->size(), value, _order);
+                    return std::inner_product(weights.begin(), weights.end(), this->begin(), FieldValueType::zero());
+                }
 
-                    std::vector<FieldValueType> tmp = this->coefficients();
-                    FieldValueType result = 0;
-                    auto end = tmp.end();
-                    while (end != tmp.begin()) {
-                        result = result * value + *--end;
+                /**
+                 * Evaluates every polynomial at the same point. The barycentric weights, and with them the only
+                 * inversion, are shared by all polynomials having the same number and order of evaluations.
+                 */
+                static std::vector<FieldValueType> evaluate_batch(const std::vector<polynomial_dfs>& polys,
+                                                                  const FieldValueType& value) {
+                    std::vector<FieldValueType> result(polys.size());
+                    std::vector<bool> done(polys.size(), false);
+                    for (std::size_t i = 0; i < polys.size(); ++i) {
+                        if (done[i]) {
+                            continue;
+                        }
+                        const std::vector<FieldValueType> weights =
+                            barycentric_weights(polys[i].size(), value, polys[i].order());
+                        for (std::size_t j = i; j < polys.size(); ++j) {
+                            if (!done[j] && polys[j].size() == polys[i].size() &&
+                                polys[j].order() == polys[i].order()) {
+                                result[j] = std::inner_product(weights.begin(), weights.end(), polys[j].begin(),
+                                                               FieldValueType::zero());
+                                done[j] = true;
+                            }
+                        }
                     }
                     return result;
                 }
@@ -391,76 +539,187 @@ namespace nil {
                 }
 
                 /**
-                 * Computes the standard polynomial addition, polynomial A + polynomial B, and stores result in
-                 * polynomial C.
+                 * Product of all the factors. The size of the result is planned once from the sum of the degrees,
+                 * each factor smaller than that is extended to it once (factors of the same size share one batched
+                 * extension, repeated factors are extended once), and the result is filled in a single pointwise
+                 * pass, with no intermediate products.
                  */
-                polynomial_dfs operator+(const polynomial_dfs& other) const {
-                    polynomial_dfs result(std::max(this->_d, other._d), this->begin(), this->end());
-                    if (other.size() > this->size()) {
-                        result.resize(other.size());
-                    }
-                    if (this->size() > other.size()) {
-                        polynomial_dfs tmp(other);
-                        tmp.resize(this->size());
-                        std::transform(tmp.begin(), tmp.end(), result.begin(), result.begin(),
-                                       std::plus<FieldValueType>());
-                        return result;
-                    }
-                    std::transform(other.begin(), other.end(), result.begin(), result.begin(),
-                                   std::plus<FieldValueType>());
+                static polynomial_dfs product(const std::vector<polynomial_dfs>& factors) {
+                    BOOST_ASSERT_MSG(!factors.empty(), "Product of no polynomials");
+
+                    std::vector<polynomial_dfs_leaf<FieldValueType>> leaves;
+                    std::size_t d = 0, max_size = 0;
+                    for (const polynomial_dfs& f : factors) {
+                        leaves.emplace_back(f.data(), f.size(), f.degree(), 0, 0, f.order());
+                        d += f.degree();
+                        max_size = std::max(max_size, f.size());
+                    }
+                    const std::size_t n = detail::power_of_two(std::max(max_size, d + 1));
+
+                    std::vector<const polynomial_dfs_leaf<FieldValueType>*> pointers;
+                    for (const polynomial_dfs_leaf<FieldValueType>& leaf : leaves) {
+                        pointers.push_back(&leaf);
+                    }
+                    const evaluation_order order = leaves_order(pointers, n, true);
+                    const std::vector<polynomial_dfs> extended = bind_leaves(pointers, n, order);
+
+                    polynomial_dfs result(d, n);
+                    result._order = order;
+                    detail::parallel_for(
+                        thread_pool::global().get(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                FieldValueType acc = leaves[0][i];
+                                for (std::size_t j = 1; j < leaves.size(); ++j) {
+                                    acc *= leaves[j][i];
+                                }
+                                result.val[i] = acc;
+                            }
+                        },
+                        1ul << 10);
                     return result;
                 }
 
-                polynomial_dfs operator-() const {
-                    polynomial_dfs result(this->_d, this->begin(), this->end());
-                    std::transform(this->begin(), this->end(), result.begin(), std::negate<FieldValueType>());
-                    return result;
+                /**
+                 * Write the values of the expression on the domain of the size e.size() to out, in one pass which
+                 * runs on the global thread pool when one is installed. Operands smaller than that are extended
+                 * first, as product does. Each value is computed from the operand values at the same index only,
+                 * so out may alias an operand of the same size, unless it is rotated: the values then go through a
+                 * copy.
+                 *
+                 * The values are in the bit-reversed order if bit_reversed is allowed and all of the operands are
+                 * of the size of the result and in that order, so that pointwise operations between such operands
+                 * take no permutation, or in the natural order otherwise. Returns the order.
+                 */
+                template<typename Expression>
+                static evaluation_order evaluate_expression(const polynomial_dfs_expression<Expression>& e,
+                                                            FieldValueType* out, bool bit_reversed = false) {
+                    const Expression& expression = e.derived();
+                    const std::size_t n = expression.size();
+
+                    std::vector<const polynomial_dfs_leaf<FieldValueType>*> leaves;
+                    expression.collect(leaves);
+                    const evaluation_order order = leaves_order(leaves, n, bit_reversed);
+                    const std::vector<polynomial_dfs> extended = bind_leaves(leaves, n, order);
+
+                    std::vector<FieldValueType> copy;
+                    for (const polynomial_dfs_leaf<FieldValueType>* leaf : leaves) {
+                        if (leaf->rotated() && leaf->data() == out && leaf->size() == n) {
+                            copy.assign(out, out + n);
+                            leaf->bind(copy.data(), n);
+                        }
+                    }
+
+                    detail::parallel_for(
+                        thread_pool::global().get(), 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                out[i] = expression[i];
+                            }
+                        },
+                        1ul << 10);
+                    return order;
                 }
 
                 /**
-                 * Computes the standard polynomial subtraction, polynomial A - polynomial B, and stores result in
-                 * polynomial C.
+                 * Bind the operands of the expression to their values on the domain of the size n, a power of two
+                 * at least the size of each of them, in the natural order: e.derived()[i] then reads the value of
+                 * the expression at omega^i, for consumers which fuse their own pass with the evaluation. Operands
+                 * of another size or order are read from extended copies, which are returned and have to outlive
+                 * the reads.
                  */
-                polynomial_dfs operator-(const polynomial_dfs& other) const {
-                    polynomial_dfs result(std::max(_d, other._d), this->begin(), this->end());
-                    if (other.size() > this->size()) {
-                        result.resize(other.size());
-                    }
-                    if (this->size() > other.size()) {
-                        polynomial_dfs tmp(other);
-                        tmp.resize(this->size());
-                        std::transform(result.begin(), result.end(), tmp.begin(), result.begin(),
-                                       std::minus<FieldValueType>());
-                        return result;
-                    }
-                    std::transform(result.begin(), result.end(), other.begin(), result.begin(),
-                                   std::minus<FieldValueType>());
-                    return result;
+                template<typename Expression>
+                static std::vector<polynomial_dfs> bind_expression(const polynomial_dfs_expression<Expression>& e,
+                                                                   std::size_t n) {
+                    std::vector<const polynomial_dfs_leaf<FieldValueType>*> leaves;
+                    e.derived().collect(leaves);
+                    return bind_leaves(leaves, n, evaluation_order::natural);
                 }
 
                 /**
-                 * Perform the multiplication of two polynomials, polynomial A * polynomial B, and stores result in
-                 * polynomial C.
+                 * Set out[i] = f(i) for i < n, in parallel on the global thread pool when one is installed. The
+                 * kernel of the in-place operations: f only reads the values at index i, so out may be one of
+                 * them, and a plain indexed loop over the values is what the compiler vectorizes for word fields.
                  */
-                polynomial_dfs operator*(const polynomial_dfs& other) const {
-                    polynomial_dfs result(this->degree() + other.degree(), this->begin(), this->end());
+                template<typename Function>
+                static void pointwise(FieldValueType* out, std::size_t n, Function f) {
+                    detail::parallel_for(
+                        thread_pool::global().get(), 0, n,
+                        [out, &f](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                out[i] = f(i);
+                            }
+                        },
+                        1ul << 10);
+                }
 
-                    size_t polynomial_s =
-                        detail::power_of_two(std::max({this->size(), other.size(), this->degree() + other.degree() + 1}));
+                /**
+                 * In-place addition. With an operand of the same size and order it takes one pass over the values
+                 * and no allocation, otherwise it is evaluated as *this = *this + other.
+                 */
+                polynomial_dfs& operator+=(const polynomial_dfs& other) {
+                    if (other.size() != this->size() || other._order != _order) {
+                        return *this = make_expression(*this) + other;
+                    }
+                    value_type* a = val.data();
+                    const value_type* b = other.data();
+                    pointwise(a, this->size(), [a, b](std::size_t i) { return a[i] + b[i]; });
+                    _d = std::max(_d, other._d);
+                    return *this;
+                }
 
-                    if (result.size() < polynomial_s) {
-                        result.resize(polynomial_s);
+                /**
+                 * In-place subtraction, see operator+=.
+                 */
+                polynomial_dfs& operator-=(const polynomial_dfs& other) {
+                    if (other.size() != this->size() || other._order != _order) {
+                        return *this = make_expression(*this) - other;
                     }
-                    if (other.size() < polynomial_s) {
-                        polynomial_dfs tmp(other);
-                        tmp.resize(polynomial_s);
-                        std::transform(result.begin(), result.end(), tmp.begin(), result.begin(),
-                                       std::multiplies<FieldValueType>());
-                        return result;
+                    value_type* a = val.data();
+                    const value_type* b = other.data();
+                    pointwise(a, this->size(), [a, b](std::size_t i) { return a[i] - b[i]; });
+                    _d = std::max(_d, other._d);
+                    return *this;
+                }
+
+                /**
+                 * In-place multiplication. It takes one pass over the values when the operand has the same size and
+                 * order and the product still fits the domain, otherwise it is evaluated as *this = *this * other,
+                 * which extends both to the size of the product.
+                 */
+                polynomial_dfs& operator*=(const polynomial_dfs& other) {
+                    if (other.size() != this->size() || other._order != _order || _d + other._d >= this->size()) {
+                        return *this = make_expression(*this) * other;
                     }
-                    std::transform(other.begin(), other.end(), result.begin(), result.begin(),
-                                   std::multiplies<FieldValueType>());
-                    return result;
+                    value_type* a = val.data();
+                    const value_type* b = other.data();
+                    pointwise(a, this->size(), [a, b](std::size_t i) { return a[i] * b[i]; });
+                    _d += other._d;
+                    return *this;
+                }
+
+                /**
+                 * Multiply by a scalar in place.
+                 */
+                polynomial_dfs& operator*=(const value_type& c) {
+                    value_type* a = val.data();
+                    pointwise(a, this->size(), [a, &c](std::size_t i) { return a[i] * c; });
+                    return *this;
+                }
+
+                /**
+                 * Accumulate c * other in place, in one pass, as operator+= does: a linear combination of columns
+                 * is then summed with no temporaries.
+                 */
+                polynomial_dfs& axpy(const value_type& c, const polynomial_dfs& other) {
+                    if (other.size() != this->size() || other._order != _order) {
+                        return *this = make_expression(*this) + c * make_expression(other);
+                    }
+                    value_type* a = val.data();
+                    const value_type* b = other.data();
+                    pointwise(a, this->size(), [a, b, &c](std::size_t i) { return a[i] + c * b[i]; });
+                    _d = std::max(_d, other._d);
+                    return *this;
                 }
 
                 /**
@@ -469,9 +728,9 @@ namespace nil {
                  * Output: Polynomial Q, such that A = (Q * B) + R.
                  */
                 polynomial_dfs operator/(const polynomial_dfs& other) const {
-                    std::vector<FieldValueType> x = this->coefficients();
-                    std::vector<FieldValueType> y = other.coefficients();
-                    std::vector<FieldValueType> r, q;
+                    container_type x = this->coefficients();
+                    container_type y = other.coefficients();
+                    container_type r(val.get_allocator()), q(val.get_allocator());
                     division(q, r, x, y);
                     std::size_t new_s = q.size();
 
@@ -489,9 +748,9 @@ namespace nil {
                  * Output: Polynomial R, such that A = (Q * B) + R.
                  */
                 polynomial_dfs operator%(const polynomial_dfs& other) const {
-                    std::vector<FieldValueType> x = this->coefficients();
-                    std::vector<FieldValueType> y = other.coefficients();
-                    std::vector<FieldValueType> r, q;
+                    container_type x = this->coefficients();
+                    container_type y = other.coefficients();
+                    container_type r(val.get_allocator()), q(val.get_allocator());
                     division(q, r, x, y);
                     std::size_t new_s = r.size();
 
@@ -503,30 +762,138 @@ namespace nil {
                     return polynomial_dfs(new_s - 1, r);
                 }
 
+                /**
+                 * Divide the polynomial by the binomial x^n - c, which must divide it, through the values: they get
+                 * multiplied by the inverses of the values of x^n - c, which repeat with the period
+                 * size() / gcd(size(), n), so only that many are inverted, in one batch. With a shift the values
+                 * are taken for those at the coset shift * D of the domain D of the size size(): e.g. the quotient
+                 * of a constraint by Z_H = x^n - 1 on an extended coset of H. x^n - c must not vanish at the points.
+                 */
+                polynomial_dfs divide_by_binomial(std::size_t n, const value_type& c,
+                                                  const value_type& shift = value_type::one()) const {
+                    typedef typename value_type::field_type FieldType;
+
+                    const std::size_t period = this->size() / std::gcd(this->size(), n);
+                    const value_type zeta = unity_root<FieldType>(this->size()).pow(n);
+
+                    /* Z(shift * omega^i) = shift^n * zeta^(i mod period) - c */
+                    container_type z(period, value_type::zero(), val.get_allocator());
+                    value_type shifted = shift.pow(n);
+                    for (std::size_t j = 0; j < period; ++j) {
+                        z[j] = shifted - c;
+                        shifted *= zeta;
+                    }
+                    batch_inverse(z);
+
+                    polynomial_dfs result(_d >= n ? _d - n : 0, this->size(), val.get_allocator());
+                    result._order = _order;
+                    const bool reversed = _order == evaluation_order::bit_reversed;
+                    const std::size_t logn = static_cast<std::size_t>(std::log2(this->size()));
+                    detail::parallel_for(
+                        thread_pool::global().get(), 0, this->size(),
+                        [this, &z, &result, period, reversed, logn](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                result[i] = val[i] * z[(reversed ? detail::bitreverse(i, logn) : i) % period];
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                    return result;
+                }
+
+                /**
+                 * Divide the polynomial by x - z, given that it vanishes at z, through the values, with all of the
+                 * values of x - z inverted in one batch. With a shift the values are taken for those at the coset
+                 * shift * D, as for divide_by_binomial. z must not be one of the points.
+                 */
+                polynomial_dfs divide_by_linear(const value_type& z,
+                                                const value_type& shift = value_type::one()) const {
+                    typedef typename value_type::field_type FieldType;
+
+                    thread_pool *pool = thread_pool::global().get();
+                    const value_type omega = unity_root<FieldType>(this->size());
+
+                    polynomial_dfs result(_d > 0 ? _d - 1 : 0, this->size(), val.get_allocator());
+                    detail::parallel_for(
+                        pool, 0, this->size(),
+                        [&](std::size_t begin, std::size_t end) {
+                            value_type x = shift * omega.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                result[i] = x - z;
+                                x *= omega;
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                    batch_inverse(result.val, pool);
+                    result._order = evaluation_order::natural;
+                    result.reorder(_order);
+
+                    detail::parallel_for(
+                        pool, 0, this->size(),
+                        [this, &result](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                result[i] *= val[i];
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                    return result;
+                }
+
+                /**
+                 * Evaluate the coefficients on the domain of the power of two size at least their number, into the
+                 * values in the given order. The bit-reversed order takes no permutation pass, see
+                 * basic_radix2_domain::fft_to_bitreversed.
+                 */
                 template<typename ContainerType>
-                void from_coefficients(const ContainerType &tmp) {
+                void from_coefficients(const ContainerType &tmp, evaluation_order order = evaluation_order::natural) {
                     typedef typename value_type::field_type FieldType;
                     size_t n = detail::power_of_two(tmp.size());
-                    value_type omega = unity_root<FieldType>(n);
                     _d = tmp.size() - 1;
                     val.assign(tmp.begin(), tmp.end());
                     val.resize(n, FieldValueType::zero());
-                    detail::basic_radix2_fft<FieldType>(val, omega);
+                    _order = order;
+                    if (order == evaluation_order::bit_reversed && n > 1) {
+                        evaluation_domain_cache<FieldType>::instance()
+                            .template get<basic_radix2_domain<FieldType>>(n)
+                            ->fft_to_bitreversed(span<FieldValueType>(val));
+                        return;
+                    }
+                    value_type omega = unity_root<FieldType>(n);
+                    detail::basic_radix2_fft<FieldType>(val, omega, thread_pool::global().get());
                 }
 
-                std::vector<FieldValueType> coefficients() const {
+                /**
+                 * The coefficients, in the natural order whatever the order of the values is.
+                 */
+                container_type coefficients() const {
                     typedef typename value_type::field_type FieldType;
 
+                    container_type tmp(this->begin(), this->end(), val.get_allocator());
+                    if (_order == evaluation_order::bit_reversed && tmp.size() > 1) {
+                        evaluation_domain_cache<FieldType>::instance()
+                            .template get<basic_radix2_domain<FieldType>>(tmp.size())
+                            ->inverse_fft_from_bitreversed(span<FieldValueType>(tmp));
+                        return trimmed(std::move(tmp));
+                    }
+
                     value_type omega = unity_root<FieldType>(this->size());
-                    std::vector<FieldValueType> tmp(this->begin(), this->end());
 
-                    detail::basic_radix2_fft<FieldType>(tmp, omega.inversed());
+                    thread_pool *pool = thread_pool::global().get();
+                    detail::basic_radix2_fft<FieldType>(tmp, omega.inversed(), pool);
 
                     const value_type sconst = value_type(this->size()).inversed();
-                    std::transform(tmp.begin(),
-                                   tmp.end(),
-                                   tmp.begin(),
-                                   std::bind(std::multiplies<value_type>(), sconst, std::placeholders::_1));
+                    detail::parallel_for(
+                        pool, 0, tmp.size(),
+                        [&tmp, &sconst](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                tmp[i] *= sconst;
+                            }
+                        },
+                        detail::basic_radix2_fft_grain_size);
+                    return trimmed(std::move(tmp));
+                }
+
+            private:
+                static container_type trimmed(container_type tmp) {
                     size_t r_size = tmp.size();
                     while (r_size > 1 && tmp[r_size - 1] == FieldValueType::zero()) {
                         --r_size;
@@ -534,54 +901,288 @@ namespace nil {
                     tmp.resize(r_size);
                     return tmp;
                 }
-            };
 
-            template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
-                     typename = typename std::enable_if<detail::is_field_element<FieldValueType>::value>::type>
-            polynomial_dfs<FieldValueType, Allocator> operator+(const polynomial_dfs<FieldValueType, Allocator>& A,
-                                                            const FieldValueType& B) {
+                template<typename FieldType>
+                static void transform(evaluation_domain<FieldType>& domain, std::vector<FieldValueType>& values,
+                                      bool inverse) {
+                    if (inverse) {
+                        domain.inverse_fft(values);
+                    } else {
+                        domain.fft(values);
+                    }
+                }
 
-                return A + polynomial_dfs<FieldValueType>(0, A.size(), B);
-            }
+                /* values with another allocator are transformed in place through a span, their size is domain.m */
+                template<typename FieldType, typename Container>
+                static void transform(evaluation_domain<FieldType>& domain, Container& values, bool inverse) {
+                    if (inverse) {
+                        domain.inverse_fft(span<FieldValueType>(values));
+                    } else {
+                        domain.fft(span<FieldValueType>(values));
+                    }
+                }
 
-            template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
-                     typename = typename std::enable_if<detail::is_field_element<FieldValueType>::value>::type>
-            polynomial_dfs<FieldValueType, Allocator> operator+(const FieldValueType& A,
-                                                            const polynomial_dfs<FieldValueType, Allocator>& B) {
+                /*
+                 * The order of an evaluation over the leaves on the domain of the size n: bit-reversed if that is
+                 * allowed and every leaf but the constants is of the size n and in that order, and is not rotated,
+                 * as the rotation is an offset of the index in the natural order.
+                 */
+                static evaluation_order
+                    leaves_order(const std::vector<const polynomial_dfs_leaf<FieldValueType>*>& leaves, std::size_t n,
+                                 bool bit_reversed) {
+                    bool any = false;
+                    for (const polynomial_dfs_leaf<FieldValueType>* leaf : leaves) {
+                        if (leaf->size() == 1) {
+                            continue;
+                        }
+                        if (leaf->size() != n || leaf->order() != evaluation_order::bit_reversed || leaf->shifted()) {
+                            return evaluation_order::natural;
+                        }
+                        any = true;
+                    }
+                    return bit_reversed && any ? evaluation_order::bit_reversed : evaluation_order::natural;
+                }
 
-                return polynomial_dfs<FieldValueType>(0, B.size(), A) + B;
-            }
+                /*
+                 * Bind every leaf to its values on the domain of the size n in the given order. Leaves of that
+                 * size and order or of the size 1 (constants) read their source directly. The others read a copy
+                 * extended to n and permuted into the order: each distinct source is extended once and the copies
+                 * of the same size share one batched extension. The returned copies have to outlive the evaluation.
+                 * Rotated leaves read the natural order only, so a bit-reversed one is read from a reordered copy,
+                 * and the bit-reversed order is rejected for them.
+                 */
+                static std::vector<polynomial_dfs>
+                    bind_leaves(const std::vector<const polynomial_dfs_leaf<FieldValueType>*>& leaves, std::size_t n,
+                                evaluation_order order = evaluation_order::natural) {
+                    std::vector<const polynomial_dfs_leaf<FieldValueType>*> distinct;
+                    auto find_distinct = [&distinct](const polynomial_dfs_leaf<FieldValueType>* leaf) {
+                        return static_cast<std::size_t>(
+                            std::find_if(distinct.begin(), distinct.end(),
+                                         [leaf](const polynomial_dfs_leaf<FieldValueType>* other) {
+                                             return other->data() == leaf->data() && other->size() == leaf->size();
+                                         }) -
+                            distinct.begin());
+                    };
+
+                    const auto direct = [n, order](const polynomial_dfs_leaf<FieldValueType>* leaf) {
+                        return leaf->size() == 1 || (leaf->size() == n && leaf->order() == order);
+                    };
+
+                    for (const polynomial_dfs_leaf<FieldValueType>* leaf : leaves) {
+                        if (leaf->shifted() && order != evaluation_order::natural) {
+                            throw std::invalid_argument("polynomial_dfs: expected the natural order for a rotation");
+                        }
+                        if (direct(leaf)) {
+                            leaf->bind(leaf->data(), n);
+                        } else if (find_distinct(leaf) == distinct.size()) {
+                            distinct.push_back(leaf);
+                        }
+                    }
 
-            template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
-                     typename = typename std::enable_if<detail::is_field_element<FieldValueType>::value>::type>
-            polynomial_dfs<FieldValueType, Allocator> operator-(const polynomial_dfs<FieldValueType, Allocator>& A,
-                                                            const FieldValueType& B) {
+                    std::vector<polynomial_dfs> extended(distinct.size());
+                    std::vector<bool> done(distinct.size(), false);
+                    std::vector<polynomial_dfs*> group;
+                    for (std::size_t i = 0; i < distinct.size(); ++i) {
+                        if (done[i]) {
+                            continue;
+                        }
+                        const std::size_t size = distinct[i]->size();
+                        group.clear();
+                        for (std::size_t j = i; j < distinct.size(); ++j) {
+                            if (!done[j] && distinct[j]->size() == size) {
+                                extended[j] = polynomial_dfs(distinct[j]->degree(), distinct[j]->data(),
+                                                             distinct[j]->data() + size);
+                                extended[j]._order = distinct[j]->order();
+                                group.push_back(&extended[j]);
+                                done[j] = true;
+                            }
+                        }
+                        if (size != n && size == detail::power_of_two(size) && n == detail::power_of_two(n)) {
+                            extend(group, static_cast<std::size_t>(std::log2(n / size)));
+                        } else if (size != n) {
+                            for (polynomial_dfs* p : group) {
+                                p->resize(n);
+                            }
+                        }
+                        for (polynomial_dfs* p : group) {
+                            p->reorder(order);
+                        }
+                    }
 
-                return A - polynomial_dfs<FieldValueType>(0, A.size(), B);
-            }
+                    for (const polynomial_dfs_leaf<FieldValueType>* leaf : leaves) {
+                        if (!direct(leaf)) {
+                            leaf->bind(extended[find_distinct(leaf)].data(), n);
+                        }
+                    }
+                    return extended;
+                }
 
-            template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
-                     typename = typename std::enable_if<detail::is_field_element<FieldValueType>::value>::type>
-            polynomial_dfs<FieldValueType, Allocator> operator-(const FieldValueType& A,
-                                                            const polynomial_dfs<FieldValueType, Allocator>& B) {
+                /**
+                 * Weights w_i such that f(x) = sum_i w_i * f_i for every f evaluated over the n-th roots of unity.
+                 * The denominators x - omega^i are inverted with batch_inverse; if x is one of the roots itself, the
+                 * weights select the matching evaluation.
+                 */
+                static std::vector<FieldValueType> barycentric_weights(std::size_t n, const FieldValueType& x,
+                                                                       evaluation_order order) {
+                    std::vector<FieldValueType> weights = barycentric_weights(n, x);
+                    if (order == evaluation_order::bit_reversed && n > 1) {
+                        detail::basic_radix2_bitreverse(weights, static_cast<std::size_t>(std::log2(n)), 0, n);
+                    }
+                    return weights;
+                }
 
-                return polynomial_dfs<FieldValueType>(0, B.size(), A) - B;
-            }
+                static std::vector<FieldValueType> barycentric_weights(std::size_t n, const FieldValueType& x) {
+                    typedef typename value_type::field_type FieldType;
 
-            template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
-                     typename = typename std::enable_if<detail::is_field_element<FieldValueType>::value>::type>
-            polynomial_dfs<FieldValueType, Allocator> operator*(const polynomial_dfs<FieldValueType, Allocator>& A,
-                                                            const FieldValueType& B) {
+                    std::vector<FieldValueType> weights(n, FieldValueType::zero());
+                    if (n == 1) {
+                        weights[0] = FieldValueType::one();
+                        return weights;
+                    }
 
-                return A * polynomial_dfs<FieldValueType>(0, A.size(), B);
-            }
+                    const FieldValueType omega = unity_root<FieldType>(n);
+                    FieldValueType omega_i = FieldValueType::one();
+                    for (std::size_t i = 0; i < n; ++i) {
+                        weights[i] = x - omega_i;
+                        if (weights[i].is_zero()) {
+                            std::fill(weights.begin(), weights.end(), FieldValueType::zero());
+                            weights[i] = FieldValueType::one();
+                            return weights;
+                        }
+                        omega_i *= omega;
+                    }
+                    batch_inverse(weights);
 
-            template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
-                     typename = typename std::enable_if<detail::is_field_element<FieldValueType>::value>::type>
-            polynomial_dfs<FieldValueType, Allocator> operator*(const FieldValueType& A,
-                                                            const polynomial_dfs<FieldValueType, Allocator>& B) {
+                    FieldValueType scale = (x.pow(n) - FieldValueType::one()) * FieldValueType(n).inversed();
+                    for (std::size_t i = 0; i < n; ++i) {
+                        weights[i] *= scale;
+                        scale *= omega;
+                    }
+                    return weights;
+                }
+
+                /*
+                 * Values of f on the extended domain of the size N = 2^k * n are f(omega_N^{q * 2^k + r}) =
+                 * f(omega_N^r * omega_n^q), so the extension interleaves the values on the 2^k cosets omega_N^r * S
+                 * of the original domain S. The coset r = 0 is S itself, others take a coset FFT each.
+                 */
+                static void extend(const std::vector<polynomial_dfs*>& polys, std::size_t k) {
+                    typedef typename value_type::field_type FieldType;
+
+                    if (k == 0 || polys.empty()) {
+                        return;
+                    }
+                    for (polynomial_dfs* p : polys) {
+                        p->reorder(evaluation_order::natural);
+                    }
+
+                    const std::size_t n = polys.front()->size();
+                    const std::size_t blowup = 1ul << k;
+
+                    CRYPTO3_MATH_INSTRUMENT("polynomial_dfs::extend", polys.size() * n * blowup,
+                                            polys.size() * n * (blowup - 1) * sizeof(FieldValueType));
+
+                    if (n == 1) {
+                        for (polynomial_dfs* p : polys) {
+                            p->val.resize(blowup, p->val[0]);
+                        }
+                        return;
+                    }
+
+                    BOOST_ASSERT_MSG(std::log2(n) + k <= fields::arithmetic_params<FieldType>::s,
+                                     "Extended domain size is too big for the field");
+
+                    const std::shared_ptr<basic_radix2_domain<FieldType>> domain =
+                        evaluation_domain_cache<FieldType>::instance().template get<basic_radix2_domain<FieldType>>(n);
+                    thread_pool* pool = domain->get_thread_pool();
+
+                    std::vector<FieldValueType> coefficients(polys.size() * n);
+                    for (std::size_t p = 0; p < polys.size(); ++p) {
+                        std::copy(polys[p]->begin(), polys[p]->end(), coefficients.begin() + p * n);
+                    }
+                    domain->inverse_fft_batch(coefficients);
+
+                    /* column (p, r) holds the coefficients of p scaled by the powers of omega_N^r */
+                    const std::size_t cosets = blowup - 1;
+                    const value_type omega = unity_root<FieldType>(n * blowup);
+                    std::vector<FieldValueType> columns(polys.size() * cosets * n);
+                    detail::parallel_for(
+                        pool, 0, polys.size() * cosets,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t c = begin; c < end; ++c) {
+                                const std::size_t p = c / cosets, r = c % cosets + 1;
+                                const value_type g = omega.pow(r);
+                                value_type u = value_type::one();
+                                for (std::size_t i = 0; i < n; ++i) {
+                                    columns[c * n + i] = coefficients[p * n + i] * u;
+                                    u *= g;
+                                }
+                            }
+                        },
+                        1);
+                    domain->fft_batch(columns);
+
+                    for (std::size_t p = 0; p < polys.size(); ++p) {
+                        container_type& val = polys[p]->val;
+                        const FieldValueType* coset_values = columns.data() + p * cosets * n;
+
+                        container_type extended(n * blowup, val.get_allocator());
+                        detail::parallel_for(
+                            pool, 0, n,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t q = begin; q < end; ++q) {
+                                    extended[q * blowup] = val[q];
+                                    for (std::size_t r = 1; r < blowup; ++r) {
+                                        extended[q * blowup + r] = coset_values[(r - 1) * n + q];
+                                    }
+                                }
+                            },
+                            detail::basic_radix2_fft_grain_size);
+                        val.swap(extended);
+                    }
+                }
+            };
+
+            namespace detail {
+                template<typename FieldValueType, typename Allocator>
+                struct polynomial_dfs_operand<polynomial_dfs<FieldValueType, Allocator>> {
+                    static constexpr bool value = true;
+                    typedef polynomial_dfs_leaf<FieldValueType> type;
+
+                    static type make(const polynomial_dfs<FieldValueType, Allocator>& x) {
+                        return type(x.data(), x.size(), x.degree(), 0, 0, x.order());
+                    }
+                };
+
+                template<typename FieldValueType, typename Allocator>
+                struct polynomial_dfs_result<polynomial_dfs<FieldValueType, Allocator>> {
+                    typedef polynomial_dfs<FieldValueType, Allocator> type;
+                };
+            }    // namespace detail
+
+            /**
+             * Division needs the coefficients, so expressions are evaluated before it.
+             */
+            template<typename L, typename R,
+                     typename = typename std::enable_if<(detail::is_polynomial_dfs_node<L>::value ||
+                                                         detail::is_polynomial_dfs_node<R>::value) &&
+                                                        detail::is_polynomial_dfs_operation<L, R>::value>::type>
+            polynomial_dfs<typename detail::polynomial_dfs_operand<L>::type::value_type>
+                operator/(const L& l, const R& r) {
+                typedef polynomial_dfs<typename detail::polynomial_dfs_operand<L>::type::value_type> result_type;
+                return result_type(detail::polynomial_dfs_operand<L>::make(l)) /
+                       result_type(detail::polynomial_dfs_operand<R>::make(r));
+            }
 
-                return polynomial_dfs<FieldValueType>(0, B.size(), A) * B;
+            template<typename L, typename R,
+                     typename = typename std::enable_if<(detail::is_polynomial_dfs_node<L>::value ||
+                                                         detail::is_polynomial_dfs_node<R>::value) &&
+                                                        detail::is_polynomial_dfs_operation<L, R>::value>::type>
+            polynomial_dfs<typename detail::polynomial_dfs_operand<L>::type::value_type>
+                operator%(const L& l, const R& r) {
+                typedef polynomial_dfs<typename detail::polynomial_dfs_operand<L>::type::value_type> result_type;
+                return result_type(detail::polynomial_dfs_operand<L>::make(l)) %
+                       result_type(detail::polynomial_dfs_operand<R>::make(r));
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -589,7 +1190,7 @@ namespace nil {
             polynomial_dfs<FieldValueType, Allocator> operator/(const polynomial_dfs<FieldValueType, Allocator>& A,
                                                             const FieldValueType& B) {
 
-                return A / polynomial_dfs<FieldValueType>(0, A.size(), B);
+                return A / polynomial_dfs<FieldValueType, Allocator>(0, A.size(), B, A.get_allocator());
             }
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -597,7 +1198,7 @@ namespace nil {
             polynomial_dfs<FieldValueType, Allocator> operator/(const FieldValueType& A,
                                                             const polynomial_dfs<FieldValueType, Allocator>& B) {
 
-                return polynomial_dfs<FieldValueType>(0, B.size(), A) / B;
+                return polynomial_dfs<FieldValueType, Allocator>(0, B.size(), A, B.get_allocator()) / B;
             }
         }    // namespace math
     }        // namespace crypto3
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include <nil/crypto3/math/polynomial/basic_operations.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <string_view>
 
 namespace nil {
@@ -57,10 +58,10 @@ namespace nil {
                 typedef typename container_type::reverse_iterator reverse_iterator;
                 typedef typename container_type::const_reverse_iterator const_reverse_iterator;
 
-                std::vector<element_type> &it;
+                container_type &it;
                 size_t _d;
 
-                polynomial_dfs_view(size_t d, std::vector<element_type>& vec) : it(vec), _d(d) {
+                polynomial_dfs_view(size_t d, container_type& vec) : it(vec), _d(d) {
                 }
 
                 polynomial_dfs_view(polynomial_dfs_view&& x)
@@ -86,6 +87,24 @@ namespace nil {
                     return *this;
                 }
 
+                /**
+                 * Evaluate a lazy expression into the viewed container, in place if it has the size of the
+                 * expression, see polynomial_dfs_expression.
+                 */
+                template<typename Expression>
+                polynomial_dfs_view& operator=(const polynomial_dfs_expression<Expression>& e) {
+                    const std::size_t d = e.derived().degree();
+                    if (it.size() == e.derived().size()) {
+                        polynomial_dfs<FieldValueType>::evaluate_expression(e, it.data());
+                    } else {
+                        container_type result(e.derived().size(), it.get_allocator());
+                        polynomial_dfs<FieldValueType>::evaluate_expression(e, result.data());
+                        it.swap(result);
+                    }
+                    _d = d;
+                    return *this;
+                }
+
                 //                polynomial_dfs& operator=(const container_type& x) {
                 //                    val = x;
                 //                    return *this;
@@ -335,7 +354,7 @@ namespace nil {
 
                     typedef typename value_type::field_type FieldType;
 
-                    std::vector<FieldValueType> tmp = this->coefficients();
+                    container_type tmp = this->coefficients();
                     FieldValueType result = 0;
                     auto end = tmp.end();
                     while (end != tmp.begin()) {
@@ -364,8 +383,15 @@ namespace nil {
                  * Computes the standard polynomial addition, polynomial A + polynomial B, and stores result in
                  * polynomial C.
                  */
-                polynomial_dfs_view operator+=(const polynomial_dfs_view& other) {
+                polynomial_dfs_view& operator+=(const polynomial_dfs_view& other) {
                     this->_d = std::max(this->_d, other._d);
+                    if (other.size() == this->size()) {
+                        value_type* a = it.data();
+                        const value_type* b = other.it.data();
+                        polynomial_dfs<FieldValueType>::pointwise(a, this->size(),
+                                                                  [a, b](std::size_t i) { return a[i] + b[i]; });
+                        return *this;
+                    }
                     if (other.size() > this->size()) {
                         this->resize(other.size());
                     }
@@ -389,8 +415,15 @@ namespace nil {
                  * Computes the standard polynomial subtraction, polynomial A - polynomial B, and stores result in
                  * polynomial C.
                  */
-                polynomial_dfs_view operator-=(const polynomial_dfs_view& other) {
+                polynomial_dfs_view& operator-=(const polynomial_dfs_view& other) {
                     this->_d = std::max(this->_d, other._d);
+                    if (other.size() == this->size()) {
+                        value_type* a = it.data();
+                        const value_type* b = other.it.data();
+                        polynomial_dfs<FieldValueType>::pointwise(a, this->size(),
+                                                                  [a, b](std::size_t i) { return a[i] - b[i]; });
+                        return *this;
+                    }
                     if (other.size() > this->size()) {
                         this->resize(other.size());
                     }
@@ -410,10 +443,17 @@ namespace nil {
                  * Perform the multiplication of two polynomials, polynomial A * polynomial B, and stores result in
                  * polynomial C.
                  */
-                polynomial_dfs_view operator*=(const polynomial_dfs_view& other) {
+                polynomial_dfs_view& operator*=(const polynomial_dfs_view& other) {
                     this->_d = this->_d + other._d;
                     size_t polynomial_s =
                         detail::power_of_two(std::max({this->size(), other.size(), this->_d + other._d + 1}));
+                    if (this->size() == polynomial_s && other.size() == polynomial_s) {
+                        value_type* a = it.data();
+                        const value_type* b = other.it.data();
+                        polynomial_dfs<FieldValueType>::pointwise(a, this->size(),
+                                                                  [a, b](std::size_t i) { return a[i] * b[i]; });
+                        return *this;
+                    }
                     if (this->size() < polynomial_s) {
                         this->resize(polynomial_s);
                     }
@@ -429,15 +469,40 @@ namespace nil {
                     return *this;
                 }
 
+                /**
+                 * Multiply by a scalar in place.
+                 */
+                polynomial_dfs_view& operator*=(const value_type& c) {
+                    value_type* a = it.data();
+                    polynomial_dfs<FieldValueType>::pointwise(a, this->size(),
+                                                              [a, &c](std::size_t i) { return a[i] * c; });
+                    return *this;
+                }
+
+                /**
+                 * Accumulate c * other in place, in one pass over the values when the sizes are equal.
+                 */
+                polynomial_dfs_view& axpy(const value_type& c, const polynomial_dfs_view& other) {
+                    if (other.size() != this->size()) {
+                        return *this = make_expression(*this) + c * make_expression(other);
+                    }
+                    value_type* a = it.data();
+                    const value_type* b = other.it.data();
+                    polynomial_dfs<FieldValueType>::pointwise(a, this->size(),
+                                                              [a, b, &c](std::size_t i) { return a[i] + c * b[i]; });
+                    this->_d = std::max(this->_d, other._d);
+                    return *this;
+                }
+
                 /**
                  * Perform the standard Euclidean Division algorithm.
                  * Input: Polynomial A, Polynomial B, where A / B
                  * Output: Polynomial Q, such that A = (Q * B) + R.
                  */
                 polynomial_dfs_view operator/=(const polynomial_dfs_view& other) {
-                    std::vector<FieldValueType> x = this->coefficients();
-                    std::vector<FieldValueType> y = other.coefficients();
-                    std::vector<FieldValueType> r, q;
+                    container_type x = this->coefficients();
+                    container_type y = other.coefficients();
+                    container_type r(it.get_allocator()), q(it.get_allocator());
                     division(q, r, x, y);
                     std::size_t new_s = q.size();
 
@@ -457,9 +522,9 @@ namespace nil {
                  * Output: Polynomial R, such that A = (Q * B) + R.
                  */
                 polynomial_dfs_view operator%=(const polynomial_dfs_view& other) {
-                    std::vector<FieldValueType> x = this->coefficients();
-                    std::vector<FieldValueType> y = other.coefficients();
-                    std::vector<FieldValueType> r, q;
+                    container_type x = this->coefficients();
+                    container_type y = other.coefficients();
+                    container_type r(it.get_allocator()), q(it.get_allocator());
                     division(q, r, x, y);
                     std::size_t new_s = r.size();
 
@@ -483,11 +548,11 @@ namespace nil {
                     detail::basic_radix2_fft<FieldType>(it, omega);
                 }
 
-                std::vector<FieldValueType> coefficients() const {
+                container_type coefficients() const {
                     typedef typename value_type::field_type FieldType;
 
                     value_type omega = unity_root<FieldType>(this->size());
-                    std::vector<FieldValueType> tmp(this->begin(), this->end());
+                    container_type tmp(this->begin(), this->end(), it.get_allocator());
 
                     detail::basic_radix2_fft<FieldType>(tmp, omega.inversed());
 
@@ -504,6 +569,23 @@ namespace nil {
                     return tmp;
                 }
             };
+
+            namespace detail {
+                template<typename FieldValueType, typename Allocator>
+                struct polynomial_dfs_operand<polynomial_dfs_view<FieldValueType, Allocator>> {
+                    static constexpr bool value = true;
+                    typedef polynomial_dfs_leaf<FieldValueType> type;
+
+                    static type make(const polynomial_dfs_view<FieldValueType, Allocator>& x) {
+                        return type(x.it.data(), x.size(), x.degree());
+                    }
+                };
+
+                template<typename FieldValueType, typename Allocator>
+                struct polynomial_dfs_result<polynomial_dfs_view<FieldValueType, Allocator>> {
+                    typedef polynomial_dfs<FieldValueType> type;
+                };
+            }    // namespace detail
         }    // namespace math
     }        // namespace crypto3
 }    // namespace nil
@@ -115,7 +115,7 @@ namespace nil {
                 }
 
                 allocator_type get_allocator() const BOOST_NOEXCEPT {
-                    return it.__alloc();
+                    return it.get_allocator();
                 }
 
                 iterator begin() BOOST_NOEXCEPT {
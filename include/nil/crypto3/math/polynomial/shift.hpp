@@ -28,6 +28,7 @@
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs_view.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -46,28 +47,47 @@ namespace nil {
                 return f_shifted;
             }
 
-            template<typename FieldValueType>
-            static inline polynomial_dfs<FieldValueType>
-                polynomial_shift(const polynomial_dfs<FieldValueType> &f,
-                                 const int shift,
-                                 std::size_t domain_size = 0) {
+            /**
+             * The values of f(omega^shift x) over the domain of f, omega the generator of the domain of the size
+             * domain_size (the size of f by default), as a view which reads f at the rotated index instead of
+             * copying it. The view is read by index, like f, and is an operand of the polynomial_dfs expressions,
+             * where it is rotated on the domain of the result. The view keeps the order of f: the expressions read
+             * a bit-reversed f through a copy in the natural order, and the view of a bit-reversed f is only an
+             * operand of them, not read by index. The view must not outlive f.
+             */
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs_leaf<FieldValueType>
+                polynomial_shift_view(const polynomial_dfs<FieldValueType, Allocator> &f, const int shift,
+                                      std::size_t domain_size = 0) {
                 if (domain_size == 0) {
                     domain_size = f.size();
                 }
 
-                const std::size_t extended_domain_size = f.size();
+                assert((f.size() % domain_size) == 0);
 
-                assert((extended_domain_size % domain_size) == 0);
+                return polynomial_dfs_leaf<FieldValueType>(f.data(), f.size(), f.degree(), shift, domain_size,
+                                                           f.order());
+            }
 
-                const std::size_t domain_scale = extended_domain_size/domain_size;
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs_leaf<FieldValueType>
+                polynomial_shift_view(const polynomial_dfs_view<FieldValueType, Allocator> &f, const int shift,
+                                      std::size_t domain_size = 0) {
+                if (domain_size == 0) {
+                    domain_size = f.size();
+                }
 
-                polynomial_dfs<FieldValueType> f_shifted(f.degree(), extended_domain_size);
+                assert((f.size() % domain_size) == 0);
 
-                for (std::size_t index = 0; index < extended_domain_size; index++){
-                    f_shifted[index] = f[(extended_domain_size + index + domain_scale * shift) % (extended_domain_size)];
-                }
+                return polynomial_dfs_leaf<FieldValueType>(f.it.data(), f.size(), f.degree(), shift, domain_size);
+            }
 
-                return f_shifted;
+            template<typename FieldValueType>
+            static inline polynomial_dfs<FieldValueType>
+                polynomial_shift(const polynomial_dfs<FieldValueType> &f,
+                                 const int shift,
+                                 std::size_t domain_size = 0) {
+                return polynomial_dfs<FieldValueType>(polynomial_shift_view(f, shift, domain_size));
             }
         }    // namespace math
     }        // namespace crypto3
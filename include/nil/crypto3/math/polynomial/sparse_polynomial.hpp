@@ -0,0 +1,521 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_POLYNOMIAL_SPARSE_POLYNOMIAL_HPP
+#define CRYPTO3_MATH_POLYNOMIAL_SPARSE_POLYNOMIAL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+#include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/thread_pool.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+            namespace detail {
+                /**
+                 * Whether a kernel over the terms of a sparse polynomial is expected to be cheaper than the dense
+                 * one on the size n: the sparse kernels take terms multiplications per coefficient or value, the
+                 * dense ones a few transforms of the size n, i.e. a few log2(n) multiplications per coefficient.
+                 */
+                inline bool sparse_kernel_preferred(std::size_t terms, std::size_t n) {
+                    const std::size_t logn =
+                        static_cast<std::size_t>(std::log2(power_of_two(std::max<std::size_t>(n, 1))));
+                    return terms <= 4 * (logn + 1);
+                }
+            }    // namespace detail
+
+            /**
+             * Polynomial given by its non-zero terms c_k x^{e_k}, sorted by increasing exponents: selectors, x^n - 1
+             * or (x^n - 1) / (x - omega^i) take a few terms whatever their degree. The zero polynomial has no terms.
+             *
+             * Products by and remainders modulo a sparse polynomial of t terms take O(t) operations per coefficient
+             * of the dense operand, and its values on a domain of the size n take O(t n), see the operators below,
+             * which fall back to the dense kernels when t is too large for that to pay off.
+             */
+            template<typename FieldValueType>
+            class sparse_polynomial {
+            public:
+                typedef FieldValueType value_type;
+                typedef std::pair<std::size_t, FieldValueType> term_type;
+                typedef std::vector<term_type> container_type;
+                typedef typename container_type::size_type size_type;
+                typedef typename container_type::const_iterator const_iterator;
+
+                sparse_polynomial() {
+                }
+
+                /**
+                 * The monomial value * x^power.
+                 */
+                sparse_polynomial(const FieldValueType& value, std::size_t power = 0) {
+                    if (!value.is_zero()) {
+                        val.emplace_back(power, value);
+                    }
+                }
+
+                /**
+                 * Terms (exponent, coefficient) in any order: the terms of the same exponent are summed up and the
+                 * zero ones dropped.
+                 */
+                template<typename InputIterator>
+                sparse_polynomial(InputIterator first, InputIterator last) : val(first, last) {
+                    normalize();
+                }
+
+                sparse_polynomial(std::initializer_list<term_type> il) : val(il) {
+                    normalize();
+                }
+
+                /**
+                 * The non-zero coefficients of a dense polynomial.
+                 */
+                template<typename Allocator>
+                explicit sparse_polynomial(const polynomial<FieldValueType, Allocator>& p) {
+                    for (std::size_t i = 0; i < p.size(); ++i) {
+                        if (!p[i].is_zero()) {
+                            val.emplace_back(i, p[i]);
+                        }
+                    }
+                }
+
+                bool operator==(const sparse_polynomial& rhs) const {
+                    return val == rhs.val;
+                }
+
+                bool operator!=(const sparse_polynomial& rhs) const {
+                    return !(rhs == *this);
+                }
+
+                const_iterator begin() const BOOST_NOEXCEPT {
+                    return val.begin();
+                }
+
+                const_iterator end() const BOOST_NOEXCEPT {
+                    return val.end();
+                }
+
+                /**
+                 * Number of the non-zero terms.
+                 */
+                size_type size() const BOOST_NOEXCEPT {
+                    return val.size();
+                }
+
+                size_type degree() const BOOST_NOEXCEPT {
+                    return val.empty() ? 0 : val.back().first;
+                }
+
+                bool is_zero() const BOOST_NOEXCEPT {
+                    return val.empty();
+                }
+
+                /**
+                 * Coefficient of x^power.
+                 */
+                FieldValueType operator[](std::size_t power) const {
+                    const_iterator it = std::lower_bound(
+                        val.begin(), val.end(), power,
+                        [](const term_type& term, std::size_t power) { return term.first < power; });
+                    return it != val.end() && it->first == power ? it->second : FieldValueType::zero();
+                }
+
+                /**
+                 * Value at x without Horner's rule: x^{e_k} follows from x^{e_{k - 1}} by an exponentiation by
+                 * squaring to the gap e_k - e_{k - 1}, i.e. O(t log(deg / t)) multiplications.
+                 */
+                FieldValueType evaluate(const FieldValueType& x) const {
+                    FieldValueType result = FieldValueType::zero(), power = FieldValueType::one();
+                    std::size_t exponent = 0;
+                    for (const term_type& term : val) {
+                        power *= x.pow(term.first - exponent);
+                        exponent = term.first;
+                        result += term.second * power;
+                    }
+                    return result;
+                }
+
+                /**
+                 * Values at the n-th roots of unity omega^i in the natural order. With few terms x^{e_k} at omega^i
+                 * is read from the table of the powers of omega at the index e_k i mod n, otherwise the coefficients
+                 * go through the FFT. Runs on the global thread pool when one is installed.
+                 */
+                std::vector<FieldValueType> evaluations(std::size_t n) const {
+                    typedef typename FieldValueType::field_type FieldType;
+
+                    if (n == 0 || n != detail::power_of_two(n)) {
+                        throw std::invalid_argument("sparse_polynomial: expected a domain of a power of two size");
+                    }
+                    const FieldValueType omega = unity_root<FieldType>(n);
+                    thread_pool* pool = thread_pool::global().get();
+
+                    std::vector<FieldValueType> result(n, FieldValueType::zero());
+                    if (!detail::sparse_kernel_preferred(val.size(), n)) {
+                        for (const term_type& term : val) {
+                            result[term.first & (n - 1)] += term.second;
+                        }
+                        detail::basic_radix2_fft<FieldType>(result, omega, pool);
+                        return result;
+                    }
+
+                    std::vector<FieldValueType> powers(n);
+                    powers[0] = FieldValueType::one();
+                    for (std::size_t i = 1; i < n; ++i) {
+                        powers[i] = powers[i - 1] * omega;
+                    }
+                    detail::parallel_for(
+                        pool, 0, n,
+                        [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                FieldValueType acc = FieldValueType::zero();
+                                for (const term_type& term : val) {
+                                    acc += term.second * powers[(term.first * i) & (n - 1)];
+                                }
+                                result[i] = acc;
+                            }
+                        },
+                        1ul << 10);
+                    return result;
+                }
+
+                /**
+                 * The dense coefficients.
+                 */
+                template<typename Allocator = std::allocator<FieldValueType>>
+                polynomial<FieldValueType, Allocator> to_polynomial() const {
+                    polynomial<FieldValueType, Allocator> result(degree() + 1, FieldValueType::zero());
+                    for (const term_type& term : val) {
+                        result[term.first] = term.second;
+                    }
+                    return result;
+                }
+
+                /**
+                 * The values on the domain of the size n, a power of two above the degree, see evaluations.
+                 */
+                template<typename Allocator = std::allocator<FieldValueType>>
+                polynomial_dfs<FieldValueType, Allocator> to_polynomial_dfs(std::size_t n) const {
+                    if (n <= degree()) {
+                        throw std::invalid_argument("sparse_polynomial: domain too small for the degree");
+                    }
+                    const std::vector<FieldValueType> values = evaluations(n);
+                    return polynomial_dfs<FieldValueType, Allocator>(degree(), values.begin(), values.end());
+                }
+
+                sparse_polynomial operator+(const sparse_polynomial& other) const {
+                    sparse_polynomial result;
+                    result.val.reserve(val.size() + other.val.size());
+                    std::merge(val.begin(), val.end(), other.val.begin(), other.val.end(),
+                               std::back_inserter(result.val),
+                               [](const term_type& a, const term_type& b) { return a.first < b.first; });
+                    result.normalize();
+                    return result;
+                }
+
+                sparse_polynomial operator-() const {
+                    sparse_polynomial result(*this);
+                    for (term_type& term : result.val) {
+                        term.second = -term.second;
+                    }
+                    return result;
+                }
+
+                sparse_polynomial operator-(const sparse_polynomial& other) const {
+                    return *this + (-other);
+                }
+
+                /**
+                 * Product of the t and u terms in O(t u log(t u)).
+                 */
+                sparse_polynomial operator*(const sparse_polynomial& other) const {
+                    sparse_polynomial result;
+                    result.val.reserve(val.size() * other.val.size());
+                    for (const term_type& a : val) {
+                        for (const term_type& b : other.val) {
+                            result.val.emplace_back(a.first + b.first, a.second * b.second);
+                        }
+                    }
+                    result.normalize();
+                    return result;
+                }
+
+                sparse_polynomial operator*(const FieldValueType& c) const {
+                    if (c.is_zero()) {
+                        return sparse_polynomial();
+                    }
+                    sparse_polynomial result(*this);
+                    for (term_type& term : result.val) {
+                        term.second *= c;
+                    }
+                    return result;
+                }
+
+            private:
+                /* sort the terms by exponent, sum up the terms of the same exponent and drop the zero ones */
+                void normalize() {
+                    std::stable_sort(val.begin(), val.end(),
+                                     [](const term_type& a, const term_type& b) { return a.first < b.first; });
+                    std::size_t k = 0;
+                    for (std::size_t i = 0; i < val.size();) {
+                        term_type term = val[i];
+                        for (++i; i < val.size() && val[i].first == term.first; ++i) {
+                            term.second += val[i].second;
+                        }
+                        if (!term.second.is_zero()) {
+                            val[k++] = term;
+                        }
+                    }
+                    val.resize(k);
+                }
+
+                container_type val;
+            };
+
+            /**
+             * Product of the dense polynomial A by the sparse polynomial B of t terms in O(t deg(A)), computed
+             * coefficient by coefficient of C on the global thread pool when one is installed. C must not be A.
+             */
+            template<typename Range, typename FieldValueType>
+            void sparse_multiplication(Range& c, const Range& a, const sparse_polynomial<FieldValueType>& b) {
+                if (b.is_zero() || a.size() == 0) {
+                    c = Range(1, FieldValueType::zero(), a.get_allocator());
+                    return;
+                }
+
+                c = Range(a.size() + b.degree(), FieldValueType::zero(), a.get_allocator());
+                detail::parallel_for(
+                    thread_pool::global().get(), 0, c.size(),
+                    [&](std::size_t begin, std::size_t end) {
+                        for (const auto& term : b) {
+                            /* c_j += b_e a_{j - e} for the j of the chunk such that 0 <= j - e < a.size() */
+                            const std::size_t first = std::max(begin, term.first),
+                                              last = std::min(end, term.first + a.size());
+                            for (std::size_t j = first; j < last; ++j) {
+                                c[j] += term.second * a[j - term.first];
+                            }
+                        }
+                    },
+                    1ul << 10);
+                condense(c);
+            }
+
+            /**
+             * Division of the dense polynomial A by the sparse polynomial B of t terms in O(t (deg(A) - deg(B))):
+             * the long division, with each step subtracting the t terms of B only.
+             * Output: Polynomial Q, Polynomial R, such that A = (Q * B) + R.
+             */
+            template<typename Range, typename FieldValueType>
+            void sparse_division(Range& q, Range& r, const Range& a, const sparse_polynomial<FieldValueType>& b) {
+                if (b.is_zero()) {
+                    throw std::invalid_argument("sparse_division: division by the zero polynomial");
+                }
+
+                const std::size_t d = b.degree();
+                r = Range(a);
+                if (r.size() <= d) {
+                    q = Range(1, FieldValueType::zero(), a.get_allocator());
+                    condense(r);
+                    return;
+                }
+
+                const FieldValueType c = b[d].inversed(); /* Inverse of Leading Coefficient of B */
+                q = Range(r.size() - d, FieldValueType::zero(), a.get_allocator());
+                for (std::size_t k = r.size(); k-- > d;) {
+                    if (r[k].is_zero()) {
+                        continue;
+                    }
+                    const FieldValueType lead_coeff = r[k] * c;
+                    q[k - d] = lead_coeff;
+                    for (const auto& term : b) {
+                        r[k - d + term.first] -= lead_coeff * term.second;
+                    }
+                }
+                r.resize(std::max<std::size_t>(d, 1));
+                condense(r);
+                condense(q);
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator*(const polynomial<FieldValueType, Allocator>& a,
+                                                            const sparse_polynomial<FieldValueType>& b) {
+                if (!detail::sparse_kernel_preferred(b.size(), a.size() + b.degree())) {
+                    return a * b.template to_polynomial<Allocator>();
+                }
+                polynomial<FieldValueType, Allocator> result(a.get_allocator());
+                sparse_multiplication(result, a, b);
+                return result;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator*(const sparse_polynomial<FieldValueType>& a,
+                                                            const polynomial<FieldValueType, Allocator>& b) {
+                return b * a;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator/(const polynomial<FieldValueType, Allocator>& a,
+                                                            const sparse_polynomial<FieldValueType>& b) {
+                if (!detail::sparse_kernel_preferred(b.size(), a.size())) {
+                    return a / b.template to_polynomial<Allocator>();
+                }
+                polynomial<FieldValueType, Allocator> q(a.get_allocator()), r(a.get_allocator());
+                sparse_division(q, r, a, b);
+                return q;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator%(const polynomial<FieldValueType, Allocator>& a,
+                                                            const sparse_polynomial<FieldValueType>& b) {
+                if (!detail::sparse_kernel_preferred(b.size(), a.size())) {
+                    return a % b.template to_polynomial<Allocator>();
+                }
+                polynomial<FieldValueType, Allocator> q(a.get_allocator()), r(a.get_allocator());
+                sparse_division(q, r, a, b);
+                return r;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator+(const polynomial<FieldValueType, Allocator>& a,
+                                                            const sparse_polynomial<FieldValueType>& b) {
+                polynomial<FieldValueType, Allocator> result(a);
+                if (result.size() <= b.degree()) {
+                    result.resize(b.degree() + 1, FieldValueType::zero());
+                }
+                for (const auto& term : b) {
+                    result[term.first] += term.second;
+                }
+                condense(result);
+                return result;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator+(const sparse_polynomial<FieldValueType>& a,
+                                                            const polynomial<FieldValueType, Allocator>& b) {
+                return b + a;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator-(const polynomial<FieldValueType, Allocator>& a,
+                                                            const sparse_polynomial<FieldValueType>& b) {
+                return a + (-b);
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial<FieldValueType, Allocator> operator-(const sparse_polynomial<FieldValueType>& a,
+                                                            const polynomial<FieldValueType, Allocator>& b) {
+                return -b + a;
+            }
+
+            namespace detail {
+                /**
+                 * Combine the values of A point by point with those of the sparse polynomial B, on the domain of
+                 * the size of A or of the smallest one above degree, to which A is then extended. The values of B
+                 * come from sparse_polynomial::evaluations, the result is in the natural order.
+                 */
+                template<typename FieldValueType, typename Allocator, typename Operation>
+                polynomial_dfs<FieldValueType, Allocator>
+                    sparse_pointwise(const polynomial_dfs<FieldValueType, Allocator>& a,
+                                     const sparse_polynomial<FieldValueType>& b, std::size_t degree,
+                                     Operation operation) {
+                    const std::size_t n = power_of_two(std::max(a.size(), degree + 1));
+                    polynomial_dfs<FieldValueType, Allocator> extended;
+                    const polynomial_dfs<FieldValueType, Allocator>* source = &a;
+                    if (n != a.size()) {
+                        extended = a;
+                        extended.resize(n);
+                        source = &extended;
+                    }
+
+                    const std::vector<FieldValueType> values = b.evaluations(n);
+                    const FieldValueType* x = source->data();
+                    const bool reversed = source->order() == evaluation_order::bit_reversed;
+                    const std::size_t logn = static_cast<std::size_t>(std::log2(n));
+
+                    polynomial_dfs<FieldValueType, Allocator> result(degree, n, a.get_allocator());
+                    polynomial_dfs<FieldValueType, Allocator>::pointwise(
+                        result.data(), n, [&](std::size_t i) {
+                            return operation(x[reversed ? bitreverse(i, logn) : i], values[i]);
+                        });
+                    return result;
+                }
+            }    // namespace detail
+
+            /**
+             * Product of the values of A by those of the sparse polynomial B, of the size of the product of the
+             * polynomials: B takes O(t) operations per value, or the FFT of its coefficients when it has too many
+             * terms for that, see sparse_polynomial::evaluations.
+             */
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType, Allocator> operator*(const polynomial_dfs<FieldValueType, Allocator>& a,
+                                                                const sparse_polynomial<FieldValueType>& b) {
+                return detail::sparse_pointwise(a, b, a.degree() + b.degree(),
+                                                [](const FieldValueType& x, const FieldValueType& y) { return x * y; });
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType, Allocator> operator*(const sparse_polynomial<FieldValueType>& a,
+                                                                const polynomial_dfs<FieldValueType, Allocator>& b) {
+                return b * a;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType, Allocator> operator+(const polynomial_dfs<FieldValueType, Allocator>& a,
+                                                                const sparse_polynomial<FieldValueType>& b) {
+                return detail::sparse_pointwise(a, b, std::max<std::size_t>(a.degree(), b.degree()),
+                                                [](const FieldValueType& x, const FieldValueType& y) { return x + y; });
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType, Allocator> operator+(const sparse_polynomial<FieldValueType>& a,
+                                                                const polynomial_dfs<FieldValueType, Allocator>& b) {
+                return b + a;
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType, Allocator> operator-(const polynomial_dfs<FieldValueType, Allocator>& a,
+                                                                const sparse_polynomial<FieldValueType>& b) {
+                return detail::sparse_pointwise(a, b, std::max<std::size_t>(a.degree(), b.degree()),
+                                                [](const FieldValueType& x, const FieldValueType& y) { return x - y; });
+            }
+
+            template<typename FieldValueType, typename Allocator>
+            polynomial_dfs<FieldValueType, Allocator> operator-(const sparse_polynomial<FieldValueType>& a,
+                                                                const polynomial_dfs<FieldValueType, Allocator>& b) {
+                return detail::sparse_pointwise(b, a, std::max<std::size_t>(a.degree(), b.degree()),
+                                                [](const FieldValueType& x, const FieldValueType& y) { return y - x; });
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_POLYNOMIAL_SPARSE_POLYNOMIAL_HPP
@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_POLYNOMIAL_VANISHING_POLYNOMIAL_HPP
+#define CRYPTO3_MATH_POLYNOMIAL_VANISHING_POLYNOMIAL_HPP
+
+#include <memory>
+#include <stdexcept>
+
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * The vanishing polynomial of domain as a polynomial_dfs of the degree domain->m on the coset
+             * coset * D, D the subgroup of the power of two size n > domain->m, as the quotient of a constraint
+             * polynomial by it needs. The values come from compute_vanishing_polynomial_on_coset of domain.
+             */
+            template<typename FieldType>
+            polynomial_dfs<typename FieldType::value_type>
+                vanishing_polynomial_dfs(const std::shared_ptr<evaluation_domain<FieldType>> &domain,
+                                         const typename FieldType::value_type &coset, std::size_t n) {
+                if (n <= domain->m) {
+                    throw std::invalid_argument("vanishing_polynomial_dfs: expected n > domain->m");
+                }
+                return polynomial_dfs<typename FieldType::value_type>(
+                    domain->m, domain->compute_vanishing_polynomial_on_coset(coset, n));
+            }
+
+            /**
+             * The i-th Lagrange polynomial of domain as a polynomial_dfs of the degree domain->m - 1 on the coset
+             * coset * D, D the subgroup of the power of two size n >= domain->m, e.g. L_0 of a permutation
+             * argument. The values come from evaluate_lagrange_polynomial_on_coset of domain.
+             */
+            template<typename FieldType>
+            polynomial_dfs<typename FieldType::value_type>
+                lagrange_polynomial_dfs(const std::shared_ptr<evaluation_domain<FieldType>> &domain, std::size_t i,
+                                        const typename FieldType::value_type &coset, std::size_t n) {
+                if (n < domain->m) {
+                    throw std::invalid_argument("lagrange_polynomial_dfs: expected n >= domain->m");
+                }
+                return polynomial_dfs<typename FieldType::value_type>(
+                    domain->m - 1, domain->evaluate_lagrange_polynomial_on_coset(i, coset, n));
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_POLYNOMIAL_VANISHING_POLYNOMIAL_HPP
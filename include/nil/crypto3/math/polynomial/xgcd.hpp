@@ -27,6 +27,7 @@
 #define CRYPTO3_MATH_XGCD_HPP
 
 #include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 #include <boost/math/tools/polynomial_gcd.hpp>
@@ -38,10 +39,184 @@ namespace nil {
     namespace crypto3 {
         namespace math {
 
+            namespace detail {
+                /**
+                 * Degree of the polynomials from which half_gcd recurses instead of running the Euclidean steps
+                 * one by one.
+                 */
+                constexpr std::size_t half_gcd_threshold = 128;
+
+                /**
+                 * Degree of polynomial A, -1 for the zero polynomial.
+                 */
+                template<typename FieldValueType>
+                std::ptrdiff_t euclidean_degree(const std::vector<FieldValueType> &a) {
+                    std::ptrdiff_t d = static_cast<std::ptrdiff_t>(a.size()) - 1;
+                    while (d >= 0 && a[d] == FieldValueType::zero()) {
+                        --d;
+                    }
+                    return d;
+                }
+
+                /**
+                 * Quotient of polynomial A by x^k.
+                 */
+                template<typename FieldValueType>
+                std::vector<FieldValueType> euclidean_shift(const std::vector<FieldValueType> &a, std::size_t k) {
+                    if (a.size() <= k) {
+                        return std::vector<FieldValueType>(1, FieldValueType::zero());
+                    }
+                    return std::vector<FieldValueType>(a.begin() + k, a.end());
+                }
+
+                /**
+                 * 2x2 matrix of polynomials taking a pair of consecutive remainders of the Euclidean algorithm
+                 * to a later pair: (r_{i + k}, r_{i + k + 1}) = M * (r_i, r_{i + 1}).
+                 */
+                template<typename FieldValueType>
+                struct euclidean_matrix {
+                    typedef std::vector<FieldValueType> polynomial_type;
+
+                    polynomial_type m00, m01, m10, m11;
+
+                    euclidean_matrix() :
+                        m00(1, FieldValueType::one()), m01(1, FieldValueType::zero()),
+                        m10(1, FieldValueType::zero()), m11(1, FieldValueType::one()) {
+                    }
+
+                    /**
+                     * (a, b) = M * (a, b).
+                     */
+                    void apply(polynomial_type &a, polynomial_type &b) const {
+                        polynomial_type x, y, s, t;
+                        multiplication(s, m00, a);
+                        multiplication(t, m01, b);
+                        addition(x, s, t);
+                        multiplication(s, m10, a);
+                        multiplication(t, m11, b);
+                        addition(y, s, t);
+                        a.swap(x);
+                        b.swap(y);
+                    }
+
+                    /**
+                     * M = other * M.
+                     */
+                    void multiply_on_left(const euclidean_matrix &other) {
+                        polynomial_type c00(m00), c10(m10), c01(m01), c11(m11);
+                        other.apply(c00, c10);
+                        other.apply(c01, c11);
+                        m00.swap(c00);
+                        m01.swap(c01);
+                        m10.swap(c10);
+                        m11.swap(c11);
+                    }
+
+                    /**
+                     * One step of the Euclidean algorithm, (a, b) = (b, a mod b), and M = [[0, 1], [1, -q]] * M.
+                     */
+                    void step(polynomial_type &a, polynomial_type &b) {
+                        polynomial_type q, r, t;
+                        division(q, r, a, b);
+                        a.swap(b);
+                        b.swap(r);
+
+                        multiplication(t, q, m10);
+                        subtraction(r, m00, t);
+                        m00.swap(m10);
+                        m10.swap(r);
+                        multiplication(t, q, m11);
+                        subtraction(r, m01, t);
+                        m01.swap(m11);
+                        m11.swap(r);
+                    }
+                };
+
+                /**
+                 * The half-GCD of A and B, deg(A) > deg(B): the matrix M of the Euclidean steps after which
+                 * (A', B') = M * (A, B) satisfies deg(A') >= m > deg(B'), m = ceil(deg(A) / 2). The quotients of
+                 * the first steps only depend on the top coefficients, so M is found from A and B divided by x^m
+                 * and then from the next remainders, divided again, in O(M(n) log n).
+                 * Below we make use of the algorithm HGCD from
+                 * [Yap 2000. Fundamental Problems of Algorithmic Algebra], lecture II, section 8.
+                 */
+                template<typename FieldValueType>
+                euclidean_matrix<FieldValueType> half_gcd(const std::vector<FieldValueType> &a,
+                                                          const std::vector<FieldValueType> &b) {
+                    const std::ptrdiff_t n = euclidean_degree(a);
+                    const std::ptrdiff_t m = (n + 1) / 2;
+
+                    euclidean_matrix<FieldValueType> R;
+                    if (euclidean_degree(b) < m) {
+                        return R;
+                    }
+
+                    std::vector<FieldValueType> c(a), d(b);
+                    if (static_cast<std::size_t>(n) < half_gcd_threshold) {
+                        while (euclidean_degree(d) >= m) {
+                            R.step(c, d);
+                        }
+                        return R;
+                    }
+
+                    R = half_gcd(euclidean_shift(a, m), euclidean_shift(b, m));
+                    R.apply(c, d);
+                    if (euclidean_degree(d) < m) {
+                        return R;
+                    }
+                    R.step(c, d);
+                    if (euclidean_degree(d) < m) {
+                        return R;
+                    }
+
+                    const std::ptrdiff_t k = 2 * m - euclidean_degree(c);
+                    BOOST_ASSERT(k >= 0);
+                    R.multiply_on_left(half_gcd(euclidean_shift(c, k), euclidean_shift(d, k)));
+                    return R;
+                }
+
+                /**
+                 * Run the Euclidean algorithm on A and B with half_gcd jumps: A becomes the last nonzero remainder
+                 * G, and U the cofactor of A in it, G = U * A + V * B, with deg(U) < deg(B) - deg(G). The cofactor
+                 * of B is not computed.
+                 */
+                template<typename FieldValueType>
+                void euclidean_cofactor(std::vector<FieldValueType> &a, std::vector<FieldValueType> b,
+                                        std::vector<FieldValueType> &u) {
+                    /* a = u * A + ... and b = w * A + ... */
+                    u.assign(1, FieldValueType::one());
+                    std::vector<FieldValueType> w(1, FieldValueType::zero()), q, r, t;
+
+                    while (euclidean_degree(b) >= 0) {
+                        division(q, r, a, b);
+                        a.swap(b);
+                        b.swap(r);
+                        multiplication(t, q, w);
+                        subtraction(r, u, t);
+                        u.swap(w);
+                        w.swap(r);
+
+                        if (euclidean_degree(b) < 0) {
+                            break;
+                        }
+                        if (static_cast<std::size_t>(euclidean_degree(a)) >= half_gcd_threshold) {
+                            const euclidean_matrix<FieldValueType> M = half_gcd(a, b);
+                            M.apply(a, b);
+                            M.apply(u, w);
+                        }
+                    }
+                    condense(a);
+                    condense(u);
+                }
+            }    // namespace detail
+
             /*!
              * @brief Perform the standard Extended Euclidean Division algorithm.
              * Input: Polynomial A, Polynomial B.
              * Output: Polynomial G, Polynomial U, Polynomial V, such that G = (A * U) + (B * V).
+             * G is monic, deg(U) < deg(B) - deg(G) and deg(V) < deg(A) - deg(G). The remainders are computed
+             * with detail::half_gcd, which takes O(M(n) log n) instead of the O(n^2) of the step by step
+             * algorithm, and V follows from an exact division, V = (G - A * U) / B.
              */
             template<typename Range1, typename Range2, typename Range3, typename Range4,
                      typename Range5>
@@ -57,29 +232,15 @@ namespace nil {
                     return;
                 }
 
-                std::vector<value_type> U(1, value_type::one());
-                std::vector<value_type> V1(1, value_type::zero());
-                std::vector<value_type> G(a);
-                std::vector<value_type> V3(b);
-
-                std::vector<value_type> Q(1, value_type::zero());
-                std::vector<value_type> R(1, value_type::zero());
-                std::vector<value_type> T(1, value_type::zero());
+                std::vector<value_type> G(std::begin(a), std::end(a));
+                const std::vector<value_type> B(std::begin(b), std::end(b));
+                std::vector<value_type> U, V1, V3, R;
 
-                while (!is_zero(V3)) {
-                    division(Q, R, G, V3);
-                    multiplication(G, V1, Q);
-                    subtraction(T, U, G);
-
-                    U = V1;
-                    G = V3;
-                    V1 = T;
-                    V3 = R;
-                }
+                detail::euclidean_cofactor(G, B, U);
 
-                multiplication(V3, a, U);
+                multiplication(V3, std::vector<value_type>(std::begin(a), std::end(a)), U);
                 subtraction(V3, G, V3);
-                division(V1, R, V3, b);
+                division(V1, R, V3, B);
 
                 value_type lead_coeff = G.back().inversed();
                 std::transform(G.begin(), G.end(), G.begin(),
@@ -93,6 +254,29 @@ namespace nil {
                 u = U;
                 v = V1;
             }
+
+            /**
+             * Compute the inverse R of polynomial A modulo polynomial M, A * R = 1 mod M, with deg(R) < deg(M),
+             * from the cofactor of A in the Extended Euclidean algorithm alone.
+             * Throws std::invalid_argument if A and M are not coprime.
+             */
+            template<typename Range>
+            void inverse_modulo(Range &r, const Range &a, const Range &m) {
+
+                typedef
+                    typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                std::vector<value_type> G(std::begin(a), std::end(a)), U;
+                detail::euclidean_cofactor(G, std::vector<value_type>(std::begin(m), std::end(m)), U);
+                if (G.size() != 1 || G[0] == value_type::zero()) {
+                    throw std::invalid_argument("expected a and m coprime");
+                }
+
+                const value_type g_inverse = G[0].inversed();
+                r.resize(U.size());
+                std::transform(U.begin(), U.end(), r.begin(),
+                               std::bind(std::multiplies<value_type>(), g_inverse, std::placeholders::_1));
+            }
         }    // namespace math
     }        // namespace crypto3
 }    // namespace nil
@@ -0,0 +1,475 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_SERIALIZATION_HPP
+#define CRYPTO3_MATH_SERIALIZATION_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CRYPTO3_MATH_SERIALIZATION_MMAP
+#endif
+
+#include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs_view.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_view.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /*
+             * The binary layout, version 1, is a sequence of records. Each record is a header followed by the raw
+             * field elements as they are held in memory, i.e. the limbs in the Montgomery form for the fields in
+             * Montgomery representation, starting and ending on a multiple of serialization_alignment bytes from
+             * the beginning of the file, so that a mapped file can be used in place.
+             *
+             * The field is identified by the size of its elements and a hash of the representation of -1, which
+             * changes with the modulus as well as with the representation.
+             */
+            namespace detail {
+                constexpr std::uint32_t serialization_version = 1;
+                constexpr std::size_t serialization_alignment = 64;
+
+                enum class serialization_kind : std::uint32_t {
+                    polynomial = 1,
+                    polynomial_dfs = 2,
+                    radix2_twiddles = 3
+                };
+
+                struct serialization_header {
+                    char magic[8];
+                    std::uint32_t version;
+                    std::uint32_t kind;
+                    std::uint64_t field;
+                    std::uint64_t element_size;
+                    std::uint64_t degree;
+                    std::uint64_t size;
+                };
+
+                inline const char *serialization_magic() {
+                    return "CR3MATH";
+                }
+
+                template<typename FieldValueType>
+                std::uint64_t serialization_field_identifier() {
+                    const FieldValueType minus_one = -FieldValueType::one();
+                    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&minus_one);
+
+                    /* FNV-1a */
+                    std::uint64_t hash = 0xcbf29ce484222325ull;
+                    for (std::size_t i = 0; i < sizeof(FieldValueType); ++i) {
+                        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+                    }
+                    return hash;
+                }
+
+                inline std::size_t serialization_padding(std::size_t bytes) {
+                    return (serialization_alignment - bytes % serialization_alignment) % serialization_alignment;
+                }
+
+                inline void serialization_write_padding(std::ostream &os, std::size_t bytes) {
+                    static const char zeros[serialization_alignment] = {};
+                    os.write(zeros, serialization_padding(bytes));
+                }
+
+                template<typename FieldValueType>
+                void serialize_record(std::ostream &os, serialization_kind kind, std::size_t degree,
+                                      std::initializer_list<std::pair<const FieldValueType *, std::size_t>> parts) {
+                    static_assert(std::is_trivially_destructible<FieldValueType>::value,
+                                  "field elements are written as they are held in memory");
+
+                    serialization_header header;
+                    std::memset(&header, 0, sizeof(header));
+                    std::memcpy(header.magic, serialization_magic(), sizeof(header.magic));
+                    header.version = serialization_version;
+                    header.kind = static_cast<std::uint32_t>(kind);
+                    header.field = serialization_field_identifier<FieldValueType>();
+                    header.element_size = sizeof(FieldValueType);
+                    header.degree = degree;
+                    header.size = 0;
+                    for (const auto &part : parts) {
+                        header.size += part.second;
+                    }
+
+                    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                    serialization_write_padding(os, sizeof(header));
+                    for (const auto &part : parts) {
+                        os.write(reinterpret_cast<const char *>(part.first), part.second * sizeof(FieldValueType));
+                    }
+                    serialization_write_padding(os, header.size * sizeof(FieldValueType));
+                    if (!os) {
+                        throw std::runtime_error("serialize: failed to write the record");
+                    }
+                }
+            }    // namespace detail
+
+            /**
+             * Write the polynomial as a record of the binary layout, see mapped_archive.
+             */
+            template<typename FieldValueType, typename Allocator>
+            void serialize(std::ostream &os, const polynomial<FieldValueType, Allocator> &p) {
+                detail::serialize_record<FieldValueType>(os, detail::serialization_kind::polynomial, p.degree(),
+                                                         {{p.data(), p.size()}});
+            }
+
+            /**
+             * Write the polynomial in the point-value form as a record of the binary layout, see mapped_archive.
+             * The values should be in the natural order.
+             */
+            template<typename FieldValueType, typename Allocator>
+            void serialize(std::ostream &os, const polynomial_dfs<FieldValueType, Allocator> &p) {
+                if (p.order() != evaluation_order::natural) {
+                    throw std::invalid_argument("serialize: expected the values in the natural order");
+                }
+                detail::serialize_record<FieldValueType>(os, detail::serialization_kind::polynomial_dfs, p.degree(),
+                                                         {{p.data(), p.size()}});
+            }
+
+            /**
+             * Write the twiddles of the domain, precomputing them if needed, as a record of the binary layout, so
+             * that mapped_archive::precompute installs them in a domain of the same size instead of computing them.
+             */
+            template<typename FieldType>
+            void serialize(std::ostream &os, basic_radix2_domain<FieldType> &domain) {
+                typedef typename FieldType::value_type value_type;
+
+                domain.precompute();
+                detail::serialize_record<value_type>(
+                    os, detail::serialization_kind::radix2_twiddles, domain.m,
+                    {{domain.fft_cache.data(), domain.fft_cache.size()},
+                     {domain.inverse_fft_cache.data(), domain.inverse_fft_cache.size()}});
+            }
+
+            /**
+             * An allocator handing out a given region, e.g. of a mapped file, for the one allocation of its size,
+             * without initializing the elements constructed there, and std::allocator for any other one. A vector
+             * built with it over the region sees the contents of the region, and moves out to the heap once it
+             * grows. Copies of containers get a heap allocator.
+             */
+            template<typename T>
+            class mapped_allocator {
+            public:
+                typedef T value_type;
+                typedef std::true_type propagate_on_container_move_assignment;
+                typedef std::true_type propagate_on_container_swap;
+
+                mapped_allocator() noexcept : region(nullptr), count(0) {
+                }
+
+                mapped_allocator(T *region, std::size_t count) noexcept : region(region), count(count) {
+                }
+
+                template<typename U>
+                mapped_allocator(const mapped_allocator<U> &) noexcept : region(nullptr), count(0) {
+                }
+
+                T *allocate(std::size_t n) {
+                    if (region != nullptr && n == count) {
+                        return region;
+                    }
+                    return std::allocator<T>().allocate(n);
+                }
+
+                void deallocate(T *p, std::size_t n) noexcept {
+                    if (p != region) {
+                        std::allocator<T>().deallocate(p, n);
+                    }
+                }
+
+                /* the elements of the region are there already */
+                template<typename U>
+                void construct(U *p) {
+                    if (!in_region(p)) {
+                        ::new (static_cast<void *>(p)) U();
+                    }
+                }
+
+                template<typename U, typename... Args>
+                void construct(U *p, Args &&...args) {
+                    ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+                }
+
+                mapped_allocator select_on_container_copy_construction() const {
+                    return mapped_allocator();
+                }
+
+                bool operator==(const mapped_allocator &other) const noexcept {
+                    return region == other.region;
+                }
+
+                bool operator!=(const mapped_allocator &other) const noexcept {
+                    return region != other.region;
+                }
+
+            private:
+                template<typename U>
+                bool in_region(const U *p) const {
+                    const void *q = p;
+                    return region != nullptr && q >= static_cast<const void *>(region) &&
+                           q < static_cast<const void *>(region + count);
+                }
+
+                T *region;
+                std::size_t count;
+            };
+
+            /**
+             * Polynomial coefficients or values held in a mapped_archive, with the views the polynomial algorithms
+             * work on. The elements are those of the mapping of the file, see mapped_archive.
+             */
+            template<typename FieldValueType>
+            class mapped_column {
+            public:
+                typedef std::vector<FieldValueType, mapped_allocator<FieldValueType>> container_type;
+
+                mapped_column(std::shared_ptr<const void> mapping, FieldValueType *data, std::size_t size,
+                              std::size_t degree) :
+                    mapping(std::move(mapping)),
+                    values(size, mapped_allocator<FieldValueType>(data, size)), d(degree) {
+                }
+
+                mapped_column(const mapped_column &) = delete;
+                mapped_column &operator=(const mapped_column &) = delete;
+
+                std::size_t degree() const {
+                    return d;
+                }
+
+                container_type &container() {
+                    return values;
+                }
+
+                /**
+                 * The values as a polynomial in the point-value form, for a polynomial_dfs record.
+                 */
+                polynomial_dfs_view<FieldValueType, mapped_allocator<FieldValueType>> dfs_view() {
+                    return polynomial_dfs_view<FieldValueType, mapped_allocator<FieldValueType>>(d, values);
+                }
+
+                /**
+                 * The coefficients as a polynomial, for a polynomial record.
+                 */
+                polynomial_view<FieldValueType, mapped_allocator<FieldValueType>> view() {
+                    return polynomial_view<FieldValueType, mapped_allocator<FieldValueType>>(values);
+                }
+
+            private:
+                std::shared_ptr<const void> mapping;
+                container_type values;
+                std::size_t d;
+            };
+
+            /**
+             * A file of records written by serialize, mapped in memory. Polynomials are read in place, without
+             * copying, and the views of them stay valid while the mapped_column they come from lives, which keeps
+             * the mapping alive on its own.
+             *
+             * The file is mapped copy-on-write, so that the views may be written to without changing the file:
+             * the writes are seen by the columns of the same archive only. On the platforms without mmap the file is
+             * read into memory instead.
+             */
+            class mapped_archive {
+            public:
+                explicit mapped_archive(const std::string &path) {
+                    std::size_t size = 0;
+#ifdef CRYPTO3_MATH_SERIALIZATION_MMAP
+                    const int fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd < 0) {
+                        throw std::runtime_error("mapped_archive: cannot open " + path);
+                    }
+                    struct stat st;
+                    if (::fstat(fd, &st) != 0) {
+                        ::close(fd);
+                        throw std::runtime_error("mapped_archive: cannot stat " + path);
+                    }
+                    size = static_cast<std::size_t>(st.st_size);
+                    if (size != 0) {
+                        void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                        ::close(fd);
+                        if (data == MAP_FAILED) {
+                            throw std::runtime_error("mapped_archive: cannot map " + path);
+                        }
+                        mapping = std::shared_ptr<void>(data, [size](void *p) { ::munmap(p, size); });
+                    } else {
+                        ::close(fd);
+                    }
+#else
+                    std::ifstream is(path, std::ios::binary | std::ios::ate);
+                    if (!is) {
+                        throw std::runtime_error("mapped_archive: cannot open " + path);
+                    }
+                    size = static_cast<std::size_t>(is.tellg());
+                    is.seekg(0);
+                    /* allocated by new, so aligned for the field elements */
+                    std::shared_ptr<std::vector<std::max_align_t>> buffer =
+                        std::make_shared<std::vector<std::max_align_t>>((size + sizeof(std::max_align_t) - 1) /
+                                                                        sizeof(std::max_align_t));
+                    is.read(reinterpret_cast<char *>(buffer->data()), size);
+                    mapping = std::shared_ptr<void>(buffer, buffer->data());
+#endif
+                    index(size);
+                }
+
+                /**
+                 * Number of the records of the file.
+                 */
+                std::size_t size() const {
+                    return records.size();
+                }
+
+                /**
+                 * The coefficients of the polynomial of record i.
+                 */
+                template<typename FieldValueType>
+                std::unique_ptr<mapped_column<FieldValueType>> polynomial(std::size_t i) const {
+                    return column<FieldValueType>(i, detail::serialization_kind::polynomial);
+                }
+
+                /**
+                 * The values of the polynomial in the point-value form of record i.
+                 */
+                template<typename FieldValueType>
+                std::unique_ptr<mapped_column<FieldValueType>> polynomial_dfs(std::size_t i) const {
+                    return column<FieldValueType>(i, detail::serialization_kind::polynomial_dfs);
+                }
+
+                /**
+                 * Precompute the domain with the twiddles of record i, which should have been written for a domain
+                 * of the same size. The twiddles are copied into the domain. Does nothing if the domain is
+                 * precomputed already.
+                 */
+                template<typename FieldType>
+                void precompute(std::size_t i, basic_radix2_domain<FieldType> &domain) const {
+                    typedef typename FieldType::value_type value_type;
+
+                    const detail::serialization_header &header =
+                        record<value_type>(i, detail::serialization_kind::radix2_twiddles);
+                    if (header.degree != domain.m) {
+                        throw std::invalid_argument("mapped_archive: twiddles of a domain of another size");
+                    }
+                    const value_type *data = payload<value_type>(i);
+                    const std::size_t half = static_cast<std::size_t>(header.size / 2);
+                    domain.precompute(std::vector<value_type>(data, data + half),
+                                      std::vector<value_type>(data + half, data + 2 * half));
+                }
+
+                /**
+                 * Offset in bytes of the elements of record i from the beginning of the file, e.g. for a file_store
+                 * of out_of_core_fft.
+                 */
+                std::size_t payload_offset(std::size_t i) const {
+                    if (i >= records.size()) {
+                        throw std::out_of_range("mapped_archive: no such record");
+                    }
+                    return records[i] + sizeof(detail::serialization_header) +
+                           detail::serialization_padding(sizeof(detail::serialization_header));
+                }
+
+            private:
+                void index(std::size_t size) {
+                    const char *base = static_cast<const char *>(mapping.get());
+                    std::size_t offset = 0;
+                    while (offset < size) {
+                        if (size - offset < sizeof(detail::serialization_header)) {
+                            throw std::invalid_argument("mapped_archive: truncated header");
+                        }
+                        const detail::serialization_header *header =
+                            reinterpret_cast<const detail::serialization_header *>(base + offset);
+                        if (std::memcmp(header->magic, detail::serialization_magic(), sizeof(header->magic)) != 0) {
+                            throw std::invalid_argument("mapped_archive: not a record");
+                        }
+                        if (header->version != detail::serialization_version) {
+                            throw std::invalid_argument("mapped_archive: unsupported version");
+                        }
+
+                        const std::size_t header_bytes =
+                            sizeof(*header) + detail::serialization_padding(sizeof(*header));
+                        const std::size_t payload_bytes = header->size * header->element_size;
+                        if (header->element_size == 0 || header->size > (size - offset) / header->element_size ||
+                            header_bytes + payload_bytes > size - offset) {
+                            throw std::invalid_argument("mapped_archive: truncated record");
+                        }
+                        records.push_back(offset);
+                        offset += header_bytes + payload_bytes + detail::serialization_padding(payload_bytes);
+                    }
+                }
+
+                template<typename FieldValueType>
+                const detail::serialization_header &record(std::size_t i, detail::serialization_kind kind) const {
+                    if (i >= records.size()) {
+                        throw std::out_of_range("mapped_archive: no such record");
+                    }
+                    const detail::serialization_header &header =
+                        *reinterpret_cast<const detail::serialization_header *>(
+                            static_cast<const char *>(mapping.get()) + records[i]);
+                    if (header.kind != static_cast<std::uint32_t>(kind)) {
+                        throw std::invalid_argument("mapped_archive: record of another kind");
+                    }
+                    if (header.element_size != sizeof(FieldValueType) ||
+                        header.field != detail::serialization_field_identifier<FieldValueType>()) {
+                        throw std::invalid_argument("mapped_archive: record of another field");
+                    }
+                    return header;
+                }
+
+                template<typename FieldValueType>
+                FieldValueType *payload(std::size_t i) const {
+                    return reinterpret_cast<FieldValueType *>(static_cast<char *>(mapping.get()) + payload_offset(i));
+                }
+
+                template<typename FieldValueType>
+                std::unique_ptr<mapped_column<FieldValueType>> column(std::size_t i,
+                                                                      detail::serialization_kind kind) const {
+                    const detail::serialization_header &header = record<FieldValueType>(i, kind);
+                    return std::unique_ptr<mapped_column<FieldValueType>>(new mapped_column<FieldValueType>(
+                        mapping, payload<FieldValueType>(i), static_cast<std::size_t>(header.size),
+                        static_cast<std::size_t>(header.degree)));
+                }
+
+                std::shared_ptr<void> mapping;
+                std::vector<std::size_t> records;
+            };
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_SERIALIZATION_HPP
@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_MATH_SPAN_HPP
+#define CRYPTO3_MATH_SPAN_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * A non-owning view of n contiguous elements, such as a std::vector with any allocator, a slice of a
+             * larger buffer or a memory-mapped region. Transforms taking a span work on the memory in place, the
+             * span cannot be resized.
+             */
+            template<typename T>
+            class span {
+            public:
+                typedef T element_type;
+                typedef typename std::remove_cv<T>::type value_type;
+                typedef std::size_t size_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef T *pointer;
+                typedef T &reference;
+                typedef T *iterator;
+                typedef std::reverse_iterator<iterator> reverse_iterator;
+
+                span() : ptr(nullptr), count(0) {
+                }
+
+                span(pointer data, size_type size) : ptr(data), count(size) {
+                }
+
+                template<std::size_t N>
+                span(element_type (&array)[N]) : ptr(array), count(N) {
+                }
+
+                /**
+                 * View of a contiguous container, e.g. std::vector or std::array, or of a span of non-const elements.
+                 */
+                template<typename Container,
+                         typename = typename std::enable_if<
+                             std::is_convertible<decltype(std::declval<Container &>().data()), pointer>::value>::type>
+                span(Container &c) : ptr(c.data()), count(c.size()) {
+                }
+
+                template<typename Container,
+                         typename = typename std::enable_if<std::is_convertible<
+                             decltype(std::declval<const Container &>().data()), pointer>::value>::type>
+                span(const Container &c) : ptr(c.data()), count(c.size()) {
+                }
+
+                pointer data() const {
+                    return ptr;
+                }
+
+                size_type size() const {
+                    return count;
+                }
+
+                bool empty() const {
+                    return count == 0;
+                }
+
+                iterator begin() const {
+                    return ptr;
+                }
+
+                iterator end() const {
+                    return ptr + count;
+                }
+
+                reverse_iterator rbegin() const {
+                    return reverse_iterator(end());
+                }
+
+                reverse_iterator rend() const {
+                    return reverse_iterator(begin());
+                }
+
+                reference operator[](size_type i) const {
+                    return ptr[i];
+                }
+
+                reference front() const {
+                    return ptr[0];
+                }
+
+                reference back() const {
+                    return ptr[count - 1];
+                }
+
+                /**
+                 * The count elements starting at offset.
+                 */
+                span subspan(size_type offset, size_type n) const {
+                    if (offset > count || n > count - offset)
+                        throw std::out_of_range("span: the subspan is out of range");
+
+                    return span(ptr + offset, n);
+                }
+
+                span first(size_type n) const {
+                    return subspan(0, n);
+                }
+
+                span last(size_type n) const {
+                    return subspan(count - n, n);
+                }
+
+            private:
+                pointer ptr;
+                size_type count;
+            };
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_SPAN_HPP
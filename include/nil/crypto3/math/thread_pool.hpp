@@ -0,0 +1,227 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MATH_THREAD_POOL_HPP
+#define CRYPTO3_MATH_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * A fixed size pool of worker threads used by the parallel paths of the evaluation domains and
+             * polynomial containers. Parallelism is opt-in: either pass a pool to an evaluation domain with
+             * set_thread_pool, or install one with thread_pool::global(), which is picked up by every domain
+             * constructed afterwards.
+             */
+            class thread_pool {
+                typedef std::function<void()> task_type;
+
+            public:
+                explicit thread_pool(std::size_t threads_count = std::thread::hardware_concurrency()) :
+                    stopped(false) {
+                    threads_count = std::max<std::size_t>(threads_count, 1);
+
+                    /* the thread calling parallel_for takes part in the work, so one thread less is enough */
+                    for (std::size_t i = 1; i < threads_count; ++i) {
+                        workers.emplace_back([this]() { this->worker_loop(); });
+                    }
+                }
+
+                thread_pool(const thread_pool &) = delete;
+                thread_pool &operator=(const thread_pool &) = delete;
+
+                ~thread_pool() {
+                    {
+                        std::unique_lock<std::mutex> lock(queue_mutex);
+                        stopped = true;
+                    }
+                    queue_cv.notify_all();
+                    for (std::thread &worker : workers) {
+                        worker.join();
+                    }
+                }
+
+                /**
+                 * Number of threads taking part in parallel_for, including the calling one.
+                 */
+                inline std::size_t size() const {
+                    return workers.size() + 1;
+                }
+
+                /**
+                 * Split [begin, end) into at most size() contiguous chunks of at least grain_size indices and call
+                 * f(chunk_begin, chunk_end) on each of them in parallel. Returns when all of the chunks are done.
+                 * Calling parallel_for from inside f is allowed: waiting threads execute pending chunks.
+                 */
+                template<typename F>
+                void parallel_for(std::size_t begin, std::size_t end, F f, std::size_t grain_size = 1) {
+                    if (begin >= end) {
+                        return;
+                    }
+
+                    grain_size = std::max<std::size_t>(grain_size, 1);
+                    const std::size_t range = end - begin;
+                    const std::size_t chunks_count = std::min(size(), (range + grain_size - 1) / grain_size);
+
+                    if (chunks_count <= 1) {
+                        f(begin, end);
+                        return;
+                    }
+
+                    const std::size_t chunk_size = (range + chunks_count - 1) / chunks_count;
+
+                    std::atomic<std::size_t> remaining(chunks_count - 1);
+                    std::exception_ptr error;
+                    std::mutex error_mutex;
+
+                    {
+                        std::unique_lock<std::mutex> lock(queue_mutex);
+                        for (std::size_t i = 1; i < chunks_count; ++i) {
+                            const std::size_t chunk_begin = begin + i * chunk_size;
+                            const std::size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+                            tasks.emplace_back([&, chunk_begin, chunk_end]() {
+                                try {
+                                    f(chunk_begin, chunk_end);
+                                } catch (...) {
+                                    std::unique_lock<std::mutex> error_lock(error_mutex);
+                                    if (!error) {
+                                        error = std::current_exception();
+                                    }
+                                }
+                                if (--remaining == 0) {
+                                    std::unique_lock<std::mutex> done_lock(queue_mutex);
+                                    done_cv.notify_all();
+                                }
+                            });
+                        }
+                    }
+                    queue_cv.notify_all();
+                    done_cv.notify_all();
+
+                    try {
+                        f(begin, std::min(end, begin + chunk_size));
+                    } catch (...) {
+                        std::unique_lock<std::mutex> error_lock(error_mutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    /* help with the pending tasks instead of blocking, so nested calls can not deadlock */
+                    while (remaining != 0) {
+                        if (!run_pending_task()) {
+                            std::unique_lock<std::mutex> lock(queue_mutex);
+                            done_cv.wait(lock, [&]() { return remaining == 0 || !tasks.empty(); });
+                        }
+                    }
+
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                }
+
+                /**
+                 * Pool used by default by the evaluation domains and polynomial containers. Empty by default,
+                 * which means everything runs on the calling thread.
+                 */
+                static std::shared_ptr<thread_pool> &global() {
+                    static std::shared_ptr<thread_pool> instance;
+                    return instance;
+                }
+
+            private:
+                bool run_pending_task() {
+                    task_type task;
+                    {
+                        std::unique_lock<std::mutex> lock(queue_mutex);
+                        if (tasks.empty()) {
+                            return false;
+                        }
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                    return true;
+                }
+
+                void worker_loop() {
+                    while (true) {
+                        task_type task;
+                        {
+                            std::unique_lock<std::mutex> lock(queue_mutex);
+                            queue_cv.wait(lock, [this]() { return stopped || !tasks.empty(); });
+                            if (stopped && tasks.empty()) {
+                                return;
+                            }
+                            task = std::move(tasks.front());
+                            tasks.pop_front();
+                        }
+                        task();
+                    }
+                }
+
+                std::vector<std::thread> workers;
+                std::deque<task_type> tasks;
+                std::mutex queue_mutex;
+                std::condition_variable queue_cv;
+                std::condition_variable done_cv;
+                bool stopped;
+            };
+
+            namespace detail {
+
+                /**
+                 * Run f(chunk_begin, chunk_end) over [begin, end) on the pool, or on the calling thread if there is
+                 * no pool.
+                 */
+                template<typename F>
+                void parallel_for(thread_pool *pool, std::size_t begin, std::size_t end, F f,
+                                  std::size_t grain_size = 1) {
+                    if (pool == nullptr || pool->size() == 1) {
+                        if (begin < end) {
+                            f(begin, end);
+                        }
+                        return;
+                    }
+
+                    pool->parallel_for(begin, end, f, grain_size);
+                }
+            }    // namespace detail
+        }        // namespace math
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MATH_THREAD_POOL_HPP
@@ -0,0 +1,168 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE distributed_fft_test
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+
+#include <nil/crypto3/math/algorithms/distributed_fft.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+typedef fields::bls12_fr<381> FieldType;
+typedef typename FieldType::value_type value_type;
+
+/* the test runs on as many ranks as mpiexec starts, from one up to four */
+struct mpi_environment {
+    mpi_environment() {
+        MPI_Init(nullptr, nullptr);
+    }
+
+    ~mpi_environment() {
+        MPI_Finalize();
+    }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE(mpi_environment);
+
+std::size_t ranks() {
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return static_cast<std::size_t>(size);
+}
+
+std::size_t rank() {
+    int index;
+    MPI_Comm_rank(MPI_COMM_WORLD, &index);
+    return static_cast<std::size_t>(index);
+}
+
+std::vector<value_type> polynomial_coefficients(std::size_t n) {
+    std::vector<value_type> f(n);
+    for (std::size_t i = 0; i < n; i++) {
+        f[i] = value_type(i * i + 3 * i + 1);
+    }
+    return f;
+}
+
+/* the slice of the rank in the natural order */
+std::vector<value_type> local_slice(const std::vector<value_type> &f) {
+    const std::size_t size = f.size() / ranks();
+    return std::vector<value_type>(f.begin() + rank() * size, f.begin() + (rank() + 1) * size);
+}
+
+void check_local_slice(const std::vector<value_type> &expected, const std::vector<value_type> &local) {
+    const std::vector<value_type> slice = local_slice(expected);
+    BOOST_CHECK_EQUAL(slice.size(), local.size());
+    for (std::size_t i = 0; i < local.size(); i++) {
+        BOOST_CHECK_EQUAL(slice[i].data, local[i].data);
+    }
+}
+
+void test_distributed_fft(std::size_t n) {
+    const std::size_t n1 = distributed_fft_sides(n).first, n2 = distributed_fft_sides(n).second;
+    const std::vector<value_type> f = polynomial_coefficients(n);
+
+    std::vector<value_type> expected(f);
+    basic_radix2_domain<FieldType>(n).fft(expected);
+
+    std::vector<value_type> a = local_slice(f);
+    distributed_transpose(a, n1, n2, MPI_COMM_WORLD);
+    const std::vector<value_type> columns(a);
+
+    distributed_fft<FieldType>(a, n, MPI_COMM_WORLD);
+    const std::vector<value_type> rows(a);
+    distributed_transpose(a, n1, n2, MPI_COMM_WORLD);
+    check_local_slice(expected, a);
+
+    a = rows;
+    distributed_inverse_fft<FieldType>(a, n, MPI_COMM_WORLD, thread_pool::global().get());
+    for (std::size_t i = 0; i < a.size(); i++) {
+        BOOST_CHECK_EQUAL(columns[i].data, a[i].data);
+    }
+}
+
+void test_distributed_coset_fft(std::size_t n, std::size_t k) {
+    const std::size_t n1 = distributed_fft_sides(n).first, n2 = distributed_fft_sides(n).second;
+    const value_type g = fields::arithmetic_params<FieldType>::multiplicative_generator;
+    const std::vector<value_type> f = polynomial_coefficients(n);
+
+    std::vector<value_type> expected(f);
+    basic_radix2_domain<FieldType>(n).coset_fft(expected, g);
+
+    std::vector<value_type> a = local_slice(f);
+    distributed_transpose(a, n1, n2, MPI_COMM_WORLD);
+
+    std::vector<value_type> b(a);
+    distributed_coset_fft<FieldType>(b, n, g, MPI_COMM_WORLD);
+    std::vector<value_type> values(b);
+    distributed_transpose(b, n1, n2, MPI_COMM_WORLD);
+    check_local_slice(expected, b);
+
+    distributed_coset_inverse_fft<FieldType>(values, n, g, MPI_COMM_WORLD);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        BOOST_CHECK_EQUAL(a[i].data, values[i].data);
+    }
+
+    /* the values on S in the row order, extended to the coset of the size 2^k n */
+    std::vector<value_type> extended(f);
+    extended.resize(n << k, value_type::zero());
+    basic_radix2_domain<FieldType>(n << k).coset_fft(extended, g);
+
+    std::vector<value_type> on_s(a);
+    distributed_fft<FieldType>(on_s, n, MPI_COMM_WORLD);
+    std::vector<std::vector<value_type>> cosets = distributed_extend<FieldType>(on_s, n, k, g, MPI_COMM_WORLD);
+    BOOST_CHECK_EQUAL(cosets.size(), 1ul << k);
+    for (std::size_t t = 0; t < cosets.size(); t++) {
+        std::vector<value_type> coset_expected(n);
+        for (std::size_t i = 0; i < n; i++) {
+            coset_expected[i] = extended[t + (i << k)];
+        }
+        distributed_transpose(cosets[t], n1, n2, MPI_COMM_WORLD);
+        check_local_slice(coset_expected, cosets[t]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(distributed_fft_test_suite)
+
+BOOST_AUTO_TEST_CASE(distributed_fft_test) {
+    for (std::size_t n : {16, 32, 256, 2048}) {
+        test_distributed_fft(n);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(distributed_coset_fft_test) {
+    test_distributed_coset_fft(16, 1);
+    test_distributed_coset_fft(512, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,10 +27,16 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cstdio>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <cstdint>
 
+#include <nil/crypto3/algebra/fields/field.hpp>
+#include <nil/crypto3/algebra/fields/params.hpp>
+#include <nil/crypto3/algebra/fields/detail/element/fp.hpp>
+
 #include <nil/crypto3/algebra/fields/bls12/base_field.hpp>
 #include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
@@ -39,6 +45,9 @@
 #include <nil/crypto3/algebra/fields/mnt4/base_field.hpp>
 #include <nil/crypto3/algebra/fields/arithmetic_params/mnt4.hpp>
 
+#include <nil/crypto3/algebra/fields/alt_bn128/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/alt_bn128.hpp>
+
 #include <nil/crypto3/algebra/fields/mnt6/scalar_field.hpp>
 #include <nil/crypto3/algebra/fields/mnt6/base_field.hpp>
 #include <nil/crypto3/algebra/fields/arithmetic_params/mnt6.hpp>
@@ -50,12 +59,94 @@
 #include <nil/crypto3/math/domains/geometric_sequence_domain.hpp>
 #include <nil/crypto3/math/domains/step_radix2_domain.hpp>
 
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
+#include <nil/crypto3/math/algorithms/calculate_domain_set.hpp>
+#include <nil/crypto3/math/algorithms/evaluation_domain_cache.hpp>
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+
+#include <nil/crypto3/math/polynomial/vanishing_polynomial.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/out_of_core_fft.hpp>
 
 #include <nil/crypto3/math/polynomial/evaluate.hpp>
 
 #include <typeinfo>
 
+namespace nil {
+    namespace crypto3 {
+        namespace algebra {
+            namespace fields {
+                /*
+                 * Prime fields of one word, for the kernel of basic_radix2_word_fft: BabyBear, 15 * 2^27 + 1, in
+                 * 32-bit words and 29 * 2^57 + 1 in 64-bit ones.
+                 */
+                template<std::size_t ModulusBits>
+                struct small_prime_field;
+
+                template<>
+                struct small_prime_field<31> : public field<31> {
+                    typedef field<31> policy_type;
+
+                    constexpr static const std::size_t modulus_bits = policy_type::modulus_bits;
+                    typedef typename policy_type::integral_type integral_type;
+                    typedef typename policy_type::extended_integral_type extended_integral_type;
+
+                    constexpr static const std::size_t number_bits = policy_type::number_bits;
+
+                    constexpr static const integral_type modulus = 0x78000001;
+
+                    typedef typename policy_type::modular_type modular_type;
+                    typedef typename detail::element_fp<params<small_prime_field<31>>> value_type;
+
+                    constexpr static const std::size_t value_bits = modulus_bits;
+                    constexpr static const std::size_t arity = 1;
+                };
+
+                template<>
+                struct small_prime_field<62> : public field<62> {
+                    typedef field<62> policy_type;
+
+                    constexpr static const std::size_t modulus_bits = policy_type::modulus_bits;
+                    typedef typename policy_type::integral_type integral_type;
+                    typedef typename policy_type::extended_integral_type extended_integral_type;
+
+                    constexpr static const std::size_t number_bits = policy_type::number_bits;
+
+                    constexpr static const integral_type modulus = 0x3a00000000000001;
+
+                    typedef typename policy_type::modular_type modular_type;
+                    typedef typename detail::element_fp<params<small_prime_field<62>>> value_type;
+
+                    constexpr static const std::size_t value_bits = modulus_bits;
+                    constexpr static const std::size_t arity = 1;
+                };
+
+                template<>
+                struct arithmetic_params<small_prime_field<31>> : public params<small_prime_field<31>> {
+                    typedef typename small_prime_field<31>::integral_type integral_type;
+
+                    constexpr static const std::size_t s = 27;
+                    constexpr static const integral_type root_of_unity = 0x1a427a41;
+                    constexpr static const integral_type multiplicative_generator = 31;
+                    constexpr static const integral_type geometric_generator = 31;
+                    constexpr static const integral_type arithmetic_generator = 0;
+                };
+
+                template<>
+                struct arithmetic_params<small_prime_field<62>> : public params<small_prime_field<62>> {
+                    typedef typename small_prime_field<62>::integral_type integral_type;
+
+                    constexpr static const std::size_t s = 57;
+                    constexpr static const integral_type root_of_unity = 0x3e6b41437d93;
+                    constexpr static const integral_type multiplicative_generator = 3;
+                    constexpr static const integral_type geometric_generator = 3;
+                    constexpr static const integral_type arithmetic_generator = 0;
+                };
+            }    // namespace fields
+        }        // namespace algebra
+    }            // namespace crypto3
+}    // namespace nil
+
 using namespace nil::crypto3::algebra;
 using namespace nil::crypto3::math;
 
@@ -194,6 +285,699 @@ void test_compute_z() {
     BOOST_CHECK_EQUAL(Z.data, a.data);
 }
 
+template<typename FieldType>
+void test_coset_vanishing_polynomial(const std::shared_ptr<evaluation_domain<FieldType>> &domain, std::size_t n,
+                                     const typename FieldType::value_type &coset) {
+    typedef typename FieldType::value_type value_type;
+
+    const value_type omega = unity_root<FieldType>(n);
+    const std::size_t m = domain->m;
+
+    for (bool parallel : {false, true}) {
+        if (parallel) {
+            domain->set_thread_pool(std::make_shared<thread_pool>(4));
+        }
+
+        std::vector<value_type> z = domain->compute_vanishing_polynomial_on_coset(coset, n);
+        std::vector<value_type> l_0 = domain->evaluate_lagrange_polynomial_on_coset(0, coset, n);
+        std::vector<value_type> l_last = domain->evaluate_lagrange_polynomial_on_coset(m - 1, coset, n);
+        BOOST_CHECK_EQUAL(z.size(), n);
+        BOOST_CHECK_EQUAL(l_0.size(), n);
+
+        for (std::size_t j = 0; j < n; j++) {
+            const value_type x = coset * omega.pow(j);
+            const std::vector<value_type> l = domain->evaluate_all_lagrange_polynomials(x);
+            BOOST_CHECK_EQUAL(domain->compute_vanishing_polynomial(x).data, z[j].data);
+            BOOST_CHECK_EQUAL(l[0].data, l_0[j].data);
+            BOOST_CHECK_EQUAL(l[m - 1].data, l_last[j].data);
+        }
+    }
+
+    if (n > m) {
+        polynomial_dfs<value_type> z_dfs = vanishing_polynomial_dfs(domain, coset, n);
+        polynomial_dfs<value_type> l_dfs = lagrange_polynomial_dfs(domain, 0, coset, n);
+        BOOST_CHECK_EQUAL(z_dfs.degree(), m);
+        BOOST_CHECK_EQUAL(l_dfs.degree(), m - 1);
+        BOOST_CHECK_EQUAL(l_dfs[0].data, domain->evaluate_lagrange_polynomial_on_coset(0, coset, n)[0].data);
+    }
+}
+
+template<typename FieldType>
+void test_basic_radix2_fft_cached() {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t m = 1024;
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(i * i + 1);
+    }
+
+    basic_radix2_domain<FieldType> domain(m);
+
+    std::vector<value_type> a(f);
+    std::vector<value_type> b(f);
+    domain.fft(a);
+    detail::basic_radix2_fft<FieldType>(b, unity_root<FieldType>(m));
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(b[i].data, a[i].data);
+    }
+
+    domain.inverse_fft(a);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, a[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_basic_radix4_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(7 * i * i + 3 * i + 1);
+    }
+
+    const std::vector<value_type> twiddles =
+        detail::basic_radix2_fft_twiddles<FieldType>(m, unity_root<FieldType>(m));
+
+    std::vector<value_type> a(f);
+    std::vector<value_type> b(f);
+    detail::basic_radix2_fft_cached<FieldType>(a, twiddles);
+    detail::basic_radix4_fft_cached<FieldType>(b, twiddles);
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+    }
+
+    const std::vector<value_type> pre_scale =
+        detail::basic_radix2_coset_powers<FieldType>(m, value_type(3), value_type(5));
+    const std::vector<value_type> post_scale =
+        detail::basic_radix2_coset_powers<FieldType>(m, value_type(7), value_type(2));
+
+    a = f;
+    b = f;
+    detail::basic_radix2_fft_cached<FieldType>(a.begin(), m, twiddles.data(), nullptr, pre_scale.data(),
+                                               post_scale.data());
+    detail::basic_radix4_fft_cached<FieldType>(b.begin(), m, twiddles.data(), nullptr, pre_scale.data(),
+                                               post_scale.data());
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_basic_radix2_codelet(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(5 * i * i + i + 2);
+    }
+
+    const value_type omega = unity_root<FieldType>(m);
+    const std::vector<value_type> twiddles = detail::basic_radix2_fft_twiddles<FieldType>(m, omega);
+    const std::vector<value_type> inverse_twiddles = detail::basic_radix2_fft_twiddles<FieldType>(m, omega.inversed());
+
+    std::vector<value_type> a(f), b(f), c(f);
+    detail::basic_radix2_fft_cached<FieldType>(a, twiddles);
+    BOOST_CHECK(detail::basic_radix2_codelet_fft<FieldType>(b.begin(), m, twiddles.data()));
+    detail::basic_radix2_fft<FieldType>(c, omega);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+        BOOST_CHECK_EQUAL(a[i].data, c[i].data);
+    }
+
+    detail::basic_radix2_codelet_fft<FieldType>(b.begin(), m, inverse_twiddles.data());
+    const value_type m_inversed = value_type(m).inversed();
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, (b[i] * m_inversed).data);
+    }
+}
+
+template<typename FieldType>
+void test_lazy_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    /* values close to the modulus as well, to check the bounds of the lazy butterflies */
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = (i % 2) ? value_type(i * i + 1) : -value_type(i + 1);
+    }
+
+    basic_radix2_domain<FieldType> domain(m);
+
+    std::vector<value_type> a(f);
+    std::vector<value_type> b(f);
+    domain.fft(a);
+    detail::basic_radix2_fft<FieldType>(b, unity_root<FieldType>(m));
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(b[i].data, a[i].data);
+    }
+
+    domain.inverse_fft(a);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, a[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_parallel_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(3 * i + 7);
+    }
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(m);
+
+    std::vector<value_type> a(f);
+    domain->fft(a);
+
+    domain->set_thread_pool(std::make_shared<thread_pool>(4));
+
+    std::vector<value_type> b(f);
+    domain->fft(b);
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+    }
+
+    domain->inverse_fft(b);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, b[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_step_radix2_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(7 * i * i + 3 * i + 1);
+    }
+
+    step_radix2_domain<FieldType> domain(m);
+
+    std::vector<value_type> a(f);
+    domain.fft(a);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(evaluate_polynomial(f, domain.get_domain_element(i), m).data, a[i].data);
+    }
+
+    domain.inverse_fft(a);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, a[i].data);
+    }
+
+    step_radix2_domain<FieldType> parallel_domain(m);
+    parallel_domain.set_thread_pool(std::make_shared<thread_pool>(4));
+
+    std::vector<value_type> b(f);
+    parallel_domain.fft(b);
+    domain.fft(a);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+    }
+
+    parallel_domain.inverse_fft(b);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, b[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_geometric_sequence_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(5 * i * i + 2 * i + 9);
+    }
+
+    geometric_sequence_domain<FieldType> domain(m);
+
+    std::vector<value_type> a(f);
+    domain.fft(a);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(evaluate_polynomial(f, domain.get_domain_element(i), m).data, a[i].data);
+    }
+
+    std::vector<value_type> b(a);
+    domain.inverse_fft(b);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, b[i].data);
+    }
+
+    /* the batch of three columns, the middle one f, on the threads of a pool */
+    domain.set_thread_pool(std::make_shared<thread_pool>(4));
+    std::vector<std::vector<value_type>> columns(3, f);
+    for (std::size_t i = 0; i < m; i++) {
+        columns[0][i] = value_type(i + 1);
+        columns[2][i] = value_type(3 * i);
+    }
+    std::vector<std::vector<value_type>> expected(columns);
+    for (std::vector<value_type> &c : expected) {
+        domain.fft(c);
+    }
+
+    domain.fft_batch(columns);
+    for (std::size_t c = 0; c < columns.size(); c++) {
+        for (std::size_t i = 0; i < m; i++) {
+            BOOST_CHECK_EQUAL(expected[c][i].data, columns[c][i].data);
+        }
+    }
+
+    domain.inverse_fft_batch(columns);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, columns[1][i].data);
+    }
+}
+
+template<typename FieldType>
+void test_basic_radix2_four_step_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(5 * i * i + i + 2);
+    }
+
+    const std::vector<value_type> twiddles =
+        detail::basic_radix2_fft_twiddles<FieldType>(m, unity_root<FieldType>(m));
+
+    std::vector<value_type> a(f);
+    std::vector<value_type> b(f);
+    detail::basic_radix2_fft_cached<FieldType>(a, twiddles);
+    detail::basic_radix2_four_step_fft<FieldType>(b, twiddles);
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+    }
+
+    const std::vector<value_type> pre_scale =
+        detail::basic_radix2_coset_powers<FieldType>(m, value_type(3), value_type(5));
+    const std::vector<value_type> post_scale =
+        detail::basic_radix2_coset_powers<FieldType>(m, value_type(7), value_type(2));
+
+    a = f;
+    b = f;
+    detail::basic_radix2_fft_cached<FieldType>(a.begin(), m, twiddles.data(), nullptr, pre_scale.data(),
+                                               post_scale.data());
+    detail::basic_radix2_four_step_fft<FieldType>(b.data(), m, twiddles.data(), nullptr, pre_scale.data(),
+                                                  post_scale.data());
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_bitreversed_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(5 * i * i + i + 2);
+    }
+    const std::size_t logm = static_cast<std::size_t>(std::log2(m));
+    const auto bitreversed = [logm](std::vector<value_type> v) {
+        detail::basic_radix2_bitreverse(v, logm, 0, v.size());
+        return v;
+    };
+
+    basic_radix2_domain<FieldType> domain(m);
+    std::vector<value_type> values(f);
+    domain.fft(values);
+
+    std::vector<value_type> a(f);
+    domain.fft_to_bitreversed(a);
+    BOOST_CHECK(a == bitreversed(values));
+    domain.inverse_fft_from_bitreversed(a);
+    BOOST_CHECK(a == f);
+
+    a = bitreversed(f);
+    domain.fft_from_bitreversed(a);
+    BOOST_CHECK(a == values);
+    domain.inverse_fft_to_bitreversed(a);
+    BOOST_CHECK(a == bitreversed(f));
+}
+
+template<typename FieldType>
+void test_out_of_core_fft(const std::size_t m, const std::size_t memory_budget) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(5 * i * i + i + 2);
+    }
+
+    basic_radix2_domain<FieldType> domain(m);
+    std::vector<value_type> a(f), b(m), c(m);
+    domain.fft(a);
+
+    memory_store<value_type> source(f), sink(b);
+    out_of_core_fft<FieldType>(source, sink, m, false, memory_budget);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(a[i].data, b[i].data);
+    }
+
+    /* back through a file */
+    const std::string path = "out_of_core_fft.bin";
+    {
+        memory_store<value_type> input(b);
+        file_store<value_type> output(path, 64);
+        out_of_core_fft<FieldType>(input, output, m, true, memory_budget);
+        output.read(0, c.data(), m);
+    }
+    std::remove(path.c_str());
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(c[i].data, f[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_coset_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(2 * i * i + 3);
+    }
+
+    const value_type g = fields::arithmetic_params<FieldType>::multiplicative_generator;
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(m);
+
+    std::vector<value_type> expected(f);
+    multiply_by_coset(expected, g);
+    domain->fft(expected);
+
+    std::vector<value_type> a(f);
+    domain->coset_fft(a, g);
+
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(expected[i].data, a[i].data);
+    }
+
+    domain->coset_inverse_fft(a, g);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, a[i].data);
+    }
+
+    /* the tables are rebuilt for another shift */
+    const value_type h = g.squared();
+
+    std::vector<value_type> b(f);
+    domain->coset_fft(b, h);
+    domain->coset_inverse_fft(b, h);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(f[i].data, b[i].data);
+    }
+}
+
+template<typename FieldType>
+void test_word_fft(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    BOOST_CHECK(detail::basic_radix2_word_reduction<FieldType>::value);
+
+    /* values close to the modulus as well, to check the reductions of the word butterflies */
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = (i % 2) ? value_type(i * i + 1) : -value_type(i + 1);
+    }
+    const std::size_t logm = static_cast<std::size_t>(std::log2(m));
+    const auto bitreversed = [logm](std::vector<value_type> v) {
+        detail::basic_radix2_bitreverse(v, logm, 0, v.size());
+        return v;
+    };
+    const value_type omega = unity_root<FieldType>(m), m_inverse = value_type(m).inversed();
+    const value_type g = fields::arithmetic_params<FieldType>::multiplicative_generator;
+
+    std::vector<value_type> values(f);
+    detail::basic_radix2_fft<FieldType>(values, omega);
+    std::vector<value_type> coset_values(f);
+    multiply_by_coset(coset_values, g);
+    detail::basic_radix2_fft<FieldType>(coset_values, omega);
+
+    basic_radix2_domain<FieldType> domain(m);
+
+    std::vector<value_type> a(f);
+    domain.fft(a);
+    BOOST_CHECK(a == values);
+    domain.inverse_fft(a);
+    BOOST_CHECK(a == f);
+
+    a = values;
+    detail::basic_radix2_fft<FieldType>(a, omega.inversed());
+    for (std::size_t i = 0; i < m; i++) {
+        a[i] *= m_inverse;
+    }
+    BOOST_CHECK(a == f);
+
+    a = f;
+    domain.fft_to_bitreversed(a);
+    BOOST_CHECK(a == bitreversed(values));
+    domain.inverse_fft_from_bitreversed(a);
+    BOOST_CHECK(a == f);
+
+    a = bitreversed(f);
+    domain.fft_from_bitreversed(a);
+    BOOST_CHECK(a == values);
+    domain.inverse_fft_to_bitreversed(a);
+    BOOST_CHECK(a == bitreversed(f));
+
+    a = f;
+    domain.coset_fft(a, g);
+    BOOST_CHECK(a == coset_values);
+    domain.coset_inverse_fft(a, g);
+    BOOST_CHECK(a == f);
+}
+
+template<typename FieldType>
+void test_fft_batch(const std::size_t m, const std::size_t columns_count) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<std::vector<value_type>> f(columns_count, std::vector<value_type>(m));
+    for (std::size_t c = 0; c < columns_count; c++) {
+        for (std::size_t i = 0; i < m; i++) {
+            f[c][i] = value_type(c * m + i * i + 1);
+        }
+    }
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(m);
+
+    std::vector<std::vector<value_type>> expected(f);
+    for (std::vector<value_type> &a : expected) {
+        domain->fft(a);
+    }
+
+    for (std::shared_ptr<thread_pool> pool : {std::shared_ptr<thread_pool>(), std::make_shared<thread_pool>(2)}) {
+        domain->set_thread_pool(pool);
+
+        std::vector<std::vector<value_type>> columns(f);
+        domain->fft_batch(columns);
+
+        std::vector<value_type> data;
+        for (const std::vector<value_type> &a : f) {
+            data.insert(data.end(), a.begin(), a.end());
+        }
+        domain->fft_batch(data);
+
+        for (std::size_t c = 0; c < columns_count; c++) {
+            for (std::size_t i = 0; i < m; i++) {
+                BOOST_CHECK_EQUAL(expected[c][i].data, columns[c][i].data);
+                BOOST_CHECK_EQUAL(expected[c][i].data, data[c * m + i].data);
+            }
+        }
+
+        domain->inverse_fft_batch(columns);
+        domain->inverse_fft_batch(data);
+
+        for (std::size_t c = 0; c < columns_count; c++) {
+            for (std::size_t i = 0; i < m; i++) {
+                BOOST_CHECK_EQUAL(f[c][i].data, columns[c][i].data);
+                BOOST_CHECK_EQUAL(f[c][i].data, data[c * m + i].data);
+            }
+        }
+    }
+}
+
+template<typename FieldType>
+void test_batch_inverse(const std::size_t n) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> f(n);
+    for (std::size_t i = 0; i < n; i++) {
+        f[i] = (i % 7 == 3) ? value_type::zero() : value_type(i * i + 5);
+    }
+
+    for (std::shared_ptr<thread_pool> pool : {std::shared_ptr<thread_pool>(), std::make_shared<thread_pool>(3)}) {
+        std::vector<value_type> a(f);
+        batch_inverse(a, pool.get());
+
+        for (std::size_t i = 0; i < n; i++) {
+            if (f[i].is_zero()) {
+                BOOST_CHECK(a[i].is_zero());
+            } else {
+                BOOST_CHECK_EQUAL(f[i].inversed().data, a[i].data);
+            }
+        }
+    }
+}
+
+template<typename FieldType>
+void test_evaluation_domain_cache(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    evaluation_domain_cache<FieldType> cache;
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = cache.get(m);
+    BOOST_CHECK(domain == cache.get(m));
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+
+    std::vector<value_type> f(m), expected(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = expected[i] = value_type(i * i + 3);
+    }
+    make_evaluation_domain<FieldType>(m)->fft(expected);
+    domain->fft(f);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(expected[i].data, f[i].data);
+    }
+
+    std::shared_ptr<basic_radix2_domain<FieldType>> radix2 = cache.template get<basic_radix2_domain<FieldType>>(m);
+    BOOST_CHECK(radix2 == cache.template get<basic_radix2_domain<FieldType>>(m));
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+
+    std::vector<std::shared_ptr<evaluation_domain<FieldType>>> shared(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < shared.size(); t++) {
+        threads.emplace_back([&cache, &shared, t, m]() { shared[t] = cache.get(2 * m); });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (std::size_t t = 0; t < shared.size(); t++) {
+        BOOST_CHECK(shared[t] != nullptr);
+        BOOST_CHECK(shared[t] == shared[0]);
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+
+    cache.evict(m);
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+    BOOST_CHECK(domain != cache.get(m));
+    domain->inverse_fft(f);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(value_type(i * i + 3).data, f[i].data);
+    }
+
+    cache.warm_up({m, 4 * m});
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+template<typename FieldType>
+void test_fft_workspace(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(m);
+    typename evaluation_domain<FieldType>::workspace_type workspace;
+
+    std::vector<value_type> f(m);
+    for (std::size_t i = 0; i < m; i++) {
+        f[i] = value_type(i * i + 11);
+    }
+    std::vector<value_type> expected(f);
+    domain->fft(expected);
+    const value_type g = fields::arithmetic_params<FieldType>::multiplicative_generator;
+    std::vector<value_type> coset_expected(f);
+    domain->coset_fft(coset_expected, g);
+
+    std::size_t capacity = 0;
+    std::size_t words_capacity = 0;
+    for (std::size_t round = 0; round < 3; round++) {
+        std::vector<value_type> a(f);
+        domain->fft(a, workspace);
+        for (std::size_t i = 0; i < m; i++) {
+            BOOST_CHECK_EQUAL(expected[i].data, a[i].data);
+        }
+
+        domain->inverse_fft(a, workspace);
+        for (std::size_t i = 0; i < m; i++) {
+            BOOST_CHECK_EQUAL(f[i].data, a[i].data);
+        }
+
+        domain->coset_fft(a, g, workspace);
+        for (std::size_t i = 0; i < m; i++) {
+            BOOST_CHECK_EQUAL(coset_expected[i].data, a[i].data);
+        }
+
+        domain->coset_inverse_fft(a, g, workspace);
+        for (std::size_t i = 0; i < m; i++) {
+            BOOST_CHECK_EQUAL(f[i].data, a[i].data);
+        }
+
+        /* the buffers are sized on the first call and reused afterwards */
+        if (round == 0) {
+            capacity = workspace.capacity();
+            words_capacity = workspace.words_capacity();
+            BOOST_CHECK(capacity <= domain->workspace_size());
+            BOOST_CHECK(words_capacity <= domain->workspace_words_size());
+        }
+        BOOST_CHECK_EQUAL(capacity, workspace.capacity());
+        BOOST_CHECK_EQUAL(words_capacity, workspace.words_capacity());
+    }
+}
+
+template<typename FieldType>
+void test_fft_span(const std::size_t m) {
+    typedef typename FieldType::value_type value_type;
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(m);
+
+    /* the middle one of three columns of size m stored one after another */
+    std::vector<value_type> data(3 * m);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i] = value_type(i * i + 2);
+    }
+    const std::vector<value_type> original(data);
+    span<value_type> column = span<value_type>(data).subspan(m, m);
+
+    std::vector<value_type> expected(original.begin() + m, original.begin() + 2 * m);
+    domain->fft(expected);
+    domain->fft(column);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(expected[i].data, data[m + i].data);
+        BOOST_CHECK_EQUAL(original[i].data, data[i].data);
+        BOOST_CHECK_EQUAL(original[2 * m + i].data, data[2 * m + i].data);
+    }
+
+    domain->divide_by_z_on_coset(expected);
+    domain->divide_by_z_on_coset(column);
+    domain->inverse_fft(expected);
+    domain->inverse_fft(column);
+    for (std::size_t i = 0; i < m; i++) {
+        BOOST_CHECK_EQUAL(expected[i].data, data[m + i].data);
+    }
+
+    std::vector<value_type> H(original.begin(), original.begin() + m + 1);
+    std::vector<value_type> H_span(H);
+    domain->add_poly_z(value_type(7), H);
+    domain->add_poly_z(value_type(7), span<value_type>(H_span));
+    for (std::size_t i = 0; i < m + 1; i++) {
+        BOOST_CHECK_EQUAL(H[i].data, H_span[i].data);
+    }
+
+    BOOST_CHECK_THROW(domain->fft(span<value_type>(data).first(m - 1)), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE(fft_evaluation_domain_test_suite)
 
 BOOST_AUTO_TEST_CASE(fft) {
@@ -201,6 +985,108 @@ BOOST_AUTO_TEST_CASE(fft) {
     test_fft<fields::mnt4<298>>();
 }
 
+BOOST_AUTO_TEST_CASE(basic_radix2_fft_cached) {
+    test_basic_radix2_fft_cached<fields::bls12<381>>();
+    test_basic_radix2_fft_cached<fields::mnt4<298>>();
+}
+
+BOOST_AUTO_TEST_CASE(basic_radix4_fft) {
+    for (std::size_t m : {1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 2048}) {
+        test_basic_radix4_fft<fields::bls12<381>>(m);
+    }
+    test_basic_radix4_fft<fields::mnt4<298>>(1024);
+}
+
+BOOST_AUTO_TEST_CASE(basic_radix2_codelet) {
+    for (std::size_t m : {2, 4, 8, 16, 32, 64}) {
+        test_basic_radix2_codelet<fields::bls12<381>>(m);
+    }
+    BOOST_CHECK(!detail::basic_radix2_codelet_fft<fields::bls12<381>>(
+        static_cast<typename fields::bls12<381>::value_type *>(nullptr), 128, nullptr));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_fft) {
+    for (std::size_t m : {2, 4, 1024}) {
+        test_lazy_fft<fields::alt_bn128_fr<254>>(m);
+    }
+    test_lazy_fft<fields::bls12_fr<381>>(1024);
+    test_lazy_fft<fields::alt_bn128_fr<254>>(detail::basic_radix2_four_step_fft_threshold);
+}
+
+BOOST_AUTO_TEST_CASE(basic_radix2_four_step_fft) {
+    for (std::size_t m : {2, 4, 8, 32, 64, 2048}) {
+        test_basic_radix2_four_step_fft<fields::bls12<381>>(m);
+    }
+    test_basic_radix2_four_step_fft<fields::mnt4<298>>(1024);
+}
+
+BOOST_AUTO_TEST_CASE(bitreversed_fft) {
+    for (std::size_t m : {2, 4, 8, 1024}) {
+        test_bitreversed_fft<fields::bls12<381>>(m);
+    }
+    test_bitreversed_fft<fields::mnt4<298>>(512);
+}
+
+BOOST_AUTO_TEST_CASE(out_of_core_fft) {
+    typedef typename fields::bls12<381>::value_type value_type;
+
+    /* the budget of one, four and all of the columns of a panel */
+    for (std::size_t m : {2, 8, 1024, 2048}) {
+        test_out_of_core_fft<fields::bls12<381>>(m, 0);
+        test_out_of_core_fft<fields::bls12<381>>(m, 12 * m * sizeof(value_type));
+        test_out_of_core_fft<fields::bls12<381>>(m, 3 * m * sizeof(value_type));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(coset_fft) {
+    for (std::size_t m : {2, 4, 1024}) {
+        test_coset_fft<fields::bls12<381>>(m);
+    }
+    test_coset_fft<fields::bls12<381>>(96);
+    test_coset_fft<fields::mnt4<298>>(256);
+}
+
+BOOST_AUTO_TEST_CASE(word_fft) {
+    /* below, at and above the four-step threshold */
+    const std::size_t threshold = detail::basic_radix2_four_step_fft_threshold;
+    for (std::size_t m : {std::size_t(2), std::size_t(4), std::size_t(64), std::size_t(1024), threshold,
+                          2 * threshold}) {
+        test_word_fft<fields::small_prime_field<31>>(m);
+        test_word_fft<fields::small_prime_field<62>>(m);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fft_batch) {
+    test_fft_batch<fields::bls12<381>>(64, 1);
+    test_fft_batch<fields::bls12<381>>(64, 9);
+    test_fft_batch<fields::bls12<381>>(12, 3);
+    test_fft_batch<fields::mnt4<298>>(256, 5);
+    /* through the lazy and word kernels */
+    test_fft_batch<fields::alt_bn128_fr<254>>(256, 5);
+    test_fft_batch<fields::small_prime_field<31>>(256, 5);
+    test_fft_batch<fields::small_prime_field<62>>(1024, 3);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_fft) {
+    test_parallel_fft<fields::bls12<381>>(1024);
+    test_parallel_fft<fields::bls12<381>>(1536);
+    test_parallel_fft<fields::mnt4<298>>(1024);
+}
+
+BOOST_AUTO_TEST_CASE(step_radix2_fft) {
+    test_step_radix2_fft<fields::bls12<381>>(9);
+    test_step_radix2_fft<fields::bls12<381>>(12);
+    test_step_radix2_fft<fields::bls12<381>>(40);
+    test_step_radix2_fft<fields::mnt4<298>>(1536);
+}
+
+BOOST_AUTO_TEST_CASE(geometric_sequence_fft) {
+    test_geometric_sequence_fft<fields::bls12<381>>(2);
+    test_geometric_sequence_fft<fields::bls12<381>>(5);
+    test_geometric_sequence_fft<fields::bls12<381>>(16);
+    test_geometric_sequence_fft<fields::mnt4<298>>(100);
+}
+
 BOOST_AUTO_TEST_CASE(inverse_fft_to_fft) {
     test_inverse_fft_of_fft<fields::bls12<381>>();
     test_inverse_fft_of_fft<fields::mnt4<298>>();
@@ -216,6 +1102,106 @@ BOOST_AUTO_TEST_CASE(lagrange_coefficients) {
     test_lagrange_coefficients<fields::mnt4<298>>();
 }
 
+template<typename FieldType>
+void test_calculate_domain_set(const std::size_t max_domain_degree, const std::size_t set_size) {
+    typedef typename FieldType::value_type value_type;
+
+    evaluation_domain_cache<FieldType>::instance().clear();
+    std::vector<std::shared_ptr<evaluation_domain<FieldType>>> domain_set =
+        calculate_domain_set<FieldType>(max_domain_degree, set_size);
+    BOOST_CHECK_EQUAL(domain_set.size(), set_size);
+
+    const std::shared_ptr<basic_radix2_domain<FieldType>> parent =
+        std::dynamic_pointer_cast<basic_radix2_domain<FieldType>>(domain_set[0]);
+    BOOST_CHECK(parent != nullptr);
+    for (std::size_t i = 0; i < set_size; i++) {
+        const std::size_t m = std::size_t(1) << (max_domain_degree - i);
+        const std::shared_ptr<basic_radix2_domain<FieldType>> domain =
+            std::dynamic_pointer_cast<basic_radix2_domain<FieldType>>(domain_set[i]);
+        BOOST_CHECK_EQUAL(domain->m, m);
+
+        /* the whole set holds the twiddles of the largest domain */
+        BOOST_CHECK(domain->fft_cache.data() == parent->fft_cache.data());
+        BOOST_CHECK(domain->inverse_fft_cache.data() == parent->inverse_fft_cache.data());
+        BOOST_CHECK_EQUAL(domain->fft_cache.size(), m - 1);
+        BOOST_CHECK(domain->lazy_fft_cache == parent->lazy_fft_cache);
+        BOOST_CHECK(domain->lazy_inverse_fft_cache == parent->lazy_inverse_fft_cache);
+        BOOST_CHECK(domain->word_fft_cache == parent->word_fft_cache);
+        BOOST_CHECK(domain->word_inverse_fft_cache == parent->word_inverse_fft_cache);
+
+        std::vector<value_type> f(m), expected(m);
+        for (std::size_t j = 0; j < m; j++) {
+            f[j] = expected[j] = value_type(j * j + 3);
+        }
+        basic_radix2_domain<FieldType>(m).fft(expected);
+        domain->fft(f);
+        for (std::size_t j = 0; j < m; j++) {
+            BOOST_CHECK_EQUAL(expected[j].data, f[j].data);
+        }
+        domain->inverse_fft(f);
+        for (std::size_t j = 0; j < m; j++) {
+            BOOST_CHECK_EQUAL(value_type(j * j + 3).data, f[j].data);
+        }
+    }
+    evaluation_domain_cache<FieldType>::instance().clear();
+}
+
+BOOST_AUTO_TEST_CASE(batch_inverse_test) {
+    for (std::size_t n : {0, 1, 4, 100, 10000}) {
+        test_batch_inverse<fields::bls12<381>>(n);
+    }
+    test_batch_inverse<fields::mnt4<298>>(100);
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_domain_cache_test) {
+    test_evaluation_domain_cache<fields::bls12<381>>(16);
+    test_evaluation_domain_cache<fields::mnt4<298>>(256);
+}
+
+BOOST_AUTO_TEST_CASE(calculate_domain_set_test) {
+    test_calculate_domain_set<fields::bls12<381>>(6, 5);
+    test_calculate_domain_set<fields::mnt4<298>>(10, 3);
+    /* with the tables of the lazy and word kernels */
+    test_calculate_domain_set<fields::alt_bn128_fr<254>>(10, 4);
+    test_calculate_domain_set<fields::small_prime_field<31>>(10, 4);
+    test_calculate_domain_set<fields::small_prime_field<62>>(10, 4);
+}
+
+BOOST_AUTO_TEST_CASE(fft_workspace) {
+    for (std::size_t m : {4, 96, 1024}) {
+        test_fft_workspace<fields::bls12<381>>(m);
+    }
+    test_fft_workspace<fields::mnt4<298>>(256);
+    /* the lazy kernel below and from the size of the four-step transform */
+    test_fft_workspace<fields::alt_bn128_fr<254>>(1024);
+    test_fft_workspace<fields::alt_bn128_fr<254>>(detail::basic_radix2_four_step_fft_threshold);
+    /* and the word kernel */
+    test_fft_workspace<fields::small_prime_field<31>>(1024);
+    test_fft_workspace<fields::small_prime_field<62>>(detail::basic_radix2_four_step_fft_threshold);
+}
+
+BOOST_AUTO_TEST_CASE(fft_span) {
+    for (std::size_t m : {4, 96, 1024}) {
+        test_fft_span<fields::bls12<381>>(m);
+    }
+    test_fft_span<fields::mnt4<298>>(256);
+}
+
+BOOST_AUTO_TEST_CASE(coset_vanishing_polynomial) {
+    typedef fields::bls12<381> FieldType;
+    typedef typename FieldType::value_type value_type;
+
+    const value_type g = fields::arithmetic_params<FieldType>::multiplicative_generator;
+    test_coset_vanishing_polynomial<FieldType>(std::make_shared<basic_radix2_domain<FieldType>>(8), 32, g);
+    test_coset_vanishing_polynomial<FieldType>(std::make_shared<basic_radix2_domain<FieldType>>(8), 32,
+                                               value_type::one());
+    test_coset_vanishing_polynomial<FieldType>(std::make_shared<basic_radix2_domain<FieldType>>(16), 4, g);
+    test_coset_vanishing_polynomial<FieldType>(std::make_shared<step_radix2_domain<FieldType>>(12), 32, g);
+    test_coset_vanishing_polynomial<FieldType>(std::make_shared<step_radix2_domain<FieldType>>(12), 32,
+                                               value_type::one());
+    test_coset_vanishing_polynomial<FieldType>(std::make_shared<geometric_sequence_domain<FieldType>>(5), 8, g);
+}
+
 BOOST_AUTO_TEST_CASE(compute_z) {
     test_compute_z<fields::bls12<381>>();
     test_compute_z<fields::mnt4<298>>();
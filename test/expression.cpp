@@ -35,6 +35,7 @@
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/expressions/expression.hpp>
 
 using namespace nil::crypto3::algebra;
@@ -82,4 +83,82 @@ BOOST_AUTO_TEST_CASE(expression_polynom_evaluation) {
     // }
 }
 
+BOOST_AUTO_TEST_CASE(expression_compiled_field_evaluation) {
+    typedef typename FieldType::value_type value_type;
+
+    const expressions::compiled_expression<value_type> e =
+        expressions::compile<value_type>("(x - y) + x * 100 - 2 * 3 / 4 + x ** 3 + pow(y, 2) / x");
+    BOOST_CHECK_EQUAL(e.variables().size(), 2);
+    BOOST_CHECK_EQUAL(e.size(), 10);
+
+    const value_type x = 505, y = 100;
+    const value_type expected = (x - y) + x * value_type(100) - value_type(6) * value_type(4).inversed() +
+                                x * x * x + y * y * x.inversed();
+
+    BOOST_CHECK_EQUAL(e.evaluate({{"x", x}, {"y", y}}).data, expected.data);
+    BOOST_CHECK_THROW(e.evaluate({{"x", x}}), std::invalid_argument);
+
+    const expressions::compiled_expression<value_type> constant = expressions::compile<value_type>("-(2 + 3) * 4");
+    BOOST_CHECK_EQUAL(constant.size(), 0);
+    BOOST_CHECK_EQUAL(constant.evaluate({}).data, (-value_type(20)).data);
+
+    BOOST_CHECK_THROW(expressions::compile<value_type>("sin(x)"), std::invalid_argument);
+    BOOST_CHECK_THROW(expressions::compile<value_type>("x ** y"), std::invalid_argument);
+    BOOST_CHECK_THROW(expressions::compile<value_type>("x + 0.5"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(expression_compiled_optimization) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::map<std::string, value_type> st = {{"a", value_type(3)}, {"b", value_type(5)}, {"c", value_type(7)}};
+
+    const expressions::compiled_expression<value_type> shared =
+        expressions::compile<value_type>("a * b + a * b * c + (b * a) ** 2");
+    BOOST_CHECK_EQUAL(shared.size(), 5);
+    BOOST_CHECK_EQUAL(shared.evaluate(st).data, value_type(15 + 105 + 225).data);
+
+    const expressions::compiled_expression<value_type> identities =
+        expressions::compile<value_type>("a * 1 + 0 + b / 1 - 0 - (-(-c))");
+    BOOST_CHECK_EQUAL(identities.size(), 2);
+    BOOST_CHECK_EQUAL(identities.evaluate(st).data, value_type(1).data);
+
+    const expressions::compiled_expression<value_type> zero = expressions::compile<value_type>("(a - a) * b + c ** 0");
+    BOOST_CHECK_EQUAL(zero.size(), 0);
+    BOOST_CHECK_EQUAL(zero.evaluate(st).data, value_type(1).data);
+
+    const expressions::compiled_expression<value_type> power = expressions::compile<value_type>("a ** 13 / 4");
+    BOOST_CHECK_EQUAL(power.size(), 6);
+    BOOST_CHECK_EQUAL(power.evaluate(st).data, (value_type(3).pow(13) * value_type(4).inversed()).data);
+
+    /* a chain keeps at most two values alive */
+    const expressions::compiled_expression<value_type> chain =
+        expressions::compile<value_type>("((a + b) * c + a) * b + c");
+    BOOST_CHECK_EQUAL(chain.size(), 5);
+    BOOST_CHECK_EQUAL(chain.registers(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(expression_compiled_column_evaluation) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = 256;
+    polynomial_dfs<value_type> a(n - 1, n), b(n - 1, n), c(n - 1, n);
+    for (std::size_t i = 0; i < n; i++) {
+        a[i] = value_type(i + 1);
+        b[i] = value_type(3 * i + 7);
+        c[i] = value_type(i * i);
+    }
+
+    const expressions::compiled_expression<value_type> e =
+        expressions::compile<value_type>("a * b * c - b / a + (a - c) * (a - c) - 5");
+    const std::vector<value_type> values =
+        e.evaluate(std::map<std::string, polynomial_dfs<value_type>> {{"a", a}, {"b", b}, {"c", c}});
+
+    BOOST_CHECK_EQUAL(values.size(), n);
+    for (std::size_t i = 0; i < n; i++) {
+        const value_type expected =
+            a[i] * b[i] * c[i] - b[i] * a[i].inversed() + (a[i] - c[i]) * (a[i] - c[i]) - value_type(5);
+        BOOST_CHECK_EQUAL(values[i].data, expected.data);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
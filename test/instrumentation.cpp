@@ -0,0 +1,168 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2022 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE instrumentation_test
+
+/* the counters are compiled in here whatever the build options are */
+#define CRYPTO3_MATH_INSTRUMENTATION
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+
+#include <nil/crypto3/math/instrumentation.hpp>
+#include <nil/crypto3/math/algorithms/batch_inverse.hpp>
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/polynomial/basic_operations.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+typedef fields::bls12_fr<381> FieldType;
+typedef typename FieldType::value_type value_type;
+
+/* the totals of the call sites of the name */
+instrumentation::counters totals(const std::string &name) {
+    instrumentation::counters result;
+    for (const instrumentation::site_counters &site : instrumentation::snapshot()) {
+        if (site.name == name) {
+            result.calls += site.totals.calls;
+            result.elements += site.totals.elements;
+            result.nanoseconds += site.totals.nanoseconds;
+            result.bytes += site.totals.bytes;
+        }
+    }
+    return result;
+}
+
+BOOST_AUTO_TEST_SUITE(instrumentation_test_suite)
+
+BOOST_AUTO_TEST_CASE(fft_counters) {
+    instrumentation::reset();
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(16);
+    std::vector<value_type> a(16, value_type(3));
+    domain->fft(a);
+    domain->fft(a);
+    domain->inverse_fft(a);
+
+    BOOST_CHECK_EQUAL(totals("make_evaluation_domain").calls, 1);
+    BOOST_CHECK_EQUAL(totals("basic_radix2_domain::fft").calls, 2);
+    BOOST_CHECK_EQUAL(totals("basic_radix2_domain::fft").elements, 32);
+    BOOST_CHECK_EQUAL(totals("basic_radix2_domain::inverse_fft").calls, 1);
+
+    instrumentation::reset();
+    BOOST_CHECK_EQUAL(totals("basic_radix2_domain::fft").calls, 0);
+
+    /* a workspace allocates on its first transform only */
+    typename evaluation_domain<FieldType>::workspace_type workspace;
+    domain->fft(a, workspace);
+    const std::uint64_t allocated = totals("basic_radix2_domain::fft").bytes;
+    BOOST_CHECK_GT(allocated, 0);
+    domain->fft(a, workspace);
+    BOOST_CHECK_EQUAL(totals("basic_radix2_domain::fft").bytes, allocated);
+
+    std::vector<value_type> b;
+    domain->fft(b, workspace);
+    BOOST_CHECK_EQUAL(totals("basic_radix2_domain::fft").bytes, allocated + b.capacity() * sizeof(value_type));
+}
+
+BOOST_AUTO_TEST_CASE(threads) {
+    instrumentation::reset();
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([]() {
+            for (std::size_t j = 0; j < 100; ++j) {
+                std::vector<value_type> v = {1, 2, 3};
+                batch_inverse(v);
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    BOOST_CHECK_EQUAL(totals("batch_inverse").calls, 400);
+    BOOST_CHECK_EQUAL(totals("batch_inverse").elements, 1200);
+
+    std::ostringstream out;
+    instrumentation::write_trace_events(out);
+    BOOST_CHECK(out.str().find("\"tid\":") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(hidden_conversions) {
+    instrumentation::reset();
+
+    polynomial_dfs<value_type> f(3, std::vector<value_type>(4, value_type(5)));
+    f.resize(16);
+    BOOST_CHECK_EQUAL(totals("polynomial_dfs::resize").calls, 1);
+    BOOST_CHECK_EQUAL(totals("polynomial_dfs::resize").bytes, 12 * sizeof(value_type));
+    BOOST_CHECK_EQUAL(totals("polynomial_dfs::extend").calls, 1);
+
+    std::vector<value_type> v = {1, 2, 3, 4};
+    batch_inverse(v);
+    BOOST_CHECK_EQUAL(totals("batch_inverse").elements, 4);
+
+    std::vector<value_type> q, r;
+    division(q, r, std::vector<value_type>({1, 2, 3, 4}), std::vector<value_type>({1, 1}));
+    BOOST_CHECK_EQUAL(totals("division").calls, 1);
+    BOOST_CHECK_EQUAL(totals("division").bytes, (q.capacity() + r.capacity()) * sizeof(value_type));
+
+    std::vector<value_type> c;
+    multiplication(c, std::vector<value_type>({1, 2, 3}), std::vector<value_type>({4, 5}));
+    BOOST_CHECK_GT(totals("multiplication").calls, 0);
+    BOOST_CHECK_GE(totals("multiplication").bytes, c.capacity() * sizeof(value_type));
+}
+
+BOOST_AUTO_TEST_CASE(trace_events) {
+    instrumentation::reset();
+
+    std::vector<value_type> v = {1, 2, 3};
+    batch_inverse(v);
+    batch_inverse(v);
+
+    std::ostringstream out;
+    instrumentation::write_trace_events(out);
+    const std::string trace = out.str();
+    BOOST_CHECK_EQUAL(trace.find("{\"traceEvents\":["), 0);
+    BOOST_CHECK(trace.find("\"name\":\"batch_inverse\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"ph\":\"X\"") != std::string::npos);
+
+    instrumentation::set_trace_capacity(0);
+    batch_inverse(v);
+    std::ostringstream empty;
+    instrumentation::write_trace_events(empty);
+    BOOST_CHECK_EQUAL(empty.str(), "{\"traceEvents\":[]}");
+    BOOST_CHECK_EQUAL(totals("batch_inverse").calls, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
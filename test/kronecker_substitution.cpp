@@ -51,7 +51,7 @@ BOOST_AUTO_TEST_CASE(standard_polynomial_multiplication) {
     std::vector<typename FieldType::value_type> b = {1, 2, 1, 1};
     std::vector<typename FieldType::value_type> c(1, FieldType::value_type::zero());
 
-    polynomial::multiplication_on_kronecker<FieldType>(c, a, b);
+    multiplication_on_kronecker<FieldType>(c, a, b);
 
     std::vector<typename FieldType::value_type> c_answer(1, FieldType::value_type::zero());
     multiplication(c_answer, a, b);
@@ -67,7 +67,7 @@ BOOST_AUTO_TEST_CASE(squared_polynomial_multiplication) {
     std::vector<typename FieldType::value_type> b = a;
     std::vector<typename FieldType::value_type> c(1, FieldType::value_type::zero());
 
-    polynomial::multiplication_on_kronecker<FieldType>(c, a, b);
+    multiplication_on_kronecker<FieldType>(c, a, b);
 
     std::vector<typename FieldType::value_type> c_answer(1, FieldType::value_type::zero());
     multiplication(c_answer, a, b);
@@ -77,4 +77,32 @@ BOOST_AUTO_TEST_CASE(squared_polynomial_multiplication) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(long_polynomial_multiplication) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> a(100), b(37);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        a[i] = -value_type(i * i + 3);
+    }
+    for (std::size_t i = 0; i < b.size(); i++) {
+        b[i] = -value_type(7 * i + 1);
+    }
+
+    for (const std::vector<value_type> *factor : {&b, &a}) {
+        std::vector<value_type> c_answer(a.size() + factor->size() - 1, value_type::zero());
+        for (std::size_t i = 0; i < a.size(); i++) {
+            for (std::size_t j = 0; j < factor->size(); j++) {
+                c_answer[i + j] += a[i] * (*factor)[j];
+            }
+        }
+
+        std::vector<value_type> c;
+        multiplication_on_kronecker<FieldType>(c, a, *factor);
+        BOOST_CHECK_EQUAL(c.size(), c_answer.size());
+        for (std::size_t i = 0; i < c_answer.size(); i++) {
+            BOOST_CHECK_EQUAL(c_answer[i].data, c[i].data);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
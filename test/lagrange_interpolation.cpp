@@ -66,4 +66,48 @@ BOOST_AUTO_TEST_CASE(polynomial_lagrange_interpolation_manual_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(polynomial_lagrange_interpolation_random_points) {
+    using field_type = fields::bls12_fr<381>;
+    using value_type = typename field_type::value_type;
+
+    for (std::size_t k : {1, 2, 3, 17, 100}) {
+        std::vector<std::pair<value_type, value_type>> points(k);
+        for (std::size_t j = 0; j < k; ++j) {
+            points[j] = std::make_pair(value_type(j * j + 3 * j + 1), value_type(7 * j + 5));
+        }
+
+        polynomial<value_type> p = lagrange_interpolation(points);
+
+        BOOST_CHECK(p.size() <= k);
+        for (std::size_t j = 0; j < k; ++j) {
+            BOOST_CHECK_EQUAL(p.evaluate(points[j].first).data, points[j].second.data);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_lagrange_interpolation_subgroup) {
+    using field_type = fields::bls12_fr<381>;
+    using value_type = typename field_type::value_type;
+
+    const std::size_t k = 64;
+    const value_type omega = unity_root<field_type>(k);
+
+    /* the same points in the order of the subgroup, which takes an inverse FFT, and reversed */
+    std::vector<std::pair<value_type, value_type>> points(k), reversed(k);
+    value_type x = value_type::one();
+    for (std::size_t j = 0; j < k; ++j) {
+        points[j] = std::make_pair(x, value_type(j * j + 2));
+        reversed[k - 1 - j] = points[j];
+        x *= omega;
+    }
+
+    polynomial<value_type> p = lagrange_interpolation(points);
+    polynomial<value_type> p_reversed = lagrange_interpolation(reversed);
+
+    BOOST_CHECK(p == p_reversed);
+    for (std::size_t j = 0; j < k; ++j) {
+        BOOST_CHECK_EQUAL(p.evaluate(points[j].first).data, points[j].second.data);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
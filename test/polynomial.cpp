@@ -35,6 +35,7 @@
 
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
 
+#include <nil/crypto3/math/arena.hpp>
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 
 using namespace nil::crypto3::algebra;
@@ -275,6 +276,36 @@ BOOST_AUTO_TEST_CASE(polynomial_multiplication_zero_b) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(polynomial_multiplication_karatsuba) {
+    typedef typename FieldType::value_type value_type;
+
+    for (std::size_t n : {3, 16, 40, 300}) {
+        for (std::size_t m : {1, 17, 40, 257}) {
+            polynomial<value_type> a(n), b(m);
+            for (std::size_t i = 0; i < n; i++) {
+                a[i] = value_type(i * i + 2 * i + 1);
+            }
+            for (std::size_t i = 0; i < m; i++) {
+                b[i] = value_type(5 * i + 3);
+            }
+
+            polynomial<value_type> c_ans(n + m - 1, value_type::zero()), s_ans(2 * n - 1, value_type::zero());
+            for (std::size_t i = 0; i < n; i++) {
+                for (std::size_t j = 0; j < m; j++) {
+                    c_ans[i + j] += a[i] * b[j];
+                }
+                for (std::size_t j = 0; j < n; j++) {
+                    s_ans[i + j] += a[i] * a[j];
+                }
+            }
+
+            BOOST_CHECK(a * b == c_ans);
+            BOOST_CHECK(b * a == c_ans);
+            BOOST_CHECK(a * a == s_ans);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(polynomial_division_test_suite)
@@ -364,4 +395,205 @@ BOOST_AUTO_TEST_CASE(polynomial_division_horner_long_equal) {
     }
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(polynomial_division_newton) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t threshold = detail::newton_division_threshold;
+    for (std::size_t a_size : {2 * threshold, 5 * threshold + 3}) {
+        for (std::size_t b_size : {threshold, 2 * threshold - 1, a_size}) {
+            polynomial<value_type> a(a_size), b(b_size);
+            for (std::size_t i = 0; i < a_size; i++) {
+                a[i] = value_type(i * i + 3 * i + 1);
+            }
+            for (std::size_t i = 0; i < b_size; i++) {
+                b[i] = value_type(7 * i + 2);
+            }
+
+            polynomial<value_type> Q, R, Q_long(Q), R_long(R);
+            newton_division(Q, R, a, b);
+
+            /* the long division, which division switches from at these sizes */
+            value_type c = b.back().inversed();
+            R_long = a;
+            Q_long = polynomial<value_type>(a_size, value_type::zero());
+            while (R_long.size() >= b_size && !R_long.is_zero()) {
+                const std::size_t shift = R_long.size() - b_size;
+                const value_type lead_coeff = R_long.back() * c;
+                Q_long[shift] = lead_coeff;
+                for (std::size_t i = 0; i < b_size; i++) {
+                    R_long[shift + i] -= b[i] * lead_coeff;
+                }
+                condense(R_long);
+            }
+            condense(Q_long);
+
+            BOOST_CHECK_EQUAL(Q_long.size(), Q.size());
+            BOOST_CHECK(std::equal(Q_long.begin(), Q_long.end(), Q.begin()));
+            BOOST_CHECK_EQUAL(R_long.size(), R.size());
+            BOOST_CHECK(std::equal(R_long.begin(), R_long.end(), R.begin()));
+            BOOST_CHECK(a / b == Q);
+            BOOST_CHECK(a % b == R);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_division_binomial_and_linear) {
+    typedef typename FieldType::value_type value_type;
+
+    polynomial<value_type> a(37);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        a[i] = value_type(i * i + 5 * i + 3);
+    }
+
+    for (std::size_t n : {1, 4, 16, 36, 37, 40}) {
+        const value_type c = value_type(n + 2);
+        polynomial<value_type> b(n + 1, value_type::zero());
+        b[0] = -c;
+        b[n] = value_type::one();
+
+        polynomial<value_type> Q, R;
+        division_by_binomial(Q, R, a, n, c);
+        BOOST_CHECK(Q * b + R == a);
+        BOOST_CHECK(R.size() <= std::max<std::size_t>(n, 1));
+        BOOST_CHECK(a.divide_by_binomial(n, c) == a / b);
+    }
+
+    const value_type z = value_type(11);
+    polynomial<value_type> Q;
+    const value_type remainder = division_by_linear(Q, a, z);
+    BOOST_CHECK_EQUAL(remainder.data, a.evaluate(z).data);
+    BOOST_CHECK(Q * polynomial<value_type>({-z, value_type::one()}) + polynomial<value_type>({remainder}) == a);
+    BOOST_CHECK(a.divide_by_linear(z) == Q);
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_reciprocal) {
+    typedef typename FieldType::value_type value_type;
+
+    const polynomial<value_type> a = {3, 1, 4, 1, 5, 9, 2, 6};
+    for (std::size_t n : {1, 2, 7, 100}) {
+        const polynomial<value_type> g = reciprocal(a, n);
+        BOOST_CHECK_EQUAL(g.size(), n);
+
+        polynomial<value_type> e = a * g;
+        e.resize(n);
+        BOOST_CHECK(e[0] == value_type::one());
+        BOOST_CHECK(std::all_of(e.begin() + 1, e.end(), [](const value_type &x) { return x.is_zero(); }));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(polynomial_evaluation_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_evaluate_many) {
+    typedef typename FieldType::value_type value_type;
+
+    polynomial<value_type> a(300);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        a[i] = value_type(3 * i * i + i + 7);
+    }
+
+    for (std::shared_ptr<thread_pool> pool : {std::shared_ptr<thread_pool>(), std::make_shared<thread_pool>(3)}) {
+        thread_pool::global() = pool;
+        for (std::size_t k : {0, 1, 5, 8, 17, 100}) {
+            std::vector<value_type> points(k);
+            for (std::size_t j = 0; j < k; j++) {
+                points[j] = value_type(5 * j * j + 2);
+            }
+
+            const std::vector<value_type> values = a.evaluate_many(points);
+            BOOST_CHECK_EQUAL(values.size(), k);
+            for (std::size_t j = 0; j < k; j++) {
+                BOOST_CHECK_EQUAL(values[j].data, a.evaluate(points[j]).data);
+            }
+        }
+    }
+    thread_pool::global().reset();
+
+    std::vector<value_type> points(70);
+    for (std::size_t j = 0; j < points.size(); j++) {
+        points[j] = value_type(j + 1);
+    }
+    std::vector<std::vector<std::vector<value_type>>> T;
+    compute_subproduct_tree<FieldType>(T, points);
+    const polynomial<value_type> b = {1, 2, 3};
+    const std::vector<value_type> a_values = a.evaluate_many(T), b_values = b.evaluate_many(T);
+    for (std::size_t j = 0; j < points.size(); j++) {
+        BOOST_CHECK_EQUAL(a_values[j].data, a.evaluate(points[j]).data);
+        BOOST_CHECK_EQUAL(b_values[j].data, b.evaluate(points[j]).data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_flat_subproduct_tree_basis_change) {
+    typedef typename FieldType::value_type value_type;
+
+    for (std::shared_ptr<thread_pool> pool : {std::shared_ptr<thread_pool>(), std::make_shared<thread_pool>(3)}) {
+        for (std::size_t n : {1, 2, 8, 64, 512}) {
+            std::vector<value_type> points(n);
+            for (std::size_t j = 0; j < n; j++) {
+                points[j] = value_type(3 * j * j + j + 4);
+            }
+
+            flat_subproduct_tree<FieldType> T;
+            compute_subproduct_tree<FieldType>(T, points, pool.get());
+
+            /* the root is the product of x - x_j of the nested tree, without its leading 1 */
+            std::vector<std::vector<std::vector<value_type>>> nested;
+            compute_subproduct_tree<FieldType>(nested, points);
+            for (std::size_t l = 0; l < n; l++) {
+                BOOST_CHECK_EQUAL(T.node(T.log_size, 0)[l].data, nested.back()[0][l].data);
+            }
+
+            polynomial<value_type> a(n);
+            for (std::size_t i = 0; i < n; i++) {
+                a[i] = value_type(7 * i * i + 2 * i + 5);
+            }
+
+            std::vector<value_type> b(a.begin(), a.end());
+            monomial_to_newton_basis<FieldType>(b, T, pool.get());
+
+            /* sum_k b_k prod_{l < k} (t - x_l) = a(t) */
+            const value_type t = value_type(1000003);
+            value_type newton = value_type::zero(), basis = value_type::one();
+            for (std::size_t k = 0; k < n; k++) {
+                newton += b[k] * basis;
+                basis *= t - points[k];
+            }
+            BOOST_CHECK_EQUAL(newton.data, a.evaluate(t).data);
+
+            newton_to_monomial_basis<FieldType>(b, T, pool.get());
+            for (std::size_t i = 0; i < n; i++) {
+                BOOST_CHECK_EQUAL(b[i].data, a[i].data);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polynomial_arena_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_arena_allocator) {
+    typedef typename FieldType::value_type value_type;
+    typedef polynomial<value_type, arena_allocator<value_type>> arena_polynomial;
+
+    arena memory;
+    arena::scope scope(memory);
+
+    const polynomial<value_type> a = {5, 0, 0, 13, 0, 1};
+    const polynomial<value_type> b = {13, 0, 1};
+    const arena_polynomial a_arena(a.begin(), a.end()), b_arena(b.begin(), b.end());
+    BOOST_CHECK(a_arena.get_allocator().resource() == &memory);
+
+    const std::vector<polynomial<value_type>> expected = {a + b, a - b, a * b, a / b, a % b, a * value_type(3)};
+    const std::vector<arena_polynomial> results = {a_arena + b_arena, a_arena - b_arena,
+                                                   a_arena * b_arena, a_arena / b_arena,
+                                                   a_arena % b_arena, a_arena * value_type(3)};
+
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        BOOST_CHECK_EQUAL(expected[i].size(), results[i].size());
+        BOOST_CHECK(std::equal(expected[i].begin(), expected[i].end(), results[i].begin()));
+        BOOST_CHECK(results[i].get_allocator().resource() == &memory);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -357,3 +357,48 @@ BOOST_AUTO_TEST_CASE(extended_gcd) {
         BOOST_CHECK_EQUAL(pv_ans[i].data, pv[i].data);
     }
 }
+
+BOOST_AUTO_TEST_CASE(extended_gcd_half_gcd) {
+    typedef typename ScalarFieldType::value_type value_type;
+
+    std::vector<value_type> f(400), h(301), common(20);
+    for (std::size_t i = 0; i < f.size(); i++) {
+        f[i] = value_type(7 * i * i + 3 * i + 1);
+    }
+    for (std::size_t i = 0; i < h.size(); i++) {
+        h[i] = value_type(i * i * i + 5);
+    }
+    for (std::size_t i = 0; i < common.size(); i++) {
+        common[i] = value_type(2 * i + 9);
+    }
+
+    std::vector<value_type> a, b;
+    multiplication(a, f, common);
+    multiplication(b, h, common);
+
+    std::vector<value_type> g, u, v;
+    extended_euclidean(a, b, g, u, v);
+
+    BOOST_CHECK_EQUAL(g.size(), common.size());
+    BOOST_CHECK(g.back() == value_type::one());
+    BOOST_CHECK(u.size() < b.size() - g.size() + 1);
+    BOOST_CHECK(v.size() < a.size() - g.size() + 1);
+
+    std::vector<value_type> au, bv, s, q, r;
+    multiplication(au, a, u);
+    multiplication(bv, b, v);
+    addition(s, au, bv);
+    BOOST_CHECK(s == g);
+
+    division(q, r, common, g);
+    BOOST_CHECK(is_zero(r));
+
+    std::vector<value_type> inverse, t;
+    inverse_modulo(inverse, f, h);
+    BOOST_CHECK(inverse.size() < h.size());
+    multiplication(t, f, inverse);
+    division(q, r, t, h);
+    BOOST_CHECK(r == std::vector<value_type>(1, value_type::one()));
+
+    BOOST_CHECK_THROW(inverse_modulo(inverse, a, b), std::invalid_argument);
+}
@@ -28,6 +28,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <type_traits>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -35,7 +36,11 @@
 
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
 
+#include <nil/crypto3/math/algorithms/calculate_domain_set.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/arena.hpp>
+#include <nil/crypto3/math/polynomial/fold.hpp>
+#include <nil/crypto3/math/polynomial/grand_product.hpp>
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/polynomial/shift.hpp>
@@ -110,6 +115,100 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_coefficients_same_degree) {
 }
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_extend_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_extend) {
+    std::vector<typename FieldType::value_type> a_coefficients = {1, 3, 4, 25, 6, 7, 7};
+
+    for (std::size_t k = 0; k <= 3; k++) {
+        polynomial_dfs<typename FieldType::value_type> a;
+        a.from_coefficients(a_coefficients);
+        a.extend(k);
+
+        std::vector<typename FieldType::value_type> padded(a_coefficients);
+        padded.resize(8 << k, 0);
+        polynomial_dfs<typename FieldType::value_type> a_ans;
+        a_ans.from_coefficients(padded);
+
+        BOOST_CHECK_EQUAL(a_ans.size(), a.size());
+        for (std::size_t i = 0; i < a.size(); i++) {
+            BOOST_CHECK_EQUAL(a_ans[i].data, a[i].data);
+        }
+        BOOST_CHECK_EQUAL(a_coefficients.size() - 1, a.degree());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_extend_batch) {
+    std::vector<std::vector<typename FieldType::value_type>> coefficients = {
+        {1, 3, 4, 25, 6, 7, 7}, {2, 1}, {5, 0, 0, 11, 3}, {9}};
+
+    std::vector<polynomial_dfs<typename FieldType::value_type>> polys(coefficients.size());
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        polys[p].from_coefficients(coefficients[p]);
+    }
+    std::vector<std::size_t> sizes;
+    for (const polynomial_dfs<typename FieldType::value_type> &a : polys) {
+        sizes.push_back(a.size());
+    }
+
+    polynomial_dfs<typename FieldType::value_type>::extend_batch(polys, 2);
+
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        std::vector<typename FieldType::value_type> padded(coefficients[p]);
+        padded.resize(sizes[p] << 2, 0);
+        polynomial_dfs<typename FieldType::value_type> a_ans;
+        a_ans.from_coefficients(padded);
+
+        BOOST_CHECK_EQUAL(a_ans.size(), polys[p].size());
+        for (std::size_t i = 0; i < a_ans.size(); i++) {
+            BOOST_CHECK_EQUAL(a_ans[i].data, polys[p][i].data);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_evaluate_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate) {
+    std::vector<typename FieldType::value_type> a_coefficients = {1, 3, 4, 25, 6, 7, 7};
+    polynomial<typename FieldType::value_type> a_ans(a_coefficients);
+
+    polynomial_dfs<typename FieldType::value_type> a;
+    a.from_coefficients(a_coefficients);
+
+    const typename FieldType::value_type omega = unity_root<FieldType>(a.size());
+    std::vector<typename FieldType::value_type> points = {0, 1, 2, 123456789, omega, omega.pow(5), -omega};
+    for (const typename FieldType::value_type &x : points) {
+        BOOST_CHECK_EQUAL(a_ans.evaluate(x).data, a.evaluate(x).data);
+    }
+
+    polynomial_dfs<typename FieldType::value_type> c = {0, {typename FieldType::value_type(42)}};
+    BOOST_CHECK_EQUAL(c.evaluate(7).data, typename FieldType::value_type(42).data);
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_batch) {
+    std::vector<std::vector<typename FieldType::value_type>> coefficients = {
+        {1, 3, 4, 25, 6, 7, 7}, {2, 1}, {5, 0, 0, 11, 3}, {9}, {8, 1, 4, 4, 0, 2, 3, 1}};
+
+    std::vector<polynomial_dfs<typename FieldType::value_type>> polys(coefficients.size());
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        polys[p].from_coefficients(coefficients[p]);
+    }
+
+    const typename FieldType::value_type x = 987654321;
+    std::vector<typename FieldType::value_type> result =
+        polynomial_dfs<typename FieldType::value_type>::evaluate_batch(polys, x);
+
+    BOOST_CHECK_EQUAL(result.size(), polys.size());
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        polynomial<typename FieldType::value_type> a_ans(coefficients[p]);
+        BOOST_CHECK_EQUAL(a_ans.evaluate(x).data, result[p].data);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE(polynomial_dfs_addition_test_suite)
 
 BOOST_AUTO_TEST_CASE(polynomial_dfs_addition_equal) {
@@ -578,6 +677,154 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_multiplication_resize_both) {
 }
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_product_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_product) {
+    std::vector<std::vector<typename FieldType::value_type>> coefficients = {
+        {1, 3, 4, 25, 6, 7, 7}, {2, 1}, {5, 0, 0, 11, 3}, {9}, {1, 3, 4, 25, 6, 7, 7}};
+
+    std::vector<polynomial_dfs<typename FieldType::value_type>> factors(coefficients.size());
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        factors[p].from_coefficients(coefficients[p]);
+    }
+    factors.push_back(factors[1]);
+    coefficients.push_back(coefficients[1]);
+
+    polynomial<typename FieldType::value_type> expected({1});
+    polynomial_dfs<typename FieldType::value_type> pairwise = factors[0];
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        expected = expected * polynomial<typename FieldType::value_type>(coefficients[p]);
+        if (p > 0) {
+            pairwise = pairwise * factors[p];
+        }
+    }
+
+    polynomial_dfs<typename FieldType::value_type> c =
+        polynomial_dfs<typename FieldType::value_type>::product(factors);
+    polynomial_dfs<typename FieldType::value_type> c_res;
+    c_res.from_coefficients(std::vector<typename FieldType::value_type>(expected.begin(), expected.end()));
+
+    BOOST_CHECK_EQUAL(expected.size() - 1, c.degree());
+    BOOST_CHECK_EQUAL(c_res.size(), c.size());
+    BOOST_CHECK_EQUAL(pairwise.size(), c.size());
+    for (std::size_t i = 0; i < c_res.size(); i++) {
+        BOOST_CHECK_EQUAL(c_res[i].data, c[i].data);
+        BOOST_CHECK_EQUAL(pairwise[i].data, c[i].data);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_expression_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_expression_gate) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<std::vector<value_type>> coefficients = {
+        {1, 3, 4, 25, 6, 7, 7}, {2, 1}, {5, 0, 0, 11, 3}, {9, 8, 7, 6, 5, 4, 3, 2}, {4, 4}, {1, 2, 3}, {0, 0, 5}};
+    std::vector<polynomial_dfs<value_type>> polys(coefficients.size());
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        polys[p].from_coefficients(coefficients[p]);
+    }
+    const polynomial_dfs<value_type> &q_l = polys[0], &q_r = polys[1], &q_m = polys[2], &q_o = polys[3],
+                                     &q_c = polys[4], &a = polys[5], &b = polys[6];
+    const value_type c = 11;
+
+    polynomial_dfs<value_type> r =
+        make_expression(q_l) * a + make_expression(q_r) * b + make_expression(q_m) * a * b + q_o * c + q_c - a;
+    BOOST_CHECK(r == q_l * a + q_r * b + q_m * a * b + q_o * c + q_c - a);
+    BOOST_CHECK((std::is_same<decltype(q_l * a + c), polynomial_dfs<value_type>>::value));
+
+    polynomial<value_type> expected = polynomial<value_type>(coefficients[0]) * polynomial<value_type>(coefficients[5]) +
+                                      polynomial<value_type>(coefficients[1]) * polynomial<value_type>(coefficients[6]) +
+                                      polynomial<value_type>(coefficients[2]) * polynomial<value_type>(coefficients[5]) *
+                                          polynomial<value_type>(coefficients[6]) +
+                                      polynomial<value_type>(coefficients[3]) * c +
+                                      polynomial<value_type>(coefficients[4]) - polynomial<value_type>(coefficients[5]);
+
+    polynomial_dfs<value_type> r_res;
+    r_res.from_coefficients(std::vector<value_type>(expected.begin(), expected.end()));
+    r_res.resize(r.size());
+
+    BOOST_CHECK_EQUAL(r.degree(), 8);
+    BOOST_CHECK_EQUAL(r.size(), 16);
+    for (std::size_t i = 0; i < r.size(); i++) {
+        BOOST_CHECK_EQUAL(r_res[i].data, r[i].data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_expression_aliasing) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> a_coefficients = {1, 3, 4, 25, 6, 7, 7};
+    polynomial_dfs<value_type> a, a_res;
+    a.from_coefficients(a_coefficients);
+    polynomial_dfs<value_type> b = a;
+
+    a = make_expression(a) * a - a;
+    a_res = b * b;
+    a_res = a_res - b;
+
+    BOOST_CHECK_EQUAL(a_res.size(), a.size());
+    BOOST_CHECK_EQUAL(a_res.degree(), a.degree());
+    for (std::size_t i = 0; i < a.size(); i++) {
+        BOOST_CHECK_EQUAL(a_res[i].data, a[i].data);
+    }
+
+    b = -make_expression(b) + value_type(1);
+    BOOST_CHECK_EQUAL(b.evaluate(value_type(2)).data,
+                      (value_type(1) - polynomial<value_type>(a_coefficients).evaluate(value_type(2))).data);
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_in_place_operators) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<std::vector<value_type>> coefficients = {{1, 3, 4, 25}, {2, 1}, {5, 0, 0, 11, 3, 1}, {9, 8}};
+    std::vector<polynomial_dfs<value_type>> columns(coefficients.size());
+    for (std::size_t p = 0; p < coefficients.size(); p++) {
+        columns[p].from_coefficients(coefficients[p]);
+        columns[p].resize(8);
+    }
+    const std::vector<value_type> c = {3, 7, 11, 13};
+
+    polynomial_dfs<value_type> combination(0, 8), expected(0, 8);
+    for (std::size_t p = 0; p < columns.size(); p++) {
+        combination.axpy(c[p], columns[p]);
+        expected = expected + c[p] * columns[p];
+    }
+    BOOST_CHECK_EQUAL(combination.degree(), expected.degree());
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), combination.begin()));
+
+    polynomial_dfs<value_type> a = columns[0];
+    a += columns[1];
+    a -= columns[2];
+    a *= columns[3];
+    a *= value_type(5);
+    expected = (columns[0] + columns[1] - columns[2]) * columns[3] * value_type(5);
+    BOOST_CHECK_EQUAL(a.size(), 8);
+    BOOST_CHECK_EQUAL(a.degree(), expected.degree());
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), a.begin()));
+
+    /* the product no longer fits the domain: the operands get extended */
+    a *= columns[2];
+    expected = expected * columns[2];
+    BOOST_CHECK_EQUAL(a.size(), 16);
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), a.begin()));
+
+    /* operands of another size */
+    polynomial_dfs<value_type> b;
+    b.from_coefficients(coefficients[1]);
+    b += columns[0];
+    expected = columns[0] + columns[1];
+    BOOST_CHECK_EQUAL(b.size(), 8);
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), b.begin()));
+
+    b -= b;
+    BOOST_CHECK(std::all_of(b.begin(), b.end(), [](const value_type& x) { return x.is_zero(); }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE(polynomial_dfs_division_test_suite)
 
 BOOST_AUTO_TEST_CASE(polynomial_dfs_division) {
@@ -635,6 +882,49 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_division) {
     BOOST_CHECK_EQUAL(R_ans.degree(), R.degree());
 }
 
+BOOST_AUTO_TEST_CASE(polynomial_dfs_division_by_vanishing_and_linear) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = 16, size = 64;
+    const value_type omega = unity_root<FieldType>(size);
+    const value_type shift = value_type(fields::arithmetic_params<FieldType>::multiplicative_generator);
+    const value_type z = value_type(12345);
+
+    polynomial<value_type> q(21);
+    for (std::size_t i = 0; i < q.size(); i++) {
+        q[i] = value_type(3 * i * i + 1);
+    }
+    polynomial<value_type> z_h(n + 1, value_type::zero());
+    z_h[0] = -value_type::one();
+    z_h[n] = value_type::one();
+    const polynomial<value_type> numerator = q * z_h;
+    const polynomial<value_type> opening = q * polynomial<value_type>({-z, value_type::one()});
+
+    /* the numerator on the coset shift * D of the extended domain D, the opening on D */
+    polynomial_dfs<value_type> numerator_dfs(numerator.degree(), size), opening_dfs(opening.degree(), size);
+    std::vector<value_type> q_on_coset(size), q_on_domain(size);
+    value_type x = value_type::one();
+    for (std::size_t i = 0; i < size; i++) {
+        numerator_dfs[i] = numerator.evaluate(shift * x);
+        opening_dfs[i] = opening.evaluate(x);
+        q_on_coset[i] = q.evaluate(shift * x);
+        q_on_domain[i] = q.evaluate(x);
+        x *= omega;
+    }
+
+    const polynomial_dfs<value_type> quotient = numerator_dfs.divide_by_binomial(n, value_type::one(), shift);
+    BOOST_CHECK_EQUAL(quotient.degree(), q.degree());
+    for (std::size_t i = 0; i < size; i++) {
+        BOOST_CHECK_EQUAL(q_on_coset[i].data, quotient[i].data);
+    }
+
+    const polynomial_dfs<value_type> opening_quotient = opening_dfs.divide_by_linear(z);
+    BOOST_CHECK_EQUAL(opening_quotient.degree(), q.degree());
+    for (std::size_t i = 0; i < size; i++) {
+        BOOST_CHECK_EQUAL(q_on_domain[i].data, opening_quotient[i].data);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(polynomial_dfs_shift) {
     
     polynomial_dfs<typename FieldType::value_type> a = {
@@ -689,4 +979,322 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_shift) {
     }
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(polynomial_dfs_shift_view) {
+    typedef typename FieldType::value_type value_type;
+
+    polynomial_dfs<value_type> a = {7, {1, 2, 3, 4, 5, 6, 7, 8}};
+    polynomial_dfs<value_type> b(15, 16);
+    for (std::size_t i = 0; i < b.size(); i++) {
+        b[i] = value_type(3 * i + 1);
+    }
+
+    for (int shift : {-9, -1, 0, 1, 3, 8}) {
+        const polynomial_dfs<value_type> shifted = polynomial_shift(a, shift);
+        const polynomial_dfs_leaf<value_type> view = polynomial_shift_view(a, shift);
+        BOOST_CHECK_EQUAL(view.size(), a.size());
+        for (std::size_t i = 0; i < a.size(); i++) {
+            BOOST_CHECK_EQUAL(view[i].data, shifted[i].data);
+        }
+
+        /* rotated on the domain of the result, of the size 16 */
+        polynomial_dfs<value_type> extended = a;
+        extended.resize(16);
+        const polynomial_dfs<value_type> expected = polynomial_shift(extended, shift, 8) * b - a;
+        const polynomial_dfs<value_type> c = polynomial_shift_view(a, shift) * b - a;
+        BOOST_CHECK_EQUAL(c.size(), expected.size());
+        for (std::size_t i = 0; i < c.size(); i++) {
+            BOOST_CHECK_EQUAL(c[i].data, expected[i].data);
+        }
+    }
+
+    /* in place, the rotated operand is read before it is overwritten */
+    const polynomial_dfs<value_type> expected = a + polynomial_shift(a, 1);
+    a = a + polynomial_shift_view(a, 1);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        BOOST_CHECK_EQUAL(a[i].data, expected[i].data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_shift_bit_reversed) {
+    typedef typename FieldType::value_type value_type;
+
+    const polynomial_dfs<value_type> a = {7, {1, 2, 3, 4, 5, 6, 7, 8}};
+    polynomial_dfs<value_type> a_reversed = a;
+    a_reversed.reorder(evaluation_order::bit_reversed);
+
+    /* the rotation reads a copy of the bit-reversed operand in the natural order */
+    for (int shift : {-1, 1, 3}) {
+        const polynomial_dfs<value_type> expected = polynomial_shift(a, shift);
+        const polynomial_dfs<value_type> shifted = polynomial_shift(a_reversed, shift);
+        BOOST_CHECK(shifted.order() == evaluation_order::natural);
+        BOOST_CHECK(std::equal(shifted.begin(), shifted.end(), expected.begin(), expected.end()));
+
+        const polynomial_dfs<value_type> c = polynomial_shift_view(a_reversed, shift) + a_reversed;
+        const polynomial_dfs<value_type> c_natural = expected + a;
+        BOOST_CHECK(c.order() == evaluation_order::natural);
+        BOOST_CHECK(std::equal(c.begin(), c.end(), c_natural.begin(), c_natural.end()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_equality) {
+    typedef typename FieldType::value_type value_type;
+
+    const polynomial_dfs<value_type> a = {7, {1, 2, 3, 4, 5, 6, 7, 8}};
+    polynomial_dfs<value_type> a_reversed = a;
+    a_reversed.reorder(evaluation_order::bit_reversed);
+
+    /* the values are compared in the natural order */
+    BOOST_CHECK(a == a_reversed);
+    BOOST_CHECK(!(a != a_reversed));
+
+    /* the same values in different orders are different polynomials */
+    const polynomial_dfs<value_type> b(7, a_reversed.begin(), a_reversed.end());
+    BOOST_CHECK(a != b);
+    BOOST_CHECK(b != a_reversed);
+
+    const polynomial_dfs<value_type> c = {6, {1, 2, 3, 4, 5, 6, 7, 8}};
+    BOOST_CHECK(a != c);
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_bit_reversed_order) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> a_coefficients(13), b_coefficients(20);
+    for (std::size_t i = 0; i < a_coefficients.size(); i++) {
+        a_coefficients[i] = value_type(i * i + 3);
+    }
+    for (std::size_t i = 0; i < b_coefficients.size(); i++) {
+        b_coefficients[i] = value_type(7 * i + 1);
+    }
+
+    polynomial_dfs<value_type> a, b, a_natural, b_natural;
+    a.from_coefficients(a_coefficients, evaluation_order::bit_reversed);
+    b.from_coefficients(b_coefficients, evaluation_order::bit_reversed);
+    a_natural.from_coefficients(a_coefficients);
+    b_natural.from_coefficients(b_coefficients);
+    BOOST_CHECK(a.order() == evaluation_order::bit_reversed);
+    BOOST_CHECK(a.coefficients() == a_natural.coefficients());
+
+    /* a round trip of operands of the same size and order takes no permutation */
+    b.resize(32);
+    b.reorder(evaluation_order::bit_reversed);
+    a.resize(32);
+    a.reorder(evaluation_order::bit_reversed);
+    const polynomial_dfs<value_type> c = a * b - b + value_type(2);
+    BOOST_CHECK(c.order() == evaluation_order::bit_reversed);
+
+    const polynomial_dfs<value_type> c_natural = a_natural * b_natural - b_natural + value_type(2);
+    BOOST_CHECK(c.coefficients() == c_natural.coefficients());
+    BOOST_CHECK_EQUAL(c.evaluate(value_type(11)).data, c_natural.evaluate(value_type(11)).data);
+
+    /* a mixed expression goes back to the natural order */
+    const polynomial_dfs<value_type> d = a * b_natural;
+    const polynomial_dfs<value_type> d_natural = a_natural * b_natural;
+    BOOST_CHECK(d.order() == evaluation_order::natural);
+    BOOST_CHECK(std::equal(d.begin(), d.end(), d_natural.begin(), d_natural.end()));
+
+    /* divisions through the values keep the order */
+    const value_type z = value_type(11);
+    const polynomial_dfs<value_type> r = polynomial_dfs<value_type>(c - c.evaluate(z)).divide_by_linear(z);
+    const polynomial_dfs<value_type> r_natural =
+        polynomial_dfs<value_type>(c_natural - c_natural.evaluate(z)).divide_by_linear(z);
+    BOOST_CHECK(r.order() == evaluation_order::bit_reversed);
+    BOOST_CHECK(r.coefficients() == r_natural.coefficients());
+
+    polynomial_dfs<value_type> z_4;
+    z_4.from_coefficients(std::vector<value_type> {-value_type::one(), 0, 0, 0, value_type::one()});
+    polynomial_dfs<value_type> p = c * z_4;
+    const polynomial_dfs<value_type> s_natural = p.divide_by_binomial(4, value_type::one(), value_type(5));
+    p.reorder(evaluation_order::bit_reversed);
+    polynomial_dfs<value_type> s = p.divide_by_binomial(4, value_type::one(), value_type(5));
+    BOOST_CHECK(s.order() == evaluation_order::bit_reversed);
+    s.reorder(evaluation_order::natural);
+    BOOST_CHECK(std::equal(s.begin(), s.end(), s_natural.begin(), s_natural.end()));
+
+    polynomial_dfs<value_type> reordered = c;
+    reordered.reorder(evaluation_order::natural);
+    BOOST_CHECK(std::equal(reordered.begin(), reordered.end(), c_natural.begin(), c_natural.end()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_arena_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_arena_allocator) {
+    typedef typename FieldType::value_type value_type;
+    typedef polynomial_dfs<value_type, arena_allocator<value_type>> arena_polynomial_dfs;
+
+    const std::vector<value_type> a_coefficients = {1, 3, 4, 25, 6, 7, 7, 2};
+    const std::vector<value_type> b_coefficients = {3, 0, 5, 1};
+
+    polynomial_dfs<value_type> a, b;
+    a.from_coefficients(a_coefficients);
+    b.from_coefficients(b_coefficients);
+
+    arena memory(1 << 10);
+    std::size_t capacity = 0;
+    for (std::size_t round = 0; round < 2; round++) {
+        {
+            arena::scope scope(memory);
+
+            arena_polynomial_dfs a_arena, b_arena;
+            a_arena.from_coefficients(a_coefficients);
+            b_arena.from_coefficients(b_coefficients);
+            BOOST_CHECK(a_arena.get_allocator().resource() == &memory);
+
+            polynomial_dfs<value_type> expected = a * b + a;
+            arena_polynomial_dfs c = a_arena * b_arena + a_arena;
+            BOOST_CHECK_EQUAL(expected.degree(), c.degree());
+            BOOST_CHECK(std::equal(expected.begin(), expected.end(), c.begin()));
+
+            expected = a / b;
+            c = a_arena / b_arena;
+            BOOST_CHECK_EQUAL(expected.degree(), c.degree());
+            BOOST_CHECK(std::equal(expected.begin(), expected.end(), c.begin()));
+
+            expected = a % b;
+            c = a_arena % b_arena;
+            BOOST_CHECK_EQUAL(expected.degree(), c.degree());
+            BOOST_CHECK(std::equal(expected.begin(), expected.end(), c.begin()));
+
+            expected = a;
+            expected.resize(4);
+            c = a_arena;
+            c.resize(4);
+            BOOST_CHECK(std::equal(expected.begin(), expected.end(), c.begin()));
+        }
+
+        BOOST_CHECK(memory.capacity() > 0);
+        if (round == 0) {
+            capacity = memory.capacity();
+        } else {
+            /* the second round reuses the blocks of the first one */
+            BOOST_CHECK_EQUAL(capacity, memory.capacity());
+        }
+        memory.reset();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_fold_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_fold) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = 32;
+    std::vector<value_type> coefficients(16);
+    for (std::size_t i = 0; i < coefficients.size(); i++) {
+        coefficients[i] = value_type(i * i + 5 * i + 1);
+    }
+    const value_type beta = 0x1234567_cppui253, shift = 7;
+    const value_type omega = unity_root<FieldType>(n);
+
+    /* the values of f on the coset shift * D */
+    const polynomial<value_type> f_coefficients(coefficients);
+    polynomial_dfs<value_type> f(coefficients.size() - 1, n);
+    for (std::size_t i = 0; i < n; i++) {
+        f[i] = f_coefficients.evaluate(shift * omega.pow(i));
+    }
+
+    std::vector<std::shared_ptr<evaluation_domain<FieldType>>> domain_set = calculate_domain_set<FieldType>(6, 3);
+    for (std::size_t k : {2, 4, 8}) {
+        std::vector<value_type> folded_coefficients(coefficients.size() / k);
+        for (std::size_t j = 0; j < folded_coefficients.size(); j++) {
+            for (std::size_t t = 0; t < k; t++) {
+                folded_coefficients[j] += beta.pow(t) * coefficients[j * k + t];
+            }
+        }
+        const polynomial<value_type> g(folded_coefficients);
+        const value_type g_omega = omega.pow(k), g_shift = shift.pow(k);
+
+        polynomial_dfs<value_type> folded = fold(f, beta, shift, k);
+        BOOST_CHECK_EQUAL(folded.size(), n / k);
+        BOOST_CHECK_EQUAL(folded.degree(), 15 / k);
+        for (std::size_t i = 0; i < folded.size(); i++) {
+            BOOST_CHECK_EQUAL(g.evaluate(g_shift * g_omega.pow(i)).data, folded[i].data);
+        }
+
+        /* with the twiddles of a larger domain, in the bit-reversed order */
+        polynomial_dfs<value_type> f_reversed = f;
+        f_reversed.reorder(evaluation_order::bit_reversed);
+        polynomial_dfs<value_type> folded_reversed = fold(f_reversed, beta, shift, k, domain_set[0]);
+        BOOST_CHECK(folded_reversed.order() == evaluation_order::bit_reversed);
+        folded_reversed.reorder(evaluation_order::natural);
+        BOOST_CHECK(std::equal(folded.begin(), folded.end(), folded_reversed.begin()));
+    }
+
+    /* a fold by 4 is two folds by 2, by beta and beta^2 */
+    polynomial_dfs<value_type> twice = fold(fold(f, beta, shift), beta.squared(), shift.squared());
+    polynomial_dfs<value_type> once = fold(f, beta, shift, 4);
+    BOOST_CHECK(std::equal(once.begin(), once.end(), twice.begin()));
+
+    BOOST_CHECK_THROW(fold(f, beta, shift, 3), std::invalid_argument);
+    BOOST_CHECK_THROW(fold(f, beta, shift, 2, domain_set[2]), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_grand_product_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_grand_product) {
+    typedef typename FieldType::value_type value_type;
+
+    const value_type beta = 0x1234567_cppui253, gamma = 0x89abcde_cppui253;
+    for (std::shared_ptr<thread_pool> pool : {std::shared_ptr<thread_pool>(), std::make_shared<thread_pool>(3)}) {
+        thread_pool::global() = pool;
+        for (std::size_t n : {1, 2, 16, 1 << 14}) {
+            const value_type omega = unity_root<FieldType>(n);
+            const std::size_t m = std::max<std::size_t>(n / 2, 1);
+            polynomial_dfs<value_type> w(n - 1, n), id(n - 1, n), sigma(n - 1, n), v(m - 1, m);
+            for (std::size_t i = 0; i < n; i++) {
+                w[i] = value_type(i * i + 3 * i + 1);
+                id[i] = omega.pow(i);
+                sigma[i] = omega.pow((5 * i + 1) % n);
+            }
+            for (std::size_t i = 0; i < v.size(); i++) {
+                v[i] = value_type(2 * i + 9);
+            }
+            polynomial_dfs<value_type> v_extended = v;
+            v_extended.resize(n);
+
+            const polynomial_dfs<value_type> z =
+                grand_product((make_expression(w) + beta * id + gamma) * (make_expression(v) + gamma),
+                              (make_expression(w) + beta * sigma + gamma) * (make_expression(v) + gamma));
+            BOOST_CHECK_EQUAL(z.size(), n);
+            value_type expected = value_type::one();
+            for (std::size_t i = 0; i < n; i++) {
+                BOOST_CHECK_EQUAL(z[i].data, expected.data);
+                expected *= (w[i] + beta * id[i] + gamma) * (v_extended[i] + gamma) *
+                            ((w[i] + beta * sigma[i] + gamma) * (v_extended[i] + gamma)).inversed();
+            }
+
+            /* operands in the bit-reversed order give the values in the natural order */
+            polynomial_dfs<value_type> w_reversed = w;
+            w_reversed.reorder(evaluation_order::bit_reversed);
+            const polynomial_dfs<value_type> z_reversed =
+                grand_product(make_expression(w_reversed) + gamma, make_expression(w) + beta);
+            const polynomial_dfs<value_type> z_plain =
+                grand_product(make_expression(w) + gamma, make_expression(w) + beta);
+            BOOST_CHECK(z_reversed.order() == evaluation_order::natural);
+            BOOST_CHECK(std::equal(z_plain.begin(), z_plain.end(), z_reversed.begin()));
+        }
+    }
+    thread_pool::global().reset();
+
+    /* the ratios of a permutation of the values multiply to one */
+    std::vector<value_type> numerator(128);
+    for (std::size_t i = 0; i < numerator.size(); i++) {
+        numerator[i] = value_type(7 * i + 2);
+    }
+    const std::vector<value_type> denominator(numerator.rbegin(), numerator.rend());
+    const polynomial_dfs<value_type> z = grand_product(numerator, denominator);
+    BOOST_CHECK_EQUAL((z[127] * numerator[127] * denominator[127].inversed()).data, value_type::one().data);
+
+    std::vector<value_type> zeros = denominator;
+    zeros[50] = value_type::zero();
+    BOOST_CHECK_THROW(grand_product(numerator, zeros), std::invalid_argument);
+    BOOST_CHECK_THROW(grand_product(numerator, std::vector<value_type>(64, 1)), std::invalid_argument);
+    BOOST_CHECK_THROW(grand_product(std::vector<value_type>(), std::vector<value_type>()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
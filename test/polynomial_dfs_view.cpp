@@ -26,6 +26,8 @@
 
 #define BOOST_TEST_MODULE polynomial_dfs_view_test
 
+#include <cstdio>
+#include <fstream>
 #include <vector>
 #include <cstdint>
 
@@ -35,7 +37,9 @@
 
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
 
+#include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial_dfs_view.hpp>
+#include <nil/crypto3/math/serialization.hpp>
 
 using namespace nil::crypto3::algebra;
 using namespace nil::crypto3::math;
@@ -579,6 +583,65 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_view_multiplication_resize_both) {
 }
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_view_expression_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_view_expression) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> a_coefficients = {1, 3, 4, 25, 6, 7, 7};
+    std::vector<value_type> b_coefficients = {2, 1};
+    std::vector<value_type> a_v, b_v, c_v;
+    polynomial_dfs_view<value_type> a = {0, a_v}, b = {0, b_v}, c = {0, c_v};
+    a.from_coefficients(a_coefficients);
+    b.from_coefficients(b_coefficients);
+
+    c = make_expression(a) * b - b + value_type(3);
+
+    polynomial<value_type> expected =
+        polynomial<value_type>(a_coefficients) * polynomial<value_type>(b_coefficients) -
+        polynomial<value_type>(b_coefficients) + polynomial<value_type>({3});
+    polynomial_dfs<value_type> c_res;
+    c_res.from_coefficients(std::vector<value_type>(expected.begin(), expected.end()));
+    c_res.resize(c.size());
+
+    BOOST_CHECK_EQUAL(c.degree(), 7);
+    BOOST_CHECK_EQUAL(c_res.size(), c_v.size());
+    for (std::size_t i = 0; i < c_v.size(); i++) {
+        BOOST_CHECK_EQUAL(c_res[i].data, c_v[i].data);
+    }
+    BOOST_CHECK(c_res == a * b - b + value_type(3));
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_view_in_place_operators) {
+    typedef typename FieldType::value_type value_type;
+
+    std::vector<value_type> a_coefficients = {1, 3, 4, 25};
+    std::vector<value_type> b_coefficients = {2, 1, 5};
+    std::vector<value_type> a_v, b_v;
+    polynomial_dfs_view<value_type> a = {0, a_v}, b = {0, b_v};
+    a.from_coefficients(a_coefficients);
+    b.from_coefficients(b_coefficients);
+    a.resize(8);
+    b.resize(8);
+
+    polynomial_dfs<value_type> expected = (a + b) * b * value_type(3) - a;
+    std::vector<value_type> a_copy = a_v;
+    polynomial_dfs_view<value_type> a_orig = {3, a_copy};
+    a += b;
+    a *= b;
+    a *= value_type(3);
+    a -= a_orig;
+    BOOST_CHECK_EQUAL(a.degree(), expected.degree());
+    BOOST_CHECK_EQUAL(a_v.size(), 8);
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), a_v.begin()));
+
+    expected = expected + value_type(7) * b;
+    a.axpy(value_type(7), b);
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), a_v.begin()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE(polynomial_dfs_view_division_test_suite)
 
 BOOST_AUTO_TEST_CASE(polynomial_dfs_view_division) {
@@ -656,4 +719,71 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_view_modulus) {
     BOOST_CHECK_EQUAL(r_ans.degree(), a.degree());
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(polynomial_dfs_view_serialization_test_suite)
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_view_mapped_archive) {
+    typedef typename FieldType::value_type value_type;
+
+    const std::size_t n = 256;
+    polynomial_dfs<value_type> a(n - 1, n), b(3, n);
+    for (std::size_t i = 0; i < n; i++) {
+        a[i] = value_type(i * i + 1);
+        b[i] = value_type(7 * i);
+    }
+    polynomial<value_type> p = {1, 3, 4, 25, 6, 7, 7};
+    basic_radix2_domain<FieldType> domain(n);
+
+    const std::string path = "polynomial_dfs_view_mapped_archive.bin";
+    {
+        std::ofstream os(path, std::ios::binary);
+        serialize(os, a);
+        serialize(os, p);
+        serialize(os, b);
+        serialize(os, domain);
+    }
+
+    {
+        mapped_archive archive(path);
+        BOOST_CHECK_EQUAL(archive.size(), 4);
+
+        std::unique_ptr<mapped_column<value_type>> column = archive.polynomial_dfs<value_type>(2);
+        polynomial_dfs_view<value_type, mapped_allocator<value_type>> view = column->dfs_view();
+        BOOST_CHECK_EQUAL(view.degree(), 3);
+        BOOST_CHECK_EQUAL(view.size(), n);
+        for (std::size_t i = 0; i < n; i++) {
+            BOOST_CHECK_EQUAL(view[i].data, b[i].data);
+        }
+
+        /* the views write to the mapping, but not to the file */
+        const value_type *mapped = column->container().data();
+        view[0] = value_type(5);
+        BOOST_CHECK(column->container().data() == mapped);
+        BOOST_CHECK_EQUAL(archive.polynomial_dfs<value_type>(2)->container()[0].data, value_type(5).data);
+        BOOST_CHECK_EQUAL(mapped_archive(path).polynomial_dfs<value_type>(2)->container()[0].data, b[0].data);
+
+        std::unique_ptr<mapped_column<value_type>> coefficients = archive.polynomial<value_type>(1);
+        polynomial_view<value_type, mapped_allocator<value_type>> q = coefficients->view();
+        BOOST_CHECK_EQUAL(q.size(), p.size());
+        for (std::size_t i = 0; i < p.size(); i++) {
+            BOOST_CHECK_EQUAL(q[i].data, p[i].data);
+        }
+
+        basic_radix2_domain<FieldType> restored(n);
+        archive.precompute(3, restored);
+        std::vector<value_type> x(a.begin(), a.end()), y(a.begin(), a.end());
+        domain.fft(x);
+        restored.fft(y);
+        for (std::size_t i = 0; i < n; i++) {
+            BOOST_CHECK_EQUAL(x[i].data, y[i].data);
+        }
+
+        BOOST_CHECK_THROW(archive.polynomial<value_type>(0), std::invalid_argument);
+        BOOST_CHECK_THROW(archive.polynomial_dfs<value_type>(4), std::out_of_range);
+        basic_radix2_domain<FieldType> other(2 * n);
+        BOOST_CHECK_THROW(archive.precompute(3, other), std::invalid_argument);
+    }
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2020-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+// Copyright (c) 2022 Aleksei Moskvin <alalmoskvin@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define BOOST_TEST_MODULE sparse_polynomial_test
+
+#include <vector>
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/polynomial/sparse_polynomial.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+typedef fields::bls12_fr<381> FieldType;
+typedef typename FieldType::value_type value_type;
+
+namespace {
+    /* schoolbook product, the reference of the sparse kernels */
+    polynomial<value_type> naive_product(const polynomial<value_type>& a, const polynomial<value_type>& b) {
+        polynomial<value_type> c(a.size() + b.size() - 1, value_type::zero());
+        for (std::size_t i = 0; i < a.size(); i++) {
+            for (std::size_t j = 0; j < b.size(); j++) {
+                c[i + j] += a[i] * b[j];
+            }
+        }
+        c.condense();
+        return c;
+    }
+
+    polynomial<value_type> dense(std::size_t n, std::size_t seed) {
+        polynomial<value_type> a(n);
+        for (std::size_t i = 0; i < n; i++) {
+            a[i] = value_type(i * i + seed * i + 1);
+        }
+        return a;
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(sparse_polynomial_test_suite)
+
+BOOST_AUTO_TEST_CASE(sparse_polynomial_constructor) {
+    const sparse_polynomial<value_type> a = {{7, 2}, {0, 1}, {3, 5}, {7, 3}, {5, 0}};
+    BOOST_CHECK_EQUAL(a.size(), 3);
+    BOOST_CHECK_EQUAL(a.degree(), 7);
+    BOOST_CHECK_EQUAL(a[7].data, value_type(5).data);
+    BOOST_CHECK_EQUAL(a[3].data, value_type(5).data);
+    BOOST_CHECK(a[5].is_zero());
+    BOOST_CHECK(a[8].is_zero());
+
+    const polynomial<value_type> dense_a = a.to_polynomial();
+    BOOST_CHECK(dense_a == polynomial<value_type>({1, 0, 0, 5, 0, 0, 0, 5}));
+    BOOST_CHECK(sparse_polynomial<value_type>(dense_a) == a);
+
+    BOOST_CHECK(sparse_polynomial<value_type>({{4, 1}, {4, -1}}).is_zero());
+    BOOST_CHECK(sparse_polynomial<value_type>(value_type::zero(), 3).is_zero());
+    BOOST_CHECK((a - a).is_zero());
+}
+
+BOOST_AUTO_TEST_CASE(sparse_polynomial_arithmetic) {
+    const sparse_polynomial<value_type> a = {{0, -1}, {16, 1}}, b = {{1, 3}, {16, 2}, {40, 7}};
+    const polynomial<value_type> dense_a = a.to_polynomial(), dense_b = b.to_polynomial();
+
+    BOOST_CHECK((a + b).to_polynomial() == dense_a + dense_b);
+    BOOST_CHECK((a - b).to_polynomial() == dense_a - dense_b);
+    BOOST_CHECK((a * b).to_polynomial() == naive_product(dense_a, dense_b));
+    BOOST_CHECK((a * value_type(3)).to_polynomial() == dense_a * value_type(3));
+
+    const value_type x = 0x1234567_cppui253;
+    BOOST_CHECK_EQUAL(b.evaluate(x).data, dense_b.evaluate(x).data);
+    BOOST_CHECK(sparse_polynomial<value_type>().evaluate(x).is_zero());
+}
+
+BOOST_AUTO_TEST_CASE(sparse_polynomial_dense_kernels) {
+    const sparse_polynomial<value_type> vanishing = {{0, -1}, {64, 1}}, b = {{3, 5}, {10, 2}, {17, 9}};
+    for (std::size_t n : {1, 10, 64, 300}) {
+        const polynomial<value_type> a = dense(n, 3);
+        for (const sparse_polynomial<value_type>& s : {vanishing, b}) {
+            const polynomial<value_type> dense_s = s.to_polynomial();
+            BOOST_CHECK(a * s == naive_product(a, dense_s));
+            BOOST_CHECK(s * a == naive_product(a, dense_s));
+            BOOST_CHECK(a + s == a + dense_s);
+            BOOST_CHECK(a - s == a - dense_s);
+            BOOST_CHECK(s - a == dense_s - a);
+
+            const polynomial<value_type> q = a / s, r = a % s;
+            BOOST_CHECK(q == a / dense_s);
+            BOOST_CHECK(r == a % dense_s);
+            BOOST_CHECK(naive_product(q, dense_s) + r == a);
+        }
+    }
+
+    /* a divisor of too many terms goes through the dense division */
+    std::vector<std::pair<std::size_t, value_type>> terms;
+    for (std::size_t e = 0; e < 100; e++) {
+        terms.emplace_back(e, value_type(e + 1));
+    }
+    const sparse_polynomial<value_type> full(terms.begin(), terms.end());
+    const polynomial<value_type> a = dense(300, 5);
+    BOOST_CHECK(a / full == a / full.to_polynomial());
+    BOOST_CHECK(a * full == naive_product(a, full.to_polynomial()));
+
+    BOOST_CHECK_THROW(a % sparse_polynomial<value_type>(), std::invalid_argument);
+
+    /* the product is split by coefficients of the result over the threads */
+    thread_pool::global() = std::make_shared<thread_pool>(3);
+    const polynomial<value_type> large = dense(3000, 1);
+    BOOST_CHECK(large * b == naive_product(large, b.to_polynomial()));
+    thread_pool::global().reset();
+}
+
+BOOST_AUTO_TEST_CASE(sparse_polynomial_dfs_kernels) {
+    const sparse_polynomial<value_type> s = {{0, 2}, {5, 1}, {31, 4}};
+    for (std::size_t n : {1, 4, 32, 64}) {
+        const value_type omega = unity_root<FieldType>(n);
+        const std::vector<value_type> values = s.evaluations(n);
+        for (std::size_t i = 0; i < n; i++) {
+            BOOST_CHECK_EQUAL(values[i].data, s.evaluate(omega.pow(i)).data);
+        }
+    }
+
+    /* with many terms the values come from the FFT of the coefficients */
+    std::vector<std::pair<std::size_t, value_type>> terms;
+    for (std::size_t e = 0; e < 100; e++) {
+        terms.emplace_back(e, value_type(3 * e + 1));
+    }
+    const sparse_polynomial<value_type> full(terms.begin(), terms.end());
+    const value_type omega = unity_root<FieldType>(128);
+    const std::vector<value_type> full_values = full.evaluations(128);
+    for (std::size_t i = 0; i < 128; i++) {
+        BOOST_CHECK_EQUAL(full_values[i].data, full.evaluate(omega.pow(i)).data);
+    }
+
+    const polynomial<value_type> a = dense(20, 7);
+    polynomial_dfs<value_type> a_dfs;
+    a_dfs.from_coefficients(a);
+    const polynomial<value_type> dense_s = s.to_polynomial();
+
+    polynomial_dfs<value_type> a_reversed;
+    a_reversed.from_coefficients(a, evaluation_order::bit_reversed);
+
+    /* the product has the size of its degree, the sum that of a */
+    const polynomial<value_type> expected_product = naive_product(a, dense_s);
+    for (const polynomial_dfs<value_type>& x : {a_dfs, a_reversed}) {
+        const polynomial_dfs<value_type> product = x * s;
+        BOOST_CHECK_EQUAL(product.degree(), 50);
+        BOOST_CHECK_EQUAL(product.size(), 64);
+        BOOST_CHECK(product.order() == evaluation_order::natural);
+        polynomial<value_type> product_coefficients(product.coefficients());
+        product_coefficients.condense();
+        BOOST_CHECK(product_coefficients == expected_product);
+        BOOST_CHECK(std::equal(product.begin(), product.end(), (s * x).begin()));
+
+        const polynomial_dfs<value_type> sum = x + s, difference = s - x;
+        BOOST_CHECK_EQUAL(sum.size(), 32);
+        polynomial<value_type> sum_coefficients(sum.coefficients()), difference_coefficients(difference.coefficients());
+        sum_coefficients.condense();
+        difference_coefficients.condense();
+        BOOST_CHECK(sum_coefficients == a + dense_s);
+        BOOST_CHECK(difference_coefficients == dense_s - a);
+    }
+
+    BOOST_CHECK_THROW(s.evaluations(12), std::invalid_argument);
+    BOOST_CHECK_THROW(s.to_polynomial_dfs(16), std::invalid_argument);
+    const polynomial_dfs<value_type> s_dfs = s.to_polynomial_dfs(32);
+    BOOST_CHECK_EQUAL(s_dfs.degree(), 31);
+    BOOST_CHECK(std::equal(s_dfs.begin(), s_dfs.end(), s.evaluations(32).begin()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()